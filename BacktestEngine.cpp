@@ -0,0 +1,303 @@
+#include "BacktestEngine.h"
+#include "database_simple.h"
+#include "IQFeedConnection/Logger.h"
+#include "Predictions/EMAKernel.h"
+#include "Predictions/PredictionTypes.h"
+#include "Predictions/TradingCalendar.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+
+// ==============================================
+// CONSTRUCTOR AND DESTRUCTOR
+// ==============================================
+
+BacktestEngine::BacktestEngine(std::shared_ptr<SimpleDatabaseManager> db_manager, const BacktestConfig& config)
+    : db_manager_(db_manager), config_(config) {
+    if (config_.worker_count == 0) {
+        config_.worker_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    if (config_.window_bars < static_cast<std::size_t>(Model1Parameters::MINIMUM_BARS)) {
+        config_.window_bars = Model1Parameters::MINIMUM_BARS;
+    }
+
+    logger_ = std::make_unique<Logger>("backtest_engine.log", true);
+    logger_->info("BacktestEngine initialized: model " + std::to_string(config_.model_id) + ", " +
+                 std::to_string(config_.days_back) + " days, " + std::to_string(config_.worker_count) + " workers");
+}
+
+BacktestEngine::~BacktestEngine() = default;
+
+// ==============================================
+// HISTORY
+// ==============================================
+
+bool BacktestEngine::load_history() {
+    if (!db_manager_ || !db_manager_->is_connected()) {
+        logger_->error("Cannot load backtest history: database not connected");
+        return false;
+    }
+
+    if (!history_.load(*db_manager_, config_.days_back)) {
+        logger_->error("Failed to load backtest history: " + db_manager_->get_last_error());
+        return false;
+    }
+
+    logger_->info("Loaded " + std::to_string(history_.bar_count()) + " bars in " +
+                 std::to_string(history_.series_count()) + " series for backtesting");
+    return true;
+}
+
+NextBusinessDayMap BacktestEngine::build_next_business_days(const std::vector<std::string>& symbols) const {
+    // Same trade-date calendar the live engine uses; resolved once per date
+    // so the workers only read the map
+    const TradingCalendar& calendar = TradingCalendar::instance();
+    NextBusinessDayMap next_business_day;
+
+    for (const auto& symbol : symbols) {
+        const std::vector<ActualBar>* bars = history_.bars(symbol, "daily");
+        if (!bars) continue;
+
+        for (const ActualBar& bar : *bars) {
+            long long day = bar.timestamp / 86400;
+            if (next_business_day.count(day)) continue;
+
+            next_business_day[day] = calendar.next_session(day);
+        }
+    }
+
+    return next_business_day;
+}
+
+// ==============================================
+// REPLAY
+// ==============================================
+
+void BacktestEngine::replay_series(const std::vector<ActualBar>& bars, const std::string& timeframe,
+                                   const BacktestConfig& config, const NextBusinessDayMap* next_business_day,
+                                   PredictionValidator::MetricsAccumulatorMap& metrics, BacktestRunStats& counters) {
+    static double ActualBar::* const DAILY_FIELDS[] = { &ActualBar::open, &ActualBar::high, &ActualBar::low, &ActualBar::close };
+    static const char* const DAILY_NAMES[] = { "open", "high", "low", "close" };
+    static double ActualBar::* const INTRADAY_FIELDS[] = { &ActualBar::high, &ActualBar::low };
+    static const char* const INTRADAY_NAMES[] = { "high", "low" };
+
+    const bool daily = timeframe == "daily";
+    if (daily && !next_business_day) return;
+
+    double ActualBar::* const* fields = daily ? DAILY_FIELDS : INTRADAY_FIELDS;
+    const char* const* names = daily ? DAILY_NAMES : INTRADAY_NAMES;
+    const std::size_t field_count = daily ? 4 : 2;
+
+    // Resolve the accumulators once; the loop below only does arithmetic.
+    // Component names follow predictions_all_symbols ("2hour_high", not "2hours_high").
+    const std::string prefix = timeframe == "2hours" ? "2hour" : timeframe;
+    MetricsAccumulator* accumulators[4];
+    for (std::size_t f = 0; f < field_count; f++) {
+        accumulators[f] = &metrics[PredictionValidator::MetricsKey(config.model_id, prefix + "_" + names[f])];
+    }
+
+    const std::size_t minimum = static_cast<std::size_t>(Model1Parameters::MINIMUM_BARS);
+    counters.bars_replayed += static_cast<long long>(bars.size());
+
+    for (std::size_t t = minimum - 1; t < bars.size(); t++) {
+        // The prediction made once bar t is complete, from the last window_bars bars
+        std::size_t begin = t + 1 > config.window_bars ? t + 1 - config.window_bars : 0;
+        std::size_t count = t + 1 - begin;
+
+        const ActualBar* target = nullptr;
+        if (daily) {
+            auto it = next_business_day->find(bars[t].timestamp / 86400);
+            if (it != next_business_day->end()) {
+                // Target business day, or the first bar after it (exchange holidays)
+                long long target_start = it->second * 86400;
+                auto found = std::lower_bound(bars.begin() + t + 1, bars.end(), target_start,
+                                              [](const ActualBar& bar, long long ts) { return bar.timestamp < ts; });
+                if (found != bars.end()) target = &*found;
+            }
+        } else if (t + 1 < bars.size()) {
+            target = &bars[t + 1];
+        }
+
+        if (!target) {
+            counters.unmatched += static_cast<long long>(field_count);
+            continue;
+        }
+
+        for (std::size_t f = 0; f < field_count; f++) {
+            double actual = target->*fields[f];
+            if (actual <= 0.0) {
+                counters.unmatched++;
+                continue;
+            }
+
+            EMAKernel::FieldView<ActualBar> series = { &bars[begin], count, fields[f], false };
+            double predicted = EMAKernel::predict(series, EMAKernel::STANDARD, Model1Parameters::BASE_ALPHA);
+
+            // Same accuracy definition as PredictionValidator
+            double accuracy = std::max(0.0, 1.0 - std::fabs((actual - predicted) / actual));
+            accumulators[f]->add(predicted, actual, accuracy);
+            counters.predictions++;
+        }
+    }
+}
+
+void BacktestEngine::replay_symbol(const std::string& symbol, const NextBusinessDayMap& next_business_day,
+                                   PredictionValidator::MetricsAccumulatorMap& metrics,
+                                   BacktestRunStats& counters) const {
+    static const char* const TIMEFRAMES[] = { "daily", "15min", "30min", "1hour", "2hours" };
+
+    for (const char* timeframe : TIMEFRAMES) {
+        const std::vector<ActualBar>* bars = history_.bars(symbol, timeframe);
+        if (bars) {
+            replay_series(*bars, timeframe, config_, &next_business_day, metrics, counters);
+        }
+    }
+}
+
+BacktestRunStats BacktestEngine::run() {
+    BacktestRunStats stats;
+
+    auto load_start = std::chrono::steady_clock::now();
+    if (!history_.is_loaded() && !load_history()) {
+        return stats;
+    }
+    stats.load_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - load_start).count();
+
+    auto replay_start = std::chrono::steady_clock::now();
+    std::vector<std::string> symbols = history_.symbols();
+    NextBusinessDayMap next_business_day = build_next_business_days(symbols);
+
+    stats.symbols = static_cast<int>(symbols.size());
+    stats.workers = static_cast<int>(std::min<std::size_t>(config_.worker_count, symbols.size()));
+
+    std::atomic<std::size_t> next_symbol{0};
+    std::mutex merge_mutex;
+    std::vector<std::thread> workers;
+
+    for (int w = 0; w < stats.workers; w++) {
+        workers.emplace_back([&]() {
+            PredictionValidator::MetricsAccumulatorMap partial;
+            BacktestRunStats counters;
+
+            for (std::size_t i = next_symbol++; i < symbols.size(); i = next_symbol++) {
+                replay_symbol(symbols[i], next_business_day, partial, counters);
+            }
+
+            std::lock_guard<std::mutex> lock(merge_mutex);
+            for (const auto& [key, accumulator] : partial) {
+                stats.metrics[key].merge(accumulator);
+            }
+            stats.bars_replayed += counters.bars_replayed;
+            stats.predictions += counters.predictions;
+            stats.unmatched += counters.unmatched;
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    stats.replay_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - replay_start).count();
+
+    std::stringstream summary;
+    summary << std::fixed << std::setprecision(1) << "Backtest replayed " << stats.bars_replayed << " bars of "
+            << stats.symbols << " symbols: " << stats.predictions << " predictions scored in "
+            << stats.replay_seconds << "s (" << stats.throughput() << " predictions/s)";
+    logger_->success(summary.str());
+
+    return stats;
+}
+
+// ==============================================
+// SUMMARY
+// ==============================================
+
+bool BacktestEngine::save_summary(const BacktestRunStats& stats) {
+    if (stats.metrics.empty()) {
+        logger_->info("No backtest metrics to save");
+        return true;
+    }
+
+    try {
+        std::stringstream run_query;
+        run_query << std::setprecision(17);
+        run_query << "INSERT INTO backtest_runs (model_id, days_back, symbols, bars_replayed, predictions, "
+                  << "unmatched, replay_seconds) VALUES ("
+                  << config_.model_id << ", " << config_.days_back << ", " << stats.symbols << ", "
+                  << stats.bars_replayed << ", " << stats.predictions << ", " << stats.unmatched << ", "
+                  << stats.replay_seconds << ") RETURNING run_id";
+
+        PGresult* result = db_manager_->execute_query_with_result(run_query.str());
+        if (!result || PQntuples(result) == 0) {
+            if (result) PQclear(result);
+            logger_->error("Failed to record backtest run: " + db_manager_->get_last_error());
+            return false;
+        }
+        std::string run_id = PQgetvalue(result, 0, 0);
+        PQclear(result);
+
+        // One row per component plus one per base timeframe
+        PredictionValidator::MetricsAccumulatorMap rows = stats.metrics;
+        for (const auto& [key, accumulator] : stats.metrics) {
+            rows[PredictionValidator::MetricsKey(key.first, PredictionValidator::base_timeframe(key.second))]
+                .merge(accumulator);
+        }
+
+        std::stringstream insert;
+        insert << std::setprecision(17);
+        insert << "INSERT INTO backtest_results (run_id, model_id, timeframe, sample_count, "
+               << "mae, rmse, mape, r_squared, mean_accuracy, std_deviation) VALUES ";
+
+        bool first = true;
+        for (const auto& [key, accumulator] : rows) {
+            if (accumulator.count == 0) continue;
+            ModelMetrics metrics = PredictionValidator::to_model_metrics(key.first, key.second, accumulator);
+            insert << (first ? "" : ", ") << "(" << run_id << ", " << key.first << ", '"
+                   << db_manager_->escape_string(key.second) << "', " << accumulator.count << ", "
+                   << metrics.mae << ", " << metrics.rmse << ", " << metrics.mape << ", "
+                   << metrics.r_squared << ", " << metrics.mean_accuracy << ", " << metrics.std_deviation << ")";
+            first = false;
+        }
+
+        if (!first && !db_manager_->execute_query(insert.str())) {
+            logger_->error("Failed to save backtest results: " + db_manager_->get_last_error());
+            return false;
+        }
+
+        logger_->success("Saved backtest run " + run_id);
+        return true;
+
+    } catch (const std::exception& e) {
+        logger_->error("Exception saving backtest summary: " + std::string(e.what()));
+        return false;
+    }
+}
+
+void BacktestEngine::print_summary(const BacktestRunStats& stats) const {
+    std::cout << "\n=== BACKTEST SUMMARY ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Model:       " << config_.model_id << " (" << config_.days_back << " days)" << std::endl;
+    std::cout << "Symbols:     " << stats.symbols << " on " << stats.workers << " workers" << std::endl;
+    std::cout << "Bars:        " << stats.bars_replayed << std::endl;
+    std::cout << "Predictions: " << stats.predictions << " (" << stats.unmatched << " unmatched)" << std::endl;
+    std::cout << "Load:        " << stats.load_seconds << " s" << std::endl;
+    std::cout << "Replay:      " << stats.replay_seconds << " s (" << stats.throughput() << " predictions/s)" << std::endl;
+
+    if (!stats.metrics.empty()) {
+        std::cout << "\nTimeframe      Samples     MAE        RMSE       MAPE%    R²       Accuracy" << std::endl;
+        for (const auto& [key, acc] : stats.metrics) {
+            if (acc.count == 0) continue;
+            std::cout << std::left << std::setw(15) << key.second << std::setw(12) << acc.count << std::right
+                      << std::setprecision(4) << std::setw(10) << acc.mae() << " " << std::setw(10) << acc.rmse()
+                      << " " << std::setw(8) << acc.mape() << " " << std::setw(8) << acc.r_squared() << " "
+                      << std::setw(8) << acc.mean_accuracy() * 100 << "%" << std::endl;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+#ifndef BACKTEST_ENGINE_H
+#define BACKTEST_ENGINE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+#include "PredictionValidator.h"
+#include "Predictions/ActualsIndex.h"
+
+class SimpleDatabaseManager;
+class Logger;
+
+struct BacktestConfig {
+    int model_id = 1;
+    int days_back = 365;             // History replayed, per historical_fetch_* table
+    std::size_t worker_count = 0;    // 0 = one worker per hardware thread
+    std::size_t window_bars = 100;   // Bars the live engine feeds the kernel per prediction
+};
+
+struct BacktestRunStats {
+    int workers = 0;
+    int symbols = 0;
+    long long bars_replayed = 0;
+    long long predictions = 0;       // Component predictions scored (e.g. daily_open, 15min_high)
+    long long unmatched = 0;         // Predictions with no later actual bar to score against
+    double load_seconds = 0.0;
+    double replay_seconds = 0.0;
+
+    // Keyed by (model_id, component timeframe) exactly like predictions_all_symbols
+    PredictionValidator::MetricsAccumulatorMap metrics;
+
+    double throughput() const { return replay_seconds > 0.0 ? predictions / replay_seconds : 0.0; }
+};
+
+// Next business day (day number -> day number) for every daily bar date
+using NextBusinessDayMap = std::unordered_map<long long, long long>;
+
+// Replays stored history through Model 1 without touching the prediction
+// tables. All historical_fetch_* bars are loaded once into an ActualsIndex;
+// then, for every bar, the engine predicts the next interval from the same
+// 100-bar window and EMA layout the live MarketPredictionEngine uses, and
+// scores it against the next actual bar in memory. Daily targets come from
+// the shared TradingCalendar, as in the live engine. Symbols are replayed in
+// parallel, and only the summary is written to the database.
+class BacktestEngine {
+private:
+    std::shared_ptr<SimpleDatabaseManager> db_manager_;
+    std::unique_ptr<Logger> logger_;
+    BacktestConfig config_;
+    ActualsIndex history_;
+
+    NextBusinessDayMap build_next_business_days(const std::vector<std::string>& symbols) const;
+    void replay_symbol(const std::string& symbol, const NextBusinessDayMap& next_business_day,
+                       PredictionValidator::MetricsAccumulatorMap& metrics,
+                       BacktestRunStats& counters) const;
+
+public:
+    explicit BacktestEngine(std::shared_ptr<SimpleDatabaseManager> db_manager,
+                            const BacktestConfig& config = BacktestConfig());
+    ~BacktestEngine();
+
+    // One bulk read per historical table; run() calls it when nothing is loaded
+    bool load_history();
+    ActualsIndex& history() { return history_; }
+
+    BacktestRunStats run();
+
+    // Score every prediction of one series. `timeframe` is the base name
+    // ("daily", "15min", ...); daily series need the business day map.
+    static void replay_series(const std::vector<ActualBar>& bars, const std::string& timeframe,
+                              const BacktestConfig& config, const NextBusinessDayMap* next_business_day,
+                              PredictionValidator::MetricsAccumulatorMap& metrics, BacktestRunStats& counters);
+
+    bool save_summary(const BacktestRunStats& stats);
+    void print_summary(const BacktestRunStats& stats) const;
+};
+
+#endif
@@ -0,0 +1,133 @@
+#include "BarEventBus.h"
+
+#include <exception>
+#include <vector>
+
+BarEventBus::BarEventBus()
+    : running_subscription_id_(0), next_subscription_id_(1), stopping_(false), published_count_(0), delivered_count_(0) {
+
+    logger_ = std::make_unique<Logger>("bar_event_bus.log", true);
+    dispatcher_thread_ = std::thread(&BarEventBus::dispatch_loop, this);
+    dispatcher_id_ = dispatcher_thread_.get_id();
+    logger_->info("BarEventBus started");
+}
+
+BarEventBus::~BarEventBus() {
+    stop();
+}
+
+// ==============================================
+// SUBSCRIPTIONS
+// ==============================================
+
+int BarEventBus::subscribe(Handler handler) {
+    std::lock_guard<std::mutex> lock(subscribers_mutex_);
+    int id = next_subscription_id_++;
+    subscribers_[id] = std::move(handler);
+    logger_->info("Subscriber " + std::to_string(id) + " registered");
+    return id;
+}
+
+void BarEventBus::unsubscribe(int subscription_id) {
+    std::unique_lock<std::mutex> lock(subscribers_mutex_);
+    if (subscribers_.erase(subscription_id) > 0) {
+        logger_->info("Subscriber " + std::to_string(subscription_id) + " removed");
+    }
+    
+    // Wait out a delivery already in progress, unless we are that delivery
+    if (std::this_thread::get_id() != dispatcher_id_) {
+        handler_done_cv_.wait(lock, [&] { return running_subscription_id_ != subscription_id; });
+    }
+}
+
+// ==============================================
+// PUBLISH / DISPATCH
+// ==============================================
+
+void BarEventBus::publish(const NewBarEvent& event) {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (stopping_) {
+            return;
+        }
+        queue_.push_back(event);
+    }
+    published_count_++;
+    queue_cv_.notify_one();
+
+    NEXDAY_LOG_DEBUG(logger_, "Published new bar: " + event.symbol + " " + event.timeframe + " " +
+                   event.bar_date + " " + event.bar_time);
+}
+
+void BarEventBus::stop() {
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (stopping_) {
+            return;
+        }
+        stopping_ = true;
+    }
+    queue_cv_.notify_all();
+
+    if (dispatcher_thread_.joinable()) {
+        dispatcher_thread_.join();
+    }
+
+    logger_->info("BarEventBus stopped: " + std::to_string(published_count_.load()) + " published, " +
+                  std::to_string(delivered_count_.load()) + " delivered");
+}
+
+std::size_t BarEventBus::pending_events() const {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    return queue_.size();
+}
+
+void BarEventBus::dispatch_loop() {
+    while (true) {
+        NewBarEvent event;
+        {
+            std::unique_lock<std::mutex> lock(queue_mutex_);
+            queue_cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+
+            // Drain remaining events before exiting
+            if (queue_.empty()) {
+                return;
+            }
+
+            event = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        // Snapshot handlers so subscribers can (un)subscribe from inside a callback
+        std::vector<std::pair<int, Handler>> handlers;
+        {
+            std::lock_guard<std::mutex> lock(subscribers_mutex_);
+            handlers.assign(subscribers_.begin(), subscribers_.end());
+        }
+
+        for (const auto& [id, handler] : handlers) {
+            {
+                // Skip handlers unsubscribed since the snapshot; claim the rest
+                std::lock_guard<std::mutex> lock(subscribers_mutex_);
+                if (subscribers_.count(id) == 0) {
+                    continue;
+                }
+                running_subscription_id_ = id;
+            }
+            
+            try {
+                handler(event);
+                delivered_count_++;
+            } catch (const std::exception& e) {
+                logger_->error("Subscriber " + std::to_string(id) + " failed on " + event.symbol + " " +
+                               event.timeframe + ": " + e.what());
+            }
+            
+            {
+                std::lock_guard<std::mutex> lock(subscribers_mutex_);
+                running_subscription_id_ = 0;
+            }
+            handler_done_cv_.notify_all();
+        }
+    }
+}
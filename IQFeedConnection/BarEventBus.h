@@ -0,0 +1,83 @@
+#ifndef BAR_EVENT_BUS_H
+#define BAR_EVENT_BUS_H
+
+#include <string>
+#include <map>
+#include <deque>
+#include <memory>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <functional>
+#include <condition_variable>
+#include "Logger.h"
+
+// ==============================================
+// BAR EVENT BUS - IN-PROCESS NEW BAR NOTIFICATIONS
+// ==============================================
+
+// Published by FetchScheduler once a newly completed bar has been persisted.
+struct NewBarEvent {
+    std::string symbol;
+    std::string timeframe;       // Scheduler naming: "15min", "30min", "1hour", "2hours", "daily"
+    std::string bar_date;        // YYYY-MM-DD
+    std::string bar_time;        // HH:MM:SS (empty for daily bars)
+    std::chrono::system_clock::time_point bar_close_time;   // When the bar's interval ended
+    std::chrono::system_clock::time_point persisted_time;   // When the bar reached the database
+};
+
+// Events are queued by publish() and delivered on a single dispatcher thread,
+// so a slow subscriber never stalls the fetch loop. Subscribers see events in
+// publish order.
+class BarEventBus {
+public:
+    using Handler = std::function<void(const NewBarEvent&)>;
+
+    BarEventBus();
+    ~BarEventBus();
+
+    BarEventBus(const BarEventBus&) = delete;
+    BarEventBus& operator=(const BarEventBus&) = delete;
+
+    // Subscription management - returns an id for unsubscribe()
+    int subscribe(Handler handler);
+    // Once this returns the handler is not running and never runs again, so
+    // the subscriber may be destroyed. From inside a callback it does not wait
+    // (the caller is the running handler).
+    void unsubscribe(int subscription_id);
+
+    // Queue an event for delivery (no-op once stopped)
+    void publish(const NewBarEvent& event);
+
+    // Deliver everything still queued, then stop the dispatcher thread
+    void stop();
+
+    // Status
+    std::size_t pending_events() const;
+    long long published_count() const { return published_count_.load(); }
+    long long delivered_count() const { return delivered_count_.load(); }
+
+private:
+    void dispatch_loop();
+
+    std::unique_ptr<Logger> logger_;
+
+    std::map<int, Handler> subscribers_;
+    mutable std::mutex subscribers_mutex_;
+    std::condition_variable handler_done_cv_;
+    int running_subscription_id_;            // Handler the dispatcher is inside, 0 when none
+    int next_subscription_id_;
+
+    std::deque<NewBarEvent> queue_;
+    mutable std::mutex queue_mutex_;
+    std::condition_variable queue_cv_;
+    bool stopping_;
+
+    std::atomic<long long> published_count_;
+    std::atomic<long long> delivered_count_;
+    std::thread dispatcher_thread_;
+    std::thread::id dispatcher_id_;          // Kept apart so stop()'s join() cannot race unsubscribe()
+};
+
+#endif // BAR_EVENT_BUS_H
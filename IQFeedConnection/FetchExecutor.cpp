@@ -0,0 +1,273 @@
+#include "FetchExecutor.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <exception>
+
+// ==============================================
+// FETCH BATCH
+// ==============================================
+
+void FetchBatch::add(int jobs) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_ += jobs;
+}
+
+void FetchBatch::complete(bool successful) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_--;
+        if (!successful) failed_++;
+    }
+    done_.notify_all();
+}
+
+bool FetchBatch::wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return pending_ <= 0; });
+    return failed_ == 0;
+}
+
+int FetchBatch::failed_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+// ==============================================
+// CONSTRUCTION
+// ==============================================
+
+FetchExecutor::FetchExecutor(const FetchExecutorConfig& config) : config_(config) {
+    if (config_.worker_count == 0) config_.worker_count = 1;
+    if (config_.max_in_flight == 0 || config_.max_in_flight > config_.worker_count) {
+        config_.max_in_flight = config_.worker_count;
+    }
+    if (config_.max_queue_depth == 0) config_.max_queue_depth = 1;
+
+    MetricsRegistry& registry = config_.registry ? *config_.registry : MetricsRegistry::instance();
+    for (FetchPriority priority : { FetchPriority::LIVE, FetchPriority::BACKFILL }) {
+        for (const auto& timeframe : config_.timeframes) {
+            Queue queue;
+            queue.timeframe = timeframe;
+            queue.priority = priority;
+            MetricLabels labels = { { "timeframe", timeframe },
+                                    { "priority", priority == FetchPriority::LIVE ? "live" : "backfill" } };
+            queue.wait_time = &registry.histogram("nexday_fetch_queue_wait_seconds",
+                                                  "Fetch job submit to start, per executor queue", labels,
+                                                  MetricsRegistry::wait_buckets());
+            queue.run_time = &registry.histogram("nexday_fetch_run_seconds",
+                                                 "Fetch job start to finish on an executor worker", labels,
+                                                 MetricsRegistry::wait_buckets());
+            queues_.push_back(std::move(queue));
+        }
+    }
+
+    for (std::size_t i = 0; i < config_.worker_count; i++) {
+        workers_.emplace_back(&FetchExecutor::worker_loop, this);
+    }
+}
+
+FetchExecutor::~FetchExecutor() {
+    stop();
+}
+
+// ==============================================
+// SUBMISSION
+// ==============================================
+
+bool FetchExecutor::submit(FetchJob job) {
+    return enqueue(std::move(job), true);
+}
+
+bool FetchExecutor::try_submit(FetchJob job) {
+    return enqueue(std::move(job), false);
+}
+
+bool FetchExecutor::enqueue(FetchJob job, bool block) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    Queue& queue = queues_[queue_index(job.timeframe, job.priority)];
+
+    if (block) {
+        space_.wait(lock, [&] { return stopped_ || queue.jobs.size() < config_.max_queue_depth; });
+    }
+    if (stopped_) return false;
+    if (queue.jobs.size() >= config_.max_queue_depth) {
+        queue.rejected++;
+        return false;
+    }
+
+    if (job.batch) job.batch->add();
+    queue.jobs.push_back({ std::move(job), Clock::now() });
+    queue.submitted++;
+    queue.max_depth = std::max(queue.max_depth, queue.jobs.size());
+    queued_++;
+
+    work_.notify_one();
+    return true;
+}
+
+// Unknown timeframes share the last (lowest-priority) queue of their class
+std::size_t FetchExecutor::queue_index(const std::string& timeframe, FetchPriority priority) const {
+    std::size_t per_class = config_.timeframes.size();
+    auto it = std::find(config_.timeframes.begin(), config_.timeframes.end(), timeframe);
+    std::size_t rank = it == config_.timeframes.end() ? per_class - 1
+                                                       : static_cast<std::size_t>(it - config_.timeframes.begin());
+    return static_cast<std::size_t>(priority) * per_class + rank;
+}
+
+// ==============================================
+// WORKERS
+// ==============================================
+
+bool FetchExecutor::has_runnable_locked() const {
+    return queued_ > 0 && in_flight_ < config_.max_in_flight;
+}
+
+void FetchExecutor::worker_loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (true) {
+        work_.wait(lock, [this] { return stopped_ || has_runnable_locked(); });
+        if (stopped_) return;
+
+        auto queue_it = std::find_if(queues_.begin(), queues_.end(),
+                                     [](const Queue& queue) { return !queue.jobs.empty(); });
+        Queue& queue = *queue_it;
+        Pending pending = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        queued_--;
+        in_flight_++;
+        space_.notify_all();
+
+        lock.unlock();
+
+        auto started = Clock::now();
+        queue.wait_time->observe(started - pending.enqueued);
+
+        bool successful = false;
+        try {
+            successful = pending.job.run && pending.job.run();
+        } catch (const std::exception& e) {
+            std::cerr << "Fetch job " << pending.job.symbol << " " << pending.job.timeframe
+                      << " threw: " << e.what() << std::endl;
+        }
+
+        queue.run_time->observe(Clock::now() - started);
+        if (pending.job.batch) pending.job.batch->complete(successful);
+
+        lock.lock();
+        in_flight_--;
+        queue.completed++;
+        if (!successful) queue.failed++;
+
+        work_.notify_one();
+        idle_.notify_all();
+    }
+}
+
+// ==============================================
+// CONTROL
+// ==============================================
+
+void FetchExecutor::wait_idle() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return stopped_ || (queued_ == 0 && in_flight_ == 0); });
+}
+
+void FetchExecutor::stop() {
+    std::vector<FetchJob> discarded;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopped_ && workers_.empty()) return;
+        stopped_ = true;
+
+        for (auto& queue : queues_) {
+            for (auto& pending : queue.jobs) {
+                discarded.push_back(std::move(pending.job));
+            }
+            queue.jobs.clear();
+        }
+        queued_ = 0;
+    }
+    work_.notify_all();
+    space_.notify_all();
+    idle_.notify_all();
+
+    for (auto& job : discarded) {
+        if (job.batch) job.batch->complete(false);
+    }
+
+    for (auto& worker : workers_) {
+        if (worker.joinable()) worker.join();
+    }
+    workers_.clear();
+}
+
+void FetchExecutor::set_max_in_flight(std::size_t max_in_flight) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        config_.max_in_flight = std::max<std::size_t>(1, std::min(max_in_flight, config_.worker_count));
+    }
+    work_.notify_all();
+}
+
+std::size_t FetchExecutor::max_in_flight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return config_.max_in_flight;
+}
+
+std::size_t FetchExecutor::in_flight() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
+
+std::size_t FetchExecutor::queued() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queued_;
+}
+
+// ==============================================
+// METRICS
+// ==============================================
+
+std::vector<FetchQueueStats> FetchExecutor::stats() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<FetchQueueStats> result;
+
+    for (const auto& queue : queues_) {
+        FetchQueueStats stats;
+        stats.timeframe = queue.timeframe;
+        stats.priority = queue.priority;
+        stats.depth = queue.jobs.size();
+        stats.max_depth = queue.max_depth;
+        stats.submitted = queue.submitted;
+        stats.completed = queue.completed;
+        stats.failed = queue.failed;
+        stats.rejected = queue.rejected;
+        HistogramSnapshot wait = queue.wait_time->snapshot();
+        stats.wait_p50_ms = wait.quantile(0.50) * 1000.0;
+        stats.wait_p95_ms = wait.quantile(0.95) * 1000.0;
+        stats.wait_p99_ms = wait.quantile(0.99) * 1000.0;
+        HistogramSnapshot run = queue.run_time->snapshot();
+        stats.run_p50_ms = run.quantile(0.50) * 1000.0;
+        stats.run_p95_ms = run.quantile(0.95) * 1000.0;
+        stats.run_p99_ms = run.quantile(0.99) * 1000.0;
+        result.push_back(stats);
+    }
+    return result;
+}
+
+void FetchExecutor::print_stats(std::ostream& out) const {
+    out << "Fetch executor: " << in_flight() << "/" << max_in_flight() << " in flight, "
+        << queued() << " queued" << std::endl;
+
+    for (const auto& stats : this->stats()) {
+        if (stats.submitted == 0 && stats.rejected == 0) continue;
+        out << "  " << (stats.priority == FetchPriority::LIVE ? "live     " : "backfill ")
+            << std::left << std::setw(7) << stats.timeframe << std::right
+            << " depth " << stats.depth << " (max " << stats.max_depth << ")"
+            << ", done " << stats.completed << ", failed " << stats.failed << ", rejected " << stats.rejected
+            << ", wait p50/p99 " << stats.wait_p50_ms << "/" << stats.wait_p99_ms << " ms"
+            << ", run p50/p99 " << stats.run_p50_ms << "/" << stats.run_p99_ms << " ms" << std::endl;
+    }
+}
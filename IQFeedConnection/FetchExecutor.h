@@ -0,0 +1,152 @@
+#ifndef FETCH_EXECUTOR_H
+#define FETCH_EXECUTOR_H
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+#include <iosfwd>
+#include "MetricsRegistry.h"
+
+// ==============================================
+// FETCH EXECUTOR - BOUNDED-CONCURRENCY FETCH WORKERS
+// ==============================================
+
+// Live fetches (a bar just closed) always go ahead of backfill/recovery
+enum class FetchPriority {
+    LIVE = 0,
+    BACKFILL = 1
+};
+
+// Counts outstanding jobs of one submission so a caller can wait for them
+class FetchBatch {
+public:
+    void add(int jobs = 1);
+    void complete(bool successful);
+
+    // Blocks until every added job has completed; true if all succeeded
+    bool wait();
+    int failed_count() const;
+
+private:
+    int pending_ = 0;
+    int failed_ = 0;
+    mutable std::mutex mutex_;
+    std::condition_variable done_;
+};
+
+struct FetchJob {
+    std::string timeframe;
+    std::string symbol;
+    FetchPriority priority = FetchPriority::LIVE;
+    std::function<bool()> run;              // Returns false on a failed fetch
+    std::shared_ptr<FetchBatch> batch;      // Optional
+};
+
+struct FetchExecutorConfig {
+    std::size_t worker_count = 4;
+    std::size_t max_in_flight = 4;          // Global cap on concurrent IQFeed requests (<= worker_count)
+    std::size_t max_queue_depth = 1024;     // Per queue; submit() blocks beyond this
+
+    // Queue order within a priority class: shorter timeframes first
+    std::vector<std::string> timeframes = { "15min", "30min", "1hour", "2hours", "daily" };
+
+    // Where the per-queue wait and run histograms live; null = MetricsRegistry::instance()
+    MetricsRegistry* registry = nullptr;
+};
+
+// Per queue: depth, wait time (submit to start) and run time. The wait and
+// run histograms are also exported as nexday_fetch_queue_wait_seconds and
+// nexday_fetch_run_seconds, labelled by timeframe and priority.
+struct FetchQueueStats {
+    std::string timeframe;
+    FetchPriority priority = FetchPriority::LIVE;
+    std::size_t depth = 0;
+    std::size_t max_depth = 0;
+    long long submitted = 0;
+    long long completed = 0;
+    long long failed = 0;
+    long long rejected = 0;
+    // Upper bounds of the histogram buckets holding each percentile
+    double wait_p50_ms = 0.0, wait_p95_ms = 0.0, wait_p99_ms = 0.0;
+    double run_p50_ms = 0.0, run_p95_ms = 0.0, run_p99_ms = 0.0;
+};
+
+// A fixed pool of workers draining one FIFO queue per (priority, timeframe).
+// Workers always take the first non-empty queue in priority order (all LIVE
+// queues before BACKFILL, 15min before 2hours), and at most max_in_flight
+// jobs run at once. A full queue blocks submit() (or fails try_submit()), so
+// a stalled feed slows the producer instead of growing memory.
+class FetchExecutor {
+public:
+    explicit FetchExecutor(const FetchExecutorConfig& config = FetchExecutorConfig());
+    ~FetchExecutor();
+
+    FetchExecutor(const FetchExecutor&) = delete;
+    FetchExecutor& operator=(const FetchExecutor&) = delete;
+
+    // Blocks while the job's queue is full. False once stopped.
+    bool submit(FetchJob job);
+    // Never blocks; false (and counted as rejected) if the queue is full
+    bool try_submit(FetchJob job);
+
+    // Wait until every queue is empty and nothing is in flight
+    void wait_idle();
+
+    // Discard queued jobs (their batches count them as failed), let
+    // in-flight jobs finish and join the workers
+    void stop();
+
+    void set_max_in_flight(std::size_t max_in_flight);
+    std::size_t max_in_flight() const;
+    std::size_t in_flight() const;
+    std::size_t queued() const;
+
+    std::vector<FetchQueueStats> stats() const;
+    void print_stats(std::ostream& out) const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Pending {
+        FetchJob job;
+        Clock::time_point enqueued;
+    };
+
+    struct Queue {
+        std::string timeframe;
+        FetchPriority priority;
+        std::deque<Pending> jobs;
+        std::size_t max_depth = 0;
+        long long submitted = 0;
+        long long completed = 0;
+        long long failed = 0;
+        long long rejected = 0;
+        Histogram* wait_time = nullptr;     // Owned by the registry
+        Histogram* run_time = nullptr;
+    };
+
+    bool enqueue(FetchJob job, bool block);
+    std::size_t queue_index(const std::string& timeframe, FetchPriority priority) const;
+    bool has_runnable_locked() const;
+    void worker_loop();
+
+    FetchExecutorConfig config_;
+    std::vector<Queue> queues_;             // Scanned in index order = priority order
+    std::vector<std::thread> workers_;
+    std::size_t in_flight_ = 0;
+    std::size_t queued_ = 0;
+    bool stopped_ = false;
+
+    mutable std::mutex mutex_;
+    std::condition_variable work_;          // Job queued, slot freed or stop
+    std::condition_variable space_;         // Queue space freed or stop
+    std::condition_variable idle_;          // A job finished
+};
+
+#endif // FETCH_EXECUTOR_H
@@ -0,0 +1,250 @@
+#include "FetchHistoryRing.h"
+#include <algorithm>
+#include <thread>
+#include <cmath>
+
+namespace {
+    std::int64_t to_epoch_ms(std::chrono::system_clock::time_point time) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch()).count();
+    }
+
+    std::chrono::system_clock::time_point from_epoch_ms(std::int64_t ms) {
+        return std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(ms)));
+    }
+
+    // Nearest-rank percentile; partially sorts the samples in place
+    double percentile_ms(std::vector<std::uint32_t>& samples_us, double percentile) {
+        if (samples_us.empty()) return 0.0;
+        std::size_t rank = static_cast<std::size_t>(std::ceil(percentile / 100.0 * samples_us.size()));
+        std::size_t index = std::min(samples_us.size() - 1, rank > 0 ? rank - 1 : 0);
+        std::nth_element(samples_us.begin(), samples_us.begin() + index, samples_us.end());
+        return samples_us[index] / 1000.0;
+    }
+
+    const std::string EMPTY;
+}
+
+// ==============================================
+// STRING INTERNER
+// ==============================================
+
+StringInterner::StringInterner(std::size_t capacity)
+    : strings_(new std::string[std::min<std::size_t>(capacity, StringInterner::FULL)]),
+      capacity_(std::min<std::size_t>(capacity, StringInterner::FULL)),
+      index_(std::make_shared<const Index>()) {
+}
+
+std::uint16_t StringInterner::intern(const std::string& text) {
+    {
+        auto index = std::atomic_load(&index_);
+        auto it = index->find(text);
+        if (it != index->end()) return it->second;
+    }
+
+    std::lock_guard<std::mutex> lock(insert_mutex_);
+    auto index = std::atomic_load(&index_);
+    auto it = index->find(text);                            // Added while we looked
+    if (it != index->end()) return it->second;
+
+    std::size_t current = count_.load(std::memory_order_relaxed);
+    if (current >= capacity_) {
+        overflows_.fetch_add(1, std::memory_order_relaxed);
+        return FULL;
+    }
+
+    strings_[current] = text;
+    count_.store(current + 1, std::memory_order_release);
+
+    auto next = std::make_shared<Index>(*index);
+    next->emplace(text, static_cast<std::uint16_t>(current));
+    std::atomic_store(&index_, std::shared_ptr<const Index>(std::move(next)));
+    return static_cast<std::uint16_t>(current);
+}
+
+const std::string& StringInterner::lookup(std::uint16_t id) const {
+    return id < count_.load(std::memory_order_acquire) ? strings_[id] : EMPTY;
+}
+
+// ==============================================
+// RING
+// ==============================================
+
+FetchHistoryRing::FetchHistoryRing(std::size_t capacity)
+    : symbols_(4096), timeframes_(64), errors_(256) {
+    capacity_ = 1;
+    while (capacity_ < std::max<std::size_t>(capacity, 2)) {
+        capacity_ <<= 1;
+    }
+    mask_ = capacity_ - 1;
+    slots_.reset(new Slot[capacity_]);
+    for (std::size_t i = 0; i < capacity_; i++) {
+        for (auto& word : slots_[i].words) word.store(0, std::memory_order_relaxed);
+    }
+}
+
+void FetchHistoryRing::record(const std::string& symbol, const std::string& timeframe,
+                              std::chrono::system_clock::time_point scheduled_time,
+                              std::chrono::system_clock::time_point actual_time,
+                              std::chrono::system_clock::duration latency,
+                              bool successful, int bars_fetched, const std::string& error_message) {
+    long long latency_us = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+
+    Packed record;
+    record.scheduled_ms = to_epoch_ms(scheduled_time);
+    record.actual_ms = to_epoch_ms(actual_time);
+    record.latency_us = static_cast<std::uint32_t>(std::min<long long>(std::max<long long>(latency_us, 0), UINT32_MAX));
+    record.bars_fetched = bars_fetched;
+    record.symbol_id = symbols_.intern(symbol);
+    record.timeframe_id = timeframes_.intern(timeframe);
+    record.error_id = error_message.empty() ? StringInterner::FULL : errors_.intern(error_message);
+    record.successful = successful;
+    publish(record);
+}
+
+void FetchHistoryRing::publish(const Packed& record) {
+    std::uint64_t index = head_.fetch_add(1, std::memory_order_relaxed);
+    Slot& slot = slots_[index & mask_];
+    const std::uint64_t writing = 2 * index + 1;
+
+    // Another writer a full lap behind may still be filling this slot; wait
+    // for it (only possible with capacity writers racing), and give way if
+    // a newer record already owns the slot
+    std::uint64_t seen = slot.sequence.load(std::memory_order_relaxed);
+    while (true) {
+        if (seen > writing) return;
+        if (seen & 1) {
+            std::this_thread::yield();
+            seen = slot.sequence.load(std::memory_order_relaxed);
+            continue;
+        }
+        if (slot.sequence.compare_exchange_weak(seen, writing, std::memory_order_relaxed)) break;
+    }
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.words[0].store(static_cast<std::uint64_t>(record.scheduled_ms), std::memory_order_relaxed);
+    slot.words[1].store(static_cast<std::uint64_t>(record.actual_ms), std::memory_order_relaxed);
+    slot.words[2].store(static_cast<std::uint64_t>(record.latency_us) |
+                        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(record.bars_fetched)) << 32),
+                        std::memory_order_relaxed);
+    slot.words[3].store(static_cast<std::uint64_t>(record.symbol_id) |
+                        (static_cast<std::uint64_t>(record.timeframe_id) << 16) |
+                        (static_cast<std::uint64_t>(record.error_id) << 32) |
+                        (static_cast<std::uint64_t>(record.successful ? 1 : 0) << 48),
+                        std::memory_order_relaxed);
+
+    slot.sequence.store(writing + 1, std::memory_order_release);
+}
+
+bool FetchHistoryRing::read(std::uint64_t index, Packed& record) const {
+    const Slot& slot = slots_[index & mask_];
+    const std::uint64_t published = 2 * index + 2;
+    if (slot.sequence.load(std::memory_order_acquire) != published) {
+        return false;
+    }
+
+    std::uint64_t words[4];
+    for (int i = 0; i < 4; i++) {
+        words[i] = slot.words[i].load(std::memory_order_relaxed);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (slot.sequence.load(std::memory_order_relaxed) != published) {
+        return false;                                      // Overwritten while we read it
+    }
+
+    record.scheduled_ms = static_cast<std::int64_t>(words[0]);
+    record.actual_ms = static_cast<std::int64_t>(words[1]);
+    record.latency_us = static_cast<std::uint32_t>(words[2]);
+    record.bars_fetched = static_cast<std::int32_t>(static_cast<std::uint32_t>(words[2] >> 32));
+    record.symbol_id = static_cast<std::uint16_t>(words[3]);
+    record.timeframe_id = static_cast<std::uint16_t>(words[3] >> 16);
+    record.error_id = static_cast<std::uint16_t>(words[3] >> 32);
+    record.successful = ((words[3] >> 48) & 1) != 0;
+    return true;
+}
+
+std::uint64_t FetchHistoryRing::first_index() const {
+    std::uint64_t head = head_.load(std::memory_order_acquire);
+    return head > capacity_ ? head - capacity_ : 0;
+}
+
+std::uint64_t FetchHistoryRing::overwritten() const {
+    return first_index();
+}
+
+std::uint64_t FetchHistoryRing::unnamed() const {
+    return symbols_.overflows() + timeframes_.overflows() + errors_.overflows();
+}
+
+FetchRecord FetchHistoryRing::decode(const Packed& record) const {
+    FetchRecord decoded;
+    decoded.symbol = symbols_.lookup(record.symbol_id);
+    decoded.timeframe = timeframes_.lookup(record.timeframe_id);
+    decoded.error_message = errors_.lookup(record.error_id);
+    decoded.scheduled_time = from_epoch_ms(record.scheduled_ms);
+    decoded.actual_time = from_epoch_ms(record.actual_ms);
+    decoded.latency = std::chrono::microseconds(record.latency_us);
+    decoded.successful = record.successful;
+    decoded.bars_fetched = record.bars_fetched;
+    return decoded;
+}
+
+// ==============================================
+// QUERIES
+// ==============================================
+
+std::vector<FetchRecord> FetchHistoryRing::recent(std::chrono::system_clock::duration window) const {
+    std::int64_t cutoff = to_epoch_ms(std::chrono::system_clock::now() - window);
+    std::uint64_t head = head_.load(std::memory_order_acquire);
+
+    std::vector<FetchRecord> records;
+    Packed record;
+    for (std::uint64_t index = first_index(); index < head; index++) {
+        if (read(index, record) && record.actual_ms >= cutoff) {
+            records.push_back(decode(record));
+        }
+    }
+    return records;
+}
+
+std::vector<FetchWindowStats> FetchHistoryRing::stats(std::chrono::system_clock::duration window) const {
+    std::int64_t cutoff = to_epoch_ms(std::chrono::system_clock::now() - window);
+    std::uint64_t head = head_.load(std::memory_order_acquire);
+
+    std::size_t timeframe_count = timeframes_.size();
+    std::vector<FetchWindowStats> stats(timeframe_count);
+    std::vector<std::vector<std::uint32_t>> latencies(timeframe_count);
+
+    Packed record;
+    for (std::uint64_t index = first_index(); index < head; index++) {
+        if (!read(index, record) || record.actual_ms < cutoff || record.timeframe_id >= timeframe_count) {
+            continue;
+        }
+
+        FetchWindowStats& entry = stats[record.timeframe_id];
+        entry.total++;
+        if (record.successful) {
+            entry.successful++;
+            entry.bars += record.bars_fetched;
+        } else {
+            entry.failed++;
+        }
+        latencies[record.timeframe_id].push_back(record.latency_us);
+    }
+
+    std::vector<FetchWindowStats> result;
+    for (std::size_t id = 0; id < timeframe_count; id++) {
+        FetchWindowStats& entry = stats[id];
+        if (entry.total == 0) continue;
+
+        auto& samples = latencies[id];
+        entry.timeframe = timeframes_.lookup(static_cast<std::uint16_t>(id));
+        entry.success_ratio = static_cast<double>(entry.successful) / entry.total;
+        entry.p50_ms = percentile_ms(samples, 50);
+        entry.p95_ms = percentile_ms(samples, 95);
+        entry.p99_ms = percentile_ms(samples, 99);
+        entry.max_ms = *std::max_element(samples.begin(), samples.end()) / 1000.0;
+        result.push_back(entry);
+    }
+    return result;
+}
@@ -0,0 +1,133 @@
+#ifndef FETCH_HISTORY_RING_H
+#define FETCH_HISTORY_RING_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+// ==============================================
+// FETCH HISTORY RING - LOCK-FREE STATUS RECORDS
+// ==============================================
+
+// Append-only string table with small integer ids. Looking up an id, or
+// interning a string that is already present, never locks; only adding a
+// new string takes the mutex. Ids are stable for the table's lifetime.
+// Known strings are found through a copy-on-write hash index, so a hit costs
+// one hash however full the table is; each insert republishes the index.
+class StringInterner {
+public:
+    static constexpr std::uint16_t FULL = 0xFFFF;    // Returned once capacity is reached
+
+    explicit StringInterner(std::size_t capacity);
+
+    std::uint16_t intern(const std::string& text);
+    const std::string& lookup(std::uint16_t id) const;   // "" for FULL or unknown ids
+    std::size_t size() const { return count_.load(std::memory_order_acquire); }
+    std::uint64_t overflows() const { return overflows_.load(std::memory_order_relaxed); }  // interns that got FULL
+
+private:
+    using Index = std::unordered_map<std::string, std::uint16_t>;
+
+    std::unique_ptr<std::string[]> strings_;
+    std::size_t capacity_;
+    std::atomic<std::size_t> count_{0};     // Entries below count_ are immutable
+    std::shared_ptr<const Index> index_;    // Only through std::atomic_load/atomic_store
+    std::mutex insert_mutex_;
+    std::atomic<std::uint64_t> overflows_{0};
+};
+
+// One fetch, decoded from the ring
+struct FetchRecord {
+    std::string symbol;
+    std::string timeframe;
+    std::string error_message;
+    std::chrono::system_clock::time_point scheduled_time;
+    std::chrono::system_clock::time_point actual_time;      // When the fetch started
+    std::chrono::microseconds latency{0};                   // Start to finish
+    bool successful = false;
+    int bars_fetched = 0;
+};
+
+// Per-timeframe summary over a window
+struct FetchWindowStats {
+    std::string timeframe;
+    long long total = 0;
+    long long successful = 0;
+    long long failed = 0;
+    double success_ratio = 0.0;
+    double p50_ms = 0.0;
+    double p95_ms = 0.0;
+    double p99_ms = 0.0;
+    double max_ms = 0.0;
+    long long bars = 0;
+};
+
+// Fixed-capacity ring of fetch records, newest overwriting oldest. Writers
+// claim a slot with one fetch_add and publish it through the slot's
+// sequence number (a per-slot seqlock), so any number of fetch workers
+// record without a lock and readers never block them. A reader skips slots
+// that are mid-write or have been overwritten since it started.
+class FetchHistoryRing {
+public:
+    explicit FetchHistoryRing(std::size_t capacity = 16384);   // Rounded up to a power of two
+
+    FetchHistoryRing(const FetchHistoryRing&) = delete;
+    FetchHistoryRing& operator=(const FetchHistoryRing&) = delete;
+
+    void record(const std::string& symbol, const std::string& timeframe,
+                std::chrono::system_clock::time_point scheduled_time,
+                std::chrono::system_clock::time_point actual_time,
+                std::chrono::system_clock::duration latency,
+                bool successful, int bars_fetched, const std::string& error_message = "");
+
+    // Records that started within the window, oldest first
+    std::vector<FetchRecord> recent(std::chrono::system_clock::duration window) const;
+
+    // Counts, success ratio and exact latency percentiles per timeframe, in
+    // the order timeframes were first recorded. Touches no strings per record.
+    std::vector<FetchWindowStats> stats(std::chrono::system_clock::duration window) const;
+
+    std::size_t capacity() const { return capacity_; }
+    std::uint64_t recorded() const { return head_.load(std::memory_order_acquire); }
+    std::uint64_t overwritten() const;
+    std::uint64_t unnamed() const;      // Strings recorded as "" because an interner was full
+
+private:
+    // 32 bytes of payload; packed into words so concurrent reads are race-free
+    struct Packed {
+        std::int64_t scheduled_ms = 0;
+        std::int64_t actual_ms = 0;
+        std::uint32_t latency_us = 0;
+        std::int32_t bars_fetched = 0;
+        std::uint16_t symbol_id = 0;
+        std::uint16_t timeframe_id = 0;
+        std::uint16_t error_id = 0;
+        bool successful = false;
+    };
+
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};     // 2*index+1 while writing, 2*index+2 once published
+        std::atomic<std::uint64_t> words[4];
+    };
+
+    void publish(const Packed& record);
+    bool read(std::uint64_t index, Packed& record) const;
+    FetchRecord decode(const Packed& record) const;
+    std::uint64_t first_index() const;
+
+    std::unique_ptr<Slot[]> slots_;
+    std::size_t capacity_;
+    std::uint64_t mask_;
+    std::atomic<std::uint64_t> head_{0};
+
+    StringInterner symbols_;
+    StringInterner timeframes_;
+    StringInterner errors_;
+};
+
+#endif // FETCH_HISTORY_RING_H
@@ -7,6 +7,9 @@
 #include "OneHourDataFetcher.h"
 #include "TwoHourDataFetcher.h"
 #include "HistoricalDataFetcher.h"
+#include "TradingCalendar.h"
+#include "MetricsRegistry.h"
+#include "Tracer.h"
 
 #include <iostream>
 #include <iomanip>
@@ -15,6 +18,31 @@
 #include <ctime>
 #include <mutex>        // Add this include
 
+namespace {
+    // is_complete_bar() accepts a bar one full minute after its end; the
+    // extra second keeps a fetch at the deadline on the right side of that
+    const std::chrono::seconds BAR_COMPLETION_GRACE(61);
+    
+    int timeframe_minutes(const std::string& timeframe) {
+        if (timeframe == "15min") return 15;
+        if (timeframe == "30min") return 30;
+        if (timeframe == "1hour") return 60;
+        if (timeframe == "2hours") return 120;
+        return 0;
+    }
+    
+    // Fetch jobs run on executor workers; std::localtime's shared buffer is not safe there
+    std::tm local_time(std::time_t time) {
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        return tm;
+    }
+}
+
 FetchScheduler::FetchScheduler(std::shared_ptr<SimpleDatabaseManager> db_manager,
                               std::shared_ptr<IQFeedConnectionManager> iqfeed_manager)
     : db_manager_(db_manager), iqfeed_manager_(iqfeed_manager), running_(false), shutdown_requested_(false) {
@@ -28,6 +56,13 @@ FetchScheduler::FetchScheduler(std::shared_ptr<SimpleDatabaseManager> db_manager
     one_hour_fetcher_ = std::make_unique<OneHourDataFetcher>(iqfeed_manager_);
     two_hour_fetcher_ = std::make_unique<TwoHourDataFetcher>(iqfeed_manager_);
     
+    for (const std::string timeframe : {"daily", "15min", "30min", "1hour", "2hours"}) {
+        timeframe_metrics_[timeframe] = lookup_timeframe_metrics(timeframe);
+    }
+    
+    apply_request_limits(*config_.snapshot());
+    open_journal();
+    
     logger_->info("FetchScheduler initialized");
 }
 
@@ -40,29 +75,156 @@ FetchScheduler::~FetchScheduler() {
 // ==============================================
 
 void FetchScheduler::set_config(const ScheduleConfig& config) {
-    config_ = config;
-    logger_->info("Configuration updated. Symbols: " + std::to_string(config_.symbols.size()) + 
-                 ", Trading days: " + std::to_string(config_.trading_days.size()));
+    apply_config_change(config_.replace(config), "set_config");
 }
 
 ScheduleConfig FetchScheduler::get_config() const {
-    return config_;
+    return *config_.snapshot();
 }
 
 void FetchScheduler::add_symbol(const std::string& symbol) {
-    auto it = std::find(config_.symbols.begin(), config_.symbols.end(), symbol);
-    if (it == config_.symbols.end()) {
-        config_.symbols.push_back(symbol);
-        logger_->info("Added symbol: " + symbol);
-    }
+    apply_config_change(config_.update([&symbol](ScheduleConfig& config) {
+        if (std::find(config.symbols.begin(), config.symbols.end(), symbol) != config.symbols.end()) {
+            return false;
+        }
+        config.symbols.push_back(symbol);
+        return true;
+    }), "add_symbol");
 }
 
 void FetchScheduler::remove_symbol(const std::string& symbol) {
-    auto it = std::find(config_.symbols.begin(), config_.symbols.end(), symbol);
-    if (it != config_.symbols.end()) {
-        config_.symbols.erase(it);
+    apply_config_change(config_.update([&symbol](ScheduleConfig& config) {
+        auto it = std::find(config.symbols.begin(), config.symbols.end(), symbol);
+        if (it == config.symbols.end()) {
+            return false;
+        }
+        config.symbols.erase(it);
+        return true;
+    }), "remove_symbol");
+}
+
+// Sources are read before the store's write lock is taken, so a slow
+// database or file never holds up another writer, and readers never wait
+bool FetchScheduler::reload_config() {
+    std::lock_guard<std::mutex> reload_lock(config_reload_mutex_);
+    auto current = config_.snapshot();
+    bool sources_ok = true;
+    std::string source;
+    
+    try {
+        // File first: it may itself switch symbols_from_db on or off
+        ScheduleConfig from_file = *current;
+        bool file_changed = false;
+        std::filesystem::file_time_type file_time{};
+        if (!current->config_file.empty()) {
+            std::error_code ec;
+            file_time = std::filesystem::last_write_time(current->config_file, ec);
+            if (ec) {
+                logger_->error("Config file " + current->config_file + " unreadable: " + ec.message());
+                sources_ok = false;
+            } else if (file_time != config_file_time_ || current->config_file != config_file_applied_) {
+                std::string error;
+                if (load_schedule_config_file(current->config_file, from_file, error)) {
+                    file_changed = true;
+                    source = current->config_file;
+                } else {
+                    // Keep running on the last good config; retried when the file changes again
+                    logger_->error("Config file " + current->config_file + " rejected, keeping current config: " +
+                                  error);
+                    config_file_applied_ = current->config_file;
+                    config_file_time_ = file_time;
+                    sources_ok = false;
+                }
+            }
+        }
+        
+        std::vector<std::string> active_symbols;
+        bool have_db_symbols = false;
+        if (from_file.symbols_from_db && db_manager_) {
+            std::lock_guard<std::mutex> db_lock(db_mutex_);
+            active_symbols = db_manager_->get_symbol_list(true);
+            // An empty result is as likely a failed query as an empty table; never drop every symbol on it
+            if (active_symbols.empty()) {
+                logger_->error("No active symbols in the symbols table; keeping the current symbol list");
+                sources_ok = false;
+            } else {
+                have_db_symbols = true;
+                source += std::string(source.empty() ? "" : " + ") + "symbols table";
+            }
+        }
+        
+        if (!file_changed && !have_db_symbols) {
+            return sources_ok;
+        }
+        
+        // Applied to the store's own copy so an add_symbol() since our snapshot is not lost
+        std::string error;
+        auto change = config_.update([&](ScheduleConfig& next) {
+            if (file_changed && !load_schedule_config_file(current->config_file, next, error)) {
+                return false;
+            }
+            if (have_db_symbols) {
+                next.symbols = active_symbols;
+            }
+            return true;
+        });
+        if (!error.empty()) {
+            logger_->error("Config file " + current->config_file + " changed while loading: " + error);
+            return false;
+        }
+        if (file_changed) {
+            config_file_applied_ = current->config_file;
+            config_file_time_ = file_time;
+        }
+        apply_config_change(change, source);
+    } catch (const std::exception& e) {
+        logger_->error("Exception in config reload: " + std::string(e.what()));
+        return false;
+    }
+    
+    return sources_ok;
+}
+
+// Runs after a new snapshot is published. Jobs already queued or running
+// keep the snapshot they took; everything below only affects what comes next.
+void FetchScheduler::apply_config_change(const ScheduleConfigChange& change, const std::string& source) {
+    if (!change.changed()) {
+        return;
+    }
+    
+    // A later writer may have published again; apply the newest, not ours
+    auto config = config_.snapshot();
+    apply_request_limits(*config);
+    if (fetch_executor_ && running_) {
+        fetch_executor_->set_max_in_flight(static_cast<std::size_t>(std::max(1, config->max_in_flight_fetches)));
+    }
+    
+    auto added = change.added_symbols();
+    auto removed = change.removed_symbols();
+    logger_->info("Configuration updated (" + source + "). Symbols: " + std::to_string(config->symbols.size()) +
+                 " (+" + std::to_string(added.size()) + "/-" + std::to_string(removed.size()) + ")" +
+                 ", Trading days: " + std::to_string(config->trading_days.size()));
+    for (const auto& symbol : added) {
+        logger_->info("Added symbol: " + symbol);
+    }
+    for (const auto& symbol : removed) {
         logger_->info("Removed symbol: " + symbol);
     }
+    
+    if (!config->trace_file.empty()) {
+        Tracer::set_enabled(true);
+    }
+    
+    // Daily hour, trading days and the reload period feed the deadlines
+    if (timer_queue_) {
+        timer_queue_->reschedule();
+    }
+    
+    // New symbols catch up like a restart would: journal position or lookback
+    added = owned_symbols(added);
+    if (!added.empty() && fetch_executor_ && running_) {
+        queue_resume(added);
+    }
 }
 
 // ==============================================
@@ -85,15 +247,46 @@ bool FetchScheduler::start_scheduler() {
         return false;
     }
     
+    // Pick up the config file / symbols table before planning anything
+    auto current = config_.snapshot();
+    if (!current->config_file.empty() || current->symbols_from_db) {
+        reload_config();
+    }
+    auto config = config_.snapshot();
+    
+    // state_directory may have changed since construction
+    if (!journal_ || journal_->directory() != config->state_directory) {
+        open_journal();
+    }
+    
+    // Take our shards before planning: startup recovery covers only those
+    if (config->sharded && !join_shards(*config)) {
+        return false;
+    }
+    
+    if (!config->trace_file.empty()) {
+        Tracer::set_enabled(true);
+    }
+    
     running_ = true;
     shutdown_requested_ = false;
     
+    FetchExecutorConfig executor_config;
+    executor_config.worker_count = static_cast<std::size_t>(std::max(1, config->fetch_workers));
+    executor_config.max_in_flight = static_cast<std::size_t>(std::max(1, config->max_in_flight_fetches));
+    executor_config.max_queue_depth = static_cast<std::size_t>(std::max(1, config->max_queued_fetches));
+    fetch_executor_ = std::make_unique<FetchExecutor>(executor_config);
+    
+    timer_queue_ = std::make_unique<TimerQueue>();
+    register_timer_jobs();
+    
     // Start scheduler thread
+    feeder_thread_ = std::thread(&FetchScheduler::feeder_loop, this);
     scheduler_thread_ = std::thread(&FetchScheduler::scheduler_main_loop, this);
     
     logger_->success("FetchScheduler started successfully");
     std::cout << "=== FETCH SCHEDULER STARTED ===" << std::endl;
-    std::cout << "Monitoring " << config_.symbols.size() << " symbols" << std::endl;
+    std::cout << "Monitoring " << config->symbols.size() << " symbols" << std::endl;
     std::cout << "Next daily schedule: " << format_time(get_next_daily_schedule()) << std::endl;
     
     return true;
@@ -108,10 +301,40 @@ void FetchScheduler::stop_scheduler() {
     shutdown_requested_ = true;
     running_ = false;
     
+    // Wakes the timer wait at once; an in-flight fetch still completes
+    if (timer_queue_) {
+        timer_queue_->stop();
+    }
+    
     if (scheduler_thread_.joinable()) {
         scheduler_thread_.join();
     }
     
+    {
+        std::lock_guard<std::mutex> lock(feeder_mutex_);
+    }
+    feeder_wake_.notify_all();
+    
+    // Drops queued fetches and waits for the ones already talking to IQFeed;
+    // also releases a feeder blocked in submit()
+    if (fetch_executor_) {
+        fetch_executor_->stop();
+    }
+    
+    if (feeder_thread_.joinable()) {
+        feeder_thread_.join();
+    }
+    
+    // Hand our shards over now rather than after the member timeout
+    if (shards_) {
+        shards_->leave();
+        shards_.reset();
+    }
+    
+    // Final counts for the last scrape
+    export_metrics();
+    export_trace();
+    
     logger_->success("FetchScheduler stopped");
     std::cout << "=== FETCH SCHEDULER STOPPED ===" << std::endl;
 }
@@ -127,7 +350,7 @@ bool FetchScheduler::is_running() const {
 bool FetchScheduler::fetch_all_data_now(const std::string& symbol) {
     std::vector<std::string> symbols_to_fetch;
     if (symbol.empty()) {
-        symbols_to_fetch = config_.symbols;
+        symbols_to_fetch = config_.snapshot()->symbols;
     } else {
         symbols_to_fetch = {symbol};
     }
@@ -157,7 +380,7 @@ bool FetchScheduler::fetch_all_data_now(const std::string& symbol) {
 bool FetchScheduler::fetch_daily_data_now(const std::string& symbol) {
     std::vector<std::string> symbols_to_fetch;
     if (symbol.empty()) {
-        symbols_to_fetch = config_.symbols;
+        symbols_to_fetch = config_.snapshot()->symbols;
     } else {
         symbols_to_fetch = {symbol};
     }
@@ -175,7 +398,7 @@ bool FetchScheduler::fetch_daily_data_now(const std::string& symbol) {
 bool FetchScheduler::fetch_intraday_data_now(const std::string& timeframe, const std::string& symbol) {
     std::vector<std::string> symbols_to_fetch;
     if (symbol.empty()) {
-        symbols_to_fetch = config_.symbols;
+        symbols_to_fetch = config_.snapshot()->symbols;
     } else {
         symbols_to_fetch = {symbol};
     }
@@ -196,106 +419,157 @@ bool FetchScheduler::fetch_intraday_data_now(const std::string& timeframe, const
 
 void FetchScheduler::scheduler_main_loop() {
     logger_->info("Scheduler main loop started");
+    if (Tracer::enabled()) {
+        Tracer::instance().set_thread_name("scheduler");
+    }
     
-    // Check for missing data on startup
-    check_and_recover_today();
+    // Queue what was missed while stopped as backfill; live bar closes overtake it.
+    // The feeder plans it, so the first deadline is not held up by gap detection.
+    logger_->info("Checking for missing data and initiating recovery...");
+    queue_resume(owned_symbols(config_.snapshot()->symbols));
     
-    auto last_daily_check = std::chrono::system_clock::now() - std::chrono::hours(25); // Force first check
-    auto last_15min_fetch = std::chrono::system_clock::now() - std::chrono::minutes(16);
-    auto last_30min_fetch = std::chrono::system_clock::now() - std::chrono::minutes(31);
-    auto last_1hour_fetch = std::chrono::system_clock::now() - std::chrono::hours(2);
-    auto last_2hour_fetch = std::chrono::system_clock::now() - std::chrono::hours(3);
+    // Sleeps until the next deadline; returns after stop_scheduler()
+    if (!shutdown_requested_) {
+        timer_queue_->run();
+    }
     
-    while (!shutdown_requested_) {
-        try {
-            auto now = std::chrono::system_clock::now();
-            
-            // Check if it's a trading day and time
-            if (is_trading_day(now)) {
-                auto current_time = std::chrono::system_clock::to_time_t(now);
-                auto tm_now = *std::localtime(&current_time);
-                
-                bool is_trading_hour = (tm_now.tm_hour == config_.daily_hour && 
-                                      tm_now.tm_min >= config_.daily_minute);
-                
-                if (is_trading_hour) {
-                    // Daily fetch check (runs once per day)
-                    if (now - last_daily_check >= std::chrono::hours(24)) {
-                        logger_->info("Executing scheduled daily fetch");
-                        
-                        for (const auto& symbol : config_.symbols) {
-                            // Check if symbol needs initialization
-                            bool needs_initial = !is_symbol_initialized_in_db(symbol, "daily");
-                            execute_daily_fetch(symbol);
-                        }
-                        last_daily_check = now;
-                    }
-                    
-                    // Intraday fetch checks (recurring - fetch only latest bar)
-                    if (now - last_15min_fetch >= std::chrono::minutes(15)) {
-                        for (const auto& symbol : config_.symbols) {
-                            bool needs_initial = !is_symbol_initialized_in_db(symbol, "15min");
-                            execute_intraday_fetch("15min", symbol);
-                        }
-                        last_15min_fetch = now;
-                    }
-                    
-                    if (now - last_30min_fetch >= std::chrono::minutes(30)) {
-                        for (const auto& symbol : config_.symbols) {
-                            bool needs_initial = !is_symbol_initialized_in_db(symbol, "30min");
-                            execute_intraday_fetch("30min", symbol);
-                        }
-                        last_30min_fetch = now;
-                    }
-                    
-                    if (now - last_1hour_fetch >= std::chrono::hours(1)) {
-                        for (const auto& symbol : config_.symbols) {
-                            bool needs_initial = !is_symbol_initialized_in_db(symbol, "1hour");
-                            execute_intraday_fetch("1hour", symbol);
-                        }
-                        last_1hour_fetch = now;
-                    }
-                    
-                    if (now - last_2hour_fetch >= std::chrono::hours(2)) {
-                        for (const auto& symbol : config_.symbols) {
-                            bool needs_initial = !is_symbol_initialized_in_db(symbol, "2hours");
-                            execute_intraday_fetch("2hours", symbol);
-                        }
-                        last_2hour_fetch = now;
-                    }
-                }
+    logger_->info("Scheduler main loop ended");
+}
+
+void FetchScheduler::register_timer_jobs() {
+    using time_point = std::chrono::system_clock::time_point;
+    
+    timer_queue_->set_drift_handler([this](const std::string& job, std::chrono::system_clock::duration drift) {
+        log_schedule_drift(job, drift);
+    });
+    
+    timer_queue_->add_job("daily",
+        [this](time_point after) { return get_next_daily_schedule(after); },
+        [this](time_point deadline) {
+            logger_->info("Executing scheduled daily fetch");
+            queue_fetches("daily", FetchPriority::LIVE, deadline);
+        });
+    
+    // Intraday jobs fetch the latest bar as soon as it has closed
+    for (const std::string timeframe : {"15min", "30min", "1hour", "2hours"}) {
+        timer_queue_->add_job(timeframe,
+            [this, timeframe](time_point after) { return get_next_bar_close(timeframe, after); },
+            [this, timeframe](time_point deadline) {
+                queue_fetches(timeframe, FetchPriority::LIVE, deadline);
+            });
+    }
+    
+    // Watches the config file and symbols table; the period is re-read from each new snapshot
+    timer_queue_->add_job("config_reload",
+        [this](time_point after) {
+            int seconds = config_.snapshot()->config_reload_seconds;
+            return after + std::chrono::seconds(seconds > 0 ? seconds : 3600);
+        },
+        [this](time_point) {
+            auto config = config_.snapshot();
+            if (config->config_reload_seconds > 0 && (!config->config_file.empty() || config->symbols_from_db)) {
+                reload_config();
             }
-            
-            // Cleanup old fetch history periodically
-            cleanup_old_fetch_history();
-            
-            // Sleep for 1 minute before next check
-            std::this_thread::sleep_for(std::chrono::minutes(1));
-            
-        } catch (const std::exception& e) {
-            logger_->error("Exception in scheduler loop: " + std::string(e.what()));
-            std::this_thread::sleep_for(std::chrono::minutes(1));
+        });
+    
+    // Gauges are sampled here rather than on every change
+    timer_queue_->add_job("metrics_export",
+        [this](time_point after) {
+            return after + std::chrono::seconds(std::max(1, config_.snapshot()->metrics_interval_seconds));
+        },
+        [this](time_point) { export_metrics(); });
+    
+    if (shards_) {
+        timer_queue_->add_job("shard_heartbeat",
+            [this](time_point after) {
+                return after + std::chrono::seconds(std::max(1, config_.snapshot()->shard_heartbeat_seconds));
+            },
+            [this](time_point) { shard_heartbeat(); });
+    }
+}
+
+// One job per symbol; never blocks. Jobs a full queue turns away go to the
+// feeder, which submits them once there is room.
+void FetchScheduler::queue_fetches(const std::string& timeframe, FetchPriority priority,
+                                   std::chrono::system_clock::time_point scheduled_time,
+                                   std::shared_ptr<FetchBatch> batch) {
+    // One snapshot per deadline: a reload mid-loop cannot split the batch across two symbol lists
+    auto config = config_.snapshot();
+    std::vector<FetchJob> overflow;
+    for (const auto& symbol : owned_symbols(config->symbols)) {
+        FetchJob job;
+        job.timeframe = timeframe;
+        job.symbol = symbol;
+        job.priority = priority;
+        job.batch = batch;
+        job.run = [this, timeframe, symbol, scheduled_time] {
+            return run_fetch(timeframe, symbol, scheduled_time);
+        };
+        
+        if (!overflow.empty() || !fetch_executor_->try_submit(job)) {
+            overflow.push_back(std::move(job));
         }
     }
     
-    logger_->info("Scheduler main loop ended");
+    if (!overflow.empty()) {
+        logger_->error(timeframe + " queue full; " + std::to_string(overflow.size()) +
+                       " fetches handed to the feeder");
+        auto jobs = std::make_shared<std::vector<FetchJob>>(std::move(overflow));
+        defer_fetches([jobs] { return std::move(*jobs); }, batch);
+    }
+}
+
+bool FetchScheduler::run_fetch(const std::string& timeframe, const std::string& symbol,
+                               std::chrono::system_clock::time_point scheduled_time) {
+    if (Tracer::enabled()) {
+        thread_local bool named = false;
+        if (!named) {
+            Tracer::instance().set_thread_name("fetch worker");
+            named = true;
+        }
+    }
+    NEXDAY_TRACE_SPAN("scheduler", "fetch", symbol, timeframe);
+    
+    try {
+        if (timeframe == "daily") {
+            return execute_daily_fetch(symbol, scheduled_time);
+        }
+        return execute_intraday_fetch(timeframe, symbol, scheduled_time);
+    } catch (const std::exception& e) {
+        handle_fetch_error(timeframe + " fetch for " + symbol, e.what());
+        return false;
+    }
+}
+
+void FetchScheduler::log_schedule_drift(const std::string& job, std::chrono::system_clock::duration drift) {
+    auto drift_ms = std::chrono::duration_cast<std::chrono::milliseconds>(drift).count();
+    std::string message = "Timer job " + job + " started " + std::to_string(drift_ms) + " ms after its deadline";
+    
+    if (drift > std::chrono::seconds(1)) {
+        logger_->error(message);
+    } else {
+        NEXDAY_LOG_DEBUG(logger_, message);
+    }
 }
 
 // ==============================================
 // FETCH EXECUTION
 // ==============================================
 
-bool FetchScheduler::execute_daily_fetch(const std::string& symbol) {
+bool FetchScheduler::execute_daily_fetch(const std::string& symbol,
+                                         std::chrono::system_clock::time_point scheduled_time) {
     FetchStatus status;
     status.timeframe = "daily";
     status.symbol = symbol;
-    status.scheduled_time = std::chrono::system_clock::now();
     status.actual_time = std::chrono::system_clock::now();
+    status.scheduled_time = scheduled_time == std::chrono::system_clock::time_point() ? status.actual_time : scheduled_time;
     
     try {
         std::vector<HistoricalBar> bars;
-        if (daily_fetcher_->fetch_historical_data(symbol, config_.bars_daily, bars)) {
+        if (daily_fetcher_->fetch_historical_data(symbol, config_.snapshot()->bars_daily, bars)) {
             if (save_historical_bars_to_db(symbol, "daily", bars)) {
+                publish_new_bar(symbol, "daily", bars);
+                journal_saved_bars(symbol, "daily", bars);
                 status.successful = true;
                 status.bars_fetched = bars.size();
                 
@@ -330,32 +604,34 @@ bool FetchScheduler::execute_daily_fetch(const std::string& symbol) {
     return status.successful;
 }
 
-bool FetchScheduler::execute_intraday_fetch(const std::string& timeframe, const std::string& symbol) {
+bool FetchScheduler::execute_intraday_fetch(const std::string& timeframe, const std::string& symbol,
+                                            std::chrono::system_clock::time_point scheduled_time) {
     std::cout << "DEBUG: Starting intraday fetch for " << symbol << " " << timeframe << std::endl;
     
     FetchStatus status;
     status.timeframe = timeframe;
     status.symbol = symbol;
-    status.scheduled_time = std::chrono::system_clock::now();
     status.actual_time = std::chrono::system_clock::now();
+    status.scheduled_time = scheduled_time == std::chrono::system_clock::time_point() ? status.actual_time : scheduled_time;
     
     try {
         std::vector<HistoricalBar> bars;  // Declare bars variable here
         int num_bars = 100; // default
         bool fetch_success = false;  // Add missing semicolon
+        auto config = config_.snapshot();
         
         // Use direct method calls on the specific fetcher objects to avoid casting issues
         if (timeframe == "15min") {
-            num_bars = config_.bars_15min;
+            num_bars = config->bars_15min;
             fetch_success = fifteen_min_fetcher_->fetch_historical_data(symbol, num_bars, bars);
         } else if (timeframe == "30min") {
-            num_bars = config_.bars_30min;
+            num_bars = config->bars_30min;
             fetch_success = thirty_min_fetcher_->fetch_historical_data(symbol, num_bars, bars);
         } else if (timeframe == "1hour") {
-            num_bars = config_.bars_1hour;
+            num_bars = config->bars_1hour;
             fetch_success = one_hour_fetcher_->fetch_historical_data(symbol, num_bars, bars);
         } else if (timeframe == "2hours") {
-            num_bars = config_.bars_2hours;
+            num_bars = config->bars_2hours;
             fetch_success = two_hour_fetcher_->fetch_historical_data(symbol, num_bars, bars);
         } else {
             status.successful = false;
@@ -372,6 +648,8 @@ bool FetchScheduler::execute_intraday_fetch(const std::string& timeframe, const
             
             if (save_historical_bars_to_db(symbol, timeframe, bars)) {
                 std::cout << "DEBUG: save_historical_bars_to_db returned TRUE" << std::endl;
+                publish_new_bar(symbol, timeframe, bars);
+                journal_saved_bars(symbol, timeframe, bars);
                 status.successful = true;
                 status.bars_fetched = bars.size();
                 
@@ -416,10 +694,15 @@ bool FetchScheduler::execute_intraday_fetch(const std::string& timeframe, const
 bool FetchScheduler::save_historical_bars_to_db(const std::string& symbol, const std::string& timeframe, 
                                                const std::vector<HistoricalBar>& bars) {
     if (bars.empty()) {
-        logger_->debug("No bars to save for " + symbol + " " + timeframe);
+        NEXDAY_LOG_DEBUG(logger_, "No bars to save for " + symbol + " " + timeframe);
         return true;
     }
     
+    // Opened before the lock, so time spent waiting on another worker's save shows
+    NEXDAY_TRACE_SPAN("db", "persist", symbol, timeframe);
+    std::lock_guard<std::mutex> db_lock(db_mutex_);
+    TimeframeMetrics metrics = timeframe_metrics(timeframe);
+    ScopedTimer save_timer(*metrics.save_seconds);
     int saved_count = 0;
     int failed_count = 0;
     
@@ -452,46 +735,251 @@ bool FetchScheduler::save_historical_bars_to_db(const std::string& symbol, const
             saved_count++;
         } else {
             failed_count++;
-            logger_->debug("Failed to save bar: " + bar.date + " " + bar.time);
+            NEXDAY_LOG_DEBUG(logger_, "Failed to save bar: " + bar.date + " " + bar.time);
         }
     }
     
+    save_timer.stop();
+    metrics.bars_saved->inc(static_cast<std::uint64_t>(saved_count));
+    metrics.bars_save_failed->inc(static_cast<std::uint64_t>(failed_count));
+    
     logger_->info("Database save for " + symbol + " " + timeframe + ": " + 
                  std::to_string(saved_count) + " saved, " + std::to_string(failed_count) + " failed");
     
     return failed_count == 0;
 }
 
+// ==============================================
+// NEW BAR EVENTS
+// ==============================================
+
+void FetchScheduler::set_event_bus(std::shared_ptr<BarEventBus> event_bus) {
+    event_bus_ = event_bus;
+    logger_->info(event_bus_ ? "New bar events enabled" : "New bar events disabled");
+}
+
+// Bars are labelled at interval start (LabelAtBeginning=1); daily bars close at end of day
+static std::chrono::system_clock::time_point get_bar_close_time(const std::string& timeframe,
+                                                                const std::string& date,
+                                                                const std::string& time) {
+    std::tm tm = {};
+    std::istringstream ss(date + " " + (time.empty() ? "00:00:00" : time));
+    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (ss.fail()) {
+        return std::chrono::system_clock::now();
+    }
+    tm.tm_isdst = -1;
+    auto bar_start = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+    
+    int interval_minutes = 24 * 60;
+    if (timeframe == "15min") interval_minutes = 15;
+    else if (timeframe == "30min") interval_minutes = 30;
+    else if (timeframe == "1hour") interval_minutes = 60;
+    else if (timeframe == "2hours") interval_minutes = 120;
+    
+    return bar_start + std::chrono::minutes(interval_minutes);
+}
+
+void FetchScheduler::publish_new_bar(const std::string& symbol, const std::string& timeframe,
+                                     const std::vector<HistoricalBar>& bars) {
+    if (!event_bus_ || bars.empty()) {
+        return;
+    }
+    NEXDAY_TRACE_SPAN("scheduler", "publish", symbol, timeframe);
+    
+    const auto& latest = bars[0]; // First bar is latest
+    std::string bar_key = latest.date + " " + latest.time;
+    
+    {
+        // Only announce bars we have not announced before
+        std::lock_guard<std::mutex> lock(last_published_mutex_);
+        std::string& last = last_published_bar_[symbol + "|" + timeframe];
+        if (last == bar_key) {
+            NEXDAY_LOG_DEBUG(logger_, "No new " + timeframe + " bar for " + symbol + " since " + bar_key);
+            return;
+        }
+        last = bar_key;
+    }
+    
+    NewBarEvent event;
+    event.symbol = symbol;
+    event.timeframe = timeframe;
+    event.bar_date = latest.date;
+    event.bar_time = latest.time;
+    event.bar_close_time = get_bar_close_time(timeframe, latest.date, latest.time);
+    event.persisted_time = std::chrono::system_clock::now();
+    
+    event_bus_->publish(event);
+    logger_->info("Published new " + timeframe + " bar for " + symbol + ": " + bar_key);
+}
+
+// ==============================================
+// SCHEDULER JOURNAL
+// ==============================================
+
+void FetchScheduler::open_journal() {
+    std::string directory = config_.snapshot()->state_directory;
+    journal_ = std::make_unique<SchedulerJournal>(directory);
+    if (!journal_->open()) {
+        logger_->error("Cannot open scheduler journal in " + directory +
+                      "; restarts will fall back to the recovery lookback");
+        return;
+    }
+    
+    logger_->info("Scheduler journal loaded: " + std::to_string(journal_->size()) + " series from " +
+                 directory);
+    if (journal_->discarded_records() > 0) {
+        logger_->error("Scheduler journal: discarded " + std::to_string(journal_->discarded_records()) +
+                      " torn or corrupt records");
+    }
+}
+
+// Called only after the bars are committed, so the journal never runs ahead of the database
+void FetchScheduler::journal_saved_bars(const std::string& symbol, const std::string& timeframe,
+                                        const std::vector<HistoricalBar>& bars) {
+    if (!journal_ || bars.empty()) {
+        return;
+    }
+    
+    std::string newest;
+    for (const auto& bar : bars) {
+        std::string key = timeframe == "daily" ? bar.date : bar.date + " " + bar.time;
+        newest = std::max(newest, key);
+    }
+    
+    if (!journal_->record(symbol, timeframe, newest)) {
+        logger_->error("Failed to journal " + timeframe + " bar " + newest + " for " + symbol);
+    }
+}
+
+// ==============================================
+// SHARDING
+// ==============================================
+
+// The coordinator gets its own connection: advisory locks live and die
+// with the session, so it must not be the one fetches reconnect or share
+bool FetchScheduler::join_shards(const ScheduleConfig& config) {
+    ShardConfig shard_config;
+    shard_config.cluster = config.shard_cluster;
+    shard_config.member_id = config.shard_member_id;
+    shard_config.shard_count = config.shard_count;
+    shard_config.member_timeout_seconds = config.shard_member_timeout_seconds;
+    
+    auto connection = std::make_shared<SimpleDatabaseManager>(db_manager_->config_);
+    shards_ = std::make_unique<ShardCoordinator>(connection, shard_config);
+    
+    ShardAssignment assignment;
+    if (!shards_->heartbeat(&assignment)) {
+        logger_->error("Cannot join shard cluster " + config.shard_cluster + ": " + shards_->last_error());
+        shards_.reset();
+        return false;
+    }
+    
+    logger_->info("Joined shard cluster " + config.shard_cluster + " as " + shards_->member_id() + ": " +
+                 std::to_string(shards_->members().size()) + " members, own " +
+                 std::to_string(assignment.gained.size()) + " of " + std::to_string(shards_->shard_count()) +
+                 " shards (" + std::to_string(assignment.pending.size()) + " still held by their previous owner)");
+    return true;
+}
+
+// Runs on the timer thread. Shards we just locked may have missed bar
+// closes while they moved, so their symbols catch up as backfill.
+void FetchScheduler::shard_heartbeat() {
+    if (!shards_) {
+        return;
+    }
+    
+    ShardAssignment assignment;
+    if (!shards_->heartbeat(&assignment)) {
+        logger_->error("Shard heartbeat failed, fetching nothing until it recovers: " + shards_->last_error());
+        return;
+    }
+    if (assignment.membership_changed || !assignment.gained.empty() || !assignment.released.empty()) {
+        logger_->info("Shard rebalance: " + std::to_string(shards_->members().size()) + " members, +" +
+                     std::to_string(assignment.gained.size()) + "/-" + std::to_string(assignment.released.size()) +
+                     " shards, " + std::to_string(assignment.pending.size()) + " pending, own " +
+                     std::to_string(shards_->owned_shards().size()) + (shards_->is_leader() ? " (leader)" : ""));
+    }
+    if (assignment.gained.empty()) {
+        return;
+    }
+    
+    std::vector<std::string> gained_symbols;
+    for (const auto& symbol : config_.snapshot()->symbols) {
+        int shard = shards_->shard_of(symbol);
+        if (std::find(assignment.gained.begin(), assignment.gained.end(), shard) != assignment.gained.end()) {
+            gained_symbols.push_back(symbol);
+        }
+    }
+    if (!gained_symbols.empty() && fetch_executor_ && running_) {
+        queue_resume(gained_symbols);
+    }
+}
+
+std::vector<std::string> FetchScheduler::owned_symbols(const std::vector<std::string>& symbols) const {
+    return shards_ ? shards_->owned(symbols) : symbols;
+}
+
 // ==============================================
 // TIME UTILITIES
 // ==============================================
 
-bool FetchScheduler::is_trading_day(const std::chrono::system_clock::time_point& time) const {
-    int weekday = get_weekday(time);
-    return std::find(config_.trading_days.begin(), config_.trading_days.end(), weekday) != config_.trading_days.end();
+// The daily run follows the 17:00 close, so it fetches the session that
+// just closed: the latest one on or before its calendar day (the Thursday
+// before Good Friday, Friday's from a Sunday run). A configured weekday is
+// skipped when an earlier run since that session already fetched it.
+bool FetchScheduler::is_daily_fetch_day(const std::chrono::system_clock::time_point& time,
+                                        const ScheduleConfig& config) const {
+    std::tm tm = local_time(std::chrono::system_clock::to_time_t(time));
+    if (std::find(config.trading_days.begin(), config.trading_days.end(), tm.tm_wday) == config.trading_days.end()) {
+        return false;
+    }
+    
+    long long day = TradingCalendar::days_from_civil(tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1),
+                                                     static_cast<unsigned>(tm.tm_mday));
+    return TradingCalendar::instance().session_closed_by(day, config.trading_days) != -1;
+}
+
+// A bar belongs to the session its last second traded in: the bar closing at
+// the 18:00 open is the previous trade date's, and bars after it on the
+// evening before a holiday belong to the holiday and are skipped
+bool FetchScheduler::is_session_bar(const std::chrono::system_clock::time_point& bar_close,
+                                    const ScheduleConfig& config) const {
+    std::tm tm = local_time(std::chrono::system_clock::to_time_t(bar_close));
+    if (std::find(config.trading_days.begin(), config.trading_days.end(), tm.tm_wday) == config.trading_days.end()) {
+        return false;
+    }
+    
+    char wall_clock[32];
+    std::strftime(wall_clock, sizeof(wall_clock), "%Y-%m-%d %H:%M:%S", &tm);
+    const TradingCalendar& calendar = TradingCalendar::instance();
+    return calendar.is_trading_day(calendar.bar_trade_date_of(wall_clock));
 }
 
 int FetchScheduler::get_weekday(const std::chrono::system_clock::time_point& time) const {
     auto time_t = std::chrono::system_clock::to_time_t(time);
-    auto tm = *std::localtime(&time_t);
+    auto tm = local_time(time_t);
     return tm.tm_wday; // 0=Sunday, 1=Monday, etc.
 }
 
 std::chrono::system_clock::time_point FetchScheduler::get_next_daily_schedule() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t_now = std::chrono::system_clock::to_time_t(now);
-    auto tm_now = *std::localtime(&time_t_now);
-    
+    return get_next_daily_schedule(std::chrono::system_clock::now());
+}
+
+std::chrono::system_clock::time_point FetchScheduler::get_next_daily_schedule(
+    std::chrono::system_clock::time_point now) const {
     // Find next trading day at 7 PM ET
+    auto config = config_.snapshot();
     for (int days_ahead = 0; days_ahead <= 7; ++days_ahead) {
         auto candidate = now + std::chrono::hours(24 * days_ahead);
-        if (is_trading_day(candidate)) {
+        if (is_daily_fetch_day(candidate, *config)) {
             auto candidate_time_t = std::chrono::system_clock::to_time_t(candidate);
-            auto tm_candidate = *std::localtime(&candidate_time_t);
+            auto tm_candidate = local_time(candidate_time_t);
             
-            tm_candidate.tm_hour = config_.daily_hour;
-            tm_candidate.tm_min = config_.daily_minute;
+            tm_candidate.tm_hour = config->daily_hour;
+            tm_candidate.tm_min = config->daily_minute;
             tm_candidate.tm_sec = 0;
+            tm_candidate.tm_isdst = -1;
             
             auto scheduled = std::chrono::system_clock::from_time_t(std::mktime(&tm_candidate));
             
@@ -504,9 +992,37 @@ std::chrono::system_clock::time_point FetchScheduler::get_next_daily_schedule()
     return now + std::chrono::hours(24); // Fallback
 }
 
+std::chrono::system_clock::time_point FetchScheduler::get_next_bar_close(
+    const std::string& timeframe, std::chrono::system_clock::time_point after) const {
+    int interval = timeframe_minutes(timeframe);
+    if (interval == 0) {
+        return after + std::chrono::hours(24); // Unknown timeframe
+    }
+    
+    // Bars are aligned to local midnight; find the first close whose
+    // fetch time (close + grace) is later than 'after'
+    auto time_t_from = std::chrono::system_clock::to_time_t(after - BAR_COMPLETION_GRACE);
+    auto tm_close = local_time(time_t_from);
+    int minute_of_day = tm_close.tm_hour * 60 + tm_close.tm_min;
+    
+    tm_close.tm_hour = 0;
+    tm_close.tm_min = (minute_of_day / interval + 1) * interval;  // mktime normalizes past midnight
+    tm_close.tm_sec = 0;
+    tm_close.tm_isdst = -1;
+    auto bar_close = std::chrono::system_clock::from_time_t(std::mktime(&tm_close));
+    
+    // Skip closes on non-trading days (bounded to one week of bars)
+    auto config = config_.snapshot();
+    for (int i = 0; i < 7 * 24 * 60 / interval && !is_session_bar(bar_close, *config); i++) {
+        bar_close += std::chrono::minutes(interval);
+    }
+    
+    return bar_close + BAR_COMPLETION_GRACE;
+}
+
 std::string FetchScheduler::format_time(const std::chrono::system_clock::time_point& time) const {
     auto time_t = std::chrono::system_clock::to_time_t(time);
-    auto tm = *std::localtime(&time_t);
+    auto tm = local_time(time_t);
     
     std::ostringstream oss;
     oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
@@ -530,96 +1046,472 @@ bool FetchScheduler::recover_missing_data(const std::chrono::system_clock::time_
                                         const std::chrono::system_clock::time_point& to_date) {
     logger_->info("Recovery operation initiated from " + format_time(from_date) + " to " + format_time(to_date));
     
+    std::vector<BackfillRange> plan = plan_backfill(from_date, to_date);
+    
+    // Scheduler running: backfill on the executor, behind live fetches
+    if (fetch_executor_ && running_) {
+        return queue_backfill(plan)->wait();
+    }
+    
     bool recovery_success = true;
+    for (const auto& range : plan) {
+        if (!run_backfill(range)) {
+            recovery_success = false;
+        }
+    }
     
-    for (const auto& symbol : config_.symbols) {
-        // Check each timeframe for missing data
-        std::vector<std::string> timeframes = {"daily", "15min", "30min", "1hour", "2hours"};
+    return recovery_success;
+}
+
+std::vector<BackfillRange> FetchScheduler::plan_backfill(const std::chrono::system_clock::time_point& from_date,
+                                                         const std::chrono::system_clock::time_point& to_date) {
+    std::vector<BackfillRange> plan;
+    auto symbols = owned_symbols(config_.snapshot()->symbols);
+    std::string from = GapDetector::local_wall_clock(from_date);
+    
+    for (const std::string timeframe : {"daily", "15min", "30min", "1hour", "2hours"}) {
+        std::map<std::string, std::string> from_by_symbol;
+        for (const auto& symbol : symbols) {
+            from_by_symbol[symbol] = timeframe == "daily" ? from.substr(0, 10) : from;
+        }
         
-        for (const auto& timeframe : timeframes) {
-            if (is_data_missing_for_timeframe(symbol, timeframe, from_date)) {
-                logger_->info("Missing data detected for " + symbol + " " + timeframe + " - recovering");
-                
-                if (timeframe == "daily") {
-                    if (!execute_daily_fetch(symbol)) {
-                        recovery_success = false;
-                    }
-                } else {
-                    if (!execute_intraday_fetch(timeframe, symbol)) {
-                        recovery_success = false;
-                    }
+        auto ranges = plan_backfill(timeframe, from_by_symbol, last_closed_slot(timeframe, to_date));
+        plan.insert(plan.end(), ranges.begin(), ranges.end());
+    }
+    
+    return plan;
+}
+
+// Each journaled series is checked from the slot after its newest saved
+// bar, so a restart only asks for what closed while the scheduler was down.
+// Series the journal has never seen get the recovery lookback (this is
+// also how a symbol added by a config reload catches up).
+std::vector<BackfillRange> FetchScheduler::plan_resume(const std::chrono::system_clock::time_point& now,
+                                                       const std::vector<std::string>& symbols) {
+    std::vector<BackfillRange> plan;
+    std::string lookback = GapDetector::local_wall_clock(
+        now - std::chrono::hours(24 * std::max(1, config_.snapshot()->recovery_lookback_days)));
+    int resumed = 0;
+    int series = 0;
+    
+    for (const std::string timeframe : {"daily", "15min", "30min", "1hour", "2hours"}) {
+        bool daily = timeframe == "daily";
+        std::map<std::string, std::string> from_by_symbol;
+        
+        for (const auto& symbol : symbols) {
+            JournalEntry entry;
+            series++;
+            if (journal_ && journal_->lookup(symbol, timeframe, entry)) {
+                long long next = GapDetector::parse_wall_clock(entry.last_bar) + GapDetector::slot_seconds(timeframe);
+                from_by_symbol[symbol] = GapDetector::format_wall_clock(next, daily);
+                resumed++;
+            } else {
+                from_by_symbol[symbol] = daily ? lookback.substr(0, 10) : lookback;
+            }
+        }
+        
+        auto ranges = plan_backfill(timeframe, from_by_symbol, last_closed_slot(timeframe, now));
+        plan.insert(plan.end(), ranges.begin(), ranges.end());
+    }
+    
+    logger_->info("Resuming " + std::to_string(resumed) + " of " + std::to_string(series) +
+                 " series from the journal; " + std::to_string(plan.size()) + " range requests to catch up");
+    return plan;
+}
+
+std::vector<BackfillRange> FetchScheduler::plan_backfill(const std::string& timeframe,
+                                                         const std::map<std::string, std::string>& from_by_symbol,
+                                                         const std::string& to) {
+    // Exchange holidays have no bars to find, early closes none after the close
+    SessionGrid session;
+    if (!from_by_symbol.empty()) {
+        std::string earliest = from_by_symbol.begin()->second;
+        for (const auto& pair : from_by_symbol) {
+            earliest = std::min(earliest, pair.second);
+        }
+        session = GapDetector::session_grid(TradingCalendar::instance(), earliest.substr(0, 10), to.substr(0, 10));
+    }
+    
+    std::lock_guard<std::mutex> db_lock(db_mutex_);
+    GapDetector detector(*db_manager_, session);
+    
+    std::vector<BarGap> gaps;
+    if (!detector.find_gaps(timeframe, from_by_symbol, to, gaps)) {
+        logger_->error("Gap detection failed for " + timeframe + ": " + db_manager_->get_last_error());
+        return {};
+    }
+    
+    std::vector<BackfillRange> ranges = GapDetector::coalesce(gaps);
+    int missing = 0;
+    for (const auto& gap : gaps) {
+        missing += gap.missing_bars;
+    }
+    if (!gaps.empty()) {
+        logger_->info(timeframe + ": " + std::to_string(missing) + " missing bars in " +
+                     std::to_string(gaps.size()) + " gaps -> " + std::to_string(ranges.size()) + " range requests");
+    }
+    
+    return ranges;
+}
+
+// Newest slot whose bar has closed (today's daily bar is still open)
+std::string FetchScheduler::last_closed_slot(const std::string& timeframe,
+                                             std::chrono::system_clock::time_point now) const {
+    if (timeframe == "daily") {
+        return GapDetector::local_wall_clock(now - std::chrono::hours(24)).substr(0, 10);
+    }
+    auto last_open = now - std::chrono::seconds(GapDetector::slot_seconds(timeframe)) - BAR_COMPLETION_GRACE;
+    return GapDetector::local_wall_clock(last_open);
+}
+
+std::shared_ptr<FetchBatch> FetchScheduler::queue_backfill(const std::vector<BackfillRange>& plan) {
+    return defer_fetches([this, plan] { return backfill_jobs(plan); }, std::make_shared<FetchBatch>());
+}
+
+// Gap detection runs on the feeder too: it is a SQL pass per timeframe
+std::shared_ptr<FetchBatch> FetchScheduler::queue_resume(const std::vector<std::string>& symbols) {
+    return defer_fetches([this, symbols] {
+        return backfill_jobs(plan_resume(std::chrono::system_clock::now(), symbols));
+    }, std::make_shared<FetchBatch>());
+}
+
+std::vector<FetchJob> FetchScheduler::backfill_jobs(const std::vector<BackfillRange>& plan) {
+    std::vector<FetchJob> jobs;
+    jobs.reserve(plan.size());
+    
+    for (const auto& range : plan) {
+        FetchJob job;
+        job.timeframe = range.timeframe;
+        job.symbol = range.symbol;
+        job.priority = FetchPriority::BACKFILL;
+        job.run = [this, range] { return run_backfill(range); };
+        jobs.push_back(std::move(job));
+    }
+    
+    return jobs;
+}
+
+// The batch gets one extra pending job that the feeder completes after the
+// last submit, so wait() cannot return before the jobs exist
+std::shared_ptr<FetchBatch> FetchScheduler::defer_fetches(std::function<std::vector<FetchJob>()> jobs,
+                                                          std::shared_ptr<FetchBatch> batch) {
+    if (batch) {
+        batch->add();
+    }
+    {
+        std::lock_guard<std::mutex> lock(feeder_mutex_);
+        deferred_fetches_.push_back({ std::move(jobs), batch });
+    }
+    feeder_wake_.notify_one();
+    return batch;
+}
+
+void FetchScheduler::feeder_loop() {
+    if (Tracer::enabled()) {
+        Tracer::instance().set_thread_name("fetch feeder");
+    }
+    
+    while (true) {
+        DeferredFetches deferred;
+        {
+            std::unique_lock<std::mutex> lock(feeder_mutex_);
+            feeder_wake_.wait(lock, [this] { return shutdown_requested_ || !deferred_fetches_.empty(); });
+            if (shutdown_requested_) {
+                break;
+            }
+            deferred = std::move(deferred_fetches_.front());
+            deferred_fetches_.pop_front();
+        }
+        
+        bool queued = true;
+        try {
+            for (auto& job : deferred.jobs()) {
+                if (!job.batch) {
+                    job.batch = deferred.batch;
+                }
+                std::string what = job.timeframe + " fetch for " + job.symbol;
+                // Blocks while the queue is full: only this thread waits
+                if (!fetch_executor_->submit(std::move(job))) {
+                    logger_->error("Fetch executor stopped; " + what + " not queued");
+                    queued = false;
+                    break;
                 }
             }
+        } catch (const std::exception& e) {
+            logger_->error("Exception planning backfill: " + std::string(e.what()));
+            queued = false;
+        }
+        if (deferred.batch) {
+            deferred.batch->complete(queued);
         }
     }
     
-    return recovery_success;
+    // Whatever was never submitted counts as failed for anyone waiting on it
+    std::lock_guard<std::mutex> lock(feeder_mutex_);
+    for (auto& deferred : deferred_fetches_) {
+        if (deferred.batch) {
+            deferred.batch->complete(false);
+        }
+    }
+    deferred_fetches_.clear();
 }
 
-bool FetchScheduler::is_data_missing_for_timeframe(const std::string& symbol, const std::string& timeframe,
-                                                  const std::chrono::system_clock::time_point& expected_time) const {
-    // This is a simplified check - in a real implementation, you'd query the database
-    // to check if data exists for the expected time period
-    return true; // For now, always assume data might be missing
+bool FetchScheduler::run_backfill(const BackfillRange& range) {
+    FetchStatus status;
+    status.timeframe = range.timeframe;
+    status.symbol = range.symbol;
+    status.scheduled_time = std::chrono::system_clock::now();
+    
+    status.actual_time = std::chrono::system_clock::now();
+    
+    try {
+        HistoricalDataFetcher* fetcher = fetcher_for(range.timeframe);
+        std::vector<HistoricalBar> bars;
+        
+        if (!fetcher) {
+            status.error_message = "Unknown timeframe: " + range.timeframe;
+        } else if (!fetcher->fetch_historical_range(range.symbol, range.begin, range.end, bars)) {
+            // Also the case for closed-market days the grid still expects
+            status.error_message = "IQFeed range fetch failed";
+            logger_->error("Backfill of " + range.symbol + " " + range.timeframe + " " + range.begin + " to " +
+                          range.end + " returned no bars");
+        } else if (!save_historical_bars_to_db(range.symbol, range.timeframe, bars)) {
+            status.error_message = "Database save failed";
+            logger_->error("Failed to save " + range.timeframe + " backfill for " + range.symbol);
+        } else {
+            journal_saved_bars(range.symbol, range.timeframe, bars);
+            status.successful = true;
+            status.bars_fetched = bars.size();
+            logger_->success("Backfilled " + range.symbol + " " + range.timeframe + " " + range.begin + " to " +
+                            range.end + ": " + std::to_string(bars.size()) + " bars (" +
+                            std::to_string(range.missing_bars) + " missing)");
+        }
+    } catch (const std::exception& e) {
+        status.error_message = e.what();
+        handle_fetch_error("backfill for " + range.symbol + " " + range.timeframe, e.what());
+    }
+    
+    record_fetch_status(status);
+    return status.successful;
+}
+
+void FetchScheduler::apply_request_limits(const ScheduleConfig& config) {
+    if (!iqfeed_manager_) return;
+    
+    RateLimiterConfig limits;
+    limits.max_rate = config.iqfeed_requests_per_second;
+    limits.max_concurrency = config.iqfeed_max_concurrent_requests;
+    iqfeed_manager_->set_request_limits(limits);
+}
+
+HistoricalDataFetcher* FetchScheduler::fetcher_for(const std::string& timeframe) const {
+    if (timeframe == "daily") return daily_fetcher_.get();
+    if (timeframe == "15min") return fifteen_min_fetcher_.get();
+    if (timeframe == "30min") return thirty_min_fetcher_.get();
+    if (timeframe == "1hour") return one_hour_fetcher_.get();
+    if (timeframe == "2hours") return two_hour_fetcher_.get();
+    return nullptr;
 }
 
 // ==============================================
 // STATUS AND MONITORING
 // ==============================================
 
+// Called as each fetch finishes, so latency is start to finish
 void FetchScheduler::record_fetch_status(const FetchStatus& status) {
-    std::lock_guard<std::mutex> lock(fetch_history_mutex_);
-    fetch_history_.push_back(status);
+    auto latency = std::chrono::system_clock::now() - status.actual_time;
+    fetch_history_.record(status.symbol, status.timeframe, status.scheduled_time, status.actual_time,
+                          latency, status.successful, status.bars_fetched, status.error_message);
+    
+    TimeframeMetrics metrics = timeframe_metrics(status.timeframe);
+    (status.successful ? metrics.fetch_successes : metrics.fetch_failures)->inc();
+    metrics.fetch_seconds->observe(latency);
+    metrics.bars_fetched->inc(static_cast<std::uint64_t>(std::max(0, status.bars_fetched)));
 }
 
-void FetchScheduler::cleanup_old_fetch_history() {
-    std::lock_guard<std::mutex> lock(fetch_history_mutex_);
-    auto cutoff = std::chrono::system_clock::now() - std::chrono::hours(168); // Keep 1 week
+FetchScheduler::TimeframeMetrics FetchScheduler::lookup_timeframe_metrics(const std::string& timeframe) {
+    auto& registry = MetricsRegistry::instance();
+    MetricLabels labels = { { "timeframe", timeframe } };
     
-    fetch_history_.erase(
-        std::remove_if(fetch_history_.begin(), fetch_history_.end(),
-                      [cutoff](const FetchStatus& status) {
-                          return status.actual_time < cutoff;
-                      }),
-        fetch_history_.end());
+    TimeframeMetrics metrics;
+    metrics.fetch_successes = &registry.counter("nexday_fetches_total", "Scheduled and manual fetches by outcome",
+                                                { { "timeframe", timeframe }, { "result", "success" } });
+    metrics.fetch_failures = &registry.counter("nexday_fetches_total", "Scheduled and manual fetches by outcome",
+                                               { { "timeframe", timeframe }, { "result", "failure" } });
+    metrics.fetch_seconds = &registry.histogram("nexday_fetch_seconds", "Fetch start to finish, including the save",
+                                                labels);
+    metrics.bars_fetched = &registry.counter("nexday_bars_fetched_total",
+                                             "Bars returned by scheduled and manual fetches", labels);
+    metrics.save_seconds = &registry.histogram("nexday_db_save_seconds", "Saving one fetch's bars, row by row",
+                                               labels);
+    metrics.bars_saved = &registry.counter("nexday_db_bars_saved_total", "Bar upserts by outcome",
+                                           { { "timeframe", timeframe }, { "result", "saved" } });
+    metrics.bars_save_failed = &registry.counter("nexday_db_bars_saved_total", "Bar upserts by outcome",
+                                                 { { "timeframe", timeframe }, { "result", "failed" } });
+    return metrics;
 }
 
-std::vector<FetchStatus> FetchScheduler::get_recent_fetch_history(int hours) const {
-    std::lock_guard<std::mutex> lock(fetch_history_mutex_);
+// The five scheduler timeframes come from the map; anything else (a
+// malformed backfill range) pays the registry lookups
+FetchScheduler::TimeframeMetrics FetchScheduler::timeframe_metrics(const std::string& timeframe) const {
+    auto it = timeframe_metrics_.find(timeframe);
+    return it != timeframe_metrics_.end() ? it->second : lookup_timeframe_metrics(timeframe);
+}
+
+void FetchScheduler::export_metrics() {
+    auto& registry = MetricsRegistry::instance();
+    auto config = config_.snapshot();
     
-    auto cutoff = std::chrono::system_clock::now() - std::chrono::hours(hours);
-    std::vector<FetchStatus> recent;
+    if (fetch_executor_) {
+        registry.gauge("nexday_fetch_in_flight", "Fetches running on executor workers")
+            .set(static_cast<double>(fetch_executor_->in_flight()));
+        registry.gauge("nexday_fetch_queued", "Fetches waiting in the executor queues")
+            .set(static_cast<double>(fetch_executor_->queued()));
+    }
+    if (iqfeed_manager_) {
+        RateLimiterStats limits = iqfeed_manager_->get_request_limiter().stats();
+        registry.gauge("nexday_iqfeed_request_rate", "Current AIMD request rate limit per second")
+            .set(limits.current_rate);
+        registry.gauge("nexday_iqfeed_requests_in_flight", "Lookup requests holding a limiter permit")
+            .set(static_cast<double>(limits.in_flight));
+        
+        // The limiter keeps running totals; each counter advances by what is new since the last export
+        auto advance = [&registry](const std::string& name, const std::string& help, long long total,
+                                   long long& exported) {
+            if (total > exported) {
+                registry.counter(name, help).inc(static_cast<std::uint64_t>(total - exported));
+            }
+            exported = total;
+        };
+        advance("nexday_iqfeed_requests_rejected_total", "Lookup requests that got no limiter permit in time",
+                limits.rejected, exported_limits_.rejected);
+        advance("nexday_iqfeed_request_errors_total", "Lookup requests IQFeed answered with an error",
+                limits.errors, exported_limits_.errors);
+        advance("nexday_iqfeed_request_timeouts_total", "Lookup requests that timed out",
+                limits.timeouts, exported_limits_.timeouts);
+        advance("nexday_iqfeed_rate_backoffs_total", "AIMD rate decreases after errors or timeouts",
+                limits.decreases, exported_limits_.decreases);
+    }
+    registry.gauge("nexday_fetch_history_unnamed", "Fetch history strings dropped because an interner table was full")
+        .set(static_cast<double>(fetch_history_.unnamed()));
+    registry.gauge("nexday_scheduler_symbols", "Symbols this scheduler fetches (its shards' share when sharded)")
+        .set(static_cast<double>(owned_symbols(config->symbols).size()));
+    if (shards_) {
+        registry.gauge("nexday_shards_owned", "Shards whose advisory lock this process holds")
+            .set(static_cast<double>(shards_->owned_shards().size()));
+    }
     
-    for (const auto& status : fetch_history_) {
-        if (status.actual_time >= cutoff) {
-            recent.push_back(status);
+    if (!config->metrics_file.empty()) {
+        std::string error;
+        if (!registry.write_prometheus_file(config->metrics_file, error)) {
+            logger_->error("Metrics export failed: " + error);
         }
     }
+}
+
+void FetchScheduler::export_trace() {
+    auto config = config_.snapshot();
+    if (config->trace_file.empty()) {
+        return;
+    }
+    
+    std::string error;
+    TracerStats stats = Tracer::instance().stats();
+    if (Tracer::instance().write_chrome_trace(config->trace_file, error)) {
+        logger_->info("Wrote " + std::to_string(stats.events) + " trace spans to " + config->trace_file +
+                     (stats.overwritten ? " (" + std::to_string(stats.overwritten) + " older spans overwritten)" : ""));
+    } else {
+        logger_->error("Trace export failed: " + error);
+    }
+}
+
+std::vector<FetchStatus> FetchScheduler::get_recent_fetch_history(int hours) const {
+    std::vector<FetchStatus> recent;
+    
+    for (const auto& record : fetch_history_.recent(std::chrono::hours(hours))) {
+        FetchStatus status;
+        status.timeframe = record.timeframe;
+        status.symbol = record.symbol;
+        status.scheduled_time = record.scheduled_time;
+        status.actual_time = record.actual_time;
+        status.successful = record.successful;
+        status.bars_fetched = record.bars_fetched;
+        status.error_message = record.error_message;
+        recent.push_back(status);
+    }
     
     return recent;
 }
 
+// Cheap enough for a once-a-second monitoring loop: one pass over the ring
+std::vector<FetchWindowStats> FetchScheduler::get_fetch_stats(std::chrono::seconds window) const {
+    return fetch_history_.stats(window);
+}
+
 void FetchScheduler::print_status_summary() const {
-    auto recent = get_recent_fetch_history(24);
-    
-    std::cout << "\n=== FETCH SCHEDULER STATUS (Last 24 Hours) ===" << std::endl;
-    std::cout << "Total fetches: " << recent.size() << std::endl;
+    auto stats = get_fetch_stats(std::chrono::hours(24));
     
-    int successful = 0;
-    int failed = 0;
+    long long total = 0;
+    long long successful = 0;
+    long long failed = 0;
     
-    for (const auto& status : recent) {
-        if (status.successful) {
-            successful++;
-        } else {
-            failed++;
-        }
+    for (const auto& timeframe : stats) {
+        total += timeframe.total;
+        successful += timeframe.successful;
+        failed += timeframe.failed;
     }
     
+    std::cout << "\n=== FETCH SCHEDULER STATUS (Last 24 Hours) ===" << std::endl;
+    std::cout << "Total fetches: " << total << std::endl;
     std::cout << "Successful: " << successful << std::endl;
     std::cout << "Failed: " << failed << std::endl;
-    std::cout << "Success rate: " << (recent.empty() ? 0 : (successful * 100 / recent.size())) << "%" << std::endl;
+    std::cout << "Success rate: " << (total == 0 ? 0 : (successful * 100 / total)) << "%" << std::endl;
+    
+    for (const auto& timeframe : stats) {
+        std::cout << "  " << std::left << std::setw(8) << timeframe.timeframe << std::right << timeframe.total
+                  << " fetches, " << std::fixed << std::setprecision(1) << timeframe.success_ratio * 100.0
+                  << "% ok, latency p50 " << timeframe.p50_ms << " ms, p95 " << timeframe.p95_ms << " ms, p99 "
+                  << timeframe.p99_ms << " ms" << std::defaultfloat << std::endl;
+    }
     std::cout << "Next scheduled fetch: " << format_time(get_next_daily_schedule()) << std::endl;
+    if (journal_ && journal_->is_open()) {
+        std::cout << "Journal: " << journal_->size() << " series, " << journal_->journal_records()
+                  << " records since last snapshot (" << journal_->directory() << ")" << std::endl;
+    }
+    if (shards_) {
+        auto config = config_.snapshot();
+        std::cout << "Shards: member " << shards_->member_id() << (shards_->is_leader() ? " (leader)" : "") << ", "
+                  << shards_->members().size() << " members, own " << shards_->owned_shards().size() << " of "
+                  << shards_->shard_count() << " shards, " << owned_symbols(config->symbols).size() << " of "
+                  << config->symbols.size() << " symbols" << std::endl;
+    }
+    
+    if (timer_queue_ && running_) {
+        std::cout << std::endl;
+        fetch_executor_->print_stats(std::cout);
+        
+        RateLimiterStats limits = iqfeed_manager_->get_request_limiter().stats();
+        std::cout << "IQFeed requests: " << std::fixed << std::setprecision(2) << limits.current_rate << "/"
+                  << limits.max_rate << " per second, " << limits.in_flight << " in flight, " << limits.acquired
+                  << " sent, " << limits.rejected << " rejected, " << limits.errors << " errors, " << limits.timeouts
+                  << " timeouts, " << limits.decreases << " backoffs" << std::defaultfloat << std::endl;
+        std::cout << "\nTimer jobs (next deadline, start drift):" << std::endl;
+        auto names = timer_queue_->job_names();
+        for (std::size_t i = 0; i < names.size(); i++) {
+            int job_id = static_cast<int>(i);
+            const Histogram* drift = timer_queue_->drift(job_id);
+            HistogramSnapshot samples = drift ? drift->snapshot() : HistogramSnapshot();
+            std::cout << "  " << std::left << std::setw(12) << names[i] << std::right
+                      << format_time(timer_queue_->next_deadline(job_id));
+            if (samples.count > 0) {
+                std::cout << "  p50 " << samples.quantile(0.50) * 1000.0 << " ms, p99 "
+                          << samples.quantile(0.99) * 1000.0 << " ms, mean "
+                          << samples.sum / static_cast<double>(samples.count) * 1000.0 << " ms ("
+                          << samples.count << " runs)";
+            }
+            std::cout << std::endl;
+        }
+    }
     std::cout << "===============================================" << std::endl;
 }
 
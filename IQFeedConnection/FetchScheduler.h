@@ -8,8 +8,22 @@
 #include <thread>
 #include <atomic>
 #include <map>
+#include <deque>
+#include <functional>
+#include <condition_variable>
 #include <mutex>  // Add this include
+#include <filesystem>
 #include "Logger.h"
+#include "BarEventBus.h"
+#include "TimerQueue.h"
+#include "FetchExecutor.h"
+#include "GapDetector.h"
+#include "SchedulerJournal.h"
+#include "FetchHistoryRing.h"
+#include "ScheduleConfig.h"
+#include "ShardCoordinator.h"
+#include "RateLimiter.h"
+#include "MetricsRegistry.h"
 
 // Forward declarations
 class SimpleDatabaseManager;
@@ -22,29 +36,6 @@ class OneHourDataFetcher;
 class TwoHourDataFetcher;
 struct HistoricalBar;
 
-// Scheduling configuration
-struct ScheduleConfig {
-    std::vector<std::string> symbols = {"QGC#"}; // Default symbols to fetch
-    std::string timezone = "America/New_York";   // Eastern Time
-    int daily_hour = 19;                         // 7 PM ET
-    int daily_minute = 0;                        // 00 minutes
-    bool enabled = true;
-    
-    // Trading days (Sunday=0, Monday=1, ..., Thursday=4)
-    std::vector<int> trading_days = {0, 1, 2, 3, 4}; // Sun-Thu
-    
-    // Number of bars to fetch for each timeframe
-    int bars_15min = 100;
-    int bars_30min = 100;
-    int bars_1hour = 100;
-    int bars_2hours = 100;
-    int bars_daily = 100;
-    
-    // Add these missing members that main.cpp expects
-    int initial_bars_daily = 100;  // For initial data load
-    int recurring_bars = 1;        // For recurring fetches (latest bar only)
-};
-
 // Fetch status tracking
 struct FetchStatus {
     std::string timeframe;
@@ -71,14 +62,62 @@ private:
     std::unique_ptr<OneHourDataFetcher> one_hour_fetcher_;
     std::unique_ptr<TwoHourDataFetcher> two_hour_fetcher_;
     
-    ScheduleConfig config_;
+    // Copy-on-write: each operation reads one snapshot, reloads publish a new one
+    ScheduleConfigStore config_;
+    std::mutex config_reload_mutex_;
+    std::string config_file_applied_;                      // Path and version last applied
+    std::filesystem::file_time_type config_file_time_{};
     std::atomic<bool> running_;
     std::atomic<bool> shutdown_requested_;
     std::thread scheduler_thread_;
     
-    // Status tracking
-    std::vector<FetchStatus> fetch_history_;
-    mutable std::mutex fetch_history_mutex_;  // Now properly declared
+    // One recurring job per timeframe, due at each bar close (daily: daily_hour)
+    std::unique_ptr<TimerQueue> timer_queue_;
+    
+    // Timer jobs only queue fetches; the executor's workers run them
+    std::unique_ptr<FetchExecutor> fetch_executor_;
+    
+    // Work the timer thread must not wait on: backfill plans (planned here,
+    // off the timer thread) and live jobs a full queue turned away. The
+    // feeder thread submits them, blocking on executor backpressure itself.
+    struct DeferredFetches {
+        std::function<std::vector<FetchJob>()> jobs;
+        std::shared_ptr<FetchBatch> batch;  // Held open until the jobs are submitted
+    };
+    std::deque<DeferredFetches> deferred_fetches_;
+    std::mutex feeder_mutex_;
+    std::condition_variable feeder_wake_;
+    std::thread feeder_thread_;
+    std::mutex db_mutex_;  // db_manager_ holds a single libpq connection
+    
+    // Status tracking: lock-free ring, oldest records overwritten
+    FetchHistoryRing fetch_history_;
+    
+    // New bar notifications (optional)
+    std::shared_ptr<BarEventBus> event_bus_;
+    std::map<std::string, std::string> last_published_bar_;  // "symbol|timeframe" -> "date time"
+    std::mutex last_published_mutex_;
+    
+    // Survives restarts: newest bar saved per symbol/timeframe
+    std::unique_ptr<SchedulerJournal> journal_;
+    
+    // Sharded mode only: which of the symbols this process fetches
+    std::unique_ptr<ShardCoordinator> shards_;
+    
+    // Limiter totals already added to the registry counters (export_metrics)
+    RateLimiterStats exported_limits_;
+    
+    // Registry metrics labelled timeframe=..., looked up once in the constructor
+    struct TimeframeMetrics {
+        Counter* fetch_successes;
+        Counter* fetch_failures;
+        Histogram* fetch_seconds;
+        Counter* bars_fetched;
+        Histogram* save_seconds;
+        Counter* bars_saved;
+        Counter* bars_save_failed;
+    };
+    std::map<std::string, TimeframeMetrics> timeframe_metrics_;   // Never modified after construction
     
 public:
     FetchScheduler(std::shared_ptr<SimpleDatabaseManager> db_manager,
@@ -91,6 +130,14 @@ public:
     void add_symbol(const std::string& symbol);
     void remove_symbol(const std::string& symbol);
     
+    // Re-read config_file (if it changed) and the active symbols (if
+    // symbols_from_db), then publish the result; new symbols are backfilled.
+    // Runs on a timer every config_reload_seconds. False if a source failed.
+    bool reload_config();
+    
+    // Publish a NewBarEvent after every save that brings in a newer bar
+    void set_event_bus(std::shared_ptr<BarEventBus> event_bus);
+    
     // Main control methods
     bool start_scheduler();
     void stop_scheduler();
@@ -108,6 +155,7 @@ public:
     
     // Status and monitoring
     std::vector<FetchStatus> get_recent_fetch_history(int hours = 24) const;
+    std::vector<FetchWindowStats> get_fetch_stats(std::chrono::seconds window = std::chrono::hours(1)) const;
     void print_status_summary() const;
     void log_fetch_summary() const;
     
@@ -116,14 +164,27 @@ private:
     void scheduler_main_loop();
     
     // Time utilities
-    bool is_trading_day(const std::chrono::system_clock::time_point& time) const;
+    bool is_daily_fetch_day(const std::chrono::system_clock::time_point& time, const ScheduleConfig& config) const;
+    bool is_session_bar(const std::chrono::system_clock::time_point& bar_close, const ScheduleConfig& config) const;
     std::string format_time(const std::chrono::system_clock::time_point& time) const;
     int get_weekday(const std::chrono::system_clock::time_point& time) const;
     std::chrono::system_clock::time_point get_next_daily_schedule() const;
-    
-    // Fetch operations - Fixed signatures to match implementation
-    bool execute_daily_fetch(const std::string& symbol);
-    bool execute_intraday_fetch(const std::string& timeframe, const std::string& symbol);
+    std::chrono::system_clock::time_point get_next_daily_schedule(std::chrono::system_clock::time_point after) const;
+    std::chrono::system_clock::time_point get_next_bar_close(const std::string& timeframe,
+                                                             std::chrono::system_clock::time_point after) const;
+    void register_timer_jobs();
+    void log_schedule_drift(const std::string& job, std::chrono::system_clock::duration drift);
+    void queue_fetches(const std::string& timeframe, FetchPriority priority,
+                       std::chrono::system_clock::time_point scheduled_time,
+                       std::shared_ptr<FetchBatch> batch = nullptr);
+    bool run_fetch(const std::string& timeframe, const std::string& symbol,
+                   std::chrono::system_clock::time_point scheduled_time = {});
+    
+    // Fetch operations - scheduled_time is the deadline the fetch ran for (default: now)
+    bool execute_daily_fetch(const std::string& symbol,
+                             std::chrono::system_clock::time_point scheduled_time = {});
+    bool execute_intraday_fetch(const std::string& timeframe, const std::string& symbol,
+                                std::chrono::system_clock::time_point scheduled_time = {});
     
     // Data state checking
     bool is_symbol_initialized_in_db(const std::string& symbol, const std::string& timeframe) const;
@@ -131,14 +192,46 @@ private:
     // Data persistence
     bool save_historical_bars_to_db(const std::string& symbol, const std::string& timeframe, 
                                    const std::vector<HistoricalBar>& bars);
-    
-    // Recovery logic
-    bool is_data_missing_for_timeframe(const std::string& symbol, const std::string& timeframe,
-                                      const std::chrono::system_clock::time_point& expected_time) const;
+    void publish_new_bar(const std::string& symbol, const std::string& timeframe,
+                        const std::vector<HistoricalBar>& bars);
+    void journal_saved_bars(const std::string& symbol, const std::string& timeframe,
+                            const std::vector<HistoricalBar>& bars);
+    void open_journal();
+    
+    // Sharding: everything is owned unless sharded mode is on
+    bool join_shards(const ScheduleConfig& config);
+    void shard_heartbeat();
+    std::vector<std::string> owned_symbols(const std::vector<std::string>& symbols) const;
+    
+    // Recovery logic: gaps found in one SQL pass per timeframe, coalesced into range requests
+    std::vector<BackfillRange> plan_backfill(const std::chrono::system_clock::time_point& from_date,
+                                             const std::chrono::system_clock::time_point& to_date);
+    std::vector<BackfillRange> plan_resume(const std::chrono::system_clock::time_point& now,
+                                           const std::vector<std::string>& symbols);
+    std::vector<BackfillRange> plan_backfill(const std::string& timeframe,
+                                             const std::map<std::string, std::string>& from_by_symbol,
+                                             const std::string& to);
+    std::string last_closed_slot(const std::string& timeframe, std::chrono::system_clock::time_point now) const;
+    // Never block: both hand their jobs to the feeder thread
+    std::shared_ptr<FetchBatch> queue_backfill(const std::vector<BackfillRange>& plan);
+    std::shared_ptr<FetchBatch> queue_resume(const std::vector<std::string>& symbols);
+    std::shared_ptr<FetchBatch> defer_fetches(std::function<std::vector<FetchJob>()> jobs,
+                                              std::shared_ptr<FetchBatch> batch = nullptr);
+    std::vector<FetchJob> backfill_jobs(const std::vector<BackfillRange>& plan);
+    void feeder_loop();
+    bool run_backfill(const BackfillRange& range);
+    HistoricalDataFetcher* fetcher_for(const std::string& timeframe) const;
+    void apply_request_limits(const ScheduleConfig& config);
+    void apply_config_change(const ScheduleConfigChange& change, const std::string& source);
     
     // Status tracking
+    static TimeframeMetrics lookup_timeframe_metrics(const std::string& timeframe);
+    TimeframeMetrics timeframe_metrics(const std::string& timeframe) const;
     void record_fetch_status(const FetchStatus& status);
-    void cleanup_old_fetch_history();
+    // Refresh the queue/limiter gauges and rewrite metrics_file if set
+    void export_metrics();
+    // Write the buffered spans to trace_file if set (at stop)
+    void export_trace();
     
     // Error handling
     void handle_fetch_error(const std::string& operation, const std::string& error);
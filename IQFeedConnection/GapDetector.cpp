@@ -0,0 +1,319 @@
+#include "GapDetector.h"
+#include "database_simple.h"
+#include "TradingCalendar.h"
+#include <sstream>
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <cstdio>
+#include <ctime>
+
+GapDetector::GapDetector(SimpleDatabaseManager& db, const SessionGrid& session)
+    : db_(db), session_(session) {
+}
+
+// ==============================================
+// GAP QUERY
+// ==============================================
+
+// Slots inside the weekly session, outside the daily break
+std::string GapDetector::session_filter(const std::string& slot) const {
+    std::string open = "'" + db_.escape_string(session_.session_open) + "'::time";
+    std::string close = "'" + db_.escape_string(session_.session_close) + "'::time";
+    std::string dow = "EXTRACT(DOW FROM " + slot + ")";
+
+    std::string filter = "NOT (" + dow + " = " + std::to_string(session_.week_open_dow) + " AND " + slot +
+                         "::time < " + open + ")"
+                         " AND NOT (" + dow + " = " + std::to_string(session_.week_close_dow) + " AND " + slot +
+                         "::time >= " + close + ")";
+
+    // Whole days between the weekly close and the next open (Saturday)
+    for (int day = (session_.week_close_dow + 1) % 7; day != session_.week_open_dow; day = (day + 1) % 7) {
+        filter += " AND " + dow + " <> " + std::to_string(day);
+    }
+
+    if (session_.session_close < session_.session_open) {
+        filter += " AND NOT (" + slot + "::time >= " + close + " AND " + slot + "::time < " + open + ")";
+        // From the open on, a slot belongs to the next day's trade date
+        filter += holiday_filter("(" + slot + " + interval '24 hours' - " + open + "::interval)::date");
+    } else {
+        filter += holiday_filter(slot + "::date");
+    }
+    return filter + early_close_filter(slot);
+}
+
+std::string GapDetector::holiday_filter(const std::string& trade_date) const {
+    if (session_.holidays.empty()) {
+        return "";
+    }
+
+    std::string dates;
+    for (const auto& holiday : session_.holidays) {
+        if (!dates.empty()) dates += ", ";
+        dates += "'" + db_.escape_string(holiday) + "'::date";
+    }
+    return " AND " + trade_date + " NOT IN (" + dates + ")";
+}
+
+// On an early close the break starts at that day's close instead
+std::string GapDetector::early_close_filter(const std::string& slot) const {
+    if (session_.early_closes.empty()) {
+        return "";
+    }
+
+    std::string rows;
+    for (const auto& early : session_.early_closes) {
+        if (!rows.empty()) rows += ", ";
+        rows += "('" + db_.escape_string(early.first) + "'::date, '" + db_.escape_string(early.second) + "'::time)";
+    }
+
+    std::string until_open;
+    if (session_.session_close < session_.session_open) {
+        until_open = " AND " + slot + "::time < '" + db_.escape_string(session_.session_open) + "'::time";
+    }
+    return " AND NOT EXISTS (SELECT 1 FROM (VALUES " + rows + ") AS e(trade_date, close_time)"
+           " WHERE " + slot + "::date = e.trade_date AND " + slot + "::time >= e.close_time" + until_open + ")";
+}
+
+// One (symbol, from_ts) row per symbol, joined to symbols by name
+std::string GapDetector::scan_starts(const std::map<std::string, std::string>& from_by_symbol, bool daily) {
+    std::string rows;
+    for (const auto& pair : from_by_symbol) {
+        if (!rows.empty()) rows += ", ";
+        rows += "('" + db_.escape_string(pair.first) + "', '" + db_.escape_string(pair.second) + "'::" +
+                (daily ? "date" : "timestamp") + ")";
+    }
+    return "(VALUES " + rows + ") AS w(symbol, from_ts) JOIN symbols s ON s.symbol = w.symbol";
+}
+
+// The grid numbers every expected slot per symbol; numbering the missing
+// slots again and subtracting gives one island value per run of
+// consecutive missing slots (gaps-and-islands), so each run is one row.
+// Each symbol's grid starts at its own from_ts.
+std::string GapDetector::build_gap_query(const std::string& timeframe,
+                                         const std::map<std::string, std::string>& from_by_symbol,
+                                         const std::string& to) {
+    std::string to_literal = "'" + db_.escape_string(to) + "'";
+
+    if (timeframe == "daily") {
+        std::string days;
+        for (int day : session_.daily_bar_days) {
+            if (!days.empty()) days += ", ";
+            days += std::to_string(day);
+        }
+
+        return "WITH grid AS ("
+               " SELECT s.symbol_id, s.symbol, g.slot::date AS slot,"
+               " ROW_NUMBER() OVER (PARTITION BY s.symbol_id ORDER BY g.slot) AS grid_rn"
+               " FROM " + scan_starts(from_by_symbol, true) +
+               " CROSS JOIN LATERAL generate_series(w.from_ts, " + to_literal + "::date, interval '1 day') AS g(slot)"
+               " WHERE EXTRACT(DOW FROM g.slot) IN (" + (days.empty() ? "NULL" : days) + ")" +
+               holiday_filter("g.slot::date") +
+               "), missing AS ("
+               " SELECT grid.symbol, grid.slot,"
+               " grid.grid_rn - ROW_NUMBER() OVER (PARTITION BY grid.symbol_id ORDER BY grid.slot) AS island"
+               " FROM grid"
+               " WHERE NOT EXISTS (SELECT 1 FROM historical_fetch_daily h"
+               " WHERE h.symbol_id = grid.symbol_id AND h.fetch_date = grid.slot)"
+               ")"
+               " SELECT symbol, to_char(MIN(slot), 'YYYY-MM-DD'), to_char(MAX(slot), 'YYYY-MM-DD'), COUNT(*)"
+               " FROM missing GROUP BY symbol, island ORDER BY symbol, MIN(slot)";
+    }
+
+    long long seconds = slot_seconds(timeframe);
+    std::string table = "historical_fetch_" + timeframe;
+
+    return "WITH grid AS ("
+           " SELECT s.symbol_id, s.symbol, g.slot,"
+           " ROW_NUMBER() OVER (PARTITION BY s.symbol_id ORDER BY g.slot) AS grid_rn"
+           " FROM " + scan_starts(from_by_symbol, false) +
+           " CROSS JOIN LATERAL generate_series(date_trunc('day', w.from_ts), " + to_literal +
+           "::timestamp, interval '" + std::to_string(seconds) + " seconds') AS g(slot)"
+           " WHERE g.slot >= w.from_ts"
+           " AND " + session_filter("g.slot") +
+           "), missing AS ("
+           " SELECT grid.symbol, grid.slot,"
+           " grid.grid_rn - ROW_NUMBER() OVER (PARTITION BY grid.symbol_id ORDER BY grid.slot) AS island"
+           " FROM grid"
+           " WHERE NOT EXISTS (SELECT 1 FROM " + table + " h"
+           " WHERE h.symbol_id = grid.symbol_id AND h.bar_ts = " + SimpleDatabaseManager::bar_timestamp_of("grid.slot") +
+           ")"
+           ")"
+           " SELECT symbol, to_char(MIN(slot), 'YYYY-MM-DD HH24:MI:SS'), to_char(MAX(slot), 'YYYY-MM-DD HH24:MI:SS'),"
+           " COUNT(*)"
+           " FROM missing GROUP BY symbol, island ORDER BY symbol, MIN(slot)";
+}
+
+bool GapDetector::find_gaps(const std::string& timeframe, const std::vector<std::string>& symbols,
+                            const std::string& from, const std::string& to, std::vector<BarGap>& gaps) {
+    std::map<std::string, std::string> from_by_symbol;
+    for (const auto& symbol : symbols) {
+        from_by_symbol[symbol] = from;
+    }
+    return find_gaps(timeframe, from_by_symbol, to, gaps);
+}
+
+bool GapDetector::find_gaps(const std::string& timeframe, const std::map<std::string, std::string>& from_by_symbol,
+                            const std::string& to, std::vector<BarGap>& gaps) {
+    gaps.clear();
+    if (slot_seconds(timeframe) == 0 || from_by_symbol.empty()) {
+        return slot_seconds(timeframe) != 0;
+    }
+
+    PGresult* result = db_.execute_query_with_result(build_gap_query(timeframe, from_by_symbol, to));
+    if (!result) {
+        return false;
+    }
+
+    for (int i = 0; i < PQntuples(result); i++) {
+        BarGap gap;
+        gap.symbol = PQgetvalue(result, i, 0);
+        gap.timeframe = timeframe;
+        gap.first_missing = PQgetvalue(result, i, 1);
+        gap.last_missing = PQgetvalue(result, i, 2);
+        gap.missing_bars = std::atoi(PQgetvalue(result, i, 3));
+        gaps.push_back(gap);
+    }
+
+    PQclear(result);
+    return true;
+}
+
+// ==============================================
+// COALESCING
+// ==============================================
+
+std::vector<BackfillRange> GapDetector::coalesce(const std::vector<BarGap>& gaps, const BackfillOptions& options) {
+    std::vector<BackfillRange> ranges;
+    long long current_end = 0;
+
+    for (const auto& gap : gaps) {
+        long long slot = slot_seconds(gap.timeframe);
+        if (slot == 0) continue;
+
+        long long first = parse_wall_clock(gap.first_missing);
+        long long last = parse_wall_clock(gap.last_missing);
+
+        bool extends_previous = !ranges.empty() && ranges.back().symbol == gap.symbol &&
+                                ranges.back().timeframe == gap.timeframe &&
+                                first - current_end <= (options.merge_within_slots + 1) * slot;
+        if (extends_previous) {
+            current_end = std::max(current_end, last);
+            ranges.back().end = gap.last_missing;
+            ranges.back().missing_bars += gap.missing_bars;
+            ranges.back().gaps++;
+        } else {
+            BackfillRange range;
+            range.symbol = gap.symbol;
+            range.timeframe = gap.timeframe;
+            range.begin = gap.first_missing;
+            range.end = gap.last_missing;
+            range.missing_bars = gap.missing_bars;
+            range.gaps = 1;
+            ranges.push_back(range);
+            current_end = last;
+        }
+    }
+
+    // Split ranges that would exceed one request
+    std::vector<BackfillRange> requests;
+    for (const auto& range : ranges) {
+        long long slot = slot_seconds(range.timeframe);
+        bool daily = range.timeframe == "daily";
+        long long begin = parse_wall_clock(range.begin);
+        long long end = parse_wall_clock(range.end);
+        long long span = std::max(1, options.max_slots_per_request) * slot;
+
+        if (end - begin < span) {
+            requests.push_back(range);
+            continue;
+        }
+
+        long long total_slots = (end - begin) / slot + 1;
+        for (long long chunk_begin = begin; chunk_begin <= end; chunk_begin += span) {
+            long long chunk_end = std::min(end, chunk_begin + span - slot);
+            BackfillRange chunk = range;
+            chunk.begin = format_wall_clock(chunk_begin, daily);
+            chunk.end = format_wall_clock(chunk_end, daily);
+            // Apportion missing slots by length; exact per chunk is not needed
+            chunk.missing_bars = static_cast<int>(range.missing_bars * ((chunk_end - chunk_begin) / slot + 1) / total_slots);
+            requests.push_back(chunk);
+        }
+    }
+    return requests;
+}
+
+// ==============================================
+// SESSION GRID
+// ==============================================
+
+SessionGrid GapDetector::session_grid(const TradingCalendar& calendar, const std::string& from_date,
+                                      const std::string& to_date) {
+    SessionGrid grid;
+    grid.session_open = calendar.rules().session_open;
+    grid.session_close = calendar.rules().session_close;
+
+    for (long long day = TradingCalendar::day_number(from_date); day <= TradingCalendar::day_number(to_date); day++) {
+        int dow = TradingCalendar::weekday(day);
+        if (dow < 1 || dow > 5) continue;
+
+        SessionTimes times = calendar.session(day);
+        if (!times.trading) {
+            grid.holidays.push_back(TradingCalendar::format_day(day));
+        } else if (times.early_close) {
+            grid.early_closes.emplace_back(TradingCalendar::format_day(day), times.close);
+        }
+    }
+    return grid;
+}
+
+// ==============================================
+// TIME HELPERS
+// ==============================================
+
+long long GapDetector::slot_seconds(const std::string& timeframe) {
+    if (timeframe == "15min") return 900;
+    if (timeframe == "30min") return 1800;
+    if (timeframe == "1hour") return 3600;
+    if (timeframe == "2hours") return 7200;
+    if (timeframe == "daily") return 86400;
+    return 0;
+}
+
+long long GapDetector::parse_wall_clock(const std::string& wall_clock) {
+    int year = 1970, month = 1, day = 1, hour = 0, minute = 0, second = 0;
+    std::sscanf(wall_clock.c_str(), "%d-%d-%d %d:%d:%d", &year, &month, &day, &hour, &minute, &second);
+    return TradingCalendar::days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day)) * 86400 +
+           hour * 3600 + minute * 60 + second;
+}
+
+std::string GapDetector::format_wall_clock(long long seconds, bool date_only) {
+    long long days = seconds >= 0 ? seconds / 86400 : (seconds - 86399) / 86400;
+    long long of_day = seconds - days * 86400;
+    long long year;
+    unsigned month, day;
+    TradingCalendar::civil_from_days(days, year, month, day);
+
+    char buffer[64];
+    if (date_only) {
+        std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u", year, month, day);
+    } else {
+        std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u %02lld:%02lld:%02lld", year, month, day,
+                      of_day / 3600, (of_day / 60) % 60, of_day % 60);
+    }
+    return buffer;
+}
+
+std::string GapDetector::local_wall_clock(std::chrono::system_clock::time_point time) {
+    auto time_t = std::chrono::system_clock::to_time_t(time);
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &time_t);
+#else
+    localtime_r(&time_t, &tm);
+#endif
+
+    std::ostringstream oss;
+    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+    return oss.str();
+}
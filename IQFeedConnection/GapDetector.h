@@ -0,0 +1,105 @@
+#ifndef GAP_DETECTOR_H
+#define GAP_DETECTOR_H
+
+#include <string>
+#include <vector>
+#include <chrono>
+#include <map>
+#include <utility>
+
+class SimpleDatabaseManager;
+class TradingCalendar;
+
+// ==============================================
+// GAP DETECTOR - SET-BASED MISSING BAR RANGES
+// ==============================================
+
+// Expected bar grid in exchange wall-clock time (IQFeed timestamps are ET).
+// Defaults follow CME Globex: the week opens Sunday 18:00 and closes Friday
+// 17:00, with a daily break from 17:00 to 18:00. Intraday slots are
+// aligned to midnight and labelled with their start time. The scheduler
+// builds its grid from the TradingCalendar (GapDetector::session_grid).
+struct SessionGrid {
+    int week_open_dow = 0;                       // Sunday (0=Sunday ... 6=Saturday)
+    int week_close_dow = 5;                      // Friday
+    std::string session_open = "18:00:00";
+    std::string session_close = "17:00:00";
+    std::vector<int> daily_bar_days = {1, 2, 3, 4, 5};  // Days that get a daily bar (Mon-Fri)
+    std::vector<std::string> holidays;                  // Trade dates without a session ("YYYY-MM-DD")
+    std::vector<std::pair<std::string, std::string>> early_closes;  // Trade date -> its close ("HH:MM:SS")
+};
+
+// A run of consecutive missing grid slots for one symbol and timeframe.
+// first/last are wall-clock "YYYY-MM-DD HH:MM:SS" ("YYYY-MM-DD" for daily).
+struct BarGap {
+    std::string symbol;
+    std::string timeframe;
+    std::string first_missing;
+    std::string last_missing;
+    int missing_bars = 0;
+};
+
+// One IQFeed range request covering one or more coalesced gaps
+struct BackfillRange {
+    std::string symbol;
+    std::string timeframe;
+    std::string begin;          // First bar to fetch (wall clock, inclusive)
+    std::string end;            // Last bar to fetch (wall clock, inclusive)
+    int missing_bars = 0;       // Missing slots covered (present bars in between are refetched)
+    int gaps = 0;               // Gaps merged into this request
+};
+
+struct BackfillOptions {
+    int merge_within_slots = 8;         // Merge gaps separated by at most this many present slots
+    int max_slots_per_request = 2000;   // Split longer ranges (calendar slots, weekends included)
+};
+
+class GapDetector {
+public:
+    explicit GapDetector(SimpleDatabaseManager& db, const SessionGrid& session = SessionGrid());
+
+    // One SQL pass per timeframe: every missing slot between from and to
+    // (wall clock, inclusive) for the given symbols, as gaps ordered by
+    // symbol and time. Symbols without a symbols row are skipped.
+    bool find_gaps(const std::string& timeframe, const std::vector<std::string>& symbols,
+                   const std::string& from, const std::string& to, std::vector<BarGap>& gaps);
+
+    // Same pass with its own first slot per symbol (symbol -> from), e.g.
+    // the slot after the newest bar the scheduler journal recorded
+    bool find_gaps(const std::string& timeframe, const std::map<std::string, std::string>& from_by_symbol,
+                   const std::string& to, std::vector<BarGap>& gaps);
+
+    std::string build_gap_query(const std::string& timeframe, const std::map<std::string, std::string>& from_by_symbol,
+                                const std::string& to);
+
+    // Merge nearby gaps per symbol/timeframe into range requests and split
+    // ranges longer than max_slots_per_request. Gaps must be ordered by
+    // symbol, timeframe and time, as find_gaps returns them.
+    static std::vector<BackfillRange> coalesce(const std::vector<BarGap>& gaps,
+                                               const BackfillOptions& options = BackfillOptions());
+
+    // The calendar's sessions for trade dates in [from_date, to_date]: its
+    // open and close, exchange holidays and early closes
+    static SessionGrid session_grid(const TradingCalendar& calendar, const std::string& from_date,
+                                    const std::string& to_date);
+
+    // Slot length in seconds: 900 for "15min", 86400 for "daily", 0 if unknown
+    static long long slot_seconds(const std::string& timeframe);
+
+    // Wall-clock helpers; arithmetic is done on the literal fields, so
+    // daylight-saving changes never shift the grid
+    static long long parse_wall_clock(const std::string& wall_clock);
+    static std::string format_wall_clock(long long seconds, bool date_only);
+    static std::string local_wall_clock(std::chrono::system_clock::time_point time);
+
+private:
+    std::string session_filter(const std::string& slot) const;
+    std::string holiday_filter(const std::string& trade_date) const;
+    std::string early_close_filter(const std::string& slot) const;
+    std::string scan_starts(const std::map<std::string, std::string>& from_by_symbol, bool daily);
+
+    SimpleDatabaseManager& db_;
+    SessionGrid session_;
+};
+
+#endif // GAP_DETECTOR_H
@@ -1,5 +1,7 @@
 #include "HistoricalDataFetcher.h"
 #include "IQFeedConnectionManager.h"
+#include "MetricsRegistry.h"
+#include "Tracer.h"
 #include <iostream>
 #include <iomanip>
 #include <sstream>
@@ -10,6 +12,17 @@ HistoricalDataFetcher::HistoricalDataFetcher(std::shared_ptr<IQFeedConnectionMan
                                            const std::string& period)
     : connection_manager(conn_mgr), period_name(period) {
     logger = std::make_unique<Logger>("iqfeed_" + period + ".log", true);
+    
+    auto& registry = MetricsRegistry::instance();
+    MetricLabels labels = { { "timeframe", period } };
+    rate_wait_seconds = &registry.histogram("nexday_iqfeed_rate_wait_seconds",
+                                            "Time waiting on the lookup request limiter", labels);
+    request_seconds = &registry.histogram("nexday_iqfeed_request_seconds",
+                                          "Lookup request from socket open to parsed bars", labels);
+    parse_seconds = &registry.histogram("nexday_parse_seconds", "Parsing one lookup response", labels);
+    bars_parsed = &registry.counter("nexday_bars_parsed_total", "Complete bars parsed from IQFeed", labels);
+    request_failures = &registry.counter("nexday_iqfeed_request_failures_total",
+                                         "Lookup requests that returned no bars", labels);
 }
 
 bool HistoricalDataFetcher::fetch_historical_data(const std::string& symbol, int num_bars, 
@@ -22,13 +35,6 @@ bool HistoricalDataFetcher::fetch_historical_data(const std::string& symbol, int
     logger->info("Fetching " + std::to_string(num_bars) + " " + period_name + 
                  " bars for symbol: " + symbol);
     
-    // Create fresh socket for this request
-    SOCKET lookup_socket = connection_manager->create_lookup_socket();
-    if (lookup_socket == INVALID_SOCKET) {
-        logger->error("Failed to create lookup socket");
-        return false;
-    }
-    
     // Build command based on timeframe
     std::string request_id = "HIST_" + symbol + "_" + period_name;
     std::string command;
@@ -47,27 +53,120 @@ bool HistoricalDataFetcher::fetch_historical_data(const std::string& symbol, int
                  ",0," + request_id + ",100,s,1\r\n";
     }
     
-    logger->debug("Sending command: " + command);
+    return request_and_parse(command, symbol, data);
+}
+
+bool HistoricalDataFetcher::fetch_historical_range(const std::string& symbol, const std::string& begin,
+                                                  const std::string& end, std::vector<HistoricalBar>& data) {
+    if (!connection_manager || !connection_manager->is_connection_ready()) {
+        logger->error("Connection manager not ready");
+        return false;
+    }
+    
+    logger->info("Fetching " + period_name + " bars for symbol: " + symbol + " from " + begin + " to " + end);
+    
+    // IQFeed wants CCYYMMDD / CCYYMMDD HHmmSS
+    auto compact = [](const std::string& wall_clock) {
+        std::string digits;
+        for (char c : wall_clock) {
+            if (c >= '0' && c <= '9') digits += c;
+        }
+        return digits.size() > 8 ? digits.substr(0, 8) + " " + digits.substr(8) : digits;
+    };
+    
+    std::string request_id = "RANGE_" + symbol + "_" + period_name;
+    std::string command;
+    
+    if (get_interval_code() == "DAILY") {
+        // HDT: Symbol,BeginDate,EndDate,MaxDatapoints,DataDirection,RequestID,DatapointsPerSend
+        command = "HDT," + symbol + "," + compact(begin) + "," + compact(end) + ",,0," + request_id + ",100\r\n";
+    } else {
+        // parse_historical_data drops the newest line as the bar in progress,
+        // so ask for one interval past the last wanted bar
+        std::tm tm = {};
+        std::istringstream end_stream(end);
+        end_stream >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+        tm.tm_isdst = -1;
+        auto extended = std::chrono::system_clock::from_time_t(std::mktime(&tm)) + get_interval_offset();
+        
+        // HIT: Symbol,Interval,BeginDateTime,EndDateTime,MaxDatapoints,BeginFilterTime,EndFilterTime,
+        //      DataDirection,RequestID,DatapointsPerSend,IntervalType,LabelAtBeginning
+        command = "HIT," + symbol + "," + get_interval_code() + "," + compact(begin) + "," +
+                 compact(format_time_point(extended)) + ",,,,0," + request_id + ",100,s,1\r\n";
+    }
+    
+    return request_and_parse(command, symbol, data);
+}
+
+bool HistoricalDataFetcher::request_and_parse(const std::string& command, const std::string& symbol,
+                                             std::vector<HistoricalBar>& data) {
+    NEXDAY_TRACE_SPAN("iqfeed", "request", symbol, period_name);
+    
+    // Every lookup request goes through the shared limiter
+    ScopedTimer wait_timer(*rate_wait_seconds);
+    TraceSpan wait_span("iqfeed", "rate_wait", symbol, period_name);
+    RateLimiter::Permit permit = connection_manager->get_request_limiter().acquire();
+    wait_timer.stop();
+    wait_span.end();
+    if (!permit) {
+        logger->error("Request rate limiter timed out; not sending: " + command);
+        request_failures->inc();
+        return false;
+    }
+    
+    ScopedTimer request_timer(*request_seconds);
+    
+    // Create fresh socket for this request
+    TraceSpan connect_span("iqfeed", "connect", symbol, period_name);
+    SOCKET lookup_socket = connection_manager->create_lookup_socket();
+    connect_span.end();
+    if (lookup_socket == INVALID_SOCKET) {
+        logger->error("Failed to create lookup socket");
+        permit.error();
+        request_failures->inc();
+        return false;
+    }
+    
+    NEXDAY_LOG_DEBUG(logger, "Sending command: " + command);
     
     // Send command
     if (!connection_manager->send_command(lookup_socket, command)) {
         connection_manager->close_lookup_socket(lookup_socket);
+        permit.error();
+        request_failures->inc();
         return false;
     }
     
     // Read response
+    TraceSpan read_span("iqfeed", "read", symbol, period_name);
     std::string response = connection_manager->read_full_response(lookup_socket);
     connection_manager->close_lookup_socket(lookup_socket);
+    read_span.end();
+    
+    // AIMD feedback: no end marker is a timeout; an error other than no-data is IQConnect pushing back
+    std::string error_message;
+    if (response.find("!ENDMSG!") == std::string::npos) {
+        permit.timeout();
+    } else if (is_error_response(response, &error_message) && error_message != "!NO_DATA!") {
+        permit.error();
+    } else {
+        permit.success();
+    }
     
     if (response.empty()) {
         logger->error("No response received");
+        request_failures->inc();
         return false;
     }
     
-    logger->debug("Raw response received (" + std::to_string(response.length()) + " characters)");
+    NEXDAY_LOG_DEBUG(logger, "Raw response received (" + std::to_string(response.length()) + " characters)");
     
     // Parse data
-    return parse_historical_data(response, symbol, data);
+    bool parsed = parse_historical_data(response, symbol, data);
+    if (!parsed) {
+        request_failures->inc();
+    }
+    return parsed;
 }
 
 bool HistoricalDataFetcher::is_complete_bar(const std::string& datetime_str) const {
@@ -82,7 +181,8 @@ bool HistoricalDataFetcher::is_complete_bar(const std::string& datetime_str) con
             return false; // Error handling
         }
 #else
-        std::tm tm_now = *std::localtime(&time_t_now);
+        std::tm tm_now{};
+        localtime_r(&time_t_now, &tm_now);
 #endif
         
         std::ostringstream today_str;
@@ -97,7 +197,7 @@ bool HistoricalDataFetcher::is_complete_bar(const std::string& datetime_str) con
         ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
         
         if (ss.fail()) {
-            logger->debug("PARSE_FAIL: " + datetime_str);
+            NEXDAY_LOG_DEBUG(logger, "PARSE_FAIL: " + datetime_str);
             return false;
         }
         
@@ -119,27 +219,30 @@ bool HistoricalDataFetcher::is_complete_bar(const std::string& datetime_str) con
         auto minutes_since_end = std::chrono::duration_cast<std::chrono::minutes>(now - bar_end_time);
         bool is_complete = minutes_since_end.count() >= 1;
         
-        // Debug logging with corrected logic
-        auto bar_end_time_t = std::chrono::system_clock::to_time_t(bar_end_time);
-        
-        // FIXED: Use safe localtime_s instead of localtime
+        // Debug logging with corrected logic; the end time is only formatted for it
+        if (logger->enabled(LogLevel::Debug)) {
+            auto bar_end_time_t = std::chrono::system_clock::to_time_t(bar_end_time);
+            
+            // FIXED: Use safe localtime_s instead of localtime
 #ifdef _WIN32
-        std::tm bar_end_tm;
-        if (localtime_s(&bar_end_tm, &bar_end_time_t) != 0) {
-            logger->debug("COMPLETENESS_CHECK: Error getting end time for " + datetime_str);
-            return false;
-        }
+            std::tm bar_end_tm;
+            if (localtime_s(&bar_end_tm, &bar_end_time_t) != 0) {
+                NEXDAY_LOG_DEBUG(logger, "COMPLETENESS_CHECK: Error getting end time for " + datetime_str);
+                return is_complete;
+            }
 #else
-        std::tm bar_end_tm = *std::localtime(&bar_end_time_t);
+            std::tm bar_end_tm{};
+            localtime_r(&bar_end_time_t, &bar_end_tm);
 #endif
-        
-        std::ostringstream end_str;
-        end_str << std::put_time(&bar_end_tm, "%Y-%m-%d %H:%M:%S");
-        
-        logger->debug("COMPLETENESS_CHECK: BarStart=" + datetime_str + 
-                     " | BarEnd=" + end_str.str() + 
-                     " | MinutesSinceEnd=" + std::to_string(minutes_since_end.count()) + 
-                     " | Result=" + (is_complete ? "COMPLETE" : "INCOMPLETE"));
+            
+            std::ostringstream end_str;
+            end_str << std::put_time(&bar_end_tm, "%Y-%m-%d %H:%M:%S");
+            
+            NEXDAY_LOG_DEBUG(logger, "COMPLETENESS_CHECK: BarStart=" + datetime_str + 
+                         " | BarEnd=" + end_str.str() + 
+                         " | MinutesSinceEnd=" + std::to_string(minutes_since_end.count()) + 
+                         " | Result=" + (is_complete ? "COMPLETE" : "INCOMPLETE"));
+        }
         
         return is_complete;
     }
@@ -150,11 +253,13 @@ bool HistoricalDataFetcher::parse_historical_data(const std::string& response, c
                                                  std::vector<HistoricalBar>& data) {
     // Suppress unused parameter warning
     (void)symbol; // FIXED: Explicitly mark parameter as intentionally unused
+    ScopedTimer parse_timer(*parse_seconds);
+    NEXDAY_TRACE_SPAN("iqfeed", "parse", symbol, period_name);
     
-    logger->debug("Parsing historical data response...");
+    NEXDAY_LOG_DEBUG(logger, "Parsing historical data response...");
     
     // Check for error messages
-    if (response.find("E,") != std::string::npos) {
+    if (is_error_response(response)) {
         logger->error("Error in response: " + response);
         return false;
     }
@@ -171,15 +276,15 @@ bool HistoricalDataFetcher::parse_historical_data(const std::string& response, c
     }
     
     // DEBUG: Show first few raw lines to understand data structure
-    logger->debug("First 5 lines of raw response:");
+    NEXDAY_LOG_DEBUG(logger, "First 5 lines of raw response:");
     for (int i = 0; i < std::min(5, (int)lines.size()); i++) {
-        logger->debug("Raw Line " + std::to_string(i) + ": " + lines[i]);
+        NEXDAY_LOG_DEBUG(logger, "Raw Line " + std::to_string(i) + ": " + lines[i]);
     }
     
     // DEBUG: Show last few lines of raw response to see the order
-    logger->debug("Last 5 lines of raw response:");
+    NEXDAY_LOG_DEBUG(logger, "Last 5 lines of raw response:");
     for (int i = std::max(0, (int)lines.size() - 5); i < (int)lines.size(); i++) {
-        logger->debug("Raw Line " + std::to_string(i) + ": " + lines[i]);
+        NEXDAY_LOG_DEBUG(logger, "Raw Line " + std::to_string(i) + ": " + lines[i]);
     }
     
     data.clear();
@@ -241,7 +346,7 @@ bool HistoricalDataFetcher::parse_historical_data(const std::string& response, c
                         bar.volume = std::stoi(fields[7]); // Volume at position [7]
                         bar.open_interest = 0; // Not available for intraday
                         
-                        logger->debug("Parsed bar - StartTime: " + original_datetime + 
+                        NEXDAY_LOG_DEBUG(logger, "Parsed bar - StartTime: " + original_datetime + 
                                      " | O:" + std::to_string(bar.open) + 
                                      " H:" + std::to_string(bar.high) + 
                                      " L:" + std::to_string(bar.low) + 
@@ -253,18 +358,18 @@ bool HistoricalDataFetcher::parse_historical_data(const std::string& response, c
                 all_bars.push_back(bar);
                 
             } catch (const std::exception& e) {
-                logger->debug("Failed to parse line: " + data_line + " - Error: " + e.what());
+                NEXDAY_LOG_DEBUG(logger, "Failed to parse line: " + data_line + " - Error: " + e.what());
                 continue;
             }
         }
     }
     
     // DEBUG: Show parsed bars structure
-    logger->debug("First 3 parsed bars:");
+    NEXDAY_LOG_DEBUG(logger, "First 3 parsed bars:");
     for (size_t i = 0; i < std::min(size_t(3), all_bars.size()); i++) {
         const auto& bar = all_bars[i];
         std::string full_datetime = (bar.time.empty()) ? bar.date : bar.date + " " + bar.time;
-        logger->debug("ParsedBar[" + std::to_string(i) + "] = " + full_datetime + 
+        NEXDAY_LOG_DEBUG(logger, "ParsedBar[" + std::to_string(i) + "] = " + full_datetime + 
                      " OHLCV: " + std::to_string(bar.open) + "/" + 
                      std::to_string(bar.high) + "/" + std::to_string(bar.low) + "/" + 
                      std::to_string(bar.close) + "/" + std::to_string(bar.volume));
@@ -287,7 +392,8 @@ bool HistoricalDataFetcher::parse_historical_data(const std::string& response, c
             return false;
         }
 #else
-        std::tm tm_now = *std::localtime(&time_t_now);
+        std::tm tm_now{};
+        localtime_r(&time_t_now, &tm_now);
 #endif
         
         std::ostringstream today_str;
@@ -297,13 +403,13 @@ bool HistoricalDataFetcher::parse_historical_data(const std::string& response, c
             if (bar.date != today_str.str()) {
                 data.push_back(bar);
                 // Debug: Show OHLC values in correct order for verification
-                logger->debug("Added daily bar: " + bar.date + 
+                NEXDAY_LOG_DEBUG(logger, "Added daily bar: " + bar.date + 
                              " | OHLC: " + std::to_string(bar.open) + "/" + 
                              std::to_string(bar.high) + "/" + std::to_string(bar.low) + "/" + 
                              std::to_string(bar.close) + " Vol:" + std::to_string(bar.volume));
             } else {
                 incomplete_bars_filtered++;
-                logger->debug("Filtered today's incomplete bar: " + bar.date);
+                NEXDAY_LOG_DEBUG(logger, "Filtered today's incomplete bar: " + bar.date);
             }
         }
         logger->info("Daily data used as-is (correctly aligned) - " + std::to_string(data.size()) + " complete bars");
@@ -325,7 +431,7 @@ bool HistoricalDataFetcher::parse_historical_data(const std::string& response, c
             
             if (is_complete_bar(corrected_datetime)) {
                 data.push_back(corrected_first_bar);
-                logger->debug("Added corrected intraday bar: " + corrected_first_bar.date + " " + corrected_first_bar.time + 
+                NEXDAY_LOG_DEBUG(logger, "Added corrected intraday bar: " + corrected_first_bar.date + " " + corrected_first_bar.time + 
                              " (timestamp from line 0, OHLCV from line 1)");
             }
             
@@ -336,7 +442,7 @@ bool HistoricalDataFetcher::parse_historical_data(const std::string& response, c
                 
                 if (is_complete_bar(full_datetime)) {
                     data.push_back(bar);
-                    logger->debug("Added intraday bar #" + std::to_string(data.size()) + 
+                    NEXDAY_LOG_DEBUG(logger, "Added intraday bar #" + std::to_string(data.size()) + 
                                  ": " + bar.date + " " + bar.time);
                 } else {
                     incomplete_bars_filtered++;
@@ -347,14 +453,17 @@ bool HistoricalDataFetcher::parse_historical_data(const std::string& response, c
     }
     
     // Debug: Show the order of final processed data
-    logger->debug("First 5 final processed bars:");
+    NEXDAY_LOG_DEBUG(logger, "First 5 final processed bars:");
     for (int i = 0; i < std::min(5, (int)data.size()); i++) {
         const auto& bar = data[i];
-        logger->debug("FinalBar[" + std::to_string(i) + "] = " + bar.date + " " + bar.time + 
+        NEXDAY_LOG_DEBUG(logger, "FinalBar[" + std::to_string(i) + "] = " + bar.date + " " + bar.time + 
                      " | O:" + std::to_string(bar.open) + " H:" + std::to_string(bar.high) + 
                      " L:" + std::to_string(bar.low) + " C:" + std::to_string(bar.close));
     }
     
+    parse_timer.stop();
+    bars_parsed->inc(data.size());
+    
     logger->success("Successfully parsed " + std::to_string(data.size()) + " complete bars" + 
                    (incomplete_bars_filtered > 0 ? 
                     " (filtered " + std::to_string(incomplete_bars_filtered) + " incomplete bars)" : ""));
@@ -402,7 +511,8 @@ std::string HistoricalDataFetcher::format_time_point(const std::chrono::system_c
         return "ERROR_FORMATTING_TIME";
     }
 #else
-    std::tm tm = *std::localtime(&time_t);
+    std::tm tm{};
+    localtime_r(&time_t, &tm);
 #endif
     
     std::ostringstream oss;
@@ -8,6 +8,8 @@
 #include "Logger.h"
 
 class IQFeedConnectionManager;
+class Histogram;
+class Counter;
 
 // Structure to hold OHLCV data
 struct HistoricalBar {
@@ -29,6 +31,13 @@ protected:
     std::unique_ptr<Logger> logger;
     std::string period_name;
     
+    // Registry metrics labelled timeframe=period_name, looked up once
+    Histogram* rate_wait_seconds;
+    Histogram* request_seconds;
+    Histogram* parse_seconds;
+    Counter* bars_parsed;
+    Counter* request_failures;
+    
     // Pure virtual method to get the IQFeed interval code
     virtual std::string get_interval_code() const = 0;
     
@@ -43,6 +52,10 @@ protected:
     bool parse_historical_data(const std::string& response, const std::string& symbol, 
                               std::vector<HistoricalBar>& data);
     
+    // Send one lookup command on a fresh socket and parse the response
+    bool request_and_parse(const std::string& command, const std::string& symbol,
+                           std::vector<HistoricalBar>& data);
+    
     // Helper methods for time formatting (for debugging) - THESE WERE MISSING
     std::string format_current_time() const;
     std::string format_time_point(const std::chrono::system_clock::time_point& tp) const;
@@ -56,11 +69,35 @@ public:
     bool fetch_historical_data(const std::string& symbol, int num_bars, 
                               std::vector<HistoricalBar>& data);
     
+    // Fetch every bar from begin to end (wall clock "YYYY-MM-DD HH:MM:SS",
+    // "YYYY-MM-DD" for daily, both inclusive) with one HIT/HDT request
+    bool fetch_historical_range(const std::string& symbol, const std::string& begin, const std::string& end,
+                                std::vector<HistoricalBar>& data);
+    
     // Display method
     void display_historical_data(const std::string& symbol, 
                                 const std::vector<HistoricalBar>& data);
     
     const std::string& get_period_name() const { return period_name; }
+    
+    // IQFeed answers a failed lookup with one "[RequestID,]E,<message>," line
+    // instead of data. Only that error field counts: "E," elsewhere in a
+    // response (a symbol, a request ID) is data. Fills message when given.
+    static bool is_error_response(const std::string& response, std::string* message = nullptr) {
+        std::string first_line = response.substr(0, response.find_first_of("\r\n"));
+        std::size_t field = 0;
+        if (first_line.compare(0, 2, "E,") != 0) {
+            std::size_t comma = first_line.find(',');
+            if (comma == std::string::npos || first_line.compare(comma + 1, 2, "E,") != 0) return false;
+            field = comma + 1;
+        }
+        if (message) {
+            std::size_t begin = field + 2;
+            std::size_t end = first_line.find(',', begin);
+            *message = first_line.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+        }
+        return true;
+    }
 };
 
 #endif // HISTORICAL_DATA_FETCHER_H
\ No newline at end of file
@@ -1,9 +1,32 @@
 #include "IQFeedConnectionManager.h"
 #include "Logger.h"
+#include "MetricsRegistry.h"
 #include <iostream>
 #include <thread>
 #include <chrono>
 
+namespace {
+    struct LookupMetrics {
+        Histogram& connect_seconds;
+        Histogram& response_seconds;
+        Counter& bytes_received;
+        Counter& socket_failures;
+        Counter& timeouts;
+    };
+
+    LookupMetrics& lookup_metrics() {
+        auto& registry = MetricsRegistry::instance();
+        static LookupMetrics metrics{
+            registry.histogram("nexday_iqfeed_connect_seconds", "Lookup socket connect and protocol handshake"),
+            registry.histogram("nexday_iqfeed_response_seconds", "First recv to !ENDMSG! for one lookup request"),
+            registry.counter("nexday_iqfeed_bytes_received_total", "Lookup response bytes"),
+            registry.counter("nexday_iqfeed_socket_failures_total", "Lookup sockets that failed to open or connect"),
+            registry.counter("nexday_iqfeed_timeouts_total", "Lookup responses that never ended with !ENDMSG!")
+        };
+        return metrics;
+    }
+}
+
 IQFeedConnectionManager::IQFeedConnectionManager() {
     logger = std::make_unique<Logger>("iqfeed_connection.log", true);
     initialize_winsock();
@@ -40,11 +63,15 @@ bool IQFeedConnectionManager::is_connection_ready() const {
 }
 
 SOCKET IQFeedConnectionManager::create_lookup_socket() {
-    logger->debug("Creating lookup socket...");
+    NEXDAY_LOG_DEBUG(logger, "Creating lookup socket...");
+    LookupMetrics& metrics = lookup_metrics();
+    ScopedTimer timer(metrics.connect_seconds);
     
     SOCKET lookup_socket = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
     if (lookup_socket == INVALID_SOCKET) {
         logger->error("Failed to create socket. Error: " + std::to_string(get_last_error()));
+        timer.cancel();
+        metrics.socket_failures.inc();
         return INVALID_SOCKET;
     }
     
@@ -60,6 +87,8 @@ SOCKET IQFeedConnectionManager::create_lookup_socket() {
             logger->error("Connection refused - IQConnect not running or not logged in");
         }
         closesocket(lookup_socket);
+        timer.cancel();
+        metrics.socket_failures.inc();
         return INVALID_SOCKET;
     }
     
@@ -68,6 +97,8 @@ SOCKET IQFeedConnectionManager::create_lookup_socket() {
     if (send(lookup_socket, protocol_cmd.c_str(), static_cast<int>(protocol_cmd.length()), 0) == SOCKET_ERROR) {
         logger->error("Failed to send protocol command");
         closesocket(lookup_socket);
+        timer.cancel();
+        metrics.socket_failures.inc();
         return INVALID_SOCKET;
     }
     
@@ -76,22 +107,22 @@ SOCKET IQFeedConnectionManager::create_lookup_socket() {
     int bytes = recv(lookup_socket, buffer, sizeof(buffer) - 1, 0);
     if (bytes > 0) {
         buffer[bytes] = '\0';
-        logger->debug("Protocol response: " + std::string(buffer));
+        NEXDAY_LOG_DEBUG(logger, "Protocol response: " + std::string(buffer));
     }
     
-    logger->debug("Lookup socket created and configured successfully");
+    NEXDAY_LOG_DEBUG(logger, "Lookup socket created and configured successfully");
     return lookup_socket;
 }
 
 void IQFeedConnectionManager::close_lookup_socket(SOCKET socket) {
     if (socket != INVALID_SOCKET) {
         closesocket(socket);
-        logger->debug("Lookup socket closed");
+        NEXDAY_LOG_DEBUG(logger, "Lookup socket closed");
     }
 }
 
 bool IQFeedConnectionManager::send_command(SOCKET socket, const std::string& command) {
-    logger->debug("Sending command: " + command);
+    NEXDAY_LOG_DEBUG(logger, "Sending command: " + command);
     
     if (send(socket, command.c_str(), static_cast<int>(command.length()), 0) == SOCKET_ERROR) {
         logger->error("Failed to send command. Error: " + std::to_string(get_last_error()));
@@ -106,12 +137,15 @@ std::string IQFeedConnectionManager::read_full_response(SOCKET socket) {
     char buffer[4096];
     int attempts = 0;
     const int max_attempts = 60; // 30 seconds timeout
+    LookupMetrics& metrics = lookup_metrics();
+    ScopedTimer timer(metrics.response_seconds);
     
     while (attempts < max_attempts) {
         int bytes = recv(socket, buffer, sizeof(buffer) - 1, 0);
         if (bytes > 0) {
             buffer[bytes] = '\0';
             full_response += std::string(buffer);
+            metrics.bytes_received.inc(static_cast<std::uint64_t>(bytes));
             
             // Check if we received the end message
             if (full_response.find("!ENDMSG!") != std::string::npos) {
@@ -120,7 +154,7 @@ std::string IQFeedConnectionManager::read_full_response(SOCKET socket) {
             
             attempts = 0; // Reset timeout if we received data
         } else if (bytes == 0) {
-            logger->debug("Connection closed by server");
+            NEXDAY_LOG_DEBUG(logger, "Connection closed by server");
             break;
         } else {
             int error = get_last_error();
@@ -138,6 +172,8 @@ std::string IQFeedConnectionManager::read_full_response(SOCKET socket) {
     
     if (attempts >= max_attempts) {
         logger->error("Timeout waiting for complete response");
+        timer.cancel();                 // Would only measure the 30 s give-up
+        metrics.timeouts.inc();
     }
     
     return full_response;
@@ -151,7 +187,7 @@ void IQFeedConnectionManager::initialize_winsock() {
         throw std::runtime_error("WSAStartup failed: " + std::to_string(result));
     }
     winsock_initialized = true;
-    logger->debug("Winsock initialized successfully");
+    NEXDAY_LOG_DEBUG(logger, "Winsock initialized successfully");
 #endif
 }
 
@@ -159,7 +195,7 @@ void IQFeedConnectionManager::cleanup_winsock() {
 #ifdef _WIN32
     if (winsock_initialized) {
         WSACleanup();
-        logger->debug("Winsock cleaned up");
+        NEXDAY_LOG_DEBUG(logger, "Winsock cleaned up");
     }
 #endif
 }
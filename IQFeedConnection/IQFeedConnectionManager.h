@@ -4,6 +4,7 @@
 #include <string>
 #include <memory>
 #include "Logger.h"  // Include instead of forward declaration
+#include "RateLimiter.h"
 
 #ifdef _WIN32
 #include <winsock2.h>
@@ -27,6 +28,7 @@ private:
     std::unique_ptr<Logger> logger;
     bool winsock_initialized = false;
     bool is_connected = false;
+    RateLimiter request_limiter;   // Shared by every fetcher's lookup requests
 
 public:
     IQFeedConnectionManager();
@@ -44,6 +46,10 @@ public:
     // Send commands and read responses
     bool send_command(SOCKET socket, const std::string& command);
     std::string read_full_response(SOCKET socket);
+    
+    // Acquire a permit before each HIX/HDX/HIT/HDT request and report its outcome
+    RateLimiter& get_request_limiter() { return request_limiter; }
+    void set_request_limits(const RateLimiterConfig& config) { request_limiter.configure(config); }
 
 private:
     void initialize_winsock();
@@ -0,0 +1,285 @@
+#include "LogSink.h"
+#include <algorithm>
+#include <cctype>
+#include <ctime>
+#include <filesystem>
+
+namespace {
+    const std::size_t kMaxBatch = 4096;
+    const auto kIdleWait = std::chrono::milliseconds(20);  // Longest a line sits in the queue
+
+    std::tm local_time(std::time_t time) {
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        return tm;
+    }
+}
+
+const char* log_level_name(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "DEBUG";
+        case LogLevel::Info:    return "INFO";
+        case LogLevel::Success: return "SUCCESS";
+        case LogLevel::Error:   return "ERROR";
+        case LogLevel::Off:     return "OFF";
+    }
+    return "INFO";
+}
+
+bool parse_log_level(const std::string& text, LogLevel& level) {
+    std::string name = text;
+    std::transform(name.begin(), name.end(), name.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    for (LogLevel candidate : { LogLevel::Debug, LogLevel::Info, LogLevel::Success, LogLevel::Error, LogLevel::Off }) {
+        if (name == log_level_name(candidate)) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ==============================================
+// LOCK-FREE QUEUE
+// ==============================================
+
+LogQueue::LogQueue(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity) size <<= 1;
+    cells_.reset(new Cell[size]);
+    mask_ = size - 1;
+    for (std::size_t i = 0; i < size; i++) {
+        cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+bool LogQueue::try_push(LogRecord& record) {
+    std::uint64_t position = tail_.load(std::memory_order_relaxed);
+    Cell* cell;
+    for (;;) {
+        cell = &cells_[position & mask_];
+        std::uint64_t sequence = cell->sequence.load(std::memory_order_acquire);
+        std::int64_t diff = static_cast<std::int64_t>(sequence) - static_cast<std::int64_t>(position);
+        if (diff == 0) {
+            if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;                                  // Full: writer has not freed this cell yet
+        } else {
+            position = tail_.load(std::memory_order_relaxed);
+        }
+    }
+    cell->record = std::move(record);
+    cell->sequence.store(position + 1, std::memory_order_release);
+    return true;
+}
+
+bool LogQueue::try_pop(LogRecord& record) {
+    Cell* cell = &cells_[head_ & mask_];
+    if (cell->sequence.load(std::memory_order_acquire) != head_ + 1) {
+        return false;
+    }
+    record = std::move(cell->record);
+    cell->sequence.store(head_ + mask_ + 1, std::memory_order_release);
+    head_++;
+    return true;
+}
+
+// ==============================================
+// SINK
+// ==============================================
+
+LogSink& LogSink::instance() {
+    static LogSink sink;
+    return sink;
+}
+
+LogSink::LogSink(std::size_t capacity)
+    : queue_(capacity) {
+    // Id 0 is console only, for loggers created with logging to file off
+    file_names_.push_back("");
+    files_.push_back(nullptr);
+    writer_ = std::thread(&LogSink::writer_loop, this);
+}
+
+LogSink::~LogSink() {
+    stopping_.store(true);
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);
+    }
+    wake_.notify_one();
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    for (std::FILE* file : files_) {
+        if (file) std::fclose(file);
+    }
+}
+
+std::uint16_t LogSink::open(const std::string& filename) {
+    std::lock_guard<std::mutex> lock(files_mutex_);
+    for (std::size_t i = 1; i < file_names_.size(); i++) {
+        if (file_names_[i] == filename) {
+            return static_cast<std::uint16_t>(i);
+        }
+    }
+    if (file_names_.size() > 0xFFFF) {
+        return 0;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories("logs", ec);
+    std::FILE* file = std::fopen(("logs/" + filename).c_str(), "a");
+    if (file) {
+        std::setvbuf(file, nullptr, _IOFBF, 1 << 16);
+    }
+    file_names_.push_back(filename);
+    files_.push_back(file);                                 // Null if it failed: console only
+    return static_cast<std::uint16_t>(files_.size() - 1);
+}
+
+bool LogSink::submit(LogLevel level, std::uint16_t file, std::string message) {
+    LogRecord record;
+    record.level = level;
+    record.file = file;
+    record.time = std::chrono::system_clock::now();
+    record.message = std::move(message);
+
+    // Count first, so flush() never sees written overtake submitted
+    submitted_.fetch_add(1, std::memory_order_relaxed);
+    while (!queue_.try_push(record)) {
+        if (level < LogLevel::Success) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            written_cv_.notify_all();
+            return false;
+        }
+        wake_.notify_one();
+        std::this_thread::yield();
+    }
+    if (level >= LogLevel::Error) {
+        wake_.notify_one();                                 // Errors reach the file promptly
+    }
+    return true;
+}
+
+void LogSink::flush() {
+    std::uint64_t target = submitted_.load();
+    std::unique_lock<std::mutex> lock(wake_mutex_);
+    wake_.notify_one();
+    written_cv_.wait(lock, [&]() {
+        return written_.load() + dropped_.load() >= target || stopping_.load();
+    });
+}
+
+LogSinkStats LogSink::stats() const {
+    LogSinkStats stats;
+    stats.submitted = submitted_.load();
+    stats.written = written_.load();
+    stats.dropped = dropped_.load();
+    stats.batches = batches_.load();
+    return stats;
+}
+
+// ==============================================
+// WRITER THREAD
+// ==============================================
+
+void LogSink::writer_loop() {
+    for (;;) {
+        std::size_t written = write_batch();
+        if (written > 0) {
+            continue;                                       // More may be waiting
+        }
+        if (stopping_.load()) {
+            while (write_batch() > 0) {}
+            written_cv_.notify_all();
+            return;
+        }
+
+        std::unique_lock<std::mutex> lock(wake_mutex_);
+        written_cv_.notify_all();
+        wake_.wait_for(lock, kIdleWait);
+    }
+}
+
+const std::string& LogSink::timestamp(std::chrono::system_clock::time_point time) {
+    std::time_t seconds = std::chrono::system_clock::to_time_t(time);
+    if (static_cast<long long>(seconds) != cached_second_) {
+        std::tm tm = local_time(seconds);
+        char text[32];
+        std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &tm);
+        cached_timestamp_ = text;
+        cached_second_ = static_cast<long long>(seconds);
+    }
+    return cached_timestamp_;
+}
+
+std::size_t LogSink::write_batch() {
+    LogRecord record;
+    std::size_t count = 0;
+    bool mirror = console_mirror();
+    std::vector<std::size_t> touched;
+
+    while (count < kMaxBatch && queue_.try_pop(record)) {
+        // "[LEVEL] YYYY-MM-DD HH:MM:SS - message", as the synchronous logger wrote it
+        const std::string& stamp = timestamp(record.time);
+        const char* level = log_level_name(record.level);
+
+        if (record.file >= buffers_.size()) {
+            buffers_.resize(record.file + 1);
+        }
+        if (record.file != 0) {
+            std::string& buffer = buffers_[record.file];
+            if (buffer.empty()) touched.push_back(record.file);
+            buffer.append("[").append(level).append("] ").append(stamp).append(" - ");
+            buffer.append(record.message).push_back('\n');
+        }
+        if (mirror || record.file == 0) {
+            console_buffer_.append("[").append(level).append("] ").append(stamp).append(" - ");
+            console_buffer_.append(record.message).push_back('\n');
+        }
+        count++;
+    }
+
+    std::uint64_t dropped = dropped_.load(std::memory_order_relaxed);
+    if (dropped != dropped_reported_) {
+        console_buffer_.append("[ERROR] ").append(timestamp(std::chrono::system_clock::now()))
+                       .append(" - Log queue full: ").append(std::to_string(dropped - dropped_reported_))
+                       .append(" debug/info lines dropped\n");
+        dropped_reported_ = dropped;
+    }
+
+    if (count == 0 && console_buffer_.empty()) {
+        return 0;
+    }
+
+    if (!touched.empty()) {
+        std::lock_guard<std::mutex> lock(files_mutex_);
+        for (std::size_t id : touched) {
+            std::FILE* file = id < files_.size() ? files_[id] : nullptr;
+            if (file) {
+                std::fwrite(buffers_[id].data(), 1, buffers_[id].size(), file);
+                std::fflush(file);
+            }
+            buffers_[id].clear();
+        }
+    }
+    if (!console_buffer_.empty()) {
+        std::fwrite(console_buffer_.data(), 1, console_buffer_.size(), stdout);
+        std::fflush(stdout);
+        console_buffer_.clear();
+    }
+
+    written_.fetch_add(count);
+    batches_.fetch_add(1, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(wake_mutex_);     // Not between flush()'s check and its wait
+    }
+    written_cv_.notify_all();
+    return count;
+}
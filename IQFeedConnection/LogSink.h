@@ -0,0 +1,129 @@
+#ifndef LOG_SINK_H
+#define LOG_SINK_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <condition_variable>
+
+// ==============================================
+// LOG SINK - ASYNCHRONOUS SHARED LOG WRITER
+// ==============================================
+
+// Mixed case on purpose: windows.h defines ERROR
+enum class LogLevel : int {
+    Debug = 0,
+    Info = 1,
+    Success = 2,
+    Error = 3,
+    Off = 4
+};
+
+const char* log_level_name(LogLevel level);
+bool parse_log_level(const std::string& text, LogLevel& level);   // "debug", "info", ...
+
+struct LogRecord {
+    LogLevel level = LogLevel::Info;
+    std::uint16_t file = 0;
+    std::chrono::system_clock::time_point time;
+    std::string message;
+};
+
+// Bounded multi-producer queue (Vyukov): a producer claims a cell with one
+// CAS on the tail and publishes it through the cell's sequence number, so
+// logging threads never take a lock. Only the writer thread pops.
+class LogQueue {
+public:
+    explicit LogQueue(std::size_t capacity);           // Rounded up to a power of two
+
+    bool try_push(LogRecord& record);                   // Moves from record on success
+    bool try_pop(LogRecord& record);                    // Single consumer
+    std::size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell {
+        std::atomic<std::uint64_t> sequence{0};
+        LogRecord record;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::uint64_t mask_;
+    alignas(64) std::atomic<std::uint64_t> tail_{0};   // Producers
+    alignas(64) std::uint64_t head_ = 0;                // Writer thread only
+};
+
+struct LogSinkStats {
+    std::uint64_t submitted = 0;
+    std::uint64_t written = 0;
+    std::uint64_t dropped = 0;          // Debug/info lines refused while the queue was full
+    std::uint64_t batches = 0;          // One write + flush per file per batch
+};
+
+// One per process. Every Logger feeds the same queue; a single writer
+// thread formats the timestamps, groups the lines by file and writes each
+// file once per batch, flushing at the end of the batch rather than per
+// line. Files are opened once by name however many Loggers use them, and
+// the console mirror is written the same way. When the queue is full,
+// debug and info lines are dropped (and counted) so the hot path never
+// waits; success and error lines wait for room.
+class LogSink {
+public:
+    static LogSink& instance();
+
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    // Opens logs/<filename> for appending (once per name); returns its id
+    std::uint16_t open(const std::string& filename);
+
+    bool submit(LogLevel level, std::uint16_t file, std::string message);
+
+    // Blocks until every line submitted before the call is written
+    void flush();
+
+    void set_console_mirror(bool enabled) { console_mirror_.store(enabled, std::memory_order_relaxed); }
+    bool console_mirror() const { return console_mirror_.load(std::memory_order_relaxed); }
+
+    LogSinkStats stats() const;
+
+private:
+    explicit LogSink(std::size_t capacity = 16384);
+    ~LogSink();
+
+    void writer_loop();
+    std::size_t write_batch();
+    const std::string& timestamp(std::chrono::system_clock::time_point time);
+
+    LogQueue queue_;
+    std::atomic<bool> console_mirror_{true};
+    std::atomic<bool> stopping_{false};
+
+    std::atomic<std::uint64_t> submitted_{0};
+    std::atomic<std::uint64_t> written_{0};
+    std::atomic<std::uint64_t> dropped_{0};
+    std::atomic<std::uint64_t> batches_{0};
+    std::uint64_t dropped_reported_ = 0;                // Writer thread only
+
+    std::mutex files_mutex_;
+    std::vector<std::string> file_names_;
+    std::vector<std::FILE*> files_;
+
+    // Writer thread only: per-file output buffers and the cached second
+    std::vector<std::string> buffers_;
+    std::string console_buffer_;
+    long long cached_second_ = -1;
+    std::string cached_timestamp_;
+
+    std::mutex wake_mutex_;
+    std::condition_variable wake_;                      // Writer sleeps here between batches
+    std::condition_variable written_cv_;                // flush() waits here
+    std::thread writer_;
+};
+
+#endif // LOG_SINK_H
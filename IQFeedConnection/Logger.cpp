@@ -1,60 +1,69 @@
 #include "Logger.h"
-#include <iostream>
-#include <chrono>
-#include <iomanip>
-#include <sstream>
-#include <filesystem>
+#include <cstdlib>
 
-Logger::Logger(const std::string& filename, bool enabled) 
-    : logging_enabled(enabled) {
-    if (logging_enabled) {
-        std::filesystem::create_directories("logs");
-        log_file.open("logs/" + filename, std::ios::app);
+namespace {
+    int initial_level() {
+        LogLevel level = LogLevel::Info;
+        const char* text = std::getenv("NEXDAY_LOG_LEVEL");
+        if (text) {
+            parse_log_level(text, level);
+        }
+        return static_cast<int>(level);
     }
 }
 
-Logger::~Logger() {
-    if (log_file.is_open()) {
-        log_file.close();
+std::atomic<int> Logger::min_level_{initial_level()};
+
+Logger::Logger(const std::string& filename, bool enabled) 
+    : file_id(0), logging_enabled(enabled) {
+    if (logging_enabled) {
+        file_id = LogSink::instance().open(filename);
     }
 }
 
-std::string Logger::get_timestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto tm = *std::localtime(&time_t);
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
-    return oss.str();
+void Logger::log(LogLevel level, std::string message) {
+    if (!enabled(level)) return;
+    LogSink::instance().submit(level, file_id, std::move(message));
 }
 
 void Logger::log(const std::string& level, const std::string& message) {
-    if (!logging_enabled) return;
-    
-    auto timestamp = get_timestamp();
-    auto log_entry = "[" + level + "] " + timestamp + " - " + message;
-    
-    std::cout << log_entry << std::endl;
-    
-    if (log_file.is_open()) {
-        log_file << log_entry << std::endl;
-        log_file.flush();
-    }
+    LogLevel parsed = LogLevel::Info;
+    parse_log_level(level, parsed);
+    log(parsed, message);
 }
 
 void Logger::info(const std::string& message) {
-    log("INFO", message);
+    log(LogLevel::Info, message);
 }
 
 void Logger::error(const std::string& message) {
-    log("ERROR", message);
+    log(LogLevel::Error, message);
 }
 
 void Logger::debug(const std::string& message) {
-    log("DEBUG", message);
+    log(LogLevel::Debug, message);
 }
 
 void Logger::success(const std::string& message) {
-    log("SUCCESS", message);
-}
\ No newline at end of file
+    log(LogLevel::Success, message);
+}
+
+// ==============================================
+// PROCESS-WIDE SETTINGS
+// ==============================================
+
+void Logger::set_level(LogLevel level) {
+    min_level_.store(static_cast<int>(level), std::memory_order_relaxed);
+}
+
+LogLevel Logger::level() {
+    return static_cast<LogLevel>(min_level_.load(std::memory_order_relaxed));
+}
+
+void Logger::set_console_mirror(bool enabled) {
+    LogSink::instance().set_console_mirror(enabled);
+}
+
+void Logger::flush() {
+    LogSink::instance().flush();
+}
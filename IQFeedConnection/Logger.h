@@ -1,25 +1,64 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include "LogSink.h"
 #include <string>
-#include <fstream>
+#include <atomic>
+#include <cstdint>
 
+// Levels below this are compiled out of the NEXDAY_LOG_* macros entirely
+// (0 debug, 1 info, 2 success, 3 error); set it from CMake for release builds
+#ifndef NEXDAY_LOG_COMPILE_LEVEL
+#define NEXDAY_LOG_COMPILE_LEVEL 0
+#endif
+
+// Lines go to the shared LogSink: the caller only checks the level and
+// enqueues, the sink's thread formats and writes them in batches. Loggers
+// naming the same file share one handle.
 class Logger {
 private:
-    std::ofstream log_file;
+    std::uint16_t file_id;
     bool logging_enabled;
-    
-    std::string get_timestamp() const;
+
+    static std::atomic<int> min_level_;
 
 public:
     Logger(const std::string& filename = "iqfeed.log", bool enabled = true);
-    ~Logger();
-    
+    ~Logger() = default;
+
+    // Cheap enough for the hot path; the macros below call it before
+    // building the message
+    bool enabled(LogLevel level) const {
+        return logging_enabled && static_cast<int>(level) >= min_level_.load(std::memory_order_relaxed);
+    }
+
+    void log(LogLevel level, std::string message);
     void log(const std::string& level, const std::string& message);
     void info(const std::string& message);
     void error(const std::string& message);
     void debug(const std::string& message);
     void success(const std::string& message);
+
+    // Process-wide; default info, or NEXDAY_LOG_LEVEL from the environment
+    static void set_level(LogLevel level);
+    static LogLevel level();
+    static void set_console_mirror(bool enabled);
+    // Wait until everything logged so far is on disk
+    static void flush();
 };
 
-#endif // LOGGER_H
\ No newline at end of file
+// The message expression is only evaluated when the level is enabled, so
+// debug lines in parse loops cost a load and a compare when they are off
+#define NEXDAY_LOG(logger, level, message)                                             \
+    do {                                                                                \
+        if (static_cast<int>(level) >= NEXDAY_LOG_COMPILE_LEVEL && (logger)->enabled(level)) { \
+            (logger)->log((level), (message));                                         \
+        }                                                                               \
+    } while (0)
+
+#define NEXDAY_LOG_DEBUG(logger, message)   NEXDAY_LOG(logger, LogLevel::Debug, message)
+#define NEXDAY_LOG_INFO(logger, message)    NEXDAY_LOG(logger, LogLevel::Info, message)
+#define NEXDAY_LOG_SUCCESS(logger, message) NEXDAY_LOG(logger, LogLevel::Success, message)
+#define NEXDAY_LOG_ERROR(logger, message)   NEXDAY_LOG(logger, LogLevel::Error, message)
+
+#endif // LOGGER_H
@@ -0,0 +1,305 @@
+#include "MetricsRegistry.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+    std::string escape_label_value(const std::string& value) {
+        std::string escaped;
+        escaped.reserve(value.size());
+        for (char c : value) {
+            if (c == '\\') escaped += "\\\\";
+            else if (c == '"') escaped += "\\\"";
+            else if (c == '\n') escaped += "\\n";
+            else escaped += c;
+        }
+        return escaped;
+    }
+
+    std::string render_labels(const MetricLabels& labels) {
+        std::string text;
+        for (const auto& label : labels) {
+            if (!text.empty()) text += ",";
+            text += label.first + "=\"" + escape_label_value(label.second) + "\"";
+        }
+        return text;
+    }
+
+    // Prometheus spells the special values out
+    std::string format_value(double value) {
+        if (std::isnan(value)) return "NaN";
+        if (std::isinf(value)) return value > 0 ? "+Inf" : "-Inf";
+        // Shortest of %.15g / %.17g that reads back exactly: 0.1, not 0.10000000000000001
+        char text[32];
+        std::snprintf(text, sizeof(text), "%.15g", value);
+        if (std::strtod(text, nullptr) != value) {
+            std::snprintf(text, sizeof(text), "%.17g", value);
+        }
+        return text;
+    }
+
+    // name{labels} with an extra label appended (histogram "le")
+    std::string series(const std::string& name, const std::string& labels, const std::string& extra = "") {
+        std::string all = labels;
+        if (!extra.empty()) all += (all.empty() ? "" : ",") + extra;
+        return all.empty() ? name : name + "{" + all + "}";
+    }
+
+    const char* type_name(int type) {
+        switch (type) {
+            case 0: return "counter";
+            case 1: return "gauge";
+            default: return "histogram";
+        }
+    }
+}
+
+std::size_t metrics_detail::shard_index() {
+    static std::atomic<std::size_t> next{0};
+    thread_local std::size_t index = next.fetch_add(1, std::memory_order_relaxed) % SHARD_COUNT;
+    return index;
+}
+
+// ==============================================
+// METRIC TYPES
+// ==============================================
+
+std::uint64_t Counter::value() const {
+    std::uint64_t total = 0;
+    for (const auto& shard : shards_) {
+        total += shard.value.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+Histogram::Histogram(std::vector<double> bounds)
+    : bounds_(std::move(bounds)) {
+    std::sort(bounds_.begin(), bounds_.end());
+    bounds_.erase(std::unique(bounds_.begin(), bounds_.end()), bounds_.end());
+    for (auto& shard : shards_) {
+        shard.buckets.reset(new std::atomic<std::uint64_t>[bounds_.size() + 1]);
+        for (std::size_t i = 0; i <= bounds_.size(); i++) {
+            shard.buckets[i].store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+void Histogram::observe(double value) {
+    // First bucket whose upper bound is >= value (Prometheus "le")
+    std::size_t bucket = std::lower_bound(bounds_.begin(), bounds_.end(), value) - bounds_.begin();
+    Shard& shard = shards_[metrics_detail::shard_index()];
+    shard.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    shard.count.fetch_add(1, std::memory_order_relaxed);
+    metrics_detail::add(shard.sum, value);
+}
+
+HistogramSnapshot Histogram::snapshot() const {
+    HistogramSnapshot snapshot;
+    snapshot.bounds = bounds_;
+    snapshot.counts.assign(bounds_.size() + 1, 0);
+    for (const auto& shard : shards_) {
+        for (std::size_t i = 0; i <= bounds_.size(); i++) {
+            snapshot.counts[i] += shard.buckets[i].load(std::memory_order_relaxed);
+        }
+        snapshot.sum += shard.sum.load(std::memory_order_relaxed);
+    }
+    // Count from the buckets, so the exposition is consistent with itself
+    for (std::uint64_t count : snapshot.counts) {
+        snapshot.count += count;
+    }
+    return snapshot;
+}
+
+double HistogramSnapshot::quantile(double q) const {
+    if (count == 0 || bounds.empty()) return 0.0;
+    std::uint64_t target = static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count)));
+    target = std::max<std::uint64_t>(1, target);
+
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < bounds.size(); i++) {
+        seen += counts[i];
+        if (seen >= target) return bounds[i];
+    }
+    return bounds.back();
+}
+
+// ==============================================
+// REGISTRY
+// ==============================================
+
+MetricsRegistry& MetricsRegistry::instance() {
+    static MetricsRegistry registry;
+    return registry;
+}
+
+const std::vector<double>& MetricsRegistry::latency_buckets() {
+    static const std::vector<double> bounds = {
+        0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+        0.1, 0.25, 0.5, 1, 2.5, 5, 10, 30, 60, 120
+    };
+    return bounds;
+}
+
+const std::vector<double>& MetricsRegistry::wait_buckets() {
+    static const std::vector<double> bounds = {
+        0.001, 0.002, 0.005, 0.01, 0.02, 0.05, 0.1, 0.2, 0.5,
+        1, 2, 5, 10, 20, 50,                    // up to 50 s
+        100, 200, 500, 1000, 2000, 5000,        // up to ~83 min
+        10000, 20000, 50000, 86400              // up to 24 h
+    };
+    return bounds;
+}
+
+MetricsRegistry::Family& MetricsRegistry::family(const std::string& name, const std::string& help, Type type) {
+    auto it = families_.find(name);
+    if (it == families_.end()) {
+        Family& created = families_[name];
+        created.type = type;
+        created.help = help;
+        return created;
+    }
+    if (it->second.type != type) {
+        throw std::logic_error("Metric " + name + " already registered as a " +
+                               type_name(static_cast<int>(it->second.type)));
+    }
+    return it->second;
+}
+
+Counter& MetricsRegistry::counter(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = family(name, help, Type::COUNTER).counters[render_labels(labels)];
+    if (!slot) slot = std::make_unique<Counter>();
+    return *slot;
+}
+
+Gauge& MetricsRegistry::gauge(const std::string& name, const std::string& help, const MetricLabels& labels) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto& slot = family(name, help, Type::GAUGE).gauges[render_labels(labels)];
+    if (!slot) slot = std::make_unique<Gauge>();
+    return *slot;
+}
+
+Histogram& MetricsRegistry::histogram(const std::string& name, const std::string& help, const MetricLabels& labels,
+                                      const std::vector<double>& bounds) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Family& entry = family(name, help, Type::HISTOGRAM);
+    if (entry.histograms.empty() && entry.bounds.empty()) {
+        entry.bounds = bounds;
+    }
+    auto& slot = entry.histograms[render_labels(labels)];
+    if (!slot) slot = std::make_unique<Histogram>(entry.bounds);
+    return *slot;
+}
+
+std::string MetricsRegistry::prometheus_text() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::ostringstream out;
+
+    for (const auto& pair : families_) {
+        const std::string& name = pair.first;
+        const Family& entry = pair.second;
+        out << "# HELP " << name << " " << entry.help << "\n";
+        out << "# TYPE " << name << " " << type_name(static_cast<int>(entry.type)) << "\n";
+
+        for (const auto& counter : entry.counters) {
+            out << series(name, counter.first) << " " << counter.second->value() << "\n";
+        }
+        for (const auto& gauge : entry.gauges) {
+            out << series(name, gauge.first) << " " << format_value(gauge.second->value()) << "\n";
+        }
+        for (const auto& histogram : entry.histograms) {
+            HistogramSnapshot snapshot = histogram.second->snapshot();
+            std::uint64_t cumulative = 0;
+            for (std::size_t i = 0; i < snapshot.bounds.size(); i++) {
+                cumulative += snapshot.counts[i];
+                out << series(name + "_bucket", histogram.first, "le=\"" + format_value(snapshot.bounds[i]) + "\"")
+                    << " " << cumulative << "\n";
+            }
+            out << series(name + "_bucket", histogram.first, "le=\"+Inf\"") << " " << snapshot.count << "\n";
+            out << series(name + "_sum", histogram.first) << " " << format_value(snapshot.sum) << "\n";
+            out << series(name + "_count", histogram.first) << " " << snapshot.count << "\n";
+        }
+    }
+    return out.str();
+}
+
+bool MetricsRegistry::write_prometheus_file(const std::string& path, std::string& error) const {
+    std::string text = prometheus_text();
+    std::filesystem::path target(path);
+    std::filesystem::path temp_path = target;
+    temp_path += ".tmp";
+
+    std::error_code ec;
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), ec);
+    }
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            error = "Cannot open " + temp_path.string();
+            return false;
+        }
+        out << text;
+        out.flush();
+        if (!out) {
+            error = "Write failed: " + temp_path.string();
+            return false;
+        }
+    }
+    std::filesystem::rename(temp_path, target, ec);
+    if (ec) {
+        error = "Rename to " + path + " failed: " + ec.message();
+        return false;
+    }
+    return true;
+}
+
+// ==============================================
+// FILE EXPORTER
+// ==============================================
+
+MetricsFileExporter::MetricsFileExporter(const std::string& path, std::chrono::milliseconds interval,
+                                         MetricsRegistry& registry)
+    : path_(path), interval_(std::max(interval, std::chrono::milliseconds(100))), registry_(registry) {
+    thread_ = std::thread(&MetricsFileExporter::run, this);
+}
+
+MetricsFileExporter::~MetricsFileExporter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_all();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    write_now();                                   // Final values for the last scrape
+}
+
+bool MetricsFileExporter::write_now() {
+    std::string error;
+    bool ok = registry_.write_prometheus_file(path_, error);
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_error_ = ok ? "" : error;
+    return ok;
+}
+
+std::string MetricsFileExporter::last_error() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_error_;
+}
+
+void MetricsFileExporter::run() {
+    for (;;) {
+        write_now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (wake_.wait_for(lock, interval_, [this]() { return stopping_; })) {
+            return;
+        }
+    }
+}
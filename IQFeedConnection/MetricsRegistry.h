@@ -0,0 +1,207 @@
+#ifndef METRICS_REGISTRY_H
+#define METRICS_REGISTRY_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <array>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+#include <condition_variable>
+
+// ==============================================
+// METRICS REGISTRY - COUNTERS, GAUGES, HISTOGRAMS
+// ==============================================
+
+namespace metrics_detail {
+    constexpr std::size_t SHARD_COUNT = 16;
+
+    // Each thread gets a shard on first use, round robin, so a handful of
+    // fetch workers never write the same cache line
+    std::size_t shard_index();
+
+    // No fetch_add for atomic<double> before C++20
+    inline void add(std::atomic<double>& target, double amount) {
+        double current = target.load(std::memory_order_relaxed);
+        while (!target.compare_exchange_weak(current, current + amount, std::memory_order_relaxed)) {}
+    }
+}
+
+// Monotonic count. inc() is one relaxed add on the calling thread's shard;
+// value() sums the shards.
+class Counter {
+public:
+    void inc(std::uint64_t amount = 1) {
+        shards_[metrics_detail::shard_index()].value.fetch_add(amount, std::memory_order_relaxed);
+    }
+    std::uint64_t value() const;
+
+private:
+    struct alignas(64) Shard {
+        std::atomic<std::uint64_t> value{0};
+    };
+    std::array<Shard, metrics_detail::SHARD_COUNT> shards_;
+};
+
+// Current value of something that goes up and down (queue depth, in flight)
+class Gauge {
+public:
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    void add(double amount) { metrics_detail::add(value_, amount); }
+    void inc() { add(1.0); }
+    void dec() { add(-1.0); }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_{0.0};
+};
+
+struct HistogramSnapshot {
+    std::vector<double> bounds;             // Upper bounds; +Inf is implied after the last
+    std::vector<std::uint64_t> counts;      // Per bucket, bounds.size() + 1 entries (not cumulative)
+    std::uint64_t count = 0;
+    double sum = 0.0;
+
+    // Upper bound of the bucket holding the quantile (0-1); the last bound if it overflowed
+    double quantile(double q) const;
+};
+
+// Fixed buckets chosen at registration. observe() finds the bucket with a
+// binary search and touches only the calling thread's shard.
+class Histogram {
+public:
+    explicit Histogram(std::vector<double> bounds);
+
+    void observe(double value);
+
+    template <typename Rep, typename Period>
+    void observe(std::chrono::duration<Rep, Period> elapsed) {
+        observe(std::chrono::duration<double>(elapsed).count());
+    }
+
+    HistogramSnapshot snapshot() const;
+    const std::vector<double>& bounds() const { return bounds_; }
+
+private:
+    struct alignas(64) Shard {
+        std::unique_ptr<std::atomic<std::uint64_t>[]> buckets;
+        std::atomic<std::uint64_t> count{0};
+        std::atomic<double> sum{0.0};
+    };
+
+    std::vector<double> bounds_;
+    std::array<Shard, metrics_detail::SHARD_COUNT> shards_;
+};
+
+// Observes the time from construction to destruction, in seconds
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Histogram& histogram)
+        : histogram_(&histogram), start_(std::chrono::steady_clock::now()) {}
+    ~ScopedTimer() { stop(); }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+    // Record now instead of at scope exit; later calls do nothing
+    void stop() {
+        if (histogram_) {
+            histogram_->observe(std::chrono::steady_clock::now() - start_);
+            histogram_ = nullptr;
+        }
+    }
+    void cancel() { histogram_ = nullptr; }
+
+private:
+    Histogram* histogram_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+using MetricLabels = std::vector<std::pair<std::string, std::string>>;
+
+// Process-wide set of named metrics, exported in the Prometheus text format.
+// Looking a metric up takes a mutex, so hot paths look theirs up once (a
+// member or a function-local static) and keep the reference; references
+// stay valid for the life of the process. A name belongs to one type:
+// asking for an existing name as another type throws std::logic_error.
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    MetricsRegistry() = default;
+    MetricsRegistry(const MetricsRegistry&) = delete;
+    MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+    Counter& counter(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    Gauge& gauge(const std::string& name, const std::string& help, const MetricLabels& labels = {});
+    // Bounds are fixed by the first registration of the name
+    Histogram& histogram(const std::string& name, const std::string& help, const MetricLabels& labels = {},
+                         const std::vector<double>& bounds = latency_buckets());
+
+    // Seconds, 100 us to 2 min: socket reads, parses, upserts, predictions
+    static const std::vector<double>& latency_buckets();
+    // Seconds, 1 ms to 24 h in 1-2-5 steps: queue waits, timer drift and
+    // bar close to prediction, where a backlog can run into hours
+    static const std::vector<double>& wait_buckets();
+
+    // Text exposition format 0.0.4, families sorted by name
+    std::string prometheus_text() const;
+
+    // Write to a temporary file and rename it over path, so a scraper
+    // (node_exporter's textfile collector) never reads a partial file
+    bool write_prometheus_file(const std::string& path, std::string& error) const;
+
+private:
+    enum class Type { COUNTER, GAUGE, HISTOGRAM };
+
+    struct Family {
+        Type type = Type::COUNTER;
+        std::string help;
+        std::vector<double> bounds;
+        // Keyed by the rendered label set, e.g. timeframe="15min"
+        std::map<std::string, std::unique_ptr<Counter>> counters;
+        std::map<std::string, std::unique_ptr<Gauge>> gauges;
+        std::map<std::string, std::unique_ptr<Histogram>> histograms;
+    };
+
+    Family& family(const std::string& name, const std::string& help, Type type);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+};
+
+// Rewrites the registry to a file every interval on its own thread, and
+// once more when destroyed
+class MetricsFileExporter {
+public:
+    MetricsFileExporter(const std::string& path, std::chrono::milliseconds interval,
+                        MetricsRegistry& registry = MetricsRegistry::instance());
+    ~MetricsFileExporter();
+
+    MetricsFileExporter(const MetricsFileExporter&) = delete;
+    MetricsFileExporter& operator=(const MetricsFileExporter&) = delete;
+
+    bool write_now();
+    const std::string& path() const { return path_; }
+    std::string last_error() const;
+
+private:
+    void run();
+
+    std::string path_;
+    std::chrono::milliseconds interval_;
+    MetricsRegistry& registry_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stopping_ = false;
+    std::string last_error_;
+    std::thread thread_;
+};
+
+#endif // METRICS_REGISTRY_H
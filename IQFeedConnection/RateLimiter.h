@@ -0,0 +1,212 @@
+#ifndef RATE_LIMITER_H
+#define RATE_LIMITER_H
+
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <algorithm>
+
+// ==============================================
+// RATE LIMITER - ADAPTIVE TOKEN BUCKET FOR IQFEED REQUESTS
+// ==============================================
+
+struct RateLimiterConfig {
+    double max_rate = 10.0;              // Requests/second ceiling (and starting rate)
+    double min_rate = 0.5;               // Floor after repeated backoff
+    double burst = 5.0;                  // Bucket size
+    int max_concurrency = 8;             // Requests in flight at once
+    double additive_increase = 0.5;      // Requests/second regained per second of clean requests
+    double decrease_factor = 0.5;        // Rate multiplier on an error or timeout
+    std::chrono::milliseconds decrease_cooldown{1000};  // One backoff per burst of failures
+    std::chrono::milliseconds max_wait{30000};          // acquire() gives up (rejection) after this
+};
+
+struct RateLimiterStats {
+    double current_rate = 0.0;
+    double max_rate = 0.0;
+    int in_flight = 0;
+    long long acquired = 0;
+    long long rejected = 0;
+    long long errors = 0;
+    long long timeouts = 0;
+    long long decreases = 0;
+};
+
+// Token bucket plus a concurrency cap, with AIMD on the refill rate: each
+// successful request adds additive_increase / rate (so about
+// additive_increase per second of traffic), and an error response or
+// timeout multiplies the rate by decrease_factor. The rate therefore settles
+// just under the point where IQConnect starts refusing requests.
+class RateLimiter {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    // Held for the duration of one request; report how it went before it
+    // goes out of scope (unreported permits count as neither)
+    class Permit {
+    public:
+        Permit() = default;
+        Permit(Permit&& other) noexcept : limiter_(other.limiter_) { other.limiter_ = nullptr; }
+        Permit(const Permit&) = delete;
+        Permit& operator=(const Permit&) = delete;
+        Permit& operator=(Permit&&) = delete;
+        ~Permit() { if (limiter_) limiter_->release(Outcome::UNREPORTED); }
+
+        explicit operator bool() const { return limiter_ != nullptr; }
+
+        void success() { finish(Outcome::SUCCEEDED); }
+        void error() { finish(Outcome::FAILED); }
+        void timeout() { finish(Outcome::TIMED_OUT); }
+
+    private:
+        friend class RateLimiter;
+        explicit Permit(RateLimiter* limiter) : limiter_(limiter) {}
+
+        void finish(int outcome) {
+            if (limiter_) limiter_->release(outcome);
+            limiter_ = nullptr;
+        }
+
+        RateLimiter* limiter_ = nullptr;
+    };
+
+    explicit RateLimiter(const RateLimiterConfig& config = RateLimiterConfig()) {
+        configure(config);
+        tokens_ = config_.burst;
+        last_refill_ = Clock::now();
+    }
+
+    RateLimiter(const RateLimiter&) = delete;
+    RateLimiter& operator=(const RateLimiter&) = delete;
+
+    // New limits apply to the next acquire; the current rate is clamped to them
+    void configure(const RateLimiterConfig& config) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            config_ = config;
+            config_.max_rate = std::max(0.001, config_.max_rate);
+            config_.min_rate = std::min(std::max(0.001, config_.min_rate), config_.max_rate);
+            config_.burst = std::max(1.0, config_.burst);
+            config_.max_concurrency = std::max(1, config_.max_concurrency);
+            rate_ = rate_ <= 0.0 ? config_.max_rate : std::min(std::max(rate_, config_.min_rate), config_.max_rate);
+        }
+        changed_.notify_all();
+    }
+
+    // Blocks for a token and a concurrency slot; an empty permit if neither
+    // came within max_wait
+    Permit acquire() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        auto deadline = Clock::now() + config_.max_wait;
+
+        while (true) {
+            auto now = Clock::now();
+            refill_locked(now);
+
+            Clock::time_point wake = deadline;
+            if (in_flight_ < config_.max_concurrency) {
+                if (tokens_ >= 1.0) {
+                    tokens_ -= 1.0;
+                    in_flight_++;
+                    acquired_++;
+                    return Permit(this);
+                }
+                auto until_token = std::chrono::duration_cast<Clock::duration>(
+                    std::chrono::duration<double>((1.0 - tokens_) / rate_));
+                wake = std::min(deadline, now + until_token);
+            }
+
+            if (now >= deadline) {
+                rejected_++;
+                return Permit();
+            }
+            changed_.wait_until(lock, wake);
+        }
+    }
+
+    // Never blocks; an empty permit (counted as rejected) if none is free now
+    Permit try_acquire() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        refill_locked(Clock::now());
+        if (in_flight_ >= config_.max_concurrency || tokens_ < 1.0) {
+            rejected_++;
+            return Permit();
+        }
+        tokens_ -= 1.0;
+        in_flight_++;
+        acquired_++;
+        return Permit(this);
+    }
+
+    double current_rate() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return rate_;
+    }
+
+    RateLimiterStats stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        RateLimiterStats stats;
+        stats.current_rate = rate_;
+        stats.max_rate = config_.max_rate;
+        stats.in_flight = in_flight_;
+        stats.acquired = acquired_;
+        stats.rejected = rejected_;
+        stats.errors = errors_;
+        stats.timeouts = timeouts_;
+        stats.decreases = decreases_;
+        return stats;
+    }
+
+private:
+    struct Outcome {
+        enum { UNREPORTED, SUCCEEDED, FAILED, TIMED_OUT };   // Clear of <windows.h> macros
+    };
+
+    void refill_locked(Clock::time_point now) {
+        double elapsed = std::chrono::duration<double>(now - last_refill_).count();
+        tokens_ = std::min(config_.burst, tokens_ + elapsed * rate_);
+        last_refill_ = now;
+    }
+
+    void release(int outcome) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            in_flight_--;
+            auto now = Clock::now();
+            refill_locked(now);
+
+            if (outcome == Outcome::SUCCEEDED) {
+                rate_ = std::min(config_.max_rate, rate_ + config_.additive_increase / rate_);
+            } else if (outcome == Outcome::FAILED || outcome == Outcome::TIMED_OUT) {
+                if (outcome == Outcome::FAILED) errors_++;
+                else timeouts_++;
+
+                if (now - last_decrease_ >= config_.decrease_cooldown) {
+                    rate_ = std::max(config_.min_rate, rate_ * config_.decrease_factor);
+                    tokens_ = std::min(tokens_, 0.0);      // Stop the burst that caused it
+                    last_decrease_ = now;
+                    decreases_++;
+                }
+            }
+        }
+        changed_.notify_all();
+    }
+
+    RateLimiterConfig config_;
+    double rate_ = 0.0;
+    double tokens_ = 0.0;
+    int in_flight_ = 0;
+    Clock::time_point last_refill_;
+    Clock::time_point last_decrease_;
+
+    long long acquired_ = 0;
+    long long rejected_ = 0;
+    long long errors_ = 0;
+    long long timeouts_ = 0;
+    long long decreases_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable changed_;
+};
+
+#endif // RATE_LIMITER_H
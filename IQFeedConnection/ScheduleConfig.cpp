@@ -0,0 +1,341 @@
+#include "ScheduleConfig.h"
+#include <fstream>
+#include <sstream>
+#include <tuple>
+#include <set>
+#include <map>
+#include <cstdio>
+
+namespace {
+    std::string trim(const std::string& text) {
+        std::size_t begin = text.find_first_not_of(" \t\r\n");
+        if (begin == std::string::npos) return "";
+        std::size_t end = text.find_last_not_of(" \t\r\n");
+        return text.substr(begin, end - begin + 1);
+    }
+
+    // Comma separated, blanks and repeats dropped, order kept
+    std::vector<std::string> split_list(const std::string& text) {
+        std::vector<std::string> items;
+        std::set<std::string> seen;
+        std::stringstream stream(text);
+        std::string item;
+        while (std::getline(stream, item, ',')) {
+            item = trim(item);
+            if (!item.empty() && seen.insert(item).second) {
+                items.push_back(item);
+            }
+        }
+        return items;
+    }
+
+    bool parse_int(const std::string& text, int& value) {
+        try {
+            std::size_t used = 0;
+            int parsed = std::stoi(text, &used);
+            if (used != text.size()) return false;
+            value = parsed;
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    bool parse_double(const std::string& text, double& value) {
+        try {
+            std::size_t used = 0;
+            double parsed = std::stod(text, &used);
+            if (used != text.size()) return false;
+            value = parsed;
+            return true;
+        } catch (const std::exception&) {
+            return false;
+        }
+    }
+
+    bool parse_bool(const std::string& text, bool& value) {
+        if (text == "true" || text == "1" || text == "yes") { value = true; return true; }
+        if (text == "false" || text == "0" || text == "no") { value = false; return true; }
+        return false;
+    }
+
+    std::string join(const std::vector<std::string>& items) {
+        std::string text;
+        for (const auto& item : items) {
+            if (!text.empty()) text += ",";
+            text += item;
+        }
+        return text;
+    }
+
+    using Setter = std::function<bool(ScheduleConfig&, const std::string&)>;
+
+    Setter int_field(int ScheduleConfig::*member) {
+        return [member](ScheduleConfig& config, const std::string& value) { return parse_int(value, config.*member); };
+    }
+
+    const std::map<std::string, Setter>& setters() {
+        static const std::map<std::string, Setter> table = {
+            { "symbols", [](ScheduleConfig& config, const std::string& value) {
+                config.symbols = split_list(value);
+                return true;
+            }},
+            { "timezone", [](ScheduleConfig& config, const std::string& value) {
+                config.timezone = value;
+                return !value.empty();
+            }},
+            { "daily_hour", [](ScheduleConfig& config, const std::string& value) {
+                return parse_int(value, config.daily_hour) && config.daily_hour >= 0 && config.daily_hour < 24;
+            }},
+            { "daily_minute", [](ScheduleConfig& config, const std::string& value) {
+                return parse_int(value, config.daily_minute) && config.daily_minute >= 0 && config.daily_minute < 60;
+            }},
+            { "enabled", [](ScheduleConfig& config, const std::string& value) {
+                return parse_bool(value, config.enabled);
+            }},
+            { "trading_days", [](ScheduleConfig& config, const std::string& value) {
+                std::vector<int> days;
+                for (const auto& item : split_list(value)) {
+                    int day = 0;
+                    if (!parse_int(item, day) || day < 0 || day > 6) return false;
+                    days.push_back(day);
+                }
+                config.trading_days = days;
+                return true;
+            }},
+            { "bars_15min", int_field(&ScheduleConfig::bars_15min) },
+            { "bars_30min", int_field(&ScheduleConfig::bars_30min) },
+            { "bars_1hour", int_field(&ScheduleConfig::bars_1hour) },
+            { "bars_2hours", int_field(&ScheduleConfig::bars_2hours) },
+            { "bars_daily", int_field(&ScheduleConfig::bars_daily) },
+            { "initial_bars_daily", int_field(&ScheduleConfig::initial_bars_daily) },
+            { "recurring_bars", int_field(&ScheduleConfig::recurring_bars) },
+            { "fetch_workers", int_field(&ScheduleConfig::fetch_workers) },
+            { "max_in_flight_fetches", int_field(&ScheduleConfig::max_in_flight_fetches) },
+            { "max_queued_fetches", int_field(&ScheduleConfig::max_queued_fetches) },
+            { "recovery_lookback_days", int_field(&ScheduleConfig::recovery_lookback_days) },
+            { "state_directory", [](ScheduleConfig& config, const std::string& value) {
+                config.state_directory = value;
+                return !value.empty();
+            }},
+            { "iqfeed_requests_per_second", [](ScheduleConfig& config, const std::string& value) {
+                return parse_double(value, config.iqfeed_requests_per_second) && config.iqfeed_requests_per_second > 0;
+            }},
+            { "iqfeed_max_concurrent_requests", int_field(&ScheduleConfig::iqfeed_max_concurrent_requests) },
+            { "symbols_from_db", [](ScheduleConfig& config, const std::string& value) {
+                return parse_bool(value, config.symbols_from_db);
+            }},
+            { "config_file", [](ScheduleConfig& config, const std::string& value) {
+                config.config_file = value;
+                return true;
+            }},
+            { "config_reload_seconds", int_field(&ScheduleConfig::config_reload_seconds) },
+            { "sharded", [](ScheduleConfig& config, const std::string& value) {
+                return parse_bool(value, config.sharded);
+            }},
+            { "shard_cluster", [](ScheduleConfig& config, const std::string& value) {
+                config.shard_cluster = value;
+                return !value.empty();
+            }},
+            { "shard_member_id", [](ScheduleConfig& config, const std::string& value) {
+                config.shard_member_id = value;
+                return true;
+            }},
+            { "shard_count", [](ScheduleConfig& config, const std::string& value) {
+                return parse_int(value, config.shard_count) && config.shard_count > 0;
+            }},
+            { "shard_heartbeat_seconds", [](ScheduleConfig& config, const std::string& value) {
+                return parse_int(value, config.shard_heartbeat_seconds) && config.shard_heartbeat_seconds > 0;
+            }},
+            { "shard_member_timeout_seconds", [](ScheduleConfig& config, const std::string& value) {
+                return parse_int(value, config.shard_member_timeout_seconds) &&
+                       config.shard_member_timeout_seconds > 0;
+            }},
+            { "metrics_file", [](ScheduleConfig& config, const std::string& value) {
+                config.metrics_file = value;
+                return true;
+            }},
+            { "metrics_interval_seconds", [](ScheduleConfig& config, const std::string& value) {
+                return parse_int(value, config.metrics_interval_seconds) && config.metrics_interval_seconds > 0;
+            }},
+            { "trace_file", [](ScheduleConfig& config, const std::string& value) {
+                config.trace_file = value;
+                return true;
+            }},
+        };
+        return table;
+    }
+}
+
+// ==============================================
+// CONFIG FILE
+// ==============================================
+
+bool parse_schedule_config(std::istream& in, ScheduleConfig& config, std::string& error) {
+    ScheduleConfig parsed = config;
+    std::string line;
+    int line_number = 0;
+
+    while (std::getline(in, line)) {
+        line_number++;
+        std::size_t comment = line.find('#');
+        // '#' inside a symbol (QGC#) is not a comment: only at line start or after a blank
+        while (comment != std::string::npos && comment > 0 && line[comment - 1] != ' ' && line[comment - 1] != '\t') {
+            comment = line.find('#', comment + 1);
+        }
+        if (comment != std::string::npos) {
+            line = line.substr(0, comment);
+        }
+        line = trim(line);
+        if (line.empty()) continue;
+
+        std::size_t equals = line.find('=');
+        if (equals == std::string::npos) {
+            error = "line " + std::to_string(line_number) + ": expected key = value";
+            return false;
+        }
+        std::string key = trim(line.substr(0, equals));
+        std::string value = trim(line.substr(equals + 1));
+
+        auto setter = setters().find(key);
+        if (setter == setters().end()) {
+            error = "line " + std::to_string(line_number) + ": unknown key '" + key + "'";
+            return false;
+        }
+        if (!setter->second(parsed, value)) {
+            error = "line " + std::to_string(line_number) + ": bad value '" + value + "' for " + key;
+            return false;
+        }
+    }
+
+    config = parsed;
+    return true;
+}
+
+bool load_schedule_config_file(const std::string& path, ScheduleConfig& config, std::string& error) {
+    std::ifstream file(path);
+    if (!file) {
+        error = "cannot open " + path;
+        return false;
+    }
+    return parse_schedule_config(file, config, error);
+}
+
+std::string format_schedule_config(const ScheduleConfig& config) {
+    std::vector<std::string> days;
+    for (int day : config.trading_days) {
+        days.push_back(std::to_string(day));
+    }
+    char rate[32];
+    std::snprintf(rate, sizeof(rate), "%.15g", config.iqfeed_requests_per_second);
+
+    std::ostringstream out;
+    out << "symbols = " << join(config.symbols) << "\n"
+        << "timezone = " << config.timezone << "\n"
+        << "daily_hour = " << config.daily_hour << "\n"
+        << "daily_minute = " << config.daily_minute << "\n"
+        << "enabled = " << (config.enabled ? "true" : "false") << "\n"
+        << "trading_days = " << join(days) << "\n"
+        << "bars_15min = " << config.bars_15min << "\n"
+        << "bars_30min = " << config.bars_30min << "\n"
+        << "bars_1hour = " << config.bars_1hour << "\n"
+        << "bars_2hours = " << config.bars_2hours << "\n"
+        << "bars_daily = " << config.bars_daily << "\n"
+        << "initial_bars_daily = " << config.initial_bars_daily << "\n"
+        << "recurring_bars = " << config.recurring_bars << "\n"
+        << "fetch_workers = " << config.fetch_workers << "\n"
+        << "max_in_flight_fetches = " << config.max_in_flight_fetches << "\n"
+        << "max_queued_fetches = " << config.max_queued_fetches << "\n"
+        << "recovery_lookback_days = " << config.recovery_lookback_days << "\n"
+        << "state_directory = " << config.state_directory << "\n"
+        << "iqfeed_requests_per_second = " << rate << "\n"
+        << "iqfeed_max_concurrent_requests = " << config.iqfeed_max_concurrent_requests << "\n"
+        << "symbols_from_db = " << (config.symbols_from_db ? "true" : "false") << "\n"
+        << "config_file = " << config.config_file << "\n"
+        << "config_reload_seconds = " << config.config_reload_seconds << "\n"
+        << "sharded = " << (config.sharded ? "true" : "false") << "\n"
+        << "shard_cluster = " << config.shard_cluster << "\n"
+        << "shard_member_id = " << config.shard_member_id << "\n"
+        << "shard_count = " << config.shard_count << "\n"
+        << "shard_heartbeat_seconds = " << config.shard_heartbeat_seconds << "\n"
+        << "shard_member_timeout_seconds = " << config.shard_member_timeout_seconds << "\n"
+        << "metrics_file = " << config.metrics_file << "\n"
+        << "metrics_interval_seconds = " << config.metrics_interval_seconds << "\n"
+        << "trace_file = " << config.trace_file << "\n";
+    return out.str();
+}
+
+bool same_schedule_config(const ScheduleConfig& a, const ScheduleConfig& b) {
+    auto fields = [](const ScheduleConfig& c) {
+        return std::tie(c.symbols, c.timezone, c.daily_hour, c.daily_minute, c.enabled, c.trading_days,
+                        c.bars_15min, c.bars_30min, c.bars_1hour, c.bars_2hours, c.bars_daily,
+                        c.initial_bars_daily, c.recurring_bars, c.fetch_workers, c.max_in_flight_fetches,
+                        c.max_queued_fetches, c.recovery_lookback_days, c.state_directory,
+                        c.iqfeed_requests_per_second, c.iqfeed_max_concurrent_requests,
+                        c.symbols_from_db, c.config_file, c.config_reload_seconds, c.sharded, c.shard_cluster,
+                        c.shard_member_id, c.shard_count, c.shard_heartbeat_seconds,
+                        c.shard_member_timeout_seconds, c.metrics_file, c.metrics_interval_seconds,
+                        c.trace_file);
+    };
+    return fields(a) == fields(b);
+}
+
+// ==============================================
+// CONFIG STORE
+// ==============================================
+
+namespace {
+    std::vector<std::string> symbols_missing_from(const ScheduleConfig& from, const ScheduleConfig& in) {
+        std::set<std::string> present(in.symbols.begin(), in.symbols.end());
+        std::vector<std::string> missing;
+        for (const auto& symbol : from.symbols) {
+            if (present.find(symbol) == present.end()) {
+                missing.push_back(symbol);
+            }
+        }
+        return missing;
+    }
+}
+
+std::vector<std::string> ScheduleConfigChange::added_symbols() const {
+    if (!previous || !current || !changed()) return {};
+    return symbols_missing_from(*current, *previous);
+}
+
+std::vector<std::string> ScheduleConfigChange::removed_symbols() const {
+    if (!previous || !current || !changed()) return {};
+    return symbols_missing_from(*previous, *current);
+}
+
+ScheduleConfigStore::ScheduleConfigStore(const ScheduleConfig& initial)
+    : current_(std::make_shared<const ScheduleConfig>(initial)) {
+}
+
+std::shared_ptr<const ScheduleConfig> ScheduleConfigStore::snapshot() const {
+    return std::atomic_load(&current_);
+}
+
+ScheduleConfigChange ScheduleConfigStore::update(const std::function<bool(ScheduleConfig&)>& change) {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+
+    ScheduleConfigChange result;
+    result.previous = std::atomic_load(&current_);
+    result.current = result.previous;
+
+    auto next = std::make_shared<ScheduleConfig>(*result.previous);
+    if (!change(*next) || same_schedule_config(*next, *result.previous)) {
+        return result;
+    }
+
+    result.current = next;
+    std::atomic_store(&current_, result.current);
+    version_.fetch_add(1, std::memory_order_acq_rel);
+    return result;
+}
+
+ScheduleConfigChange ScheduleConfigStore::replace(const ScheduleConfig& config) {
+    return update([&config](ScheduleConfig& next) {
+        next = config;
+        return true;
+    });
+}
@@ -0,0 +1,135 @@
+#ifndef SCHEDULE_CONFIG_H
+#define SCHEDULE_CONFIG_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <iosfwd>
+#include <cstdint>
+#include <functional>
+
+// Scheduling configuration
+struct ScheduleConfig {
+    std::vector<std::string> symbols = {"QGC#"}; // Default symbols to fetch
+    std::string timezone = "America/New_York";   // Eastern Time
+    int daily_hour = 19;                         // 7 PM ET
+    int daily_minute = 0;                        // 00 minutes
+    bool enabled = true;
+
+    // Trading days (Sunday=0, Monday=1, ..., Thursday=4)
+    std::vector<int> trading_days = {0, 1, 2, 3, 4}; // Sun-Thu
+
+    // Number of bars to fetch for each timeframe
+    int bars_15min = 100;
+    int bars_30min = 100;
+    int bars_1hour = 100;
+    int bars_2hours = 100;
+    int bars_daily = 100;
+
+    // Add these missing members that main.cpp expects
+    int initial_bars_daily = 100;  // For initial data load
+    int recurring_bars = 1;        // For recurring fetches (latest bar only)
+
+    // Fetch executor: workers, concurrent IQFeed requests, jobs per queue
+    int fetch_workers = 4;
+    int max_in_flight_fetches = 4;
+    int max_queued_fetches = 1024;
+
+    // How far back startup recovery looks for missing bars (series not yet in the journal)
+    int recovery_lookback_days = 7;
+
+    // Journal of the newest stored bar per symbol/timeframe; restarts resume from it
+    std::string state_directory = "state";
+
+    // Shared IQFeed request limiter: ceiling rate and concurrency (AIMD backs off below it)
+    double iqfeed_requests_per_second = 10.0;
+    int iqfeed_max_concurrent_requests = 8;
+
+    // Hot reload while running: the symbol universe from the symbols table
+    // (is_active rows) and/or settings from a watched file, checked every
+    // config_reload_seconds (0 = only on reload_config())
+    bool symbols_from_db = false;
+    std::string config_file;                     // Empty: no file
+    int config_reload_seconds = 60;
+
+    // Sharded mode: scheduler processes in one shard_cluster split the
+    // symbols by consistent hashing, owning shards through PostgreSQL
+    // advisory locks and the scheduler_members heartbeat table. Read at start.
+    bool sharded = false;
+    std::string shard_cluster = "default";
+    std::string shard_member_id;                 // Empty: host:pid
+    int shard_count = 64;
+    int shard_heartbeat_seconds = 5;
+    int shard_member_timeout_seconds = 20;
+
+    // Prometheus text file rewritten every metrics_interval_seconds (for
+    // node_exporter's textfile collector or any file scraper); empty: off
+    std::string metrics_file;
+    int metrics_interval_seconds = 15;
+
+    // Chrome trace-event JSON of the most recent fetch/parse/persist spans,
+    // written when the scheduler stops; setting it turns tracing on. Empty: off
+    std::string trace_file;
+};
+
+// ==============================================
+// CONFIG FILE
+// ==============================================
+
+// "key = value" lines; '#' at the start of a line or after a blank starts
+// a comment (the one in QGC# does not). Keys are the ScheduleConfig
+// member names; lists (symbols, trading_days) are comma separated. Keys
+// the text leaves out keep their value in config. On any bad line config
+// is left untouched and error names the line.
+bool parse_schedule_config(std::istream& in, ScheduleConfig& config, std::string& error);
+bool load_schedule_config_file(const std::string& path, ScheduleConfig& config, std::string& error);
+
+// Every key in the file format; parsing the result gives back the same config
+std::string format_schedule_config(const ScheduleConfig& config);
+bool same_schedule_config(const ScheduleConfig& a, const ScheduleConfig& b);
+
+// ==============================================
+// CONFIG STORE - COPY-ON-WRITE SNAPSHOTS
+// ==============================================
+
+// Result of one update: both snapshots, identical if nothing changed
+struct ScheduleConfigChange {
+    std::shared_ptr<const ScheduleConfig> previous;
+    std::shared_ptr<const ScheduleConfig> current;
+
+    bool changed() const { return previous != current; }
+    std::vector<std::string> added_symbols() const;
+    std::vector<std::string> removed_symbols() const;
+};
+
+// RCU-style holder for the live config. Readers take a snapshot with one
+// atomic load and never wait for a writer; a job keeps using the snapshot
+// it started with, which stays alive until the last reader drops it.
+// Writers serialize on a mutex, change a private copy and publish it with
+// one atomic store, so a reader sees either the old config or the new one
+// in full, never a mix.
+class ScheduleConfigStore {
+public:
+    explicit ScheduleConfigStore(const ScheduleConfig& initial = ScheduleConfig());
+
+    ScheduleConfigStore(const ScheduleConfigStore&) = delete;
+    ScheduleConfigStore& operator=(const ScheduleConfigStore&) = delete;
+
+    std::shared_ptr<const ScheduleConfig> snapshot() const;
+
+    // change edits a copy of the current config; returning false (or
+    // leaving it equal) publishes nothing
+    ScheduleConfigChange update(const std::function<bool(ScheduleConfig&)>& change);
+    ScheduleConfigChange replace(const ScheduleConfig& config);
+
+    std::uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+private:
+    std::shared_ptr<const ScheduleConfig> current_;     // Only through std::atomic_load/atomic_store
+    std::mutex write_mutex_;
+    std::atomic<std::uint64_t> version_{0};
+};
+
+#endif // SCHEDULE_CONFIG_H
@@ -0,0 +1,311 @@
+#include "SchedulerJournal.h"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <cstdlib>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // FNV-1a; enough to tell a torn or garbled line from a whole one
+    std::string checksum(const std::string& text) {
+        std::uint32_t hash = 2166136261u;
+        for (unsigned char c : text) {
+            hash ^= c;
+            hash *= 16777619u;
+        }
+        char buffer[16];
+        std::snprintf(buffer, sizeof(buffer), "%08x", hash);
+        return buffer;
+    }
+
+    // Flush stdio and the OS cache: the record is on disk when this returns
+    bool sync_file(std::FILE* file) {
+        if (std::fflush(file) != 0) {
+            return false;
+        }
+#ifdef _WIN32
+        return _commit(_fileno(file)) == 0;
+#else
+        return fsync(fileno(file)) == 0;
+#endif
+    }
+
+    // Make a rename inside the directory durable (NTFS journals it already)
+    void sync_directory(const std::string& directory) {
+#ifndef _WIN32
+        int fd = ::open(directory.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fsync(fd);
+            ::close(fd);
+        }
+#else
+        (void)directory;
+#endif
+    }
+
+    std::string entry_key(const std::string& symbol, const std::string& timeframe) {
+        return symbol + "|" + timeframe;
+    }
+}
+
+SchedulerJournal::SchedulerJournal(const std::string& directory, std::size_t compact_after)
+    : directory_(directory), compact_after_(compact_after == 0 ? 1 : compact_after) {
+}
+
+SchedulerJournal::~SchedulerJournal() {
+    close();
+}
+
+// ==============================================
+// OPEN / CLOSE
+// ==============================================
+
+bool SchedulerJournal::open() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (journal_) {
+        return true;
+    }
+
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+    if (ec) {
+        return false;
+    }
+
+    entries_.clear();
+    discarded_records_ = 0;
+    load_file(snapshot_path());
+    load_file(journal_path());
+
+    // Folding the replayed journal into the snapshot also drops a torn tail
+    return compact_locked();
+}
+
+void SchedulerJournal::close() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (journal_) {
+        sync_file(journal_);
+        std::fclose(journal_);
+        journal_ = nullptr;
+    }
+}
+
+bool SchedulerJournal::is_open() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return journal_ != nullptr;
+}
+
+bool SchedulerJournal::load_file(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    std::size_t start = 0;
+    while (start < text.size()) {
+        std::size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            discarded_records_++;       // Torn last record: the write never completed
+            break;
+        }
+
+        JournalEntry entry;
+        if (decode(text.substr(start, end - start), entry)) {
+            apply_locked(entry);
+        } else {
+            discarded_records_++;
+        }
+        start = end + 1;
+    }
+    return true;
+}
+
+// ==============================================
+// RECORDING
+// ==============================================
+
+bool SchedulerJournal::record(const std::string& symbol, const std::string& timeframe, const std::string& last_bar,
+                              std::chrono::system_clock::time_point fetch_time) {
+    JournalEntry entry;
+    entry.symbol = symbol;
+    entry.timeframe = timeframe;
+    entry.last_bar = last_bar;
+    entry.last_fetch = std::chrono::duration_cast<std::chrono::seconds>(fetch_time.time_since_epoch()).count();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!journal_) {
+        return false;
+    }
+
+    std::string line = encode(entry);
+    if (std::fwrite(line.data(), 1, line.size(), journal_) != line.size() || !sync_file(journal_)) {
+        return false;
+    }
+
+    apply_locked(entry);
+    if (++journal_records_ >= compact_after_) {
+        return compact_locked();
+    }
+    return true;
+}
+
+// Bars only move forward: a backfill of an old gap never rewinds the entry
+void SchedulerJournal::apply_locked(const JournalEntry& entry) {
+    auto it = entries_.find(entry_key(entry.symbol, entry.timeframe));
+    if (it == entries_.end()) {
+        entries_[entry_key(entry.symbol, entry.timeframe)] = entry;
+        return;
+    }
+
+    if (entry.last_bar > it->second.last_bar) {
+        it->second.last_bar = entry.last_bar;
+    }
+    if (entry.last_fetch > it->second.last_fetch) {
+        it->second.last_fetch = entry.last_fetch;
+    }
+}
+
+// ==============================================
+// COMPACTION
+// ==============================================
+
+bool SchedulerJournal::compact() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return compact_locked();
+}
+
+// A crash before the rename leaves the old snapshot and the full journal; a
+// crash after it leaves the new snapshot and a journal it already contains.
+// Either way open() recovers the same state.
+bool SchedulerJournal::compact_locked() {
+    std::string temp_path = snapshot_path() + ".tmp";
+    std::FILE* snapshot = std::fopen(temp_path.c_str(), "wb");
+    if (!snapshot) {
+        return false;
+    }
+
+    bool written = true;
+    for (const auto& pair : entries_) {
+        std::string line = encode(pair.second);
+        written = written && std::fwrite(line.data(), 1, line.size(), snapshot) == line.size();
+    }
+    written = sync_file(snapshot) && written;
+    std::fclose(snapshot);
+
+    std::error_code ec;
+    if (!written) {
+        std::filesystem::remove(temp_path, ec);
+        return false;
+    }
+
+    std::filesystem::rename(temp_path, snapshot_path(), ec);
+    if (ec) {
+        return false;
+    }
+    sync_directory(directory_);
+
+    if (journal_) {
+        std::fclose(journal_);
+        journal_ = nullptr;
+    }
+    journal_records_ = 0;
+    return open_journal_locked("wb") && open_journal_locked("ab");
+}
+
+bool SchedulerJournal::open_journal_locked(const char* mode) {
+    if (journal_) {
+        std::fclose(journal_);
+    }
+    journal_ = std::fopen(journal_path().c_str(), mode);
+    return journal_ != nullptr;
+}
+
+// ==============================================
+// QUERIES
+// ==============================================
+
+bool SchedulerJournal::lookup(const std::string& symbol, const std::string& timeframe, JournalEntry& entry) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(entry_key(symbol, timeframe));
+    if (it == entries_.end()) {
+        return false;
+    }
+    entry = it->second;
+    return true;
+}
+
+std::vector<JournalEntry> SchedulerJournal::entries() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<JournalEntry> all;
+    for (const auto& pair : entries_) {
+        all.push_back(pair.second);
+    }
+    return all;
+}
+
+std::size_t SchedulerJournal::size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_.size();
+}
+
+std::size_t SchedulerJournal::journal_records() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return journal_records_;
+}
+
+int SchedulerJournal::discarded_records() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return discarded_records_;
+}
+
+// ==============================================
+// RECORD FORMAT
+// ==============================================
+
+std::string SchedulerJournal::encode(const JournalEntry& entry) {
+    std::string body = entry.symbol + "\t" + entry.timeframe + "\t" + entry.last_bar + "\t" +
+                       std::to_string(entry.last_fetch);
+    return body + "\t" + checksum(body) + "\n";
+}
+
+bool SchedulerJournal::decode(const std::string& line, JournalEntry& entry) {
+    std::size_t split = line.rfind('\t');
+    if (split == std::string::npos || line.substr(split + 1) != checksum(line.substr(0, split))) {
+        return false;
+    }
+
+    std::vector<std::string> fields;
+    std::stringstream body(line.substr(0, split));
+    std::string field;
+    while (std::getline(body, field, '\t')) {
+        fields.push_back(field);
+    }
+    if (fields.size() != 4 || fields[0].empty() || fields[1].empty() || fields[2].empty()) {
+        return false;
+    }
+
+    entry.symbol = fields[0];
+    entry.timeframe = fields[1];
+    entry.last_bar = fields[2];
+    entry.last_fetch = std::atoll(fields[3].c_str());
+    return true;
+}
+
+std::string SchedulerJournal::snapshot_path() const {
+    return directory_ + "/fetch_scheduler.snapshot";
+}
+
+std::string SchedulerJournal::journal_path() const {
+    return directory_ + "/fetch_scheduler.journal";
+}
@@ -0,0 +1,80 @@
+#ifndef SCHEDULER_JOURNAL_H
+#define SCHEDULER_JOURNAL_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <mutex>
+#include <cstdio>
+#include <chrono>
+
+// ==============================================
+// SCHEDULER JOURNAL - CRASH-SAFE FETCH STATE
+// ==============================================
+
+// Newest stored bar for one symbol and timeframe
+struct JournalEntry {
+    std::string symbol;
+    std::string timeframe;
+    std::string last_bar;       // Wall clock "YYYY-MM-DD HH:MM:SS" ("YYYY-MM-DD" for daily)
+    long long last_fetch = 0;   // Unix seconds of the fetch that stored it
+};
+
+// Append-only journal plus snapshot under one directory:
+//   <directory>/fetch_scheduler.snapshot   full state at the last compaction
+//   <directory>/fetch_scheduler.journal    one record per successful save since
+// Every record is flushed and synced before record() returns. Each line
+// carries a checksum, so a record torn by a crash is dropped on load rather
+// than misread. Replay keeps the newest bar per key, which makes replaying a
+// journal over a snapshot that already contains it harmless.
+class SchedulerJournal {
+public:
+    explicit SchedulerJournal(const std::string& directory = "state", std::size_t compact_after = 1000);
+    ~SchedulerJournal();
+
+    SchedulerJournal(const SchedulerJournal&) = delete;
+    SchedulerJournal& operator=(const SchedulerJournal&) = delete;
+
+    // Load snapshot and journal, then compact so appends start on a clean file
+    bool open();
+    void close();
+    bool is_open() const;
+
+    // Append one successful save; compacts every compact_after records
+    bool record(const std::string& symbol, const std::string& timeframe, const std::string& last_bar,
+                std::chrono::system_clock::time_point fetch_time = std::chrono::system_clock::now());
+
+    bool lookup(const std::string& symbol, const std::string& timeframe, JournalEntry& entry) const;
+    std::vector<JournalEntry> entries() const;
+
+    // Rewrite the snapshot (temp file + rename) and truncate the journal
+    bool compact();
+
+    std::size_t size() const;
+    std::size_t journal_records() const;     // Appended since the last compaction
+    int discarded_records() const;           // Torn or corrupt lines skipped by open()
+    const std::string& directory() const { return directory_; }
+
+    // One line per entry, tab separated, ending in a checksum of the rest
+    static std::string encode(const JournalEntry& entry);
+    static bool decode(const std::string& line, JournalEntry& entry);
+
+private:
+    bool load_file(const std::string& path);
+    void apply_locked(const JournalEntry& entry);
+    bool compact_locked();
+    bool open_journal_locked(const char* mode);
+
+    std::string snapshot_path() const;
+    std::string journal_path() const;
+
+    std::string directory_;
+    std::size_t compact_after_;
+    std::map<std::string, JournalEntry> entries_;   // "symbol|timeframe"
+    std::FILE* journal_ = nullptr;
+    std::size_t journal_records_ = 0;
+    int discarded_records_ = 0;
+    mutable std::mutex mutex_;                      // Fetch workers record concurrently
+};
+
+#endif // SCHEDULER_JOURNAL_H
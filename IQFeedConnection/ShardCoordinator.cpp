@@ -0,0 +1,316 @@
+#include "ShardCoordinator.h"
+#include "database_simple.h"
+#include <algorithm>
+#include <iterator>
+#include <cstdlib>
+#include <sstream>
+
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace {
+    std::string shard_key(int shard) {
+        return "shard:" + std::to_string(shard);
+    }
+
+    std::string int_array(const std::vector<int>& values) {
+        std::ostringstream out;
+        out << "ARRAY[";
+        for (std::size_t i = 0; i < values.size(); i++) {
+            out << (i ? "," : "") << values[i];
+        }
+        out << "]::int[]";
+        return out.str();
+    }
+}
+
+// ==============================================
+// CONSISTENT HASH RING
+// ==============================================
+
+ConsistentHashRing::ConsistentHashRing(int virtual_nodes)
+    : virtual_nodes_(std::max(1, virtual_nodes)) {
+}
+
+void ConsistentHashRing::set_members(const std::vector<std::string>& members) {
+    members_ = members;
+    std::sort(members_.begin(), members_.end());
+    members_.erase(std::unique(members_.begin(), members_.end()), members_.end());
+
+    points_.clear();
+    points_.reserve(members_.size() * virtual_nodes_);
+    for (std::size_t m = 0; m < members_.size(); m++) {
+        for (int v = 0; v < virtual_nodes_; v++) {
+            points_.emplace_back(hash(members_[m] + "#" + std::to_string(v)), m);
+        }
+    }
+    std::sort(points_.begin(), points_.end());
+}
+
+const std::string& ConsistentHashRing::owner(std::uint64_t hash) const {
+    static const std::string none;
+    if (points_.empty()) {
+        return none;
+    }
+
+    auto it = std::lower_bound(points_.begin(), points_.end(), std::make_pair(hash, std::size_t(0)));
+    if (it == points_.end()) {
+        it = points_.begin();                               // Wrap around
+    }
+    return members_[it->second];
+}
+
+std::uint64_t ConsistentHashRing::hash(const std::string& key) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (unsigned char c : key) {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    // FNV alone clusters similar keys ("m#1", "m#2"); mix the bits
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+// ==============================================
+// COORDINATOR
+// ==============================================
+
+ShardCoordinator::ShardCoordinator(std::shared_ptr<SimpleDatabaseManager> db, const ShardConfig& config)
+    : db_(db), config_(config), ring_(config.virtual_nodes) {
+    config_.shard_count = std::max(1, config_.shard_count);
+    config_.member_timeout_seconds = std::max(1, config_.member_timeout_seconds);
+    member_id_ = config_.member_id.empty() ? default_member_id() : config_.member_id;
+    lock_namespace_ = lock_namespace(config_.cluster);
+    held_.assign(config_.shard_count, false);
+}
+
+ShardCoordinator::~ShardCoordinator() {
+    leave();
+}
+
+std::string ShardCoordinator::default_member_id() {
+    const char* host = std::getenv("COMPUTERNAME");
+    if (!host) host = std::getenv("HOSTNAME");
+#ifdef _WIN32
+    int pid = _getpid();
+#else
+    int pid = static_cast<int>(getpid());
+#endif
+    return std::string(host ? host : "localhost") + ":" + std::to_string(pid);
+}
+
+int ShardCoordinator::lock_namespace(const std::string& cluster) {
+    return static_cast<int>(ConsistentHashRing::hash("nexday-scheduler:" + cluster) & 0x7FFFFFFF);
+}
+
+bool ShardCoordinator::heartbeat(ShardAssignment* assignment) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ShardAssignment local;
+    ShardAssignment& result = assignment ? *assignment : local;
+    result = ShardAssignment();
+
+    if (heartbeat_locked(result)) {
+        return true;
+    }
+
+    // Unsure what the session still holds: stop fetching everything
+    for (int shard = 0; shard < config_.shard_count; shard++) {
+        if (held_[shard]) result.released.push_back(shard);
+    }
+    drop_all_locked();
+    return false;
+}
+
+bool ShardCoordinator::heartbeat_locked(ShardAssignment& assignment) {
+    if (!db_) {
+        last_error_ = "No database";
+        return false;
+    }
+
+    // A reset connection is a new session: whatever it held is gone
+    if (db_->connection_ && PQstatus(db_->connection_) == CONNECTION_BAD) {
+        PQreset(db_->connection_);
+        std::fill(held_.begin(), held_.end(), false);
+        leader_ = false;
+    }
+    if ((!db_->is_connected() && !db_->test_connection()) ||
+        (db_->connection_ && PQstatus(db_->connection_) != CONNECTION_OK)) {
+        last_error_ = "Database unreachable: " + db_->get_last_error();
+        return false;
+    }
+
+    const std::string cluster = "'" + db_->escape_string(config_.cluster) + "'";
+    const std::string timeout = "make_interval(secs => " + std::to_string(config_.member_timeout_seconds) + ")";
+
+    std::ostringstream upsert;
+    upsert << "INSERT INTO scheduler_members (cluster, member_id, backend_pid) VALUES (" << cluster << ", '"
+           << db_->escape_string(member_id_) << "', pg_backend_pid()) "
+           << "ON CONFLICT (cluster, member_id) DO UPDATE SET heartbeat_at = now(), backend_pid = pg_backend_pid()";
+    if (!db_->execute_query(upsert.str())) {
+        last_error_ = "Heartbeat failed: " + db_->get_last_error();
+        return false;
+    }
+
+    // Leadership: only the lock holder expires rows, so a stale member is
+    // dropped once however many processes notice it
+    if (!leader_) {
+        PGresult* result = db_->execute_query_with_result(
+            "SELECT pg_try_advisory_lock(" + std::to_string(lock_namespace_) + ", -1)");
+        if (!result) {
+            last_error_ = "Leader lock failed: " + db_->get_last_error();
+            return false;
+        }
+        leader_ = PQntuples(result) == 1 && std::string(PQgetvalue(result, 0, 0)) == "t";
+        PQclear(result);
+    }
+    if (leader_ && !db_->execute_query("DELETE FROM scheduler_members WHERE cluster = " + cluster +
+                                       " AND heartbeat_at < now() - " + timeout)) {
+        last_error_ = "Expiring members failed: " + db_->get_last_error();
+        return false;
+    }
+
+    PGresult* result = db_->execute_query_with_result(
+        "SELECT member_id FROM scheduler_members WHERE cluster = " + cluster +
+        " AND heartbeat_at >= now() - " + timeout + " ORDER BY member_id");
+    if (!result) {
+        last_error_ = "Reading members failed: " + db_->get_last_error();
+        return false;
+    }
+    std::vector<std::string> members;
+    for (int i = 0; i < PQntuples(result); i++) {
+        members.push_back(PQgetvalue(result, i, 0));
+    }
+    PQclear(result);
+    if (std::find(members.begin(), members.end(), member_id_) == members.end()) {
+        members.push_back(member_id_);
+    }
+
+    std::vector<std::string> sorted = members;
+    std::sort(sorted.begin(), sorted.end());
+    assignment.membership_changed = sorted != ring_.members();
+    if (assignment.membership_changed) {
+        ring_.set_members(sorted);
+    }
+
+    // Let go first, so a shard moving between two members is never wanted twice by us
+    std::vector<int> release;
+    std::vector<int> acquire;
+    for (int shard = 0; shard < config_.shard_count; shard++) {
+        bool ours = ring_.owner_of(shard_key(shard)) == member_id_;
+        if (held_[shard] && !ours) release.push_back(shard);
+        if (!held_[shard] && ours) acquire.push_back(shard);
+    }
+
+    std::vector<int> unlocked;
+    if (!release.empty() && !query_shards("pg_advisory_unlock", release, unlocked)) {
+        return false;
+    }
+    for (int shard : release) {
+        held_[shard] = false;                  // Not holding it either way
+    }
+    assignment.released = release;
+
+    std::vector<int> locked;
+    if (!acquire.empty() && !query_shards("pg_try_advisory_lock", acquire, locked)) {
+        return false;
+    }
+    for (int shard : locked) {
+        held_[shard] = true;
+    }
+    assignment.gained = locked;
+    std::set_difference(acquire.begin(), acquire.end(), locked.begin(), locked.end(),
+                        std::back_inserter(assignment.pending));
+    return true;
+}
+
+// Runs function(namespace, shard) for every shard; returns those it was true for
+bool ShardCoordinator::query_shards(const std::string& function, const std::vector<int>& shards,
+                                    std::vector<int>& succeeded) {
+    PGresult* result = db_->execute_query_with_result(
+        "SELECT s FROM unnest(" + int_array(shards) + ") AS s WHERE " + function + "(" +
+        std::to_string(lock_namespace_) + ", s) ORDER BY s");
+    if (!result) {
+        last_error_ = function + " failed: " + db_->get_last_error();
+        return false;
+    }
+    for (int i = 0; i < PQntuples(result); i++) {
+        succeeded.push_back(std::atoi(PQgetvalue(result, i, 0)));
+    }
+    PQclear(result);
+    return true;
+}
+
+void ShardCoordinator::drop_all_locked() {
+    if (db_ && db_->is_connected()) {
+        PGresult* result = db_->execute_query_with_result("SELECT pg_advisory_unlock_all()");
+        if (result) PQclear(result);
+    }
+    std::fill(held_.begin(), held_.end(), false);
+    leader_ = false;
+}
+
+void ShardCoordinator::leave() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (db_ && db_->is_connected()) {
+        db_->execute_query("DELETE FROM scheduler_members WHERE cluster = '" + db_->escape_string(config_.cluster) +
+                           "' AND member_id = '" + db_->escape_string(member_id_) + "'");
+    }
+    drop_all_locked();
+    ring_.set_members({});
+}
+
+// ==============================================
+// OWNERSHIP QUERIES
+// ==============================================
+
+int ShardCoordinator::shard_of(const std::string& symbol) const {
+    return static_cast<int>(ConsistentHashRing::hash(symbol) % static_cast<std::uint64_t>(config_.shard_count));
+}
+
+bool ShardCoordinator::owns(const std::string& symbol) const {
+    int shard = shard_of(symbol);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return held_[shard];
+}
+
+std::vector<std::string> ShardCoordinator::owned(const std::vector<std::string>& symbols) const {
+    std::vector<std::string> result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& symbol : symbols) {
+        if (held_[shard_of(symbol)]) {
+            result.push_back(symbol);
+        }
+    }
+    return result;
+}
+
+std::vector<int> ShardCoordinator::owned_shards() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<int> shards;
+    for (int shard = 0; shard < config_.shard_count; shard++) {
+        if (held_[shard]) shards.push_back(shard);
+    }
+    return shards;
+}
+
+std::vector<std::string> ShardCoordinator::members() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return ring_.members();
+}
+
+bool ShardCoordinator::is_leader() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return leader_;
+}
+
+std::string ShardCoordinator::last_error() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return last_error_;
+}
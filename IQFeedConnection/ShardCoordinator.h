@@ -0,0 +1,113 @@
+#ifndef SHARD_COORDINATOR_H
+#define SHARD_COORDINATOR_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <cstdint>
+#include <utility>
+
+class SimpleDatabaseManager;
+
+// ==============================================
+// SHARD COORDINATOR - SYMBOLS SPLIT ACROSS SCHEDULER PROCESSES
+// ==============================================
+
+// Consistent hash ring: each member is placed at virtual_nodes points and a
+// key belongs to the first point clockwise from its hash. A member joining
+// or leaving only moves the keys next to its own points, about 1/N of them.
+class ConsistentHashRing {
+public:
+    explicit ConsistentHashRing(int virtual_nodes = 64);
+
+    // Order and duplicates do not matter; the same set gives the same ring
+    void set_members(const std::vector<std::string>& members);
+    const std::vector<std::string>& members() const { return members_; }
+
+    const std::string& owner(std::uint64_t hash) const;         // "" with no members
+    const std::string& owner_of(const std::string& key) const { return owner(hash(key)); }
+
+    // FNV-1a with a 64-bit finalizer; stable across processes and platforms
+    static std::uint64_t hash(const std::string& key);
+
+private:
+    int virtual_nodes_;
+    std::vector<std::string> members_;                           // Sorted
+    std::vector<std::pair<std::uint64_t, std::size_t>> points_;  // (hash, member index), sorted
+};
+
+struct ShardConfig {
+    std::string cluster = "default";        // Processes sharing a cluster split its symbols
+    std::string member_id;                  // Empty: host:pid
+    int shard_count = 64;                   // Symbols hash onto these; the ring assigns them
+    int virtual_nodes = 64;
+    int member_timeout_seconds = 20;        // No heartbeat for this long: dropped from the ring
+};
+
+// What one heartbeat changed
+struct ShardAssignment {
+    std::vector<int> gained;                // Locked this heartbeat: start fetching
+    std::vector<int> released;              // Moved to another member
+    std::vector<int> pending;               // Ours by the ring, still locked by the previous owner
+    bool membership_changed = false;
+};
+
+// Each scheduler process runs one coordinator on its own connection (the
+// advisory locks belong to that session). On every heartbeat it:
+//   1. upserts its row in scheduler_members (heartbeat_at = now())
+//   2. the leader - whoever holds the cluster's leader advisory lock -
+//      deletes rows whose heartbeat is older than member_timeout_seconds
+//   3. builds the ring from the live rows and, per shard, unlocks the ones
+//      the ring moved away and pg_try_advisory_lock()s the ones it moved in
+// A shard is fetched only by the session holding its lock, so two members
+// never fetch the same symbols even while they disagree about membership:
+// the new owner waits until the old one has seen the change and let go. A
+// crashed process loses its locks with its session, and its row expires.
+class ShardCoordinator {
+public:
+    ShardCoordinator(std::shared_ptr<SimpleDatabaseManager> db, const ShardConfig& config);
+    ~ShardCoordinator();
+
+    ShardCoordinator(const ShardCoordinator&) = delete;
+    ShardCoordinator& operator=(const ShardCoordinator&) = delete;
+
+    // False if the database could not be reached; all shards are then dropped
+    bool heartbeat(ShardAssignment* assignment = nullptr);
+
+    // Delete our row and release every lock, so others rebalance at once
+    void leave();
+
+    int shard_of(const std::string& symbol) const;
+    bool owns(const std::string& symbol) const;
+    std::vector<std::string> owned(const std::vector<std::string>& symbols) const;
+    std::vector<int> owned_shards() const;
+    std::vector<std::string> members() const;
+    bool is_leader() const;
+
+    const std::string& member_id() const { return member_id_; }
+    int shard_count() const { return config_.shard_count; }
+    std::string last_error() const;
+
+    static std::string default_member_id();
+    // Advisory lock key space of a cluster (first int4 of the two-key form)
+    static int lock_namespace(const std::string& cluster);
+
+private:
+    bool heartbeat_locked(ShardAssignment& assignment);
+    bool query_shards(const std::string& function, const std::vector<int>& shards, std::vector<int>& succeeded);
+    void drop_all_locked();
+
+    std::shared_ptr<SimpleDatabaseManager> db_;
+    ShardConfig config_;
+    std::string member_id_;
+    int lock_namespace_;
+
+    mutable std::mutex mutex_;
+    ConsistentHashRing ring_;
+    std::vector<bool> held_;                // By shard: we hold its advisory lock
+    bool leader_ = false;
+    std::string last_error_;
+};
+
+#endif // SHARD_COORDINATOR_H
@@ -0,0 +1,167 @@
+#include "TimerQueue.h"
+#include <algorithm>
+
+// ==============================================
+// JOB REGISTRATION
+// ==============================================
+
+int TimerQueue::add_job(const std::string& name, NextDeadline next_deadline, Action action) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    Job job;
+    job.name = name;
+    job.next_deadline = std::move(next_deadline);
+    job.action = std::move(action);
+    job.drift = &registry_.histogram("nexday_timer_drift_seconds", "Timer job start minus its deadline",
+                                     { { "job", name } }, MetricsRegistry::wait_buckets());
+    jobs_.push_back(std::move(job));
+
+    int job_id = static_cast<int>(jobs_.size() - 1);
+    push_locked(job_id, jobs_[job_id].next_deadline(Clock::now()));
+    wakeup_.notify_all();
+    return job_id;
+}
+
+void TimerQueue::set_drift_handler(DriftHandler handler) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    drift_handler_ = std::move(handler);
+}
+
+// ==============================================
+// RUN LOOP
+// ==============================================
+
+void TimerQueue::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    while (!stopped_) {
+        if (changed_) {
+            rebuild_locked();
+            changed_ = false;
+        }
+
+        if (heap_.empty()) {
+            wakeup_.wait(lock, [this] { return stopped_ || changed_ || !heap_.empty(); });
+            continue;
+        }
+
+        const Entry next = heap_.front();
+        if (Clock::now() < next.deadline) {
+            // Also wakes early for stop(), reschedule() and newly added earlier jobs
+            wakeup_.wait_until(lock, next.deadline, [this, &next] {
+                return stopped_ || changed_ || heap_.front().deadline < next.deadline ||
+                       Clock::now() >= next.deadline;
+            });
+            continue;
+        }
+
+        std::pop_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+        heap_.pop_back();
+
+        // Copies, so add_job() may grow jobs_ while the action runs
+        Job& job = jobs_[next.job_id];
+        const std::string name = job.name;
+        const Action action = job.action;
+        const NextDeadline next_deadline = job.next_deadline;
+        Histogram* drift = job.drift;
+        const DriftHandler drift_handler = drift_handler_;
+
+        lock.unlock();
+
+        auto lateness = Clock::now() - next.deadline;
+        drift->observe(lateness);
+        if (drift_handler) drift_handler(name, lateness);
+
+        action(next.deadline);
+
+        // Missed deadlines are skipped rather than replayed back to back
+        auto following = next_deadline(std::max(next.deadline, Clock::now()));
+
+        lock.lock();
+        if (!changed_) {
+            push_locked(next.job_id, following);
+        } else {
+            jobs_[next.job_id].deadline = following;  // Not due: rebuild_locked() recomputes it
+        }
+    }
+}
+
+void TimerQueue::stop() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopped_ = true;
+    }
+    wakeup_.notify_all();
+}
+
+void TimerQueue::reschedule() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        changed_ = true;
+    }
+    wakeup_.notify_all();
+}
+
+// ==============================================
+// HEAP MAINTENANCE
+// ==============================================
+
+void TimerQueue::push_locked(int job_id, Clock::time_point deadline) {
+    jobs_[job_id].deadline = deadline;
+    heap_.push_back({ deadline, job_id });
+    std::push_heap(heap_.begin(), heap_.end(), std::greater<Entry>());
+}
+
+// Deadlines that came due before the rebuild (e.g. while an action ran) are
+// kept, so they still run; only the ones still ahead are recomputed
+void TimerQueue::rebuild_locked() {
+    heap_.clear();
+    auto now = Clock::now();
+    for (std::size_t i = 0; i < jobs_.size(); i++) {
+        Clock::time_point previous = jobs_[i].deadline;
+        push_locked(static_cast<int>(i), previous <= now ? previous : jobs_[i].next_deadline(now));
+    }
+}
+
+// ==============================================
+// STATUS
+// ==============================================
+
+bool TimerQueue::is_stopped() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stopped_;
+}
+
+std::size_t TimerQueue::job_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return jobs_.size();
+}
+
+TimerQueue::Clock::time_point TimerQueue::next_deadline(int job_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (job_id < 0 || job_id >= static_cast<int>(jobs_.size())) return Clock::time_point();
+    return jobs_[job_id].deadline;
+}
+
+TimerQueue::Clock::time_point TimerQueue::next_deadline(const std::string& name) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    for (const auto& job : jobs_) {
+        if (job.name == name) return job.deadline;
+    }
+    return Clock::time_point();
+}
+
+const Histogram* TimerQueue::drift(int job_id) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (job_id < 0 || job_id >= static_cast<int>(jobs_.size())) return nullptr;
+    return jobs_[job_id].drift;
+}
+
+std::vector<std::string> TimerQueue::job_names() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<std::string> names;
+    for (const auto& job : jobs_) {
+        names.push_back(job.name);
+    }
+    return names;
+}
@@ -0,0 +1,94 @@
+#ifndef TIMER_QUEUE_H
+#define TIMER_QUEUE_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <mutex>
+#include <functional>
+#include <condition_variable>
+#include "MetricsRegistry.h"
+
+// ==============================================
+// TIMER QUEUE - DEADLINE-DRIVEN RECURRING JOBS
+// ==============================================
+
+// Recurring jobs, each with a function that gives its next deadline. The
+// pending deadlines sit in a min-heap and run() sleeps with
+// condition_variable::wait_until until the earliest one is due, so a job
+// starts at its deadline instead of at the next polling tick. stop() and
+// reschedule() wake the loop at once.
+//
+// Drift (actual start minus deadline) is recorded per job, in the registry
+// histogram nexday_timer_drift_seconds{job="..."}. A job that falls behind
+// is not run once per missed deadline: its next deadline is computed from
+// the time it actually ran.
+class TimerQueue {
+public:
+    using Clock = std::chrono::system_clock;     // Bar closes are wall-clock instants
+    using NextDeadline = std::function<Clock::time_point(Clock::time_point after)>;
+    using Action = std::function<void(Clock::time_point deadline)>;
+    using DriftHandler = std::function<void(const std::string& job, Clock::duration drift)>;
+
+    explicit TimerQueue(MetricsRegistry& registry = MetricsRegistry::instance()) : registry_(registry) {}
+    TimerQueue(const TimerQueue&) = delete;
+    TimerQueue& operator=(const TimerQueue&) = delete;
+
+    // Register a job; its first deadline is next_deadline(now). Returns its id.
+    int add_job(const std::string& name, NextDeadline next_deadline, Action action);
+
+    // Run due jobs on the calling thread until stop()
+    void run();
+
+    // Wake run() and make it return once the current job (if any) finishes
+    void stop();
+
+    // Recompute every deadline from now (e.g. after a configuration change)
+    void reschedule();
+
+    // Called after each job start with its drift (for logging)
+    void set_drift_handler(DriftHandler handler);
+
+    bool is_stopped() const;
+    std::size_t job_count() const;
+
+    // Earliest pending deadline of a job; Clock::time_point() if unknown
+    Clock::time_point next_deadline(int job_id) const;
+    Clock::time_point next_deadline(const std::string& name) const;
+
+    // Drift samples of one job (seconds), or null for an unknown id
+    const Histogram* drift(int job_id) const;
+    std::vector<std::string> job_names() const;
+
+private:
+    struct Job {
+        std::string name;
+        NextDeadline next_deadline;
+        Action action;
+        Clock::time_point deadline;
+        Histogram* drift = nullptr;         // Owned by the registry
+    };
+
+    struct Entry {
+        Clock::time_point deadline;
+        int job_id;
+
+        bool operator>(const Entry& other) const { return deadline > other.deadline; }
+    };
+
+    void push_locked(int job_id, Clock::time_point deadline);
+    void rebuild_locked();
+
+    MetricsRegistry& registry_;
+    std::vector<Job> jobs_;
+    std::vector<Entry> heap_;          // std::push_heap/pop_heap with std::greater: earliest on top
+    bool stopped_ = false;
+    bool changed_ = false;
+    DriftHandler drift_handler_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wakeup_;
+};
+
+#endif // TIMER_QUEUE_H
@@ -0,0 +1,225 @@
+#include "Tracer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace {
+    constexpr std::size_t DEFAULT_PER_THREAD_CAPACITY = 65536;
+    constexpr int TRACE_PID = 1;                    // One process per trace file
+
+    std::string json_escape(const std::string& text) {
+        std::string escaped;
+        escaped.reserve(text.size());
+        for (char c : text) {
+            switch (c) {
+                case '"':  escaped += "\\\""; break;
+                case '\\': escaped += "\\\\"; break;
+                case '\n': escaped += "\\n"; break;
+                case '\r': escaped += "\\r"; break;
+                case '\t': escaped += "\\t"; break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char code[8];
+                        std::snprintf(code, sizeof(code), "\\u%04x", static_cast<unsigned char>(c));
+                        escaped += code;
+                    } else {
+                        escaped += c;
+                    }
+            }
+        }
+        return escaped;
+    }
+
+    // Trace-event timestamps are microseconds; keep the nanoseconds as decimals
+    std::string microseconds(std::int64_t ns) {
+        char text[32];
+        std::snprintf(text, sizeof(text), "%lld.%03lld", static_cast<long long>(ns / 1000),
+                      static_cast<long long>(ns % 1000));
+        return text;
+    }
+}
+
+std::atomic<bool> Tracer::enabled_{false};
+
+Tracer& Tracer::instance() {
+    static Tracer tracer;
+    return tracer;
+}
+
+Tracer::Tracer()
+    : epoch_(std::chrono::steady_clock::now()), per_thread_capacity_(DEFAULT_PER_THREAD_CAPACITY) {
+    const char* path = std::getenv("NEXDAY_TRACE_FILE");
+    if (path && *path) {
+        output_path_ = path;
+        set_enabled(true);
+    }
+}
+
+Tracer::ThreadBuffer& Tracer::local_buffer() {
+    thread_local std::shared_ptr<ThreadBuffer> buffer;
+    if (!buffer) {
+        buffer = std::make_shared<ThreadBuffer>();
+        buffer->capacity = std::max<std::size_t>(1, per_thread_capacity_.load(std::memory_order_relaxed));
+        std::lock_guard<std::mutex> lock(buffers_mutex_);
+        buffer->tid = static_cast<std::uint32_t>(buffers_.size() + 1);
+        buffers_.push_back(buffer);
+    }
+    return *buffer;
+}
+
+// ==============================================
+// RECORDING
+// ==============================================
+
+void Tracer::record(const char* category, const char* name, std::chrono::steady_clock::time_point start,
+                    std::chrono::steady_clock::time_point end, const std::string& symbol,
+                    const std::string& timeframe) {
+    ThreadBuffer& buffer = local_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+
+    TraceEvent* slot;
+    if (buffer.ring.size() < buffer.capacity) {
+        buffer.ring.emplace_back();
+        slot = &buffer.ring.back();
+    } else {
+        slot = &buffer.ring[buffer.next];
+        buffer.overwritten++;
+    }
+    buffer.next = (buffer.next + 1) % buffer.capacity;
+
+    slot->name = name;
+    slot->category = category;
+    slot->start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(start - epoch_).count();
+    slot->duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    slot->symbol = symbol;                          // Reuses the slot's storage once the ring wraps
+    slot->timeframe = timeframe;
+}
+
+void Tracer::set_thread_name(const std::string& name) {
+    ThreadBuffer& buffer = local_buffer();
+    std::lock_guard<std::mutex> lock(buffer.mutex);
+    buffer.thread_name = name;
+}
+
+void Tracer::set_per_thread_capacity(std::size_t capacity) {
+    per_thread_capacity_.store(std::max<std::size_t>(1, capacity), std::memory_order_relaxed);
+}
+
+void Tracer::clear() {
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    for (const auto& buffer : buffers_) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        buffer->ring.clear();
+        buffer->next = 0;
+        buffer->overwritten = 0;
+    }
+}
+
+TracerStats Tracer::stats() const {
+    TracerStats stats;
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    stats.threads = buffers_.size();
+    for (const auto& buffer : buffers_) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        stats.events += buffer->ring.size();
+        stats.overwritten += buffer->overwritten;
+    }
+    return stats;
+}
+
+std::vector<TraceEvent> Tracer::events() const {
+    std::vector<TraceEvent> all;
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    for (const auto& buffer : buffers_) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        all.insert(all.end(), buffer->ring.begin(), buffer->ring.end());
+    }
+    std::sort(all.begin(), all.end(), [](const TraceEvent& a, const TraceEvent& b) {
+        return a.start_ns < b.start_ns;
+    });
+    return all;
+}
+
+// ==============================================
+// CHROME TRACE EXPORT
+// ==============================================
+
+std::string Tracer::chrome_trace_json() const {
+    std::ostringstream out;
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    bool first = true;
+    auto separator = [&]() {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    std::lock_guard<std::mutex> lock(buffers_mutex_);
+    for (const auto& buffer : buffers_) {
+        std::lock_guard<std::mutex> buffer_lock(buffer->mutex);
+        if (!buffer->thread_name.empty()) {
+            separator();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << TRACE_PID << ",\"tid\":" << buffer->tid
+                << ",\"args\":{\"name\":\"" << json_escape(buffer->thread_name) << "\"}}";
+        }
+
+        // Oldest first once the ring has wrapped
+        std::size_t count = buffer->ring.size();
+        std::size_t oldest = count < buffer->capacity ? 0 : buffer->next;
+        for (std::size_t i = 0; i < count; i++) {
+            const TraceEvent& event = buffer->ring[(oldest + i) % count];
+            separator();
+            out << "{\"name\":\"" << json_escape(event.name) << "\",\"cat\":\"" << json_escape(event.category)
+                << "\",\"ph\":\"X\",\"ts\":" << microseconds(event.start_ns)
+                << ",\"dur\":" << microseconds(event.duration_ns) << ",\"pid\":" << TRACE_PID
+                << ",\"tid\":" << buffer->tid;
+            if (!event.symbol.empty() || !event.timeframe.empty()) {
+                out << ",\"args\":{";
+                if (!event.symbol.empty()) {
+                    out << "\"symbol\":\"" << json_escape(event.symbol) << "\"";
+                }
+                if (!event.timeframe.empty()) {
+                    out << (event.symbol.empty() ? "" : ",") << "\"timeframe\":\"" << json_escape(event.timeframe)
+                        << "\"";
+                }
+                out << "}";
+            }
+            out << "}";
+        }
+    }
+    out << "\n]}\n";
+    return out.str();
+}
+
+bool Tracer::write_chrome_trace(const std::string& path, std::string& error) const {
+    std::string text = chrome_trace_json();
+    std::filesystem::path target(path);
+    std::filesystem::path temp_path = target;
+    temp_path += ".tmp";
+
+    std::error_code ec;
+    if (target.has_parent_path()) {
+        std::filesystem::create_directories(target.parent_path(), ec);
+    }
+    {
+        std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+        if (!out.is_open()) {
+            error = "Cannot open " + temp_path.string();
+            return false;
+        }
+        out << text;
+        out.flush();
+        if (!out) {
+            error = "Write failed: " + temp_path.string();
+            return false;
+        }
+    }
+    std::filesystem::rename(temp_path, target, ec);
+    if (ec) {
+        error = "Rename to " + path + " failed: " + ec.message();
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,156 @@
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+
+// Set to 0 from CMake to compile every span out; the tracer itself stays
+#ifndef NEXDAY_TRACING
+#define NEXDAY_TRACING 1
+#endif
+
+// ==============================================
+// PIPELINE TRACER - SPANS TO CHROME TRACE JSON
+// ==============================================
+
+// One finished span. name and category are string literals; only the tags
+// are copied, and symbols and timeframes fit the small-string buffer.
+struct TraceEvent {
+    const char* name = "";
+    const char* category = "";
+    std::int64_t start_ns = 0;              // Since the tracer's epoch
+    std::int64_t duration_ns = 0;
+    std::string symbol;
+    std::string timeframe;
+};
+
+struct TracerStats {
+    std::size_t threads = 0;
+    std::size_t events = 0;                 // Held in the buffers now
+    std::uint64_t overwritten = 0;          // Oldest events a full buffer replaced
+};
+
+// Process-wide span recorder. Each thread writes finished spans into its
+// own ring buffer (the buffer's mutex is only ever contended by an export),
+// so fetch workers never share a cache line. When tracing is off a span is
+// one relaxed load. A full buffer overwrites its oldest events: the export
+// holds the most recent per_thread_capacity spans of every thread.
+//
+// Off by default; NEXDAY_TRACE_FILE in the environment turns it on at start
+// and names the file output_path() returns.
+class Tracer {
+public:
+    static Tracer& instance();
+
+    static bool enabled() { return enabled_.load(std::memory_order_relaxed); }
+    static void set_enabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+
+    void record(const char* category, const char* name, std::chrono::steady_clock::time_point start,
+                std::chrono::steady_clock::time_point end, const std::string& symbol, const std::string& timeframe);
+
+    // Shown as the thread's row label in the viewer
+    void set_thread_name(const std::string& name);
+
+    // Applies to buffers created afterwards; default 65536 events per thread
+    void set_per_thread_capacity(std::size_t capacity);
+
+    // Trace-event JSON ("X" complete events plus thread names) for
+    // chrome://tracing or ui.perfetto.dev; timestamps in microseconds
+    std::string chrome_trace_json() const;
+
+    // Temporary file renamed over path, like the metrics export
+    bool write_chrome_trace(const std::string& path, std::string& error) const;
+
+    // Drop every buffered event; threads keep their buffers
+    void clear();
+
+    TracerStats stats() const;
+    std::vector<TraceEvent> events() const;
+
+    // NEXDAY_TRACE_FILE, or empty
+    const std::string& output_path() const { return output_path_; }
+
+private:
+    struct ThreadBuffer {
+        std::mutex mutex;
+        std::vector<TraceEvent> ring;
+        std::size_t capacity = 0;
+        std::size_t next = 0;               // Slot the next event goes in
+        std::uint64_t overwritten = 0;
+        std::uint32_t tid = 0;
+        std::string thread_name;
+    };
+
+    Tracer();
+    ThreadBuffer& local_buffer();
+
+    static std::atomic<bool> enabled_;
+
+    std::chrono::steady_clock::time_point epoch_;
+    std::string output_path_;
+    std::atomic<std::size_t> per_thread_capacity_;
+
+    mutable std::mutex buffers_mutex_;
+    // Shared so a thread's spans outlive the thread until exported
+    std::vector<std::shared_ptr<ThreadBuffer>> buffers_;
+};
+
+// Records the time from construction to destruction as one span. Tags are
+// only copied when tracing is on; with NEXDAY_TRACING 0 a span is dead code.
+class TraceSpan {
+public:
+    TraceSpan(const char* category, const char* name)
+        : TraceSpan(category, name, empty_tag(), empty_tag()) {}
+    TraceSpan(const char* category, const char* name, const std::string& symbol,
+              const std::string& timeframe = empty_tag())
+        : category_(category), name_(name), active_(NEXDAY_TRACING && Tracer::enabled()) {
+        if (active_) {
+            symbol_ = symbol;
+            timeframe_ = timeframe;
+            start_ = std::chrono::steady_clock::now();
+        }
+    }
+    ~TraceSpan() { end(); }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+
+    // Close the span now instead of at scope exit; later calls do nothing
+    void end() {
+        if (active_) {
+            active_ = false;
+            Tracer::instance().record(category_, name_, start_, std::chrono::steady_clock::now(),
+                                      symbol_, timeframe_);
+        }
+    }
+
+private:
+    static const std::string& empty_tag() {
+        static const std::string empty;
+        return empty;
+    }
+
+    const char* category_;
+    const char* name_;
+    bool active_;
+    std::string symbol_;
+    std::string timeframe_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// NEXDAY_TRACE_SPAN("iqfeed", "parse", symbol, period_name) traces the rest
+// of the enclosing scope; the symbol and timeframe arguments are optional
+#define NEXDAY_TRACE_CONCAT_INNER(a, b) a##b
+#define NEXDAY_TRACE_CONCAT(a, b) NEXDAY_TRACE_CONCAT_INNER(a, b)
+
+#define NEXDAY_TRACE_SPAN(...) TraceSpan NEXDAY_TRACE_CONCAT(nexday_trace_span_, __LINE__)(__VA_ARGS__)
+
+#endif // TRACER_H
@@ -4,10 +4,12 @@
 #include <chrono>
 #include <thread>
 #include <iomanip>
+#include <filesystem>
 
 // Existing includes
 #include "IQFeedConnectionManager.h"
 #include "FetchScheduler.h"
+#include "BarEventBus.h"
 #include "database_simple.h"
 #include "DailyDataFetcher.h"
 #include "FifteenMinDataFetcher.h"
@@ -21,6 +23,7 @@
 #include "MarketPrediction.h"
 #include "PredictionTypes.h"
 #include "BusinessDayCalculator.h"
+#include "PredictionTrigger.h"
 
 int main() {
     std::cout << "\n==============================================\n";
@@ -90,8 +93,19 @@ int main() {
         config.initial_bars_daily = 100;
         config.recurring_bars = 1;
         
+        // Optional overrides, reloaded while running; one per process in sharded mode
+        // (e.g. "sharded = true", "symbols_from_db = true", "shard_member_id = node-1")
+        if (std::filesystem::exists("fetch_scheduler.conf")) {
+            config.config_file = "fetch_scheduler.conf";
+        }
+        
         scheduler.set_config(config);
         
+        // Event-driven predictions: every newly saved bar triggers its next-interval prediction
+        auto bar_event_bus = std::make_shared<BarEventBus>();
+        scheduler.set_event_bus(bar_event_bus);
+        PredictionTrigger prediction_trigger(*prediction_engine, bar_event_bus);
+        
         std::cout << "4. System Ready - Complete Pipeline Available" << std::endl;
         std::cout << "   - Symbols: QGC# (Gold Futures)" << std::endl;
         std::cout << "   - Model: Epoch Market Advisor (EMA-based)" << std::endl;
@@ -114,6 +128,7 @@ int main() {
             std::cout << "18. Generate predictions for all symbols ⭐ NEW\n";
             std::cout << "19. Test EMA calculation with real data ⭐ NEW\n";
             std::cout << "20. Run COMPLETE PIPELINE (Fetch → Predict → Validate) ⭐ NEW\n";
+            std::cout << "21. Show bar close → prediction latency and cache stats\n";
             std::cout << "\n✅ PREDICTION VALIDATION:\n";
             std::cout << "10. Validate all pending predictions\n";
             std::cout << "11. Validate daily predictions\n";
@@ -134,7 +149,7 @@ int main() {
                 std::cout << "🔴 SCHEDULER STATUS: STOPPED" << std::endl;
             }
             
-            std::cout << "\nEnter choice (1-20): ";
+            std::cout << "\nEnter choice (1-21): ";
             int choice;
             std::cin >> choice;
             
@@ -376,17 +391,22 @@ int main() {
                         std::cout << "📊 Retrieved " << historical_data.size() << " historical bars for QGC#" << std::endl;
                         
                         // Test EMA calculation
-                        auto ema_result = prediction_engine->calculate_ema_for_prediction(historical_data, "close");
+                        // Capture intermediate values for the debug printout
+                        std::vector<double> sma_buffer(Model1Parameters::SMA_PERIODS);
+                        std::vector<double> ema_buffer(historical_data.size());
+                        EMATrace trace(sma_buffer.data(), sma_buffer.size(), ema_buffer.data(), ema_buffer.size());
+                        
+                        auto ema_result = prediction_engine->calculate_ema_for_prediction(historical_data, "close", &trace);
                         
                         if (ema_result.valid) {
                             std::cout << "✅ EMA calculation successful!" << std::endl;
                             std::cout << "🎯 Final EMA prediction: " << ema_result.final_ema << std::endl;
-                            std::cout << "📈 SMA values calculated: " << ema_result.sma_values.size() << std::endl;
-                            std::cout << "📊 EMA values calculated: " << ema_result.ema_values.size() << std::endl;
+                            std::cout << "📈 SMA values calculated: " << trace.sma_total << std::endl;
+                            std::cout << "📊 EMA values calculated: " << trace.ema_total << std::endl;
                             std::cout << "📋 Total bars used: " << ema_result.bars_used << std::endl;
                             
                             // Show debug output
-                            prediction_engine->print_ema_calculation_debug(historical_data, ema_result);
+                            prediction_engine->print_ema_calculation_debug(historical_data, ema_result, trace);
                         } else {
                             std::cout << "❌ EMA calculation failed" << std::endl;
                             std::cout << "Error: " << prediction_engine->get_last_error() << std::endl;
@@ -465,18 +485,25 @@ int main() {
                     break;
                 }
                 
+                case 21: {
+                    prediction_trigger.print_latency_summary();
+                    prediction_engine->print_cache_stats();
+                    break;
+                }
+                
                 case 16: {
                     std::cout << "Shutting down..." << std::endl;
                     if (scheduler.is_running()) {
                         std::cout << "Stopping scheduler..." << std::endl;
                         scheduler.stop_scheduler();
                     }
+                    bar_event_bus->stop();
                     std::cout << "Goodbye!" << std::endl;
                     return 0;
                 }
                 
                 default: {
-                    std::cout << "Invalid choice. Please enter 1-20." << std::endl;
+                    std::cout << "Invalid choice. Please enter 1-21." << std::endl;
                     break;
                 }
             }
@@ -2,6 +2,8 @@
 #include "database_simple.h"
 #include "IQFeedConnectionManager.h"
 #include "Logger.h"
+#include "MetricsRegistry.h"
+#include "TradingCalendar.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -10,6 +12,23 @@
 #include <stdexcept>
 #include <libpq-fe.h>
 
+namespace {
+    // Times one generate_*_prediction call and counts its outcome
+    template <typename Generate>
+    bool record_prediction(const std::string& timeframe, Generate generate) {
+        auto& registry = MetricsRegistry::instance();
+        ScopedTimer timer(registry.histogram(
+            "nexday_prediction_seconds", "Generating one prediction: history load, EMA, confidence",
+            { { "engine", "integrated" }, { "timeframe", timeframe } }));
+        bool generated = generate();
+        timer.stop();
+        registry.counter("nexday_predictions_total", "Predictions by outcome (generated, cached, failed)",
+                         { { "engine", "integrated" }, { "timeframe", timeframe },
+                           { "result", generated ? "generated" : "failed" } }).inc();
+        return generated;
+    }
+}
+
 IntegratedMarketPredictionEngine::IntegratedMarketPredictionEngine(
     std::shared_ptr<SimpleDatabaseManager> db_manager,
     std::shared_ptr<IQFeedConnectionManager> iqfeed_manager)
@@ -40,7 +59,7 @@ bool IntegratedMarketPredictionEngine::generate_predictions_for_symbol(const std
     bool overall_success = true;
     
     // Generate daily predictions
-    if (!generate_daily_prediction(symbol)) {
+    if (!record_prediction("daily", [&]() { return generate_daily_prediction(symbol); })) {
         logger_->error("Failed to generate daily prediction for " + symbol);
         overall_success = false;
     }
@@ -48,7 +67,7 @@ bool IntegratedMarketPredictionEngine::generate_predictions_for_symbol(const std
     // Generate intraday predictions for multiple timeframes
     std::vector<std::string> intraday_timeframes = {"15min", "30min", "1hour", "2hours"};
     for (const auto& timeframe : intraday_timeframes) {
-        if (!generate_intraday_prediction(symbol, timeframe)) {
+        if (!record_prediction(timeframe, [&]() { return generate_intraday_prediction(symbol, timeframe); })) {
             logger_->error("Failed to generate " + timeframe + " prediction for " + symbol);
             overall_success = false;
         }
@@ -203,7 +222,7 @@ bool IntegratedMarketPredictionEngine::retrieve_historical_data_from_db(const st
         if (timeframe == "daily") {
             query << "fetch_date DESC ";
         } else {
-            query << "fetch_date DESC, fetch_time DESC ";
+            query << "bar_ts DESC ";
         }
         
         query << "LIMIT 100"; // Get last 100 bars
@@ -307,9 +326,10 @@ bool IntegratedMarketPredictionEngine::fetch_fresh_data_from_iqfeed(const std::s
 // EMA CALCULATION METHODS
 // ==============================================
 
-EMAResult IntegratedMarketPredictionEngine::calculate_ema_sequence(const std::vector<PriceBar>& price_data, 
-                                                                  const std::string& price_type) {
-    EMAResult result;
+EMASequenceResult IntegratedMarketPredictionEngine::calculate_ema_sequence(const std::vector<PriceBar>& price_data, 
+                                                                          const std::string& price_type,
+                                                                          EMATrace* trace) {
+    EMASequenceResult result;
     
     if (price_data.size() < MINIMUM_BARS) {
         result.error_message = "Insufficient data: need " + std::to_string(MINIMUM_BARS) + 
@@ -317,73 +337,51 @@ EMAResult IntegratedMarketPredictionEngine::calculate_ema_sequence(const std::ve
         return result;
     }
     
+    // Resolve the requested price type once instead of per bar
+    double PriceBar::*field = price_field(price_type);
+    
     // Step 1: Calculate SMA10 (bootstrap) from first 10 bars
-    result.sma10 = calculate_sma_10(price_data, price_type);
+    result.sma10 = calculate_sma_10(price_data, field);
     if (result.sma10 == 0) {
         result.error_message = "Failed to calculate SMA10 bootstrap";
         return result;
     }
     
-    logger_->debug("Bootstrap SMA10: " + std::to_string(result.sma10));
-    
-    // Step 2: Initialize EMA sequence
-    result.ema_sequence.clear();
-    result.ema_sequence.reserve(price_data.size() - BOOTSTRAP_BARS);
-    
-    double previous_ema = result.sma10;  // SMA10 becomes initial previous_predict
-    
-    // Step 3: Calculate EMA sequence starting from bar 11 (index 10)
-    for (size_t i = BOOTSTRAP_BARS; i < price_data.size(); i++) {
-        double current_value;
-        
-        // Extract the requested price type
-        if (price_type == "open") current_value = price_data[i].open;
-        else if (price_type == "high") current_value = price_data[i].high;
-        else if (price_type == "low") current_value = price_data[i].low;
-        else current_value = price_data[i].close;  // default to close
-        
-        // EMA Formula: predict_t = (base_alpha * current_value) + ((1 - base_alpha) * previous_predict)
-        double current_ema = (BASE_ALPHA * current_value) + ((1.0 - BASE_ALPHA) * previous_ema);
-        
-        result.ema_sequence.push_back(current_ema);
-        previous_ema = current_ema;  // Current EMA becomes previous for next iteration
-        
-        logger_->debug("EMA[" + std::to_string(i - BOOTSTRAP_BARS + 1) + "]: " + std::to_string(current_ema) + 
-                      " (current=" + std::to_string(current_value) + ", prev=" + std::to_string(previous_ema) + ")");
+    if (trace) {
+        trace->reset();
+        trace->record_sma(result.sma10);
     }
     
-    // Step 4: Set final EMA as the last calculated value
+    // Step 2: EMA sequence from bar 11 (index 10), seeded with SMA10 - shared Model 1 kernel
+    double previous_ema = EMAKernel::run_ema(EMAKernel::view(price_data, field), BOOTSTRAP_BARS,
+                                             result.sma10, BASE_ALPHA, trace);
+    
+    // Step 3: Set final EMA as the last calculated value
     result.final_ema = previous_ema;
+    result.sequence_length = static_cast<int>(price_data.size() - BOOTSTRAP_BARS);
     result.calculation_valid = true;
     
-    logger_->info("EMA calculation completed. Final EMA: " + std::to_string(result.final_ema) + 
-                 " (sequence length: " + std::to_string(result.ema_sequence.size()) + ")");
+    NEXDAY_LOG_DEBUG(logger_, "EMA calculation completed. Final EMA: " + std::to_string(result.final_ema) +
+                     " (sequence length: " + std::to_string(result.sequence_length) + ")");
     
     return result;
 }
 
 double IntegratedMarketPredictionEngine::calculate_sma_10(const std::vector<PriceBar>& price_data, 
-                                                         const std::string& price_type) {
+                                                         double PriceBar::*field) {
     if (price_data.size() < BOOTSTRAP_BARS) {
         logger_->error("Insufficient data for SMA10 calculation");
         return 0.0;
     }
     
-    double sum = 0.0;
-    for (int i = 0; i < BOOTSTRAP_BARS; i++) {
-        double value;
-        if (price_type == "open") value = price_data[i].open;
-        else if (price_type == "high") value = price_data[i].high;
-        else if (price_type == "low") value = price_data[i].low;
-        else value = price_data[i].close;
-        
-        sum += value;
-    }
-    
-    double sma10 = sum / BOOTSTRAP_BARS;
-    logger_->debug("SMA10 calculated: " + std::to_string(sma10) + " from " + std::to_string(BOOTSTRAP_BARS) + " bars");
-    
-    return sma10;
+    return EMAKernel::bootstrap(EMAKernel::view(price_data, field), EMAKernel::SMA10_SEED);
+}
+
+double PriceBar::* IntegratedMarketPredictionEngine::price_field(const std::string& price_type) {
+    if (price_type == "open") return &PriceBar::open;
+    if (price_type == "high") return &PriceBar::high;
+    if (price_type == "low") return &PriceBar::low;
+    return &PriceBar::close;  // default to close
 }
 
 // ==============================================
@@ -408,10 +406,10 @@ bool IntegratedMarketPredictionEngine::generate_daily_predictions(const std::str
     
     try {
         // Generate predictions for each OHLC component
-        EMAResult open_ema = calculate_ema_sequence(historical_data, "open");
-        EMAResult high_ema = calculate_ema_sequence(historical_data, "high");
-        EMAResult low_ema = calculate_ema_sequence(historical_data, "low");
-        EMAResult close_ema = calculate_ema_sequence(historical_data, "close");
+        EMASequenceResult open_ema = calculate_ema_sequence(historical_data, "open");
+        EMASequenceResult high_ema = calculate_ema_sequence(historical_data, "high");
+        EMASequenceResult low_ema = calculate_ema_sequence(historical_data, "low");
+        EMASequenceResult close_ema = calculate_ema_sequence(historical_data, "close");
         
         // Validate all calculations
         if (!open_ema.calculation_valid || !high_ema.calculation_valid || 
@@ -459,8 +457,8 @@ bool IntegratedMarketPredictionEngine::generate_intraday_predictions(const std::
     
     try {
         // Generate High and Low predictions for next interval
-        EMAResult high_ema = calculate_ema_sequence(historical_data, "high");
-        EMAResult low_ema = calculate_ema_sequence(historical_data, "low");
+        EMASequenceResult high_ema = calculate_ema_sequence(historical_data, "high");
+        EMASequenceResult low_ema = calculate_ema_sequence(historical_data, "low");
         
         if (!high_ema.calculation_valid || !low_ema.calculation_valid) {
             result.error_message = "EMA calculation failed for High/Low predictions";
@@ -502,6 +500,9 @@ int IntegratedMarketPredictionEngine::get_or_create_model_id() {
 }
 
 bool IntegratedMarketPredictionEngine::save_predictions_to_db(const PredictionResult& result) {
+    static Histogram& save_seconds = MetricsRegistry::instance().histogram(
+        "nexday_prediction_save_seconds", "Persisting one prediction", { { "engine", "integrated" } });
+    ScopedTimer timer(save_seconds);
     logger_->info("Saving predictions to database for " + result.symbol + " " + result.timeframe);
     
     try {
@@ -586,35 +587,12 @@ bool IntegratedMarketPredictionEngine::save_predictions_to_db(const PredictionRe
 // ==============================================
 
 std::string IntegratedMarketPredictionEngine::get_next_business_day(const std::string& from_date) {
-    // Simple implementation - add 1 day and handle weekends
-    // In full implementation, handle holidays too
-    
-    std::tm tm = {};
-    std::istringstream ss(from_date);
-    ss >> std::get_time(&tm, "%Y-%m-%d");
-    
-    auto time_t = std::mktime(&tm);
-    auto time_point = std::chrono::system_clock::from_time_t(time_t);
-    
-    // Add 1 day
-    time_point += std::chrono::hours(24);
-    
-    // If it's Saturday (6) or Sunday (0), move to Monday
-    time_t = std::chrono::system_clock::to_time_t(time_point);
-    tm = *std::localtime(&time_t);
-    
-    if (tm.tm_wday == 6) {  // Saturday
-        time_point += std::chrono::hours(48);  // Move to Monday
-    } else if (tm.tm_wday == 0) {  // Sunday
-        time_point += std::chrono::hours(24);  // Move to Monday
-    }
-    
-    time_t = std::chrono::system_clock::to_time_t(time_point);
-    tm = *std::localtime(&time_t);
-    
-    std::ostringstream oss;
-    oss << std::put_time(&tm, "%Y-%m-%d");
-    return oss.str();
+    // Next exchange trade date: skips weekends and holidays
+    return TradingCalendar::instance().next_session(from_date);
+}
+
+bool IntegratedMarketPredictionEngine::is_business_day(const std::string& date) {
+    return TradingCalendar::instance().is_trading_day(date);
 }
 
 bool IntegratedMarketPredictionEngine::is_ready() const {
@@ -694,28 +672,34 @@ void IntegratedMarketPredictionEngine::print_ema_calculation_details(const std::
         std::cout << "Minimum Bars Required: " << MINIMUM_BARS << std::endl;
         std::cout << "Bootstrap Bars (SMA10): " << BOOTSTRAP_BARS << std::endl;
         
-        // Calculate EMA for close prices as example
-        EMAResult result = calculate_ema_sequence(historical_data, "close");
+        // Calculate EMA for close prices as example, capturing the full chain
+        double sma_buffer[1];
+        std::vector<double> ema_buffer(historical_data.size() - BOOTSTRAP_BARS);
+        EMATrace trace(sma_buffer, 1, ema_buffer.data(), ema_buffer.size());
+        
+        EMASequenceResult result = calculate_ema_sequence(historical_data, "close", &trace);
         
         if (result.calculation_valid) {
             std::cout << "\nBootstrap SMA10: " << std::fixed << std::setprecision(6) << result.sma10 << std::endl;
             std::cout << "Final EMA Value: " << std::fixed << std::setprecision(6) << result.final_ema << std::endl;
-            std::cout << "EMA Sequence Length: " << result.ema_sequence.size() << std::endl;
+            std::cout << "EMA Sequence Length: " << result.sequence_length << std::endl;
+            
+            size_t captured = trace.ema_count();
             
             // Show first few EMA calculations
             std::cout << "\nFirst 5 EMA calculations:" << std::endl;
-            for (size_t i = 0; i < std::min(size_t(5), result.ema_sequence.size()); i++) {
+            for (size_t i = 0; i < std::min(size_t(5), captured); i++) {
                 std::cout << "  EMA[" << (i + 1) << "] = " << std::fixed << std::setprecision(6) 
-                         << result.ema_sequence[i] << std::endl;
+                         << trace.ema_values[i] << std::endl;
             }
             
             // Show last few EMA calculations
-            if (result.ema_sequence.size() > 5) {
+            if (captured > 5) {
                 std::cout << "\nLast 3 EMA calculations:" << std::endl;
-                size_t start = result.ema_sequence.size() - 3;
-                for (size_t i = start; i < result.ema_sequence.size(); i++) {
+                size_t start = captured - 3;
+                for (size_t i = start; i < captured; i++) {
                     std::cout << "  EMA[" << (i + 1) << "] = " << std::fixed << std::setprecision(6) 
-                             << result.ema_sequence[i] << std::endl;
+                             << trace.ema_values[i] << std::endl;
                 }
             }
             
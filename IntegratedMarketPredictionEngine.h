@@ -4,6 +4,7 @@
 #include <vector>
 #include <memory>
 #include <chrono>
+#include "EMAKernel.h"
 
 // Forward declarations
 class SimpleDatabaseManager;
@@ -25,15 +26,16 @@ struct PriceBar {
         : date(d), time(""), open(o), high(h), low(l), close(c), volume(v) {}
 };
 
-// Structure to hold EMA calculation results
-struct EMAResult {
+// Structure to hold EMA calculation results (named apart from the prediction
+// engine's EMAResult so both engines can link into one binary)
+struct EMASequenceResult {
     double sma10;           // SMA of first 10 bars (bootstrap)
     double final_ema;       // Final EMA value (last prediction)
-    std::vector<double> ema_sequence; // Complete EMA sequence
+    int sequence_length;    // Number of EMA steps (capture them with an EMATrace)
     bool calculation_valid;
     std::string error_message;
     
-    EMAResult() : sma10(0), final_ema(0), calculation_valid(false) {}
+    EMASequenceResult() : sma10(0), final_ema(0), sequence_length(0), calculation_valid(false) {}
 };
 
 // Structure to hold prediction results
@@ -82,10 +84,8 @@ private:
     bool fetch_fresh_data_from_iqfeed(const std::string& symbol, const std::string& timeframe,
                                      int num_bars, std::vector<PriceBar>& fresh_data);
     
-    // Core EMA calculation methods
-    EMAResult calculate_ema_sequence(const std::vector<PriceBar>& price_data, 
-                                    const std::string& price_type = "close");
-    double calculate_sma_10(const std::vector<PriceBar>& price_data, const std::string& price_type);
+    double calculate_sma_10(const std::vector<PriceBar>& price_data, double PriceBar::*field);
+    static double PriceBar::* price_field(const std::string& price_type);
     
     // Prediction generation methods
     bool generate_daily_predictions(const std::string& symbol, const std::vector<PriceBar>& historical_data,
@@ -125,6 +125,12 @@ public:
     bool generate_predictions_for_all_symbols();
     bool generate_predictions_for_symbol_list(const std::vector<std::string>& symbols);
     
+    // Core EMA calculation - no per-bar allocation or logging; pass a trace to
+    // capture the EMA chain
+    EMASequenceResult calculate_ema_sequence(const std::vector<PriceBar>& price_data, 
+                                             const std::string& price_type = "close",
+                                             EMATrace* trace = nullptr);
+    
     // Configuration and status
     void set_minimum_bars(int bars) { /* Could make configurable if needed */ }
     void set_base_alpha(double alpha) { /* Could make configurable if needed */ }
@@ -0,0 +1,94 @@
+#ifndef METRICS_ACCUMULATOR_H
+#define METRICS_ACCUMULATOR_H
+
+#include <cmath>
+#include <algorithm>
+
+// ==============================================
+// METRICS ACCUMULATOR - STREAMING ERROR METRICS
+// ==============================================
+
+// Running state for one model/timeframe. Each validated prediction is added
+// in O(1) and every metric can be read in O(1), so reporting no longer
+// rereads the prediction history.
+//
+// Means and second moments use Welford's update, which stays numerically
+// stable for price-scale values where the naive sum-of-squares formula
+// cancels. Two accumulators built independently (e.g. by parallel
+// validation workers) combine exactly with merge() (Chan et al.).
+struct MetricsAccumulator {
+    long long count = 0;
+
+    // Signed error (actual - predicted): mean and sum of squared deviations
+    double mean_error = 0.0;
+    double m2_error = 0.0;
+
+    // Actual values: mean and sum of squared deviations (R² denominator)
+    double mean_actual = 0.0;
+    double m2_actual = 0.0;
+
+    double sum_abs_error = 0.0;
+    double sum_squared_error = 0.0;
+    double sum_abs_pct_error = 0.0;    // Fractional, skips actual == 0 like calculate_mape
+    double sum_accuracy = 0.0;
+
+    void add(double predicted, double actual, double accuracy) {
+        double error = actual - predicted;
+        count++;
+
+        double delta_error = error - mean_error;
+        mean_error += delta_error / count;
+        m2_error += delta_error * (error - mean_error);
+
+        double delta_actual = actual - mean_actual;
+        mean_actual += delta_actual / count;
+        m2_actual += delta_actual * (actual - mean_actual);
+
+        sum_abs_error += std::abs(error);
+        sum_squared_error += error * error;
+        if (actual != 0.0) {
+            sum_abs_pct_error += std::abs(error / actual);
+        }
+        sum_accuracy += accuracy;
+    }
+
+    void merge(const MetricsAccumulator& other) {
+        if (other.count == 0) return;
+        if (count == 0) {
+            *this = other;
+            return;
+        }
+
+        double n_a = static_cast<double>(count);
+        double n_b = static_cast<double>(other.count);
+        double n = n_a + n_b;
+
+        double delta_error = other.mean_error - mean_error;
+        mean_error += delta_error * n_b / n;
+        m2_error += other.m2_error + delta_error * delta_error * n_a * n_b / n;
+
+        double delta_actual = other.mean_actual - mean_actual;
+        mean_actual += delta_actual * n_b / n;
+        m2_actual += other.m2_actual + delta_actual * delta_actual * n_a * n_b / n;
+
+        sum_abs_error += other.sum_abs_error;
+        sum_squared_error += other.sum_squared_error;
+        sum_abs_pct_error += other.sum_abs_pct_error;
+        sum_accuracy += other.sum_accuracy;
+        count += other.count;
+    }
+
+    // Metrics - same definitions as PredictionValidator::calculate_*
+    double mae() const { return count > 0 ? sum_abs_error / count : 0.0; }
+    double rmse() const { return count > 0 ? std::sqrt(sum_squared_error / count) : 0.0; }
+    double mape() const { return count > 0 ? (sum_abs_pct_error / count) * 100.0 : 0.0; }
+    double mean_accuracy() const { return count > 0 ? sum_accuracy / count : 0.0; }
+    double std_deviation() const { return count > 0 ? std::sqrt(std::max(0.0, m2_error) / count) : 0.0; }
+
+    double r_squared() const {
+        if (count == 0 || m2_actual == 0.0) return 0.0;
+        return 1.0 - (sum_squared_error / m2_actual);
+    }
+};
+
+#endif // METRICS_ACCUMULATOR_H
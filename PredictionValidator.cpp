@@ -1,6 +1,10 @@
 #include "PredictionValidator.h"
+#include "ValidationScheduler.h"
 #include "database_simple.h"
 #include "IQFeedConnection/Logger.h"
+#include "IQFeedConnection/Tracer.h"
+#include "Predictions/ErrorMetricsKernel.h"
+#include "Predictions/ActualsIndex.h"
 #include <iostream>
 #include <cmath>
 #include <algorithm>
@@ -8,6 +12,7 @@
 #include <sstream>
 #include <iomanip>
 #include <chrono>
+#include <ctime>
 
 // ==============================================
 // CONSTRUCTOR AND DESTRUCTOR
@@ -16,16 +21,20 @@
 PredictionValidator::PredictionValidator(std::shared_ptr<SimpleDatabaseManager> db_manager)
     : db_manager_(db_manager) {
     logger_ = std::make_unique<Logger>("prediction_validator.log", true);
+    load_metric_accumulators();
     logger_->info("PredictionValidator initialized");
 }
 
-PredictionValidator::~PredictionValidator() = default;
+PredictionValidator::~PredictionValidator() {
+    flush_metric_accumulators();
+}
 
 // ==============================================
 // MAIN VALIDATION METHODS
 // ==============================================
 
 bool PredictionValidator::validate_daily_predictions(const std::string& symbol) {
+    NEXDAY_TRACE_SPAN("validate", "validate", symbol, "daily");
     logger_->info("Starting daily predictions validation for symbol: " + 
                  (symbol.empty() ? "ALL" : symbol));
     
@@ -68,6 +77,8 @@ bool PredictionValidator::validate_daily_predictions(const std::string& symbol)
         
         PQclear(result);
         
+        flush_metric_accumulators();
+        
         logger_->success("Validated " + std::to_string(validated_count) + 
                         " out of " + std::to_string(rows) + " daily predictions");
         return true;
@@ -80,6 +91,7 @@ bool PredictionValidator::validate_daily_predictions(const std::string& symbol)
 
 bool PredictionValidator::validate_intraday_predictions(const std::string& timeframe, 
                                                        const std::string& symbol) {
+    NEXDAY_TRACE_SPAN("validate", "validate", symbol, timeframe);
     logger_->info("Starting intraday predictions validation for " + timeframe + 
                  " (symbol: " + (symbol.empty() ? "ALL" : symbol) + ")");
     
@@ -132,6 +144,8 @@ bool PredictionValidator::validate_intraday_predictions(const std::string& timef
         
         PQclear(result);
         
+        flush_metric_accumulators();
+        
         logger_->success("Validated " + std::to_string(validated_count) + 
                         " out of " + std::to_string(rows) + " " + timeframe + " predictions");
         return true;
@@ -142,11 +156,48 @@ bool PredictionValidator::validate_intraday_predictions(const std::string& timef
     }
 }
 
-bool PredictionValidator::validate_all_pending_predictions() {
-    logger_->info("Starting validation of all pending predictions");
+bool PredictionValidator::validate_all_pending_predictions(bool bulk, std::size_t workers) {
+    logger_->info(std::string("Starting validation of all pending predictions") +
+                 (bulk ? " (bulk mode)" : ""));
     
     bool success = true;
     
+    if (bulk && workers != 1) {
+        // Workers merge their partial metrics into this validator, which persists them
+        ValidationScheduler scheduler(db_manager_->config_, workers);
+        ValidationRunStats stats = scheduler.run(this);
+        return stats.ok();
+    }
+    
+    if (bulk) {
+        // One set-based statement per timeframe, however large the backlog is
+        std::vector<std::string> timeframes = {"daily", "15min", "30min", "1hour", "2hours"};
+        int total_validated = 0;
+        for (const auto& tf : timeframes) {
+            int validated = validate_pending_predictions_bulk(tf);
+            if (validated < 0) {
+                success = false;
+            } else {
+                total_validated += validated;
+            }
+        }
+        
+        if (!flush_metric_accumulators()) {
+            success = false;
+        }
+        
+        if (success) {
+            logger_->success("Bulk validation completed: " + std::to_string(total_validated) +
+                            " predictions validated");
+        } else {
+            logger_->error("Some bulk validations encountered issues");
+        }
+        return success;
+    }
+    
+    // Resolve actual prices from memory instead of one query per prediction
+    load_actuals_index();
+    
     // Validate daily predictions
     if (!validate_daily_predictions()) {
         success = false;
@@ -160,6 +211,8 @@ bool PredictionValidator::validate_all_pending_predictions() {
         }
     }
     
+    clear_actuals_index();
+    
     if (success) {
         logger_->success("All pending predictions validation completed successfully");
     } else {
@@ -169,11 +222,125 @@ bool PredictionValidator::validate_all_pending_predictions() {
     return success;
 }
 
+// ==============================================
+// BULK (SET-BASED) VALIDATION
+// ==============================================
+
+std::string PredictionValidator::build_bulk_validation_query(const std::string& timeframe, int symbol_id) {
+    // Same table and wait-time mapping as the per-prediction path
+    std::string table_name;
+    std::string time_threshold;
+    std::string timeframe_pattern = timeframe;
+    if (timeframe == "daily") {
+        table_name = "historical_fetch_daily";
+        time_threshold = "1 day";
+    } else if (timeframe == "15min") {
+        table_name = "historical_fetch_15min";
+        time_threshold = "20 minutes";
+    } else if (timeframe == "30min") {
+        table_name = "historical_fetch_30min";
+        time_threshold = "35 minutes";
+    } else if (timeframe == "1hour") {
+        table_name = "historical_fetch_1hour";
+        time_threshold = "70 minutes";
+    } else if (timeframe == "2hours") {
+        table_name = "historical_fetch_2hours";
+        time_threshold = "130 minutes";
+        timeframe_pattern = "2hour";  // Accept both '2hour' and '2hours' prefixes
+    } else {
+        return "";
+    }
+    
+    std::stringstream query;
+    query << "UPDATE predictions_all_symbols p SET ";
+    query << "actual_price = a.actual_price, ";
+    query << "prediction_error = a.actual_price - p.predicted_price, ";
+    query << "prediction_accuracy = GREATEST(0, 1 - ABS((a.actual_price - p.predicted_price) / a.actual_price)), ";
+    query << "is_validated = TRUE, ";
+    query << "validated_at = CURRENT_TIMESTAMP ";
+    query << "FROM (";
+    query << "SELECT q.prediction_id, bar.actual_price ";
+    query << "FROM predictions_all_symbols q ";
+    
+    // First bar after the prediction was made, picked per prediction as one
+    // range probe on the (symbol_id, bar_ts) index (fetch_date for daily)
+    query << "CROSS JOIN LATERAL (";
+    query << "SELECT CASE ";
+    query << "WHEN q.timeframe LIKE '%\\_high%' THEN h.high_price ";
+    query << "WHEN q.timeframe LIKE '%\\_low%' THEN h.low_price ";
+    query << "WHEN q.timeframe LIKE '%\\_open%' THEN h.open_price ";
+    query << "ELSE h.close_price END AS actual_price ";
+    query << "FROM " << table_name << " h ";
+    query << "WHERE h.symbol_id = q.symbol_id ";
+    if (timeframe == "daily") {
+        query << "AND h.fetch_date > q.prediction_time::date ";
+        query << "ORDER BY h.fetch_date ASC LIMIT 1";
+    } else {
+        query << "AND h.bar_ts > " << SimpleDatabaseManager::bar_timestamp_of("q.prediction_time") << " ";
+        query << "ORDER BY h.bar_ts ASC LIMIT 1";
+    }
+    query << ") bar ";
+    
+    query << "WHERE q.is_validated = FALSE ";
+    query << "AND q.timeframe LIKE '" << timeframe_pattern << "%' ";
+    if (symbol_id >= 0) {
+        query << "AND q.symbol_id = " << symbol_id << " ";
+    }
+    query << "AND q.prediction_time < CURRENT_TIMESTAMP - INTERVAL '" << time_threshold << "'";
+    query << ") a ";
+    query << "WHERE p.prediction_id = a.prediction_id ";
+    query << "AND a.actual_price > 0 ";
+    
+    // Validated rows feed the streaming metrics without another round trip
+    query << "RETURNING p.model_id, p.timeframe, p.predicted_price, p.actual_price, p.prediction_accuracy, "
+          << "p.symbol_id, p.prediction_time";
+    
+    return query.str();
+}
+
+int PredictionValidator::validate_pending_predictions_bulk(const std::string& timeframe) {
+    NEXDAY_TRACE_SPAN("validate", "validate_bulk", std::string(), timeframe);
+    try {
+        std::string query = build_bulk_validation_query(timeframe);
+        if (query.empty()) {
+            logger_->error("Unknown timeframe for bulk validation: " + timeframe);
+            return -1;
+        }
+        
+        auto start = std::chrono::steady_clock::now();
+        PGresult* result = db_manager_->execute_query_with_result(query);
+        if (!result) {
+            logger_->error("Bulk validation failed for " + timeframe + " predictions");
+            return -1;
+        }
+        
+        int validated_count = PQntuples(result);
+        for (int i = 0; i < validated_count; i++) {
+            record_validation(std::stoi(PQgetvalue(result, i, 0)), PQgetvalue(result, i, 1),
+                              std::stoi(PQgetvalue(result, i, 5)), PQgetvalue(result, i, 6),
+                              std::stod(PQgetvalue(result, i, 2)), std::stod(PQgetvalue(result, i, 3)),
+                              std::stod(PQgetvalue(result, i, 4)));
+        }
+        PQclear(result);
+        
+        auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        logger_->info("Bulk validated " + std::to_string(validated_count) + " " + timeframe +
+                     " predictions in " + std::to_string(elapsed_ms) + " ms");
+        return validated_count;
+        
+    } catch (const std::exception& e) {
+        logger_->error("Exception in validate_pending_predictions_bulk: " + std::string(e.what()));
+        return -1;
+    }
+}
+
 // ==============================================
 // INDIVIDUAL PREDICTION VALIDATION
 // ==============================================
 
 ValidationResult PredictionValidator::validate_single_prediction(int prediction_id) {
+    NEXDAY_TRACE_SPAN("validate", "validate_one");
     ValidationResult result;
     result.prediction_id = prediction_id;
     result.is_valid = false;
@@ -181,7 +348,7 @@ ValidationResult PredictionValidator::validate_single_prediction(int prediction_
     try {
         // Get prediction details
         std::string query = 
-            "SELECT p.predicted_price, p.timeframe, p.prediction_time, s.symbol, p.symbol_id "
+            "SELECT p.predicted_price, p.timeframe, p.prediction_time, s.symbol, p.symbol_id, p.model_id "
             "FROM predictions_all_symbols p "
             "JOIN symbols s ON p.symbol_id = s.symbol_id "
             "WHERE p.prediction_id = " + std::to_string(prediction_id);
@@ -197,7 +364,9 @@ ValidationResult PredictionValidator::validate_single_prediction(int prediction_
         result.timeframe = PQgetvalue(pg_result, 0, 1);
         std::string prediction_time = PQgetvalue(pg_result, 0, 2);
         std::string symbol = PQgetvalue(pg_result, 0, 3);
-        int symbol_id = std::stoi(PQgetvalue(pg_result, 0, 4));
+        result.symbol_id = std::stoi(PQgetvalue(pg_result, 0, 4));
+        result.model_id = std::stoi(PQgetvalue(pg_result, 0, 5));
+        result.prediction_time = prediction_time;
         
         PQclear(pg_result);
         
@@ -234,6 +403,7 @@ ValidationResult PredictionValidator::validate_single_prediction(int prediction_
 }
 
 bool PredictionValidator::update_prediction_validation(const ValidationResult& result) {
+    NEXDAY_TRACE_SPAN("validate", "save_validation", std::string(), result.timeframe);
     try {
         std::stringstream update_query;
         update_query << "UPDATE predictions_all_symbols SET ";
@@ -246,6 +416,8 @@ bool PredictionValidator::update_prediction_validation(const ValidationResult& r
         
         bool success = db_manager_->execute_query(update_query.str());
         if (success) {
+            record_validation(result.model_id, result.timeframe, result.symbol_id, result.prediction_time,
+                              result.predicted_price, result.actual_price, result.accuracy_score);
             logger_->debug("Updated validation for prediction " + std::to_string(result.prediction_id));
         }
         
@@ -323,11 +495,12 @@ ModelMetrics PredictionValidator::calculate_model_metrics(int model_id, const st
         
         PQclear(result);
         
-        // Calculate error metrics
-        metrics.mae = calculate_mae(predicted_values, actual_values);
-        metrics.rmse = calculate_rmse(predicted_values, actual_values);
-        metrics.mape = calculate_mape(predicted_values, actual_values);
-        metrics.r_squared = calculate_r_squared(predicted_values, actual_values);
+        // Calculate error metrics in one fused pass
+        ErrorMetrics fused = ErrorMetricsKernel::compute(actual_values, predicted_values);
+        metrics.mae = fused.mae;
+        metrics.rmse = fused.rmse;
+        metrics.mape = fused.mape;
+        metrics.r_squared = fused.ss_total == 0.0 ? 0.0 : fused.r_squared;
         
         // Calculate mean accuracy
         metrics.mean_accuracy = std::accumulate(accuracy_scores.begin(), accuracy_scores.end(), 0.0) / accuracy_scores.size();
@@ -340,18 +513,7 @@ ModelMetrics PredictionValidator::calculate_model_metrics(int model_id, const st
         }
         metrics.std_deviation = std::sqrt(variance / errors.size());
         
-        // Get total predictions count (including unvalidated)
-        std::string total_query = 
-            "SELECT COUNT(*) FROM predictions_all_symbols "
-            "WHERE model_id = " + std::to_string(model_id) + " "
-            "AND timeframe LIKE '" + db_manager_->escape_string(timeframe) + "%' "
-            "AND prediction_time >= CURRENT_TIMESTAMP - INTERVAL '" + std::to_string(lookback_days) + " days'";
-        
-        PGresult* total_result = db_manager_->execute_query_with_result(total_query);
-        if (total_result && PQntuples(total_result) > 0) {
-            metrics.total_predictions = std::stoi(PQgetvalue(total_result, 0, 0));
-        }
-        if (total_result) PQclear(total_result);
+        metrics.total_predictions = std::max(0, count_predictions(model_id, timeframe, lookback_days));
         
         logger_->info("Calculated metrics for model " + std::to_string(model_id) + 
                      " " + timeframe + ": MAE=" + std::to_string(metrics.mae) + 
@@ -365,6 +527,28 @@ ModelMetrics PredictionValidator::calculate_model_metrics(int model_id, const st
     return metrics;
 }
 
+int PredictionValidator::count_predictions(int model_id, const std::string& timeframe, int lookback_days) {
+    try {
+        std::string query = 
+            "SELECT COUNT(*) FROM predictions_all_symbols "
+            "WHERE model_id = " + std::to_string(model_id) + " "
+            "AND timeframe LIKE '" + db_manager_->escape_string(timeframe) + "%'";
+        if (lookback_days > 0) {
+            query += " AND prediction_time >= CURRENT_TIMESTAMP - INTERVAL '" + std::to_string(lookback_days) + " days'";
+        }
+        
+        PGresult* result = db_manager_->execute_query_with_result(query);
+        if (!result) return -1;
+        int total = PQntuples(result) > 0 ? std::stoi(PQgetvalue(result, 0, 0)) : 0;
+        PQclear(result);
+        return total;
+        
+    } catch (const std::exception& e) {
+        logger_->error("Exception counting predictions: " + std::string(e.what()));
+        return -1;
+    }
+}
+
 bool PredictionValidator::update_model_performance(const ModelMetrics& metrics) {
     try {
         // Update the accuracy_metrics JSONB field in model_standard table
@@ -408,15 +592,49 @@ bool PredictionValidator::update_model_performance(const ModelMetrics& metrics)
 
 bool PredictionValidator::update_model_standard_deviation(const ModelMetrics& metrics) {
     try {
-        // Insert or update model_std_deviation record
-        std::string upsert_query = 
-            "INSERT INTO model_std_deviation "
-            "(model_id, symbol_id, timeframe, std_deviation, sample_size, last_calculated) "
-            "SELECT " + std::to_string(metrics.model_id) + ", symbol_id, '" + 
-            db_manager_->escape_string(metrics.timeframe) + "', " + 
-            std::to_string(metrics.std_deviation) + ", " + 
-            std::to_string(metrics.validated_predictions) + ", CURRENT_TIMESTAMP "
-            "FROM symbols WHERE symbol = 'QGC#' LIMIT 1 "
+        // Prefer each symbol's own trailing 30-day error spread from the rolling windows
+        std::stringstream values;
+        values << std::setprecision(17);
+        int symbols = 0;
+        {
+            std::lock_guard<std::mutex> lock(accumulators_mutex_);
+            const std::string timeframe = base_timeframe(metrics.timeframe);
+            const long long today = today_day_number();
+            
+            for (auto& [key, window] : rolling_windows_) {
+                const auto& [model_id, key_timeframe, symbol_id] = key;
+                if (model_id != metrics.model_id || key_timeframe != timeframe || symbol_id == ALL_SYMBOLS) {
+                    continue;
+                }
+                window.advance_to(today);
+                const MetricsAccumulator* last_30 = window.window(30);
+                if (!last_30 || last_30->count == 0) continue;
+                
+                values << (symbols ? ", " : "") << "(" << metrics.model_id << ", " << symbol_id << ", '"
+                       << db_manager_->escape_string(metrics.timeframe) << "', "
+                       << last_30->std_deviation() << ", " << last_30->count << ", CURRENT_TIMESTAMP)";
+                symbols++;
+            }
+        }
+        
+        std::string upsert_query;
+        if (symbols > 0) {
+            upsert_query =
+                "INSERT INTO model_std_deviation "
+                "(model_id, symbol_id, timeframe, std_deviation, sample_size, last_calculated) "
+                "VALUES " + values.str() + " ";
+        } else {
+            // No rolling data yet: keep the model-wide figure on the reference symbol
+            upsert_query =
+                "INSERT INTO model_std_deviation "
+                "(model_id, symbol_id, timeframe, std_deviation, sample_size, last_calculated) "
+                "SELECT " + std::to_string(metrics.model_id) + ", symbol_id, '" + 
+                db_manager_->escape_string(metrics.timeframe) + "', " + 
+                std::to_string(metrics.std_deviation) + ", " + 
+                std::to_string(metrics.validated_predictions) + ", CURRENT_TIMESTAMP "
+                "FROM symbols WHERE symbol = 'QGC#' LIMIT 1 ";
+        }
+        upsert_query +=
             "ON CONFLICT (model_id, symbol_id, timeframe) DO UPDATE SET "
             "std_deviation = EXCLUDED.std_deviation, "
             "sample_size = EXCLUDED.sample_size, "
@@ -430,6 +648,455 @@ bool PredictionValidator::update_model_standard_deviation(const ModelMetrics& me
     }
 }
 
+// ==============================================
+// STREAMING MODEL METRICS
+// ==============================================
+
+// Accumulator state columns, shared by model_metric_accumulators and model_metric_daily_buckets
+static const char* const ACCUMULATOR_COLUMNS =
+    "sample_count, mean_error, m2_error, mean_actual, m2_actual, "
+    "sum_abs_error, sum_squared_error, sum_abs_pct_error, sum_accuracy";
+
+// The same state computed by the database for a group of validated predictions
+// (selected from a subquery exposing actual_price, prediction_accuracy and err)
+static const char* const ACCUMULATOR_AGGREGATES =
+    "COUNT(*), "
+    "AVG(err), COALESCE(VAR_POP(err), 0) * COUNT(*), "
+    "AVG(actual_price), COALESCE(VAR_POP(actual_price), 0) * COUNT(*), "
+    "SUM(ABS(err)), SUM(err * err), "
+    "COALESCE(SUM(ABS(err / NULLIF(actual_price, 0))), 0), "
+    "COALESCE(SUM(prediction_accuracy), 0)";
+
+static MetricsAccumulator read_accumulator(PGresult* result, int row, int first_column) {
+    MetricsAccumulator acc;
+    acc.count = std::stoll(PQgetvalue(result, row, first_column));
+    acc.mean_error = std::stod(PQgetvalue(result, row, first_column + 1));
+    acc.m2_error = std::stod(PQgetvalue(result, row, first_column + 2));
+    acc.mean_actual = std::stod(PQgetvalue(result, row, first_column + 3));
+    acc.m2_actual = std::stod(PQgetvalue(result, row, first_column + 4));
+    acc.sum_abs_error = std::stod(PQgetvalue(result, row, first_column + 5));
+    acc.sum_squared_error = std::stod(PQgetvalue(result, row, first_column + 6));
+    acc.sum_abs_pct_error = std::stod(PQgetvalue(result, row, first_column + 7));
+    acc.sum_accuracy = std::stod(PQgetvalue(result, row, first_column + 8));
+    return acc;
+}
+
+static void write_accumulator(std::ostream& out, const MetricsAccumulator& acc) {
+    out << acc.count << ", " << acc.mean_error << ", " << acc.m2_error << ", "
+        << acc.mean_actual << ", " << acc.m2_actual << ", "
+        << acc.sum_abs_error << ", " << acc.sum_squared_error << ", "
+        << acc.sum_abs_pct_error << ", " << acc.sum_accuracy;
+}
+
+// Chan's parallel merge of a flushed delta (EXCLUDED) into the stored row
+// (alias acc), the SQL twin of MetricsAccumulator::merge. Every right-hand
+// side reads the row as it was, so any number of validators can flush into
+// the same key without losing samples. Deltas always have sample_count > 0.
+static const char* const ACCUMULATOR_MERGE_SET =
+    "sample_count = acc.sample_count + EXCLUDED.sample_count, "
+    "mean_error = acc.mean_error + (EXCLUDED.mean_error - acc.mean_error) * EXCLUDED.sample_count"
+    " / (acc.sample_count + EXCLUDED.sample_count)::float8, "
+    "m2_error = acc.m2_error + EXCLUDED.m2_error + (EXCLUDED.mean_error - acc.mean_error)"
+    " * (EXCLUDED.mean_error - acc.mean_error) * acc.sample_count * EXCLUDED.sample_count"
+    " / (acc.sample_count + EXCLUDED.sample_count)::float8, "
+    "mean_actual = acc.mean_actual + (EXCLUDED.mean_actual - acc.mean_actual) * EXCLUDED.sample_count"
+    " / (acc.sample_count + EXCLUDED.sample_count)::float8, "
+    "m2_actual = acc.m2_actual + EXCLUDED.m2_actual + (EXCLUDED.mean_actual - acc.mean_actual)"
+    " * (EXCLUDED.mean_actual - acc.mean_actual) * acc.sample_count * EXCLUDED.sample_count"
+    " / (acc.sample_count + EXCLUDED.sample_count)::float8, "
+    "sum_abs_error = acc.sum_abs_error + EXCLUDED.sum_abs_error, "
+    "sum_squared_error = acc.sum_squared_error + EXCLUDED.sum_squared_error, "
+    "sum_abs_pct_error = acc.sum_abs_pct_error + EXCLUDED.sum_abs_pct_error, "
+    "sum_accuracy = acc.sum_accuracy + EXCLUDED.sum_accuracy, "
+    "updated_at = EXCLUDED.updated_at";
+
+ModelMetrics PredictionValidator::to_model_metrics(int model_id, const std::string& timeframe,
+                                                   const MetricsAccumulator& acc) {
+    ModelMetrics metrics;
+    metrics.model_id = model_id;
+    metrics.timeframe = timeframe;
+    // total_predictions counts unvalidated rows too; callers fill it from count_predictions()
+    metrics.validated_predictions = static_cast<int>(acc.count);
+    metrics.mae = acc.mae();
+    metrics.rmse = acc.rmse();
+    metrics.mape = acc.mape();
+    metrics.r_squared = acc.r_squared();
+    metrics.mean_accuracy = acc.mean_accuracy();
+    metrics.std_deviation = acc.std_deviation();
+    return metrics;
+}
+
+std::string PredictionValidator::base_timeframe(const std::string& timeframe) {
+    // Prediction rows carry suffixes such as "15min_high"; metrics roll them up
+    if (timeframe.rfind("daily", 0) == 0) return "daily";
+    if (timeframe.rfind("15min", 0) == 0) return "15min";
+    if (timeframe.rfind("30min", 0) == 0) return "30min";
+    if (timeframe.rfind("1h", 0) == 0) return "1hour";
+    if (timeframe.rfind("2hour", 0) == 0) return "2hours";
+    return timeframe;
+}
+
+long long PredictionValidator::day_number(const std::string& timestamp) {
+    long long seconds = ActualsIndex::parse_timestamp(timestamp.substr(0, 10));
+    return seconds < 0 ? -1 : seconds / 86400;
+}
+
+long long PredictionValidator::today_day_number() {
+    // Local calendar date, the same wall clock prediction_time strings are in,
+    // read back through day_number() so bucket days and "today" agree
+    std::time_t now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &now);
+#else
+    localtime_r(&now, &tm);
+#endif
+    char date[16];
+    std::strftime(date, sizeof(date), "%Y-%m-%d", &tm);
+    return day_number(date);
+}
+
+void PredictionValidator::record_validation(int model_id, const std::string& timeframe, int symbol_id,
+                                            const std::string& prediction_time,
+                                            double predicted, double actual, double accuracy) {
+    MetricsKey key(model_id, base_timeframe(timeframe));
+    long long day = day_number(prediction_time);
+    
+    std::lock_guard<std::mutex> lock(accumulators_mutex_);
+    metric_accumulators_[key].add(predicted, actual, accuracy);
+    pending_accumulators_[key].add(predicted, actual, accuracy);
+    
+    if (day >= 0) {
+        MetricsAccumulator sample;
+        sample.add(predicted, actual, accuracy);
+        merge_bucket_locked(BucketKey(model_id, key.second, symbol_id, day), sample);
+    }
+}
+
+void PredictionValidator::merge_metric_accumulators(const MetricsAccumulatorMap& partials) {
+    std::lock_guard<std::mutex> lock(accumulators_mutex_);
+    for (const auto& [key, partial] : partials) {
+        MetricsKey normalized(key.first, base_timeframe(key.second));
+        metric_accumulators_[normalized].merge(partial);
+        pending_accumulators_[normalized].merge(partial);
+    }
+}
+
+ModelMetrics PredictionValidator::get_streaming_metrics(int model_id, const std::string& timeframe) const {
+    std::lock_guard<std::mutex> lock(accumulators_mutex_);
+    auto it = metric_accumulators_.find(MetricsKey(model_id, base_timeframe(timeframe)));
+    if (it == metric_accumulators_.end()) {
+        ModelMetrics metrics;
+        metrics.model_id = model_id;
+        metrics.timeframe = timeframe;
+        return metrics;
+    }
+    return to_model_metrics(model_id, timeframe, it->second);
+}
+
+bool PredictionValidator::update_model_performance(int model_id, const std::string& timeframe) {
+    ModelMetrics metrics = get_streaming_metrics(model_id, timeframe);
+    if (metrics.validated_predictions == 0) {
+        logger_->info("No streaming metrics yet for model " + std::to_string(model_id) +
+                     " timeframe " + timeframe);
+        return false;
+    }
+    metrics.total_predictions = std::max(metrics.validated_predictions, count_predictions(model_id, timeframe));
+    
+    flush_metric_accumulators();
+    return update_model_performance(metrics);
+}
+
+bool PredictionValidator::load_metric_accumulators() {
+    bool success = true;
+    
+    try {
+        PGresult* result = db_manager_->execute_query_with_result(
+            std::string("SELECT model_id, timeframe, ") + ACCUMULATOR_COLUMNS + " FROM model_metric_accumulators");
+        
+        int rows = result ? PQntuples(result) : 0;
+        if (rows == 0) {
+            if (result) PQclear(result);
+            // First run (or table missing): rebuild state from validated history once
+            success = seed_metric_accumulators_from_history();
+        } else {
+            std::lock_guard<std::mutex> lock(accumulators_mutex_);
+            for (int i = 0; i < rows; i++) {
+                metric_accumulators_[MetricsKey(std::stoi(PQgetvalue(result, i, 0)), PQgetvalue(result, i, 1))] =
+                    read_accumulator(result, i, 2);
+            }
+            PQclear(result);
+            
+            logger_->info("Loaded " + std::to_string(rows) + " streaming metric accumulators");
+        }
+        
+    } catch (const std::exception& e) {
+        logger_->error("Exception loading metric accumulators: " + std::string(e.what()));
+        success = false;
+    }
+    
+    return load_rolling_buckets() && success;
+}
+
+bool PredictionValidator::seed_metric_accumulators_from_history() {
+    try {
+        // The database computes each group's partial state; merge() combines
+        // the per-suffix groups ("15min_high", "15min_low", ...) exactly
+        std::string query =
+            std::string("SELECT model_id, timeframe, ") + ACCUMULATOR_AGGREGATES + " "
+            "FROM (SELECT model_id, timeframe, actual_price, prediction_accuracy, "
+            "             actual_price - predicted_price AS err "
+            "      FROM predictions_all_symbols "
+            "      WHERE is_validated = TRUE AND actual_price IS NOT NULL) v "
+            "GROUP BY model_id, timeframe";
+        
+        PGresult* result = db_manager_->execute_query_with_result(query);
+        if (!result) {
+            logger_->error("Failed to seed metric accumulators from validated history");
+            return false;
+        }
+        
+        MetricsAccumulatorMap partials;
+        int rows = PQntuples(result);
+        for (int i = 0; i < rows; i++) {
+            partials[MetricsKey(std::stoi(PQgetvalue(result, i, 0)), base_timeframe(PQgetvalue(result, i, 1)))]
+                .merge(read_accumulator(result, i, 2));
+        }
+        PQclear(result);
+        
+        merge_metric_accumulators(partials);
+        logger_->info("Seeded " + std::to_string(partials.size()) +
+                     " streaming metric accumulators from validated history");
+        return true;
+        
+    } catch (const std::exception& e) {
+        logger_->error("Exception seeding metric accumulators: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool PredictionValidator::flush_metric_accumulators() {
+    std::lock_guard<std::mutex> lock(accumulators_mutex_);
+    if (pending_accumulators_.empty()) {
+        return flush_rolling_buckets_locked();
+    }
+    
+    try {
+        // One multi-row upsert of what was validated since the last flush; the
+        // database merges each delta into whatever other writers stored
+        std::stringstream upsert;
+        upsert << std::setprecision(17);
+        upsert << "INSERT INTO model_metric_accumulators AS acc (model_id, timeframe, "
+               << ACCUMULATOR_COLUMNS << ", updated_at) VALUES ";
+        
+        bool first = true;
+        for (const auto& [key, delta] : pending_accumulators_) {
+            if (delta.count == 0) continue;
+            upsert << (first ? "" : ", ") << "("
+                   << key.first << ", '" << db_manager_->escape_string(key.second) << "', ";
+            write_accumulator(upsert, delta);
+            upsert << ", CURRENT_TIMESTAMP)";
+            first = false;
+        }
+        
+        if (!first) {
+            upsert << " ON CONFLICT (model_id, timeframe) DO UPDATE SET " << ACCUMULATOR_MERGE_SET
+                   << " RETURNING model_id, timeframe, " << ACCUMULATOR_COLUMNS;
+            
+            PGresult* result = db_manager_->execute_query_with_result(upsert.str());
+            if (!result) {
+                logger_->error("Failed to persist streaming metric accumulators");
+                return false;
+            }
+            
+            // The merged rows include other writers' samples; adopt them
+            int rows = PQntuples(result);
+            for (int i = 0; i < rows; i++) {
+                metric_accumulators_[MetricsKey(std::stoi(PQgetvalue(result, i, 0)), PQgetvalue(result, i, 1))] =
+                    read_accumulator(result, i, 2);
+            }
+            PQclear(result);
+        }
+        
+        pending_accumulators_.clear();
+        return flush_rolling_buckets_locked();
+        
+    } catch (const std::exception& e) {
+        logger_->error("Exception persisting metric accumulators: " + std::string(e.what()));
+        return false;
+    }
+}
+
+// ==============================================
+// ROLLING WINDOW METRICS (7/30/90 DAYS)
+// ==============================================
+
+void PredictionValidator::merge_bucket_locked(const BucketKey& key, const MetricsAccumulator& partial) {
+    const auto& [model_id, timeframe, symbol_id, day] = key;
+    
+    rolling_windows_[RollingKey(model_id, timeframe, symbol_id)].merge_bucket(day, partial);
+    if (symbol_id != ALL_SYMBOLS) {
+        // Model-wide window is derived, only per-symbol buckets are persisted
+        rolling_windows_[RollingKey(model_id, timeframe, ALL_SYMBOLS)].merge_bucket(day, partial);
+        pending_buckets_[key].merge(partial);
+    }
+}
+
+void PredictionValidator::merge_rolling_buckets(const BucketAccumulatorMap& partials) {
+    std::lock_guard<std::mutex> lock(accumulators_mutex_);
+    for (const auto& [key, partial] : partials) {
+        const auto& [model_id, timeframe, symbol_id, day] = key;
+        merge_bucket_locked(BucketKey(model_id, base_timeframe(timeframe), symbol_id, day), partial);
+    }
+}
+
+ModelMetrics PredictionValidator::get_rolling_metrics(int model_id, const std::string& timeframe,
+                                                      int window_days, int symbol_id) {
+    std::lock_guard<std::mutex> lock(accumulators_mutex_);
+    
+    auto it = rolling_windows_.find(RollingKey(model_id, base_timeframe(timeframe), symbol_id));
+    if (it != rolling_windows_.end()) {
+        it->second.advance_to(today_day_number());
+        if (const MetricsAccumulator* window = it->second.window(window_days)) {
+            return to_model_metrics(model_id, timeframe, *window);
+        }
+        logger_->error("Unsupported rolling window: " + std::to_string(window_days) + " days");
+    }
+    
+    ModelMetrics metrics;
+    metrics.model_id = model_id;
+    metrics.timeframe = timeframe;
+    return metrics;
+}
+
+bool PredictionValidator::load_rolling_buckets() {
+    try {
+        const std::string window = std::to_string(RollingMetricsWindow::MAX_DAYS);
+        
+        PGresult* result = db_manager_->execute_query_with_result(
+            std::string("SELECT model_id, timeframe, symbol_id, bucket_date - DATE '1970-01-01', ") +
+            ACCUMULATOR_COLUMNS + " FROM model_metric_daily_buckets "
+            "WHERE bucket_date > CURRENT_DATE - " + window);
+        
+        bool seeded = false;
+        if (!result || PQntuples(result) == 0) {
+            if (result) PQclear(result);
+            
+            // First run: bucket validated history of the last 90 days by prediction day
+            result = db_manager_->execute_query_with_result(
+                std::string("SELECT model_id, timeframe, symbol_id, prediction_day - DATE '1970-01-01', ") +
+                ACCUMULATOR_AGGREGATES + " "
+                "FROM (SELECT model_id, timeframe, symbol_id, prediction_time::date AS prediction_day, "
+                "             actual_price, prediction_accuracy, actual_price - predicted_price AS err "
+                "      FROM predictions_all_symbols "
+                "      WHERE is_validated = TRUE AND actual_price IS NOT NULL "
+                "      AND prediction_time > CURRENT_DATE - " + window + ") v "
+                "GROUP BY model_id, timeframe, symbol_id, prediction_day");
+            if (!result) {
+                logger_->error("Failed to load rolling metric buckets");
+                return false;
+            }
+            seeded = true;
+        }
+        
+        BucketAccumulatorMap partials;
+        int rows = PQntuples(result);
+        for (int i = 0; i < rows; i++) {
+            partials[BucketKey(std::stoi(PQgetvalue(result, i, 0)), base_timeframe(PQgetvalue(result, i, 1)),
+                               std::stoi(PQgetvalue(result, i, 2)), std::stoll(PQgetvalue(result, i, 3)))]
+                .merge(read_accumulator(result, i, 4));
+        }
+        PQclear(result);
+        
+        std::lock_guard<std::mutex> lock(accumulators_mutex_);
+        for (const auto& [key, partial] : partials) {
+            merge_bucket_locked(key, partial);
+        }
+        if (!seeded) {
+            pending_buckets_.clear();   // Loaded rows are already persisted
+        }
+        
+        logger_->info(std::string(seeded ? "Seeded " : "Loaded ") + std::to_string(partials.size()) +
+                     " daily metric buckets for rolling windows");
+        return true;
+        
+    } catch (const std::exception& e) {
+        logger_->error("Exception loading rolling metric buckets: " + std::string(e.what()));
+        return false;
+    }
+}
+
+bool PredictionValidator::flush_rolling_buckets_locked() {
+    if (pending_buckets_.empty()) {
+        return true;
+    }
+    
+    try {
+        // Deltas merged into the stored day, like the model-wide accumulators
+        std::stringstream upsert;
+        upsert << std::setprecision(17);
+        upsert << "INSERT INTO model_metric_daily_buckets AS acc (model_id, timeframe, symbol_id, bucket_date, "
+               << ACCUMULATOR_COLUMNS << ", updated_at) VALUES ";
+        
+        bool first = true;
+        for (const auto& [key, delta] : pending_buckets_) {
+            const auto& [model_id, timeframe, symbol_id, day] = key;
+            if (delta.count == 0) continue;
+            
+            upsert << (first ? "" : ", ") << "("
+                   << model_id << ", '" << db_manager_->escape_string(timeframe) << "', " << symbol_id
+                   << ", DATE '1970-01-01' + " << day << ", ";
+            write_accumulator(upsert, delta);
+            upsert << ", CURRENT_TIMESTAMP)";
+            first = false;
+        }
+        
+        if (!first) {
+            upsert << " ON CONFLICT (model_id, timeframe, symbol_id, bucket_date) DO UPDATE SET "
+                   << ACCUMULATOR_MERGE_SET;
+            
+            if (!db_manager_->execute_query(upsert.str())) {
+                logger_->error("Failed to persist rolling metric buckets");
+                return false;
+            }
+        }
+        
+        pending_buckets_.clear();
+        return true;
+        
+    } catch (const std::exception& e) {
+        logger_->error("Exception persisting rolling metric buckets: " + std::string(e.what()));
+        return false;
+    }
+}
+
+// ==============================================
+// ACTUALS INDEX
+// ==============================================
+
+bool PredictionValidator::load_actuals_index(int days_back) {
+    auto index = std::make_unique<ActualsIndex>();
+    auto start = std::chrono::steady_clock::now();
+    
+    if (!index->load(*db_manager_, days_back)) {
+        logger_->error("Failed to load actuals index; falling back to per-prediction queries");
+        actuals_index_.reset();
+        return false;
+    }
+    
+    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start).count();
+    logger_->info("Loaded actuals index: " + std::to_string(index->bar_count()) + " bars in " +
+                 std::to_string(index->series_count()) + " series (" + std::to_string(elapsed_ms) + " ms)");
+    
+    actuals_index_ = std::move(index);
+    return true;
+}
+
+void PredictionValidator::clear_actuals_index() {
+    actuals_index_.reset();
+}
+
 // ==============================================
 // UTILITY METHODS
 // ==============================================
@@ -494,6 +1161,24 @@ double PredictionValidator::get_actual_price_for_prediction(int prediction_id,
             return 0.0;
         }
         
+        // In-memory path: first bar after the prediction, by binary search. A
+        // miss is not final (the symbol may have no loaded series, or the bar
+        // may have been stored after the load), so it falls through to SQL
+        bool is_daily = table_name == "historical_fetch_daily";
+        long long prediction_ts = ActualsIndex::parse_timestamp(
+            is_daily ? prediction_time.substr(0, 10) : prediction_time);
+        
+        if (actuals_index_ && prediction_ts >= 0 && actuals_index_->covers(prediction_ts)) {
+            const ActualBar* bar = actuals_index_->find_first_after(
+                symbol, table_name.substr(std::string("historical_fetch_").size()), prediction_ts);
+            if (bar) {
+                if (timeframe.find("_high") != std::string::npos) return bar->high;
+                if (timeframe.find("_low") != std::string::npos) return bar->low;
+                if (timeframe.find("_open") != std::string::npos) return bar->open;
+                return bar->close;
+            }
+        }
+        
         // Build query to get actual price
         std::stringstream query;
         query << "SELECT ";
@@ -520,8 +1205,8 @@ double PredictionValidator::get_actual_price_for_prediction(int prediction_id,
             query << "ORDER BY h.fetch_date ASC LIMIT 1";
         } else {
             // For intraday, get the specific time period that was predicted
-            query << "AND (h.fetch_date || ' ' || h.fetch_time)::timestamp > '" << prediction_time << "' ";
-            query << "ORDER BY h.fetch_date ASC, h.fetch_time ASC LIMIT 1";
+            query << "AND h.bar_ts > " << db_manager_->bar_timestamp(prediction_time) << " ";
+            query << "ORDER BY h.bar_ts ASC LIMIT 1";
         }
         
         PGresult* result = db_manager_->execute_query_with_result(query.str());
@@ -553,58 +1238,32 @@ std::string PredictionValidator::get_current_timestamp() {
 // ERROR CALCULATION FUNCTIONS (STATIC)
 // ==============================================
 
+// Thin wrappers over the fused kernel (see Predictions/ErrorMetricsKernel.h)
 double PredictionValidator::calculate_mae(const std::vector<double>& predicted, 
                                         const std::vector<double>& actual) {
     if (predicted.size() != actual.size() || predicted.empty()) return 0.0;
-    
-    double sum = 0.0;
-    for (size_t i = 0; i < predicted.size(); ++i) {
-        sum += std::abs(actual[i] - predicted[i]);
-    }
-    return sum / predicted.size();
+    return ErrorMetricsKernel::compute(actual, predicted).mae;
 }
 
 double PredictionValidator::calculate_rmse(const std::vector<double>& predicted, 
                                          const std::vector<double>& actual) {
     if (predicted.size() != actual.size() || predicted.empty()) return 0.0;
-    
-    double sum = 0.0;
-    for (size_t i = 0; i < predicted.size(); ++i) {
-        double error = actual[i] - predicted[i];
-        sum += error * error;
-    }
-    return std::sqrt(sum / predicted.size());
+    return ErrorMetricsKernel::compute(actual, predicted).rmse;
 }
 
 double PredictionValidator::calculate_mape(const std::vector<double>& predicted, 
                                          const std::vector<double>& actual) {
     if (predicted.size() != actual.size() || predicted.empty()) return 0.0;
-    
-    double sum = 0.0;
-    for (size_t i = 0; i < predicted.size(); ++i) {
-        if (actual[i] != 0.0) {
-            sum += std::abs((actual[i] - predicted[i]) / actual[i]);
-        }
-    }
-    return (sum / predicted.size()) * 100.0;
+    return ErrorMetricsKernel::compute(actual, predicted).mape;
 }
 
 double PredictionValidator::calculate_r_squared(const std::vector<double>& predicted, 
                                               const std::vector<double>& actual) {
     if (predicted.size() != actual.size() || predicted.empty()) return 0.0;
     
-    // Calculate mean of actual values
-    double mean_actual = std::accumulate(actual.begin(), actual.end(), 0.0) / actual.size();
-    
-    // Calculate total sum of squares and residual sum of squares
-    double ss_tot = 0.0, ss_res = 0.0;
-    for (size_t i = 0; i < actual.size(); ++i) {
-        ss_tot += (actual[i] - mean_actual) * (actual[i] - mean_actual);
-        ss_res += (actual[i] - predicted[i]) * (actual[i] - predicted[i]);
-    }
-    
-    if (ss_tot == 0.0) return 0.0;
-    return 1.0 - (ss_res / ss_tot);
+    ErrorMetrics metrics = ErrorMetricsKernel::compute(actual, predicted);
+    if (metrics.ss_total == 0.0) return 0.0;
+    return metrics.r_squared;
 }
 
 double PredictionValidator::calculate_accuracy_score(double predicted, double actual) {
@@ -699,7 +1358,13 @@ void PredictionValidator::print_model_performance(int model_id) {
         std::vector<std::string> timeframes = {"daily", "15min", "30min", "1hour", "2hours"};
         
         for (const auto& tf : timeframes) {
-            ModelMetrics metrics = calculate_model_metrics(model_id, tf, 30); // Last 30 days
+            // Last 30 days, from the rolling window when one is maintained
+            ModelMetrics metrics = get_rolling_metrics(model_id, tf, 30);
+            if (metrics.validated_predictions == 0) {
+                metrics = calculate_model_metrics(model_id, tf, 30);
+            } else {
+                metrics.total_predictions = std::max(metrics.validated_predictions, count_predictions(model_id, tf, 30));
+            }
             
             std::cout << "\n" << tf << " Predictions:" << std::endl;
             std::cout << "  Total Predictions: " << metrics.total_predictions << std::endl;
@@ -712,6 +1377,17 @@ void PredictionValidator::print_model_performance(int model_id) {
                 std::cout << "  R-squared: " << std::fixed << std::setprecision(4) << metrics.r_squared << std::endl;
                 std::cout << "  Mean Accuracy: " << std::fixed << std::setprecision(2) << metrics.mean_accuracy * 100 << "%" << std::endl;
                 std::cout << "  Std Deviation: " << std::fixed << std::setprecision(4) << metrics.std_deviation << std::endl;
+                
+                std::cout << "  Rolling MAE (7d/30d/90d):";
+                for (int days : RollingMetricsWindow::WINDOW_DAYS) {
+                    ModelMetrics rolling = get_rolling_metrics(model_id, tf, days);
+                    if (rolling.validated_predictions > 0) {
+                        std::cout << " " << std::fixed << std::setprecision(4) << rolling.mae;
+                    } else {
+                        std::cout << " N/A";
+                    }
+                }
+                std::cout << std::endl;
             } else {
                 std::cout << "  No validated predictions available" << std::endl;
             }
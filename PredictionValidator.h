@@ -4,12 +4,23 @@
 #include <string>
 #include <vector>
 #include <memory>
+#include <map>
+#include <set>
+#include <mutex>
+#include <utility>
+#include <tuple>
+#include "MetricsAccumulator.h"
+#include "RollingMetrics.h"
 
 class SimpleDatabaseManager;
 class Logger;
+class ActualsIndex;
 
 struct ValidationResult {
     int prediction_id = 0;
+    int model_id = 1;
+    int symbol_id = 0;
+    std::string prediction_time;
     std::string timeframe;
     double predicted_price = 0.0;
     double actual_price = 0.0;
@@ -23,7 +34,7 @@ struct ValidationResult {
 struct ModelMetrics {
     int model_id = 0;
     std::string timeframe;
-    int total_predictions = 0;
+    int total_predictions = 0;              // Validated or not; 0 when not counted
     int validated_predictions = 0;
     double mae = 0.0;
     double rmse = 0.0;
@@ -34,10 +45,40 @@ struct ModelMetrics {
 };
 
 class PredictionValidator {
+public:
+    // Streaming metrics are kept per (model_id, base timeframe)
+    using MetricsKey = std::pair<int, std::string>;
+    using MetricsAccumulatorMap = std::map<MetricsKey, MetricsAccumulator>;
+    
+    // Rolling windows are kept per (model_id, base timeframe, symbol_id), with
+    // ALL_SYMBOLS holding the model-wide window; buckets add the day number
+    static constexpr int ALL_SYMBOLS = 0;
+    using RollingKey = std::tuple<int, std::string, int>;
+    using BucketKey = std::tuple<int, std::string, int, long long>;
+    using BucketAccumulatorMap = std::map<BucketKey, MetricsAccumulator>;
+    
 private:
     std::shared_ptr<SimpleDatabaseManager> db_manager_;
     std::unique_ptr<Logger> logger_;
     
+    // In-memory actual bars for per-prediction validation runs (null when not loaded)
+    std::unique_ptr<ActualsIndex> actuals_index_;
+    
+    MetricsAccumulatorMap metric_accumulators_;
+    MetricsAccumulatorMap pending_accumulators_;    // Validated since the last flush, persisted as deltas
+    std::map<RollingKey, RollingMetricsWindow> rolling_windows_;
+    BucketAccumulatorMap pending_buckets_;          // Per-symbol day deltas since the last flush
+    mutable std::mutex accumulators_mutex_;
+    
+    void record_validation(int model_id, const std::string& timeframe, int symbol_id,
+                           const std::string& prediction_time,
+                           double predicted, double actual, double accuracy);
+    void merge_bucket_locked(const BucketKey& key, const MetricsAccumulator& partial);
+    bool load_metric_accumulators();
+    bool seed_metric_accumulators_from_history();
+    bool load_rolling_buckets();
+    bool flush_rolling_buckets_locked();
+    
     bool update_model_standard_deviation(const ModelMetrics& metrics);
     std::string get_current_timestamp();
     
@@ -47,14 +88,56 @@ public:
     
     bool validate_daily_predictions(const std::string& symbol = "");
     bool validate_intraday_predictions(const std::string& timeframe, const std::string& symbol = "");
-    bool validate_all_pending_predictions();
+    // Bulk mode partitions the backlog by symbol and timeframe across
+    // ValidationScheduler workers with pooled connections (workers 0 = one per
+    // hardware thread); workers 1 runs one statement per timeframe here.
+    bool validate_all_pending_predictions(bool bulk = true, std::size_t workers = 0);
+    
+    // Set-based validation: matches every pending prediction of a timeframe to
+    // its actual bar and writes the results in a single UPDATE ... FROM.
+    // Returns the number of predictions validated, or -1 on failure.
+    int validate_pending_predictions_bulk(const std::string& timeframe);
+    
+    // The UPDATE ... FROM behind bulk validation, optionally limited to one
+    // symbol. It returns model_id, timeframe, predicted, actual and accuracy
+    // for every validated row. Empty for an unknown timeframe.
+    static std::string build_bulk_validation_query(const std::string& timeframe, int symbol_id = -1);
     
     ValidationResult validate_single_prediction(int prediction_id);
     bool update_prediction_validation(const ValidationResult& result);
     
     ModelMetrics calculate_model_metrics(int model_id, const std::string& timeframe, int lookback_days = 30);
+    
+    // Predictions made in the last lookback_days (all history when 0), validated
+    // or not; -1 on failure
+    int count_predictions(int model_id, const std::string& timeframe, int lookback_days = 0);
     bool update_model_performance(const ModelMetrics& metrics);
     
+    // O(1) metrics from the streaming accumulators (all validated history)
+    ModelMetrics get_streaming_metrics(int model_id, const std::string& timeframe) const;
+    bool update_model_performance(int model_id, const std::string& timeframe);
+    
+    // Fold in partial states built elsewhere, e.g. by parallel workers
+    void merge_metric_accumulators(const MetricsAccumulatorMap& partials);
+    void merge_rolling_buckets(const BucketAccumulatorMap& partials);
+    
+    // Persist what was validated since the last flush. The database merges
+    // each delta into its stored row, so validators sharing a row add up.
+    bool flush_metric_accumulators();
+    
+    // O(1) metrics over the last 7, 30 or 90 days (by prediction day)
+    ModelMetrics get_rolling_metrics(int model_id, const std::string& timeframe, int window_days,
+                                     int symbol_id = ALL_SYMBOLS);
+    
+    static std::string base_timeframe(const std::string& timeframe);
+    static ModelMetrics to_model_metrics(int model_id, const std::string& timeframe, const MetricsAccumulator& acc);
+    static long long day_number(const std::string& timestamp);   // Days since 1970-01-01, -1 if malformed
+    static long long today_day_number();
+    
+    // Bulk-load recent bars so actual price lookups resolve in memory
+    bool load_actuals_index(int days_back = 30);
+    void clear_actuals_index();
+    
     std::vector<int> get_unvalidated_predictions(const std::string& timeframe = "");
     double get_actual_price_for_prediction(int prediction_id, const std::string& timeframe,
                                          const std::string& symbol, const std::string& prediction_time);
@@ -0,0 +1,228 @@
+#pragma once
+
+#include "database_simple.h"
+#include "TradingCalendar.h"
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <iostream>
+#include <cstddef>
+
+// ==============================================
+// ACTUALS INDEX - IN-MEMORY BAR LOOKUP FOR VALIDATION
+// ==============================================
+
+// Validation needs the actual bar behind each prediction. Asking the database
+// once per prediction makes a validation run latency-bound. This index
+// instead loads the whole validation window with one bulk read per historical
+// table, keeps each (symbol, timeframe) series as sorted timestamp/OHLC
+// arrays, and resolves every lookup with a binary search.
+//
+// Timestamps are the bar's wall-clock date/time as stored (no time zone
+// conversion), counted in seconds, which matches how the SQL lookups compare
+// them. Daily bars use midnight of their date.
+struct ActualBar {
+    long long timestamp = 0;
+    double open = 0.0;
+    double high = 0.0;
+    double low = 0.0;
+    double close = 0.0;
+};
+
+class ActualsIndex {
+public:
+    // Load every bar from the last `days_back` days for all symbols and
+    // timeframes, replacing whatever was loaded before
+    bool load(SimpleDatabaseManager& db, int days_back) {
+        series_.clear();
+        bar_count_ = 0;
+        loaded_ = false;
+
+        for (const char* timeframe : TIMEFRAMES) {
+            if (!load_table(db, timeframe, days_back)) {
+                std::cerr << "[ERROR] ActualsIndex: failed to load " << timeframe << " bars" << std::endl;
+                series_.clear();
+                bar_count_ = 0;
+                return false;
+            }
+        }
+
+        window_start_ = 0;
+        for (const auto& [key, series] : series_) {
+            if (!series.timestamps.empty() && (window_start_ == 0 || series.timestamps.front() < window_start_)) {
+                window_start_ = series.timestamps.front();
+            }
+        }
+
+        loaded_ = true;
+        std::cout << "[INFO] ActualsIndex: loaded " << bar_count_ << " bars in " << series_.size()
+                  << " series (" << days_back << " days)" << std::endl;
+        return true;
+    }
+
+    void clear() {
+        series_.clear();
+        bar_count_ = 0;
+        window_start_ = 0;
+        loaded_ = false;
+    }
+
+    // Bar starting exactly at `timestamp`
+    const ActualBar* find_exact(const std::string& symbol, const std::string& timeframe, long long timestamp) const {
+        const Series* series = find_series(symbol, timeframe);
+        if (!series) return nullptr;
+
+        auto it = std::lower_bound(series->timestamps.begin(), series->timestamps.end(), timestamp);
+        if (it == series->timestamps.end() || *it != timestamp) return nullptr;
+        return &series->bars[it - series->timestamps.begin()];
+    }
+
+    // First bar starting strictly after `timestamp`
+    const ActualBar* find_first_after(const std::string& symbol, const std::string& timeframe, long long timestamp) const {
+        const Series* series = find_series(symbol, timeframe);
+        if (!series) return nullptr;
+
+        auto it = std::upper_bound(series->timestamps.begin(), series->timestamps.end(), timestamp);
+        if (it == series->timestamps.end()) return nullptr;
+        return &series->bars[it - series->timestamps.begin()];
+    }
+
+    // Every loaded bar of one series in time order; null if none were loaded
+    const std::vector<ActualBar>* bars(const std::string& symbol, const std::string& timeframe) const {
+        const Series* series = find_series(symbol, timeframe);
+        return series ? &series->bars : nullptr;
+    }
+
+    // Distinct symbols with at least one loaded series, sorted
+    std::vector<std::string> symbols() const {
+        std::vector<std::string> result;
+        for (const auto& [key, series] : series_) {
+            result.push_back(key.substr(0, key.find('|')));
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        return result;
+    }
+
+    // Install one series directly (bars sorted by timestamp), e.g. for
+    // benchmarks and replay tests that run without a database
+    void add_series(const std::string& symbol, const std::string& timeframe, std::vector<ActualBar> bars) {
+        Series& series = series_[series_key(symbol, timeframe)];
+        bar_count_ += bars.size() - series.bars.size();
+        series.timestamps.clear();
+        series.timestamps.reserve(bars.size());
+        for (const ActualBar& bar : bars) {
+            series.timestamps.push_back(bar.timestamp);
+            if (window_start_ == 0 || bar.timestamp < window_start_) window_start_ = bar.timestamp;
+        }
+        series.bars = std::move(bars);
+        loaded_ = true;
+    }
+
+    // A lookup at or after the earliest loaded bar can be answered from
+    // memory when it finds a bar; a miss still needs the database, since the
+    // symbol may have no series here or its bar may be newer than the load
+    bool covers(long long timestamp) const { return loaded_ && window_start_ != 0 && timestamp >= window_start_; }
+
+    bool is_loaded() const { return loaded_; }
+    std::size_t series_count() const { return series_.size(); }
+    std::size_t bar_count() const { return bar_count_; }
+
+    // "YYYY-MM-DD" or "YYYY-MM-DD HH:MM:SS[...]" -> seconds; -1 if malformed
+    static long long parse_timestamp(const std::string& text) {
+        if (text.size() < 10 || text[4] != '-' || text[7] != '-') return -1;
+
+        int year = digits(text, 0, 4), month = digits(text, 5, 2), day = digits(text, 8, 2);
+        if (year < 0 || month < 1 || month > 12 || day < 1 || day > 31) return -1;
+
+        long long seconds = TradingCalendar::days_from_civil(year, static_cast<unsigned>(month),
+                                                             static_cast<unsigned>(day)) * 86400LL;
+        if (text.size() >= 19 && (text[10] == ' ' || text[10] == 'T')) {
+            int hour = digits(text, 11, 2), minute = digits(text, 14, 2), second = digits(text, 17, 2);
+            if (hour < 0 || minute < 0 || second < 0) return -1;
+            seconds += hour * 3600LL + minute * 60LL + second;
+        }
+        return seconds;
+    }
+
+private:
+    struct Series {
+        std::vector<long long> timestamps;   // Sorted, searched on their own for cache locality
+        std::vector<ActualBar> bars;
+    };
+
+    static constexpr const char* TIMEFRAMES[] = { "daily", "15min", "30min", "1hour", "2hours" };
+
+    std::unordered_map<std::string, Series> series_;
+    std::size_t bar_count_ = 0;
+    long long window_start_ = 0;
+    bool loaded_ = false;
+
+    static std::string series_key(const std::string& symbol, const std::string& timeframe) {
+        return symbol + '|' + timeframe;
+    }
+
+    const Series* find_series(const std::string& symbol, const std::string& timeframe) const {
+        auto it = series_.find(series_key(symbol, timeframe));
+        return it == series_.end() ? nullptr : &it->second;
+    }
+
+    bool load_table(SimpleDatabaseManager& db, const std::string& timeframe, int days_back) {
+        bool daily = timeframe == "daily";
+
+        std::string window_start = "CURRENT_DATE - " + std::to_string(days_back);
+        std::string query = "SELECT s.symbol, h.fetch_date, " + std::string(daily ? "NULL" : "h.fetch_time") +
+            ", h.open_price, h.high_price, h.low_price, h.close_price "
+            "FROM historical_fetch_" + timeframe + " h "
+            "JOIN symbols s ON h.symbol_id = s.symbol_id "
+            "WHERE " + (daily ? "h.fetch_date >= " + window_start
+                              : "h.bar_ts >= ((" + window_start + ")::timestamp AT TIME ZONE 'UTC')") + " "
+            "ORDER BY s.symbol, " + (daily ? "h.fetch_date" : "h.bar_ts");
+
+        PGresult* result = db.execute_query_with_result(query);
+        if (!result) return false;
+
+        int rows = PQntuples(result);
+        Series* series = nullptr;
+        std::string current_symbol;
+
+        for (int i = 0; i < rows; i++) {
+            std::string symbol = PQgetvalue(result, i, 0);
+            if (!series || symbol != current_symbol) {
+                current_symbol = symbol;
+                series = &series_[series_key(symbol, timeframe)];
+            }
+
+            std::string stamp = PQgetvalue(result, i, 1);
+            if (!daily) {
+                stamp += ' ';
+                stamp += PQgetvalue(result, i, 2);
+            }
+
+            ActualBar bar;
+            bar.timestamp = parse_timestamp(stamp);
+            if (bar.timestamp < 0) continue;
+            bar.open = std::stod(PQgetvalue(result, i, 3));
+            bar.high = std::stod(PQgetvalue(result, i, 4));
+            bar.low = std::stod(PQgetvalue(result, i, 5));
+            bar.close = std::stod(PQgetvalue(result, i, 6));
+
+            series->timestamps.push_back(bar.timestamp);
+            series->bars.push_back(bar);
+            bar_count_++;
+        }
+
+        PQclear(result);
+        return true;
+    }
+
+    static int digits(const std::string& text, std::size_t pos, std::size_t count) {
+        int value = 0;
+        for (std::size_t i = pos; i < pos + count; i++) {
+            if (i >= text.size() || text[i] < '0' || text[i] > '9') return -1;
+            value = value * 10 + (text[i] - '0');
+        }
+        return value;
+    }
+};
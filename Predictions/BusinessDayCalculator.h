@@ -5,52 +5,42 @@
 #include <vector>
 #include <sstream>
 #include <iomanip>
+#include <algorithm>
+#include "TradingCalendar.h"
 
 // ==============================================
 // BUSINESS DAY CALCULATOR UTILITY
 // ==============================================
 
+// Business days are exchange trade dates from the shared TradingCalendar
+// (weekends and exchange holidays excluded); each call converts its time
+// point to a local date once and the calendar does the rest. That
+// conversion calls localtime_r/_s at most once per local day and thread.
 class BusinessDayCalculator {
 public:
-    // Check if a given date is a business day (Monday-Friday)
+    // Check if a given date is a business day (a trade date)
     static bool is_business_day(const std::chrono::system_clock::time_point& date) {
-        auto time_t = std::chrono::system_clock::to_time_t(date);
-        auto tm = *std::localtime(&time_t);
-        
-        // Sunday = 0, Monday = 1, ..., Saturday = 6
-        int day_of_week = tm.tm_wday;
-        
-        // Monday (1) through Friday (5) are business days
-        return (day_of_week >= 1 && day_of_week <= 5);
+        return TradingCalendar::instance().is_trading_day(local_day(date));
     }
     
-    // Get the next business day after the given date
+    // Get the next business day after the given date (same time of day)
     static std::chrono::system_clock::time_point get_next_business_day(
         const std::chrono::system_clock::time_point& date) {
         
-        auto next_day = date + std::chrono::hours(24);
-        
-        while (!is_business_day(next_day)) {
-            next_day += std::chrono::hours(24);
-        }
-        
-        return next_day;
+        long long day = local_day(date);
+        return date + std::chrono::hours(24 * (TradingCalendar::instance().next_session(day) - day));
     }
     
-    // Get the previous business day before the given date
+    // Get the previous business day before the given date (same time of day)
     static std::chrono::system_clock::time_point get_previous_business_day(
         const std::chrono::system_clock::time_point& date) {
         
-        auto prev_day = date - std::chrono::hours(24);
-        
-        while (!is_business_day(prev_day)) {
-            prev_day -= std::chrono::hours(24);
-        }
-        
-        return prev_day;
+        long long day = local_day(date);
+        return date - std::chrono::hours(24 * (day - TradingCalendar::instance().previous_session(day)));
     }
     
-    // Calculate number of business days between two dates
+    // Calculate number of business days between two dates: the days
+    // start_date + k * 24h that are still before end_date
     static int count_business_days_between(
         const std::chrono::system_clock::time_point& start_date,
         const std::chrono::system_clock::time_point& end_date) {
@@ -59,53 +49,75 @@ public:
             return 0;
         }
         
-        int count = 0;
-        auto current = start_date;
+        auto span = end_date - start_date;
+        long long days = std::chrono::duration_cast<std::chrono::hours>(span).count() / 24;
+        if (start_date + std::chrono::hours(24 * days) < end_date) {
+            days++;
+        }
+        
+        long long first = local_day(start_date);
+        return TradingCalendar::instance().sessions_between(first, first + days);
+    }
+    
+    // Local calendar date as a civil day number (days since 1970-01-01).
+    // The span of the last day looked up is cached per thread, an hour
+    // short at each end so a daylight-saving change cannot stretch it.
+    static long long local_day(const std::chrono::system_clock::time_point& date) {
+        struct CachedDay {
+            std::time_t from = 0;
+            std::time_t to = 0;
+            long long day = 0;
+        };
+        thread_local CachedDay cached;
         
-        while (current < end_date) {
-            if (is_business_day(current)) {
-                count++;
-            }
-            current += std::chrono::hours(24);
+        std::time_t time = std::chrono::system_clock::to_time_t(date);
+        if (time >= cached.from && time < cached.to) {
+            return cached.day;
         }
         
-        return count;
+        std::tm tm = local_time(time);
+        long long of_day = tm.tm_hour * 3600LL + tm.tm_min * 60LL + tm.tm_sec;
+        cached.from = time - static_cast<std::time_t>(std::max(0LL, of_day - 3600));
+        cached.to = time + static_cast<std::time_t>(std::max(1LL, 86400 - 3600 - of_day));
+        cached.day = TradingCalendar::days_from_civil(tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1),
+                                                      static_cast<unsigned>(tm.tm_mday));
+        return cached.day;
+    }
+    
+    // Thread-safe localtime
+    static std::tm local_time(std::time_t time) {
+        std::tm tm{};
+#ifdef _WIN32
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        return tm;
     }
     
     // Get day of week as string
     static std::string get_day_name(const std::chrono::system_clock::time_point& date) {
-        auto time_t = std::chrono::system_clock::to_time_t(date);
-        auto tm = *std::localtime(&time_t);
-        
-        const std::vector<std::string> day_names = {
+        static const char* const day_names[] = {
             "Sunday", "Monday", "Tuesday", "Wednesday", 
             "Thursday", "Friday", "Saturday"
         };
         
-        return day_names[tm.tm_wday];
+        return day_names[TradingCalendar::weekday(local_day(date))];
     }
     
     // Check if it's Friday (needs Monday prediction)
     static bool is_friday(const std::chrono::system_clock::time_point& date) {
-        auto time_t = std::chrono::system_clock::to_time_t(date);
-        auto tm = *std::localtime(&time_t);
-        return tm.tm_wday == 5; // Friday = 5
+        return TradingCalendar::weekday(local_day(date)) == 5; // Friday = 5
     }
     
     // Get date string in YYYY-MM-DD format
     static std::string format_date(const std::chrono::system_clock::time_point& date) {
-        auto time_t = std::chrono::system_clock::to_time_t(date);
-        auto tm = *std::localtime(&time_t);
-        
-        char buffer[32];
-        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d", &tm);
-        return std::string(buffer);
+        return TradingCalendar::format_day(local_day(date));
     }
     
     // Get datetime string in ISO format for database
     static std::string format_datetime(const std::chrono::system_clock::time_point& date) {
-        auto time_t = std::chrono::system_clock::to_time_t(date);
-        auto tm = *std::localtime(&time_t);
+        auto tm = local_time(std::chrono::system_clock::to_time_t(date));
         
         char buffer[64];
         std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", &tm);
@@ -136,8 +148,7 @@ public:
     // Check if current time is after market close (assuming 4 PM ET)
     static bool is_after_market_close() {
         auto et_now = get_current_et();
-        auto time_t = std::chrono::system_clock::to_time_t(et_now);
-        auto tm = *std::localtime(&time_t);
+        auto tm = local_time(std::chrono::system_clock::to_time_t(et_now));
         
         // Market closes at 4 PM (16:00)
         return tm.tm_hour >= 16;
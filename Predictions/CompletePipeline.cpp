@@ -20,6 +20,7 @@
 #include "../IQFeedConnection/OneHourDataFetcher.h"
 #include "../IQFeedConnection/TwoHourDataFetcher.h"
 #include "../IQFeedConnection/HistoricalDataFetcher.h"
+#include "../IQFeedConnection/Tracer.h"
 
 // ==============================================
 // COMPLETE END-TO-END PIPELINE WITH INTRADAY
@@ -80,6 +81,11 @@ public:
         two_hour_fetcher = std::make_unique<TwoHourDataFetcher>(iqfeed_manager);
         std::cout << "✅ All timeframe data fetchers ready" << std::endl;
         
+        if (Tracer::enabled()) {
+            Tracer::instance().set_thread_name("pipeline");
+            std::cout << "🔎 Tracing to " << Tracer::instance().output_path() << std::endl;
+        }
+        
         is_initialized = true;
         std::cout << "🎉 COMPLETE PIPELINE WITH INTRADAY READY!" << std::endl;
     }
@@ -97,6 +103,7 @@ public:
         std::cout << "📡 Fetching " << timeframe << " data for " << symbol << "..." << std::endl;
         
         bool fetch_success = false;
+        TraceSpan fetch_span("pipeline", "fetch", symbol, timeframe);
         
         if (timeframe == "15min") {
             fetch_success = fifteen_min_fetcher->fetch_historical_data(symbol, bars_to_fetch, bars);
@@ -107,6 +114,7 @@ public:
         } else if (timeframe == "2hours") {
             fetch_success = two_hour_fetcher->fetch_historical_data(symbol, bars_to_fetch, bars);
         }
+        fetch_span.end();
         
         if (!fetch_success) {
             std::cout << "❌ Failed to fetch " << timeframe << " data" << std::endl;
@@ -133,6 +141,7 @@ public:
     bool persist_intraday_bars(const std::string& symbol, 
                                const std::string& timeframe,
                                const std::vector<HistoricalBar>& bars) {
+        NEXDAY_TRACE_SPAN("pipeline", "persist", symbol, timeframe);
         
         std::cout << "💾 Persisting " << timeframe << " historical data to database..." << std::endl;
         std::cout << "[DEBUG] Symbol: " << symbol << std::endl;
@@ -199,20 +208,19 @@ public:
     bool process_intraday_predictions(const std::string& symbol, 
                                      const std::string& timeframe,
                                      const std::vector<HistoricalBar>& bars) {
+        NEXDAY_TRACE_SPAN("pipeline", "predict", symbol, timeframe);
         
         std::cout << "🧮 Calculating " << timeframe << " EMA predictions..." << std::endl;
         
-        // Extract OHLC price series
-        std::vector<double> high_prices, low_prices;
-        
-        for (const auto& bar : bars) {
-            high_prices.push_back(bar.high);
-            low_prices.push_back(bar.low);
-        }
-        
-        // Calculate EMA predictions for High/Low (intraday focuses on range)
-        double predicted_high = SimpleEMACalculator::calculate_prediction(high_prices);
-        double predicted_low = SimpleEMACalculator::calculate_prediction(low_prices);
+        // Calculate EMA predictions for High/Low (intraday focuses on range),
+        // both fields in one kernel pass
+        static constexpr double HistoricalBar::* high_low_fields[] = { &HistoricalBar::high, &HistoricalBar::low };
+        double high_low[2] = { 0.0, 0.0 };
+        TraceSpan ema_span("pipeline", "ema", symbol, timeframe);
+        SimpleEMACalculator::calculate_predictions(bars, high_low_fields, high_low);
+        ema_span.end();
+        double predicted_high = high_low[0];
+        double predicted_low = high_low[1];
         
         if (predicted_high == 0.0 || predicted_low == 0.0) {
             std::cout << "❌ " << timeframe << " EMA calculation failed" << std::endl;
@@ -228,6 +236,7 @@ public:
         (void)current_time; // placeholder if needed for logging
         std::string target_time = get_next_interval_time(timeframe);
         
+        NEXDAY_TRACE_SPAN("pipeline", "save", symbol, timeframe);
         bool high_saved = PredictionPersister::save_prediction_components(
             *db_manager, symbol, timeframe, timeframe + "_high", predicted_high, target_time);
             
@@ -308,16 +317,41 @@ public:
             return false;
         }
         
+        bool pipeline_success = run_pipeline_steps(symbol);
+        export_trace();
+        return pipeline_success;
+    }
+    
+    // Write this run's spans to NEXDAY_TRACE_FILE when it is set
+    void export_trace() {
+        Tracer& tracer = Tracer::instance();
+        if (!Tracer::enabled() || tracer.output_path().empty()) {
+            return;
+        }
+        std::string error;
+        if (tracer.write_chrome_trace(tracer.output_path(), error)) {
+            std::cout << "🔎 Trace written to " << tracer.output_path()
+                      << " (open in chrome://tracing or ui.perfetto.dev)" << std::endl;
+        } else {
+            std::cout << "❌ Trace export failed: " << error << std::endl;
+        }
+    }
+    
+    // Steps 1-6 of execute_complete_pipeline, traced as one "pipeline" span
+    bool run_pipeline_steps(const std::string& symbol) {
+        NEXDAY_TRACE_SPAN("pipeline", "pipeline", symbol);
         bool pipeline_success = true;
         
         // STEP 1: FETCH DAILY DATA (unchanged)
         std::cout << "\n📡 STEP 1: Fetching daily historical data from IQFeed..." << std::endl;
         
         std::vector<HistoricalBar> daily_bars;
+        TraceSpan fetch_span("pipeline", "fetch", symbol, "daily");
         if (!daily_fetcher->fetch_historical_data(symbol, 100, daily_bars)) {
             std::cout << "❌ Failed to fetch daily data from IQFeed" << std::endl;
             return false;
         }
+        fetch_span.end();
         
         std::cout << "✅ Retrieved " << daily_bars.size() << " daily bars from IQFeed" << std::endl;
         
@@ -330,12 +364,14 @@ public:
         std::cout << "\n💾 STEP 2: Persisting daily historical data to database..." << std::endl;
         
         int saved_daily_bars = 0;
+        TraceSpan persist_span("pipeline", "persist", symbol, "daily");
         for (const auto& bar : daily_bars) {
             if (db_manager->insert_historical_data_daily(symbol, bar.date, 
                 bar.open, bar.high, bar.low, bar.close, bar.volume, bar.open_interest)) {
                 saved_daily_bars++;
             }
         }
+        persist_span.end();
         
         std::cout << "✅ Saved " << saved_daily_bars << "/" << daily_bars.size() << " daily bars to database" << std::endl;
         
@@ -367,21 +403,18 @@ public:
         // STEP 4: CALCULATE AND SAVE DAILY PREDICTIONS
         std::cout << "\n🧮 STEP 4: Calculating daily EMA predictions..." << std::endl;
         
-        // Extract OHLC price series from daily data
-        std::vector<double> daily_open_prices, daily_high_prices, daily_low_prices, daily_close_prices;
-        
-        for (const auto& bar : daily_bars) {
-            daily_open_prices.push_back(bar.open);
-            daily_high_prices.push_back(bar.high);
-            daily_low_prices.push_back(bar.low);
-            daily_close_prices.push_back(bar.close);
-        }
-        
-        // Calculate daily EMA predictions
-        double predicted_open = SimpleEMACalculator::calculate_prediction(daily_open_prices);
-        double predicted_high = SimpleEMACalculator::calculate_prediction(daily_high_prices);
-        double predicted_low = SimpleEMACalculator::calculate_prediction(daily_low_prices);
-        double predicted_close = SimpleEMACalculator::calculate_prediction(daily_close_prices);
+        // Calculate daily EMA predictions for all four OHLC fields in one kernel pass
+        static constexpr double HistoricalBar::* ohlc_fields[] = {
+            &HistoricalBar::open, &HistoricalBar::high, &HistoricalBar::low, &HistoricalBar::close
+        };
+        double ohlc[4] = { 0.0, 0.0, 0.0, 0.0 };
+        TraceSpan ema_span("pipeline", "ema", symbol, "daily");
+        SimpleEMACalculator::calculate_predictions(daily_bars, ohlc_fields, ohlc);
+        ema_span.end();
+        double predicted_open = ohlc[0];
+        double predicted_high = ohlc[1];
+        double predicted_low = ohlc[2];
+        double predicted_close = ohlc[3];
         
         if (predicted_open == 0.0 || predicted_high == 0.0 || predicted_low == 0.0 || predicted_close == 0.0) {
             std::cout << "❌ Daily EMA calculation failed" << std::endl;
@@ -408,7 +441,10 @@ public:
         daily_prediction.prediction_time = PredictionPersister::get_current_timestamp();
         daily_prediction.confidence_score = 0.75;
         
-        if (!PredictionPersister::save_daily_prediction(*db_manager, daily_prediction)) {
+        TraceSpan save_span("pipeline", "save", symbol, "daily");
+        bool daily_saved = PredictionPersister::save_daily_prediction(*db_manager, daily_prediction);
+        save_span.end();
+        if (!daily_saved) {
             std::cout << "❌ Failed to save daily prediction to database" << std::endl;
             pipeline_success = false;
         } else {
@@ -419,6 +455,7 @@ public:
         std::cout << "\n📈 STEP 6: Calculating prediction errors..." << std::endl;
         
         if (daily_bars.size() >= 20) {
+            NEXDAY_TRACE_SPAN("pipeline", "validate", symbol, "daily");
             double last_actual_close = daily_bars[0].close; // Latest bar
             std::string sample_prediction_time = PredictionPersister::get_current_timestamp();
             
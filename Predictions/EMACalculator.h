@@ -6,6 +6,8 @@
 #include <iomanip>
 #include <numeric>
 #include <algorithm>
+#include "EMATrace.h"
+#include "EMAKernel.h"
 
 // ==============================================
 // SIMPLE EMA CALCULATOR WITH WORKING LOGIC
@@ -13,61 +15,65 @@
 
 class SimpleEMACalculator {
 private:
-    static constexpr double BASE_ALPHA = 0.5;  // Working value: base_alpha = 0.5
+    static constexpr double BASE_ALPHA = EMAKernel::BASE_ALPHA;  // Working value: base_alpha = 0.5
     static constexpr int MIN_BARS_REQUIRED = 15;  // Need 15 bars minimum for SMA10 bootstrap
+    static constexpr int SMA_PERIODS = 10;        // SMA1 through SMA10
+    static constexpr int SMA_WINDOW = 5;          // 5-bar rolling windows
     
-public:
-    // Main calculation method - returns prediction for next bar
-    static double calculate_prediction(const std::vector<double>& price_data) {
-        if (price_data.size() < MIN_BARS_REQUIRED) {
-            std::cout << "❌ Insufficient data: " << price_data.size() 
+    // Original layout of this calculator: reversed series, SMA1..SMA10, EMA from bar 11
+    static constexpr EMALayout LAYOUT = EMAKernel::OVERLAPPED;
+    
+    static bool has_enough_bars(std::size_t count) {
+        if (count < MIN_BARS_REQUIRED) {
+            std::cout << "❌ Insufficient data: " << count 
                       << " bars (need " << MIN_BARS_REQUIRED << "+)" << std::endl;
+            return false;
+        }
+        return true;
+    }
+    
+public:
+    // Main calculation method - returns prediction for next bar.
+    // Allocation-free unless a trace is supplied (and even then only the
+    // caller's buffers are written).
+    static double calculate_prediction(const std::vector<double>& price_data, EMATrace* trace = nullptr) {
+        if (!has_enough_bars(price_data.size())) {
             return 0.0;
         }
         
-        // Reverse data so newest is at index 0 (IQFeed format)
-        std::vector<double> data = price_data;
-        std::reverse(data.begin(), data.end());
-        
-        // STEP 1: BOOTSTRAP PROCESS - Calculate SMA10 using 5-bar rolling windows
-        std::vector<double> sma_values;
-        
-        // Calculate SMA1 through SMA10 using 5-bar windows
-        for (int i = 0; i < 10; i++) {
-            double sum = 0.0;
-            for (int j = 0; j < 5; j++) {
-                sum += data[i + j];
-            }
-            double sma = sum / 5.0;
-            sma_values.push_back(sma);
+        // Reverse data so newest is at index 0 (IQFeed format) - done by indexing, not copying
+        return EMAKernel::predict(EMAKernel::view(price_data, true), LAYOUT, BASE_ALPHA, trace);
+    }
+    
+    // Same calculation reading one OHLC field straight out of a bar container,
+    // so callers don't have to build a temporary price vector per field.
+    template <typename Bar>
+    static double calculate_prediction(const std::vector<Bar>& bars, double Bar::*field, 
+                                       EMATrace* trace = nullptr) {
+        if (!has_enough_bars(bars.size())) {
+            return 0.0;
         }
         
-        // SMA10 becomes our initial previous_predict
-        double previous_predict = sma_values[9];  // SMA10 is the 10th value (index 9)
-        
-        // STEP 2: EMA CALCULATION SEQUENCE
-        // Start from bar 10 (index 10) since we used bars 0-13 for SMA calculations
-        std::vector<double> ema_results;
-        
-        for (size_t i = 10; i < data.size(); i++) {
-            double current_value = data[i];
-            
-            // EMA formula: predict_t = (base_alpha * current_value) + ((1 - base_alpha) * previous_predict)
-            double ema_predict = (BASE_ALPHA * current_value) + ((1 - BASE_ALPHA) * previous_predict);
-            
-            ema_results.push_back(ema_predict);
-            
-            // Update previous_predict for next iteration
-            previous_predict = ema_predict;
+        return EMAKernel::predict(EMAKernel::view(bars, field, true), LAYOUT, BASE_ALPHA, trace);
+    }
+    
+    // Several fields of the same bars in one pass (SIMD lanes across fields),
+    // e.g. { &Bar::open, &Bar::high, &Bar::low, &Bar::close }. Returns false
+    // and leaves `predictions` untouched when there is not enough data.
+    template <typename Bar, std::size_t N>
+    static bool calculate_predictions(const std::vector<Bar>& bars, double Bar::* const (&fields)[N],
+                                      double (&predictions)[N]) {
+        if (!has_enough_bars(bars.size())) {
+            return false;
         }
         
-        // Return the final EMA result as the prediction for the next bar
-        return ema_results.back();
+        EMAKernel::predict_fields(bars, fields, true, LAYOUT, predictions, BASE_ALPHA);
+        return true;
     }
     
-    // Debug method to show detailed calculation steps
-    static void print_calculation_debug(const std::vector<double>& price_data) {
-        if (price_data.size() < MIN_BARS_REQUIRED) {
+    // Debug method to show detailed calculation steps from a captured trace
+    static void print_calculation_debug(const std::vector<double>& price_data, const EMATrace& trace) {
+        if (price_data.size() < MIN_BARS_REQUIRED || trace.sma_count() < SMA_PERIODS) {
             std::cout << "❌ Cannot show debug: insufficient data" << std::endl;
             return;
         }
@@ -78,63 +84,69 @@ public:
         std::cout << "Base Alpha: " << BASE_ALPHA << std::endl;
         std::cout << "Min required bars: " << MIN_BARS_REQUIRED << std::endl;
         
-        // Reverse data for calculation
-        std::vector<double> data = price_data;
-        std::reverse(data.begin(), data.end());
+        // Reversed view of the input, matching the calculation order
+        const std::size_t n = price_data.size();
+        auto data = EMAKernel::view(price_data, true);
         
         std::cout << "\nSTEP 1: SMA BOOTSTRAP (5-bar rolling windows)" << std::endl;
         std::cout << "--------------------------------------------" << std::endl;
         
         // Show SMA calculations
-        std::vector<double> sma_values;
-        for (int i = 0; i < 10; i++) {
-            double sum = 0.0;
+        for (int i = 0; i < SMA_PERIODS; i++) {
             std::cout << "SMA" << (i+1) << ": bars " << i << "-" << (i+4) << " = ";
-            for (int j = 0; j < 5; j++) {
-                sum += data[i + j];
-                std::cout << std::fixed << std::setprecision(2) << data[i + j];
-                if (j < 4) std::cout << " + ";
+            for (int j = 0; j < SMA_WINDOW; j++) {
+                std::cout << std::fixed << std::setprecision(2) << data(i + j);
+                if (j < SMA_WINDOW - 1) std::cout << " + ";
             }
-            double sma = sum / 5.0;
-            sma_values.push_back(sma);
-            std::cout << " = " << std::fixed << std::setprecision(4) << sma << std::endl;
+            std::cout << " = " << std::fixed << std::setprecision(4) << trace.sma_values[i] << std::endl;
         }
         
         std::cout << "\nSTEP 2: EMA CALCULATION SEQUENCE" << std::endl;
         std::cout << "--------------------------------" << std::endl;
-        std::cout << "Initial previous_predict = SMA10 = " << std::fixed << std::setprecision(4) << sma_values[9] << std::endl;
+        std::cout << "Initial previous_predict = SMA10 = " << std::fixed << std::setprecision(4) 
+                  << trace.sma_values[SMA_PERIODS - 1] << std::endl;
         
-        double previous_predict = sma_values[9];
-        std::vector<double> ema_results;
+        double previous_predict = trace.sma_values[SMA_PERIODS - 1];
+        std::size_t shown = std::min(trace.ema_count(), std::size_t(10));  // Show first 10 EMA calculations
         
-        for (size_t i = 10; i < std::min(data.size(), size_t(20)); i++) {  // Show first 10 EMA calculations
-            double current_value = data[i];
-            double ema_predict = (BASE_ALPHA * current_value) + ((1 - BASE_ALPHA) * previous_predict);
+        for (std::size_t e = 0; e < shown; e++) {
+            std::size_t i = e + SMA_PERIODS;
+            double ema_predict = trace.ema_values[e];
             
-            std::cout << "EMA" << (i+1) << ": (" << BASE_ALPHA << " * " << std::fixed << std::setprecision(4) << current_value 
+            std::cout << "EMA" << (i+1) << ": (" << BASE_ALPHA << " * " << std::fixed << std::setprecision(4) << data(i) 
                       << ") + (" << (1-BASE_ALPHA) << " * " << previous_predict << ") = " 
                       << ema_predict << std::endl;
             
-            ema_results.push_back(ema_predict);
             previous_predict = ema_predict;
         }
         
-        if (data.size() > 20) {
-            std::cout << "... (continuing to bar " << data.size() << ")" << std::endl;
-            
-            // Complete the calculation without printing
-            for (size_t i = 20; i < data.size(); i++) {
-                double current_value = data[i];
-                double ema_predict = (BASE_ALPHA * current_value) + ((1 - BASE_ALPHA) * previous_predict);
-                ema_results.push_back(ema_predict);
-                previous_predict = ema_predict;
-            }
+        if (trace.ema_total > shown) {
+            std::cout << "... (continuing to bar " << n << ")" << std::endl;
         }
         
-        std::cout << "\nFINAL PREDICTION: " << std::fixed << std::setprecision(4) << ema_results.back() << std::endl;
+        if (trace.ema_count() == trace.ema_total && trace.ema_total > 0) {
+            std::cout << "\nFINAL PREDICTION: " << std::fixed << std::setprecision(4) 
+                      << trace.ema_values[trace.ema_total - 1] << std::endl;
+        }
         std::cout << "=================" << std::endl;
     }
     
+    // Convenience debug entry point: captures into local buffers, then prints.
+    // Diagnostic only - the allocation happens here, never in calculate_prediction.
+    static void print_calculation_debug(const std::vector<double>& price_data) {
+        if (price_data.size() < MIN_BARS_REQUIRED) {
+            std::cout << "❌ Cannot show debug: insufficient data" << std::endl;
+            return;
+        }
+        
+        double sma_buffer[SMA_PERIODS];
+        std::vector<double> ema_buffer(price_data.size() - SMA_PERIODS);
+        EMATrace trace(sma_buffer, SMA_PERIODS, ema_buffer.data(), ema_buffer.size());
+        
+        calculate_prediction(price_data, &trace);
+        print_calculation_debug(price_data, trace);
+    }
+    
     // Get the minimum bars required for calculation
     static int get_min_bars_required() {
         return MIN_BARS_REQUIRED;
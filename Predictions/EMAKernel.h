@@ -0,0 +1,229 @@
+#pragma once
+
+#include "EMATrace.h"
+#include <cstddef>
+#include <vector>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define EMA_KERNEL_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define EMA_KERNEL_SSE2 1
+#endif
+
+// ==============================================
+// EMA KERNEL - SHARED MODEL 1 IMPLEMENTATION
+// ==============================================
+
+// Every engine computes the Model 1 prediction through this header:
+//
+//   1. Bootstrap: sma_periods rolling SMAs of sma_window bars each; the last
+//      one seeds the recurrence.
+//   2. EMA: predict_t = (alpha * value_t) + ((1 - alpha) * predict_t-1) for
+//      every bar from ema_start to the end of the series.
+//
+// The engines historically disagree on where the EMA starts and how the
+// bootstrap is formed, so each layout below reproduces one of them exactly.
+// Series order is the caller's business: views index the data either as
+// stored or newest-first, without copying.
+struct EMALayout {
+    int sma_periods;   // Number of bootstrap SMAs (the last one seeds the EMA)
+    int sma_window;    // Bars per SMA window
+    int ema_start;     // First bar index fed into the EMA recurrence
+
+    // Bars needed before the layout can produce a value
+    std::size_t min_bars() const {
+        int bootstrap_end = sma_periods - 1 + sma_window;
+        return static_cast<std::size_t>(bootstrap_end > ema_start ? bootstrap_end : ema_start);
+    }
+};
+
+class EMAKernel {
+public:
+    static constexpr double BASE_ALPHA = 0.5;  // base_alpha = 2/(P+1) where P=3
+
+    // SMA1..SMA10 over 5-bar windows, EMA from bar 15 (MarketPredictionEngine, EMA tests)
+    static constexpr EMALayout STANDARD = { 10, 5, 14 };
+    // SMA1..SMA10 over 5-bar windows, EMA from bar 11 (SimpleEMACalculator / CompletePipeline)
+    static constexpr EMALayout OVERLAPPED = { 10, 5, 10 };
+    // Plain SMA of the first 10 bars, EMA from bar 11 (IntegratedMarketPredictionEngine)
+    static constexpr EMALayout SMA10_SEED = { 1, 10, 10 };
+
+    // ==============================================
+    // SERIES VIEWS
+    // ==============================================
+
+    // Plain array of values, optionally read newest-first
+    struct ValueView {
+        const double* values;
+        std::size_t count;
+        bool reversed;
+
+        double operator()(std::size_t k) const { return values[reversed ? count - 1 - k : k]; }
+        std::size_t size() const { return count; }
+    };
+
+    // One price field of a bar array, optionally read newest-first
+    template <typename Bar>
+    struct FieldView {
+        const Bar* bars;
+        std::size_t count;
+        double Bar::*field;
+        bool reversed;
+
+        double operator()(std::size_t k) const { return bars[reversed ? count - 1 - k : k].*field; }
+        std::size_t size() const { return count; }
+    };
+
+    static ValueView view(const std::vector<double>& values, bool reversed = false) {
+        return { values.data(), values.size(), reversed };
+    }
+
+    template <typename Bar>
+    static FieldView<Bar> view(const std::vector<Bar>& bars, double Bar::*field, bool reversed = false) {
+        return { bars.data(), bars.size(), field, reversed };
+    }
+
+    // ==============================================
+    // SCALAR KERNEL
+    // ==============================================
+
+    // Bootstrap SMAs; returns the seed (last SMA). Callers check min_bars().
+    template <typename View>
+    static double bootstrap(const View& series, const EMALayout& layout, EMATrace* trace = nullptr) {
+        double sma = 0.0;
+        for (int i = 0; i < layout.sma_periods; i++) {
+            double sum = 0.0;
+            for (int j = i; j < i + layout.sma_window; j++) {
+                sum += series(j);
+            }
+            sma = sum / layout.sma_window;
+            if (trace) trace->record_sma(sma);
+        }
+        return sma;
+    }
+
+    // EMA recurrence over [begin, series.size()) starting from seed
+    template <typename View>
+    static double run_ema(const View& series, std::size_t begin, double seed,
+                          double alpha = BASE_ALPHA, EMATrace* trace = nullptr) {
+        double previous_predict = seed;
+        const std::size_t end = series.size();
+        for (std::size_t i = begin; i < end; i++) {
+            previous_predict = (alpha * series(i)) + ((1.0 - alpha) * previous_predict);
+            if (trace) trace->record_ema(previous_predict);
+        }
+        return previous_predict;
+    }
+
+    // Full Model 1 prediction for the next bar. Allocation-free; the series
+    // must hold at least layout.min_bars() values.
+    template <typename View>
+    static double predict(const View& series, const EMALayout& layout,
+                          double alpha = BASE_ALPHA, EMATrace* trace = nullptr) {
+        if (trace) trace->reset();
+        double seed = bootstrap(series, layout, trace);
+        return run_ema(series, static_cast<std::size_t>(layout.ema_start), seed, alpha, trace);
+    }
+
+    // ==============================================
+    // SIMD KERNEL - SEVERAL FIELDS OF THE SAME BARS AT ONCE
+    // ==============================================
+
+    // The recurrence is serial in time, so the vector lanes run across price
+    // fields instead (O/H/L/C for daily, H/L for intraday). Each lane performs
+    // exactly the scalar operation sequence, so results match predict().
+    template <typename Bar, std::size_t N>
+    static void predict_fields(const std::vector<Bar>& bars, double Bar::* const (&fields)[N],
+                               bool reversed, const EMALayout& layout, double (&out)[N],
+                               double alpha = BASE_ALPHA) {
+        std::size_t lane = 0;
+#if defined(EMA_KERNEL_AVX)
+        for (; lane + 4 <= N; lane += 4) {
+            predict_lanes_avx(bars, fields + lane, reversed, layout, alpha, out + lane);
+        }
+#endif
+#if defined(EMA_KERNEL_SSE2)
+        for (; lane + 2 <= N; lane += 2) {
+            predict_lanes_sse2(bars, fields + lane, reversed, layout, alpha, out + lane);
+        }
+#endif
+        for (; lane < N; lane++) {
+            out[lane] = predict(view(bars, fields[lane], reversed), layout, alpha);
+        }
+    }
+
+    // Name of the widest vector path compiled in (for benchmark output)
+    static const char* simd_path() {
+#if defined(EMA_KERNEL_AVX)
+        return "AVX";
+#elif defined(EMA_KERNEL_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+
+private:
+    template <typename Bar>
+    static const Bar& bar_at(const std::vector<Bar>& bars, std::size_t k, bool reversed) {
+        return bars[reversed ? bars.size() - 1 - k : k];
+    }
+
+#if defined(EMA_KERNEL_SSE2)
+    template <typename Bar>
+    static void predict_lanes_sse2(const std::vector<Bar>& bars, double Bar::* const* fields,
+                                   bool reversed, const EMALayout& layout, double alpha, double* out) {
+        const __m128d window = _mm_set1_pd(static_cast<double>(layout.sma_window));
+        __m128d sma = _mm_setzero_pd();
+        for (int i = 0; i < layout.sma_periods; i++) {
+            __m128d sum = _mm_setzero_pd();
+            for (int j = i; j < i + layout.sma_window; j++) {
+                const Bar& bar = bar_at(bars, j, reversed);
+                sum = _mm_add_pd(sum, _mm_set_pd(bar.*fields[1], bar.*fields[0]));
+            }
+            sma = _mm_div_pd(sum, window);
+        }
+
+        const __m128d a = _mm_set1_pd(alpha);
+        const __m128d b = _mm_set1_pd(1.0 - alpha);
+        __m128d previous_predict = sma;
+        for (std::size_t i = static_cast<std::size_t>(layout.ema_start); i < bars.size(); i++) {
+            const Bar& bar = bar_at(bars, i, reversed);
+            __m128d current = _mm_set_pd(bar.*fields[1], bar.*fields[0]);
+            previous_predict = _mm_add_pd(_mm_mul_pd(a, current), _mm_mul_pd(b, previous_predict));
+        }
+        _mm_storeu_pd(out, previous_predict);
+    }
+#endif
+
+#if defined(EMA_KERNEL_AVX)
+    template <typename Bar>
+    static void predict_lanes_avx(const std::vector<Bar>& bars, double Bar::* const* fields,
+                                  bool reversed, const EMALayout& layout, double alpha, double* out) {
+        const __m256d window = _mm256_set1_pd(static_cast<double>(layout.sma_window));
+        __m256d sma = _mm256_setzero_pd();
+        for (int i = 0; i < layout.sma_periods; i++) {
+            __m256d sum = _mm256_setzero_pd();
+            for (int j = i; j < i + layout.sma_window; j++) {
+                const Bar& bar = bar_at(bars, j, reversed);
+                sum = _mm256_add_pd(sum, _mm256_set_pd(bar.*fields[3], bar.*fields[2],
+                                                       bar.*fields[1], bar.*fields[0]));
+            }
+            sma = _mm256_div_pd(sum, window);
+        }
+
+        const __m256d a = _mm256_set1_pd(alpha);
+        const __m256d b = _mm256_set1_pd(1.0 - alpha);
+        __m256d previous_predict = sma;
+        for (std::size_t i = static_cast<std::size_t>(layout.ema_start); i < bars.size(); i++) {
+            const Bar& bar = bar_at(bars, i, reversed);
+            __m256d current = _mm256_set_pd(bar.*fields[3], bar.*fields[2], bar.*fields[1], bar.*fields[0]);
+            previous_predict = _mm256_add_pd(_mm256_mul_pd(a, current), _mm256_mul_pd(b, previous_predict));
+        }
+        _mm256_storeu_pd(out, previous_predict);
+    }
+#endif
+};
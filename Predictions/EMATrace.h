@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+// ==============================================
+// EMA TRACE - OPT-IN DIAGNOSTIC CAPTURE
+// ==============================================
+
+// Caller-owned buffers that record the intermediate SMA bootstrap and EMA
+// chain of a Model 1 calculation. The production path passes no trace and
+// therefore never touches the heap; debug printers hand in a trace backed by
+// whatever storage they like (stack array, std::vector, arena slice).
+//
+// Values are written until a buffer is full; the *_total counters keep
+// counting so callers can tell a truncated capture from a complete one.
+struct EMATrace {
+    double* sma_values = nullptr;
+    std::size_t sma_capacity = 0;
+    std::size_t sma_total = 0;
+
+    double* ema_values = nullptr;
+    std::size_t ema_capacity = 0;
+    std::size_t ema_total = 0;
+
+    EMATrace() = default;
+    EMATrace(double* sma_buffer, std::size_t sma_size, double* ema_buffer, std::size_t ema_size)
+        : sma_values(sma_buffer), sma_capacity(sma_size), ema_values(ema_buffer), ema_capacity(ema_size) {}
+
+    void reset() {
+        sma_total = 0;
+        ema_total = 0;
+    }
+
+    void record_sma(double value) {
+        if (sma_total < sma_capacity) sma_values[sma_total] = value;
+        sma_total++;
+    }
+
+    void record_ema(double value) {
+        if (ema_total < ema_capacity) ema_values[ema_total] = value;
+        ema_total++;
+    }
+
+    // Number of values actually stored in each buffer
+    std::size_t sma_count() const { return sma_total < sma_capacity ? sma_total : sma_capacity; }
+    std::size_t ema_count() const { return ema_total < ema_capacity ? ema_total : ema_capacity; }
+};
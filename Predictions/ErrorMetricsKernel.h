@@ -0,0 +1,292 @@
+#pragma once
+
+#include <cstddef>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ERROR_METRICS_AVX 1
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ERROR_METRICS_SSE2 1
+#endif
+
+// ==============================================
+// ERROR METRICS KERNEL - FUSED SINGLE PASS
+// ==============================================
+
+struct ErrorMetrics {
+    double mae = 0.0;           // Mean Absolute Error
+    double rmse = 0.0;          // Root Mean Square Error
+    double mape = 0.0;          // Mean Absolute Percentage Error
+    double smape = 0.0;         // Symmetric Mean Absolute Percentage Error
+    double r_squared = 0.0;     // R-squared coefficient
+    double matthews_correlation = 0.0; // Matthews Correlation Coefficient
+    double directional_accuracy = 0.0; // Fraction (0-1) of correct direction predictions
+    double max_deviation = 0.0; // Maximum absolute deviation
+    double avg_deviation = 0.0; // Average absolute deviation
+    double ss_total = 0.0;      // Total sum of squares of actual values (0 for a flat series)
+    int sample_count = 0;       // Number of samples used in calculation
+};
+
+// Both prediction validators compute their error metrics here. One pass over
+// contiguous actual/predicted arrays accumulates every sum the metrics need,
+// instead of one loop per metric.
+//
+// R² needs the mean of the actuals before the pass, so the total sum of
+// squares is taken from sums shifted by the first actual value, which keeps
+// the usual one-pass formula accurate at price scale. Direction metrics are
+// only produced when the previous values (the price each prediction was made
+// from) are supplied.
+class ErrorMetricsKernel {
+public:
+    static ErrorMetrics compute(const double* actual, const double* predicted, std::size_t count,
+                                const double* previous = nullptr) {
+        ErrorMetrics metrics;
+        if (count == 0) return metrics;
+
+        Sums sums;
+        const double shift = actual[0];
+        std::size_t i = 0;
+#if defined(ERROR_METRICS_AVX)
+        i = accumulate_avx(actual, predicted, previous, count, shift, sums);
+#elif defined(ERROR_METRICS_SSE2)
+        i = accumulate_sse2(actual, predicted, previous, count, shift, sums);
+#endif
+        accumulate_scalar(actual, predicted, previous, i, count, shift, sums);
+
+        return finalize(sums, count, previous != nullptr);
+    }
+
+    static ErrorMetrics compute(const std::vector<double>& actual, const std::vector<double>& predicted) {
+        if (actual.size() != predicted.size()) return ErrorMetrics();
+        return compute(actual.data(), predicted.data(), actual.size());
+    }
+
+    static ErrorMetrics compute(const std::vector<double>& actual, const std::vector<double>& predicted,
+                                const std::vector<double>& previous) {
+        if (actual.size() != predicted.size() || actual.size() != previous.size()) return ErrorMetrics();
+        return compute(actual.data(), predicted.data(), actual.size(), previous.data());
+    }
+
+    // Name of the vector path compiled in (for benchmark output)
+    static const char* simd_path() {
+#if defined(ERROR_METRICS_AVX)
+        return "AVX";
+#elif defined(ERROR_METRICS_SSE2)
+        return "SSE2";
+#else
+        return "scalar";
+#endif
+    }
+
+private:
+    struct Sums {
+        double abs_error = 0.0;
+        double squared_error = 0.0;
+        double abs_pct_error = 0.0;      // |e| / |actual|, actual != 0
+        double smape_terms = 0.0;        // |e| / ((|actual| + |predicted|) / 2), denominator != 0
+        double max_abs_error = 0.0;
+        double shifted_actual = 0.0;     // sum(actual - shift)
+        double shifted_actual_sq = 0.0;  // sum((actual - shift)^2)
+        long long true_up = 0, true_down = 0, false_up = 0, false_down = 0;
+    };
+
+    static void accumulate_scalar(const double* actual, const double* predicted, const double* previous,
+                                  std::size_t begin, std::size_t end, double shift, Sums& sums) {
+        for (std::size_t i = begin; i < end; i++) {
+            double error = actual[i] - predicted[i];
+            double abs_error = std::abs(error);
+            sums.abs_error += abs_error;
+            sums.squared_error += error * error;
+            sums.max_abs_error = std::max(sums.max_abs_error, abs_error);
+
+            if (actual[i] != 0.0) {
+                sums.abs_pct_error += std::abs(error / actual[i]);
+            }
+            double denominator = (std::abs(actual[i]) + std::abs(predicted[i])) / 2.0;
+            if (denominator != 0.0) {
+                sums.smape_terms += abs_error / denominator;
+            }
+
+            double shifted = actual[i] - shift;
+            sums.shifted_actual += shifted;
+            sums.shifted_actual_sq += shifted * shifted;
+
+            if (previous) {
+                bool actual_up = actual[i] > previous[i];
+                bool predicted_up = predicted[i] > previous[i];
+                if (predicted_up) {
+                    (actual_up ? sums.true_up : sums.false_up)++;
+                } else {
+                    (actual_up ? sums.false_down : sums.true_down)++;
+                }
+            }
+        }
+    }
+
+    static void count_directions(int actual_up, int predicted_up, int lanes, Sums& sums) {
+        static const int BITS[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+        const int all = (1 << lanes) - 1;
+        sums.true_up += BITS[actual_up & predicted_up];
+        sums.false_up += BITS[~actual_up & predicted_up & all];
+        sums.false_down += BITS[actual_up & ~predicted_up & all];
+        sums.true_down += BITS[~actual_up & ~predicted_up & all];
+    }
+
+#if defined(ERROR_METRICS_AVX)
+    static std::size_t accumulate_avx(const double* actual, const double* predicted, const double* previous,
+                                      std::size_t count, double shift, Sums& sums) {
+        const __m256d sign_mask = _mm256_set1_pd(-0.0);
+        const __m256d zero = _mm256_setzero_pd();
+        const __m256d half = _mm256_set1_pd(0.5);
+        const __m256d shift_v = _mm256_set1_pd(shift);
+
+        __m256d abs_sum = zero, sq_sum = zero, pct_sum = zero, smape_sum = zero;
+        __m256d max_abs = zero, shifted_sum = zero, shifted_sq_sum = zero;
+
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256d a = _mm256_loadu_pd(actual + i);
+            __m256d p = _mm256_loadu_pd(predicted + i);
+            __m256d e = _mm256_sub_pd(a, p);
+            __m256d abs_e = _mm256_andnot_pd(sign_mask, e);
+
+            abs_sum = _mm256_add_pd(abs_sum, abs_e);
+            sq_sum = _mm256_add_pd(sq_sum, _mm256_mul_pd(e, e));
+            max_abs = _mm256_max_pd(max_abs, abs_e);
+
+            // Masked divisions: lanes with a zero denominator contribute nothing
+            __m256d abs_a = _mm256_andnot_pd(sign_mask, a);
+            __m256d pct = _mm256_div_pd(abs_e, abs_a);
+            pct_sum = _mm256_add_pd(pct_sum, _mm256_and_pd(pct, _mm256_cmp_pd(a, zero, _CMP_NEQ_OQ)));
+
+            __m256d denominator = _mm256_mul_pd(_mm256_add_pd(abs_a, _mm256_andnot_pd(sign_mask, p)), half);
+            __m256d smape = _mm256_div_pd(abs_e, denominator);
+            smape_sum = _mm256_add_pd(smape_sum, _mm256_and_pd(smape, _mm256_cmp_pd(denominator, zero, _CMP_NEQ_OQ)));
+
+            __m256d shifted = _mm256_sub_pd(a, shift_v);
+            shifted_sum = _mm256_add_pd(shifted_sum, shifted);
+            shifted_sq_sum = _mm256_add_pd(shifted_sq_sum, _mm256_mul_pd(shifted, shifted));
+
+            if (previous) {
+                __m256d prev = _mm256_loadu_pd(previous + i);
+                count_directions(_mm256_movemask_pd(_mm256_cmp_pd(a, prev, _CMP_GT_OQ)),
+                                 _mm256_movemask_pd(_mm256_cmp_pd(p, prev, _CMP_GT_OQ)), 4, sums);
+            }
+        }
+
+        sums.abs_error += horizontal_sum(abs_sum);
+        sums.squared_error += horizontal_sum(sq_sum);
+        sums.abs_pct_error += horizontal_sum(pct_sum);
+        sums.smape_terms += horizontal_sum(smape_sum);
+        sums.shifted_actual += horizontal_sum(shifted_sum);
+        sums.shifted_actual_sq += horizontal_sum(shifted_sq_sum);
+
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, max_abs);
+        for (double lane : lanes) sums.max_abs_error = std::max(sums.max_abs_error, lane);
+
+        return i;
+    }
+
+    static double horizontal_sum(__m256d v) {
+        alignas(32) double lanes[4];
+        _mm256_store_pd(lanes, v);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+#elif defined(ERROR_METRICS_SSE2)
+    static std::size_t accumulate_sse2(const double* actual, const double* predicted, const double* previous,
+                                       std::size_t count, double shift, Sums& sums) {
+        const __m128d sign_mask = _mm_set1_pd(-0.0);
+        const __m128d zero = _mm_setzero_pd();
+        const __m128d half = _mm_set1_pd(0.5);
+        const __m128d shift_v = _mm_set1_pd(shift);
+
+        __m128d abs_sum = zero, sq_sum = zero, pct_sum = zero, smape_sum = zero;
+        __m128d max_abs = zero, shifted_sum = zero, shifted_sq_sum = zero;
+
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2) {
+            __m128d a = _mm_loadu_pd(actual + i);
+            __m128d p = _mm_loadu_pd(predicted + i);
+            __m128d e = _mm_sub_pd(a, p);
+            __m128d abs_e = _mm_andnot_pd(sign_mask, e);
+
+            abs_sum = _mm_add_pd(abs_sum, abs_e);
+            sq_sum = _mm_add_pd(sq_sum, _mm_mul_pd(e, e));
+            max_abs = _mm_max_pd(max_abs, abs_e);
+
+            // Masked divisions: lanes with a zero denominator contribute nothing
+            __m128d abs_a = _mm_andnot_pd(sign_mask, a);
+            __m128d pct = _mm_div_pd(abs_e, abs_a);
+            pct_sum = _mm_add_pd(pct_sum, _mm_and_pd(pct, _mm_cmpneq_pd(a, zero)));
+
+            __m128d denominator = _mm_mul_pd(_mm_add_pd(abs_a, _mm_andnot_pd(sign_mask, p)), half);
+            __m128d smape = _mm_div_pd(abs_e, denominator);
+            smape_sum = _mm_add_pd(smape_sum, _mm_and_pd(smape, _mm_cmpneq_pd(denominator, zero)));
+
+            __m128d shifted = _mm_sub_pd(a, shift_v);
+            shifted_sum = _mm_add_pd(shifted_sum, shifted);
+            shifted_sq_sum = _mm_add_pd(shifted_sq_sum, _mm_mul_pd(shifted, shifted));
+
+            if (previous) {
+                __m128d prev = _mm_loadu_pd(previous + i);
+                count_directions(_mm_movemask_pd(_mm_cmpgt_pd(a, prev)),
+                                 _mm_movemask_pd(_mm_cmpgt_pd(p, prev)), 2, sums);
+            }
+        }
+
+        sums.abs_error += horizontal_sum(abs_sum);
+        sums.squared_error += horizontal_sum(sq_sum);
+        sums.abs_pct_error += horizontal_sum(pct_sum);
+        sums.smape_terms += horizontal_sum(smape_sum);
+        sums.shifted_actual += horizontal_sum(shifted_sum);
+        sums.shifted_actual_sq += horizontal_sum(shifted_sq_sum);
+
+        double lanes[2];
+        _mm_storeu_pd(lanes, max_abs);
+        sums.max_abs_error = std::max(sums.max_abs_error, std::max(lanes[0], lanes[1]));
+
+        return i;
+    }
+
+    static double horizontal_sum(__m128d v) {
+        double lanes[2];
+        _mm_storeu_pd(lanes, v);
+        return lanes[0] + lanes[1];
+    }
+#endif
+
+    static ErrorMetrics finalize(const Sums& sums, std::size_t count, bool has_direction) {
+        ErrorMetrics metrics;
+        const double n = static_cast<double>(count);
+
+        metrics.sample_count = static_cast<int>(count);
+        metrics.mae = sums.abs_error / n;
+        metrics.rmse = std::sqrt(sums.squared_error / n);
+        metrics.mape = (sums.abs_pct_error / n) * 100.0;
+        metrics.smape = (sums.smape_terms / n) * 100.0;
+        metrics.max_deviation = sums.max_abs_error;
+        metrics.avg_deviation = metrics.mae;
+
+        metrics.ss_total = std::max(0.0, sums.shifted_actual_sq - sums.shifted_actual * sums.shifted_actual / n);
+        metrics.r_squared = metrics.ss_total == 0.0 ? 1.0 : 1.0 - (sums.squared_error / metrics.ss_total);
+
+        if (has_direction) {
+            double tp = static_cast<double>(sums.true_up);
+            double tn = static_cast<double>(sums.true_down);
+            double fp = static_cast<double>(sums.false_up);
+            double fn = static_cast<double>(sums.false_down);
+
+            metrics.directional_accuracy = (tp + tn) / n;
+            double denominator = std::sqrt((tp + fp) * (tp + fn) * (tn + fp) * (tn + fn));
+            metrics.matthews_correlation = denominator > 0.0 ? (tp * tn - fp * fn) / denominator : 0.0;
+        }
+
+        return metrics;
+    }
+};
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "PredictionTypes.h"
+#include "EMAKernel.h"
+#include "PredictionCache.h"
 #include "BusinessDayCalculator.h"
 #include "database_simple.h"
 #include <memory>
@@ -8,6 +10,7 @@
 #include <map>
 #include <string>
 #include <chrono>
+#include <mutex>
 
 // ==============================================
 // MARKET PREDICTION ENGINE - EPOCH MARKET ADVISOR
@@ -20,6 +23,13 @@ private:
     std::string model_name_;
     std::string last_error_;
     
+    // Serializes menu-driven runs with event-driven runs (PredictionTrigger)
+    std::recursive_mutex engine_mutex_;
+    
+    // Memoized predictions keyed by latest input bar
+    PredictionCache<OHLCPrediction> daily_cache_;
+    PredictionCache<HighLowPrediction> intraday_cache_;
+    
     // Model parameters
     static constexpr double BASE_ALPHA = Model1Parameters::BASE_ALPHA;
     static constexpr int MINIMUM_BARS = Model1Parameters::MINIMUM_BARS;
@@ -38,10 +48,16 @@ public:
     // Specific prediction types
     OHLCPrediction generate_daily_prediction(const std::string& symbol);
     std::map<TimeFrame, HighLowPrediction> generate_intraday_predictions(const std::string& symbol);
+    HighLowPrediction generate_intraday_prediction(const std::string& symbol, TimeFrame timeframe);
+    
+    // Generate and persist the next-interval prediction for one timeframe
+    bool generate_prediction_for_timeframe(const std::string& symbol, TimeFrame timeframe);
     
-    // EMA calculation engine
+    // EMA calculation engine - allocation-free; pass a trace to capture the
+    // SMA bootstrap and EMA chain for debugging
     EMAResult calculate_ema_for_prediction(const std::vector<HistoricalBar>& historical_data,
-                                          const std::string& price_type = "close");
+                                          const std::string& price_type = "close",
+                                          EMATrace* trace = nullptr);
     
     // Historical data retrieval
     std::vector<HistoricalBar> get_historical_data(const std::string& symbol, 
@@ -49,7 +65,7 @@ public:
                                                   int num_bars = 100);
     
     // Database operations
-    bool save_prediction_to_database(const std::string& symbol, const OHLCPrediction& prediction);
+    bool save_daily_prediction_to_database(const std::string& symbol, const OHLCPrediction& prediction);
     bool save_intraday_prediction_to_database(const std::string& symbol, 
                                              const HighLowPrediction& prediction);
     
@@ -66,21 +82,22 @@ public:
     std::string get_last_error() const { return last_error_; }
     bool is_initialized() const { return db_manager_ && db_manager_->is_connected(); }
     
+    // Prediction cache
+    const PredictionCache<OHLCPrediction>& daily_cache() const { return daily_cache_; }
+    const PredictionCache<HighLowPrediction>& intraday_cache() const { return intraday_cache_; }
+    void clear_prediction_cache();
+    void print_cache_stats() const;
+    
     // Debug and logging
     void print_ema_calculation_debug(const std::vector<HistoricalBar>& data, 
-                                    const EMAResult& result);
+                                    const EMAResult& result,
+                                    const EMATrace& trace);
     void print_prediction_summary(const SymbolPrediction& prediction);
 
 private:
     // Internal EMA calculation helpers
-    double calculate_sma(const std::vector<double>& values, int start_index, int window_size);
-    std::vector<double> calculate_sma_bootstrap(const std::vector<double>& values);
-    std::vector<double> calculate_ema_sequence(const std::vector<double>& values, 
-                                              double initial_previous_predict);
-    
     // Historical data processing
-    std::vector<double> extract_price_series(const std::vector<HistoricalBar>& bars, 
-                                            const std::string& price_type);
+    static double HistoricalBar::* price_field(const std::string& price_type);
     bool validate_historical_data(const std::vector<HistoricalBar>& data);
     
     // Database table name helpers
@@ -88,6 +105,8 @@ private:
     std::string get_prediction_component_name(const std::string& base_name, TimeFrame timeframe);
     
     // Time and business day calculations
+    std::string format_timestamp(const std::chrono::system_clock::time_point& tp);
+    std::chrono::system_clock::time_point parse_date_string(const std::string& date_str);
     std::chrono::system_clock::time_point calculate_next_prediction_time(TimeFrame timeframe);
     std::chrono::system_clock::time_point get_latest_complete_bar_time(TimeFrame timeframe);
     
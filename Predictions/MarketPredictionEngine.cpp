@@ -1,9 +1,44 @@
 #include "MarketPredictionEngine.h"
+#include "MetricsRegistry.h"
+#include "Tracer.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
 #include <cmath>
+#include <ctime>
+
+namespace {
+    // Time and outcome of one prediction, recorded when it goes out of scope
+    class PredictionMetrics {
+    public:
+        explicit PredictionMetrics(const std::string& timeframe)
+            : timeframe_(timeframe),
+              timer_(MetricsRegistry::instance().histogram(
+                  "nexday_prediction_seconds", "Generating one prediction: history load, EMA, confidence",
+                  { { "engine", "market" }, { "timeframe", timeframe } })) {}
+
+        ~PredictionMetrics() {
+            timer_.stop();
+            MetricsRegistry::instance().counter(
+                "nexday_predictions_total", "Predictions by outcome (generated, cached, failed)",
+                { { "engine", "market" }, { "timeframe", timeframe_ }, { "result", result_ } }).inc();
+        }
+
+        void set_result(const char* result) { result_ = result; }
+
+    private:
+        std::string timeframe_;
+        const char* result_ = "failed";
+        ScopedTimer timer_;
+    };
+
+    Histogram& prediction_save_seconds() {
+        static Histogram& histogram = MetricsRegistry::instance().histogram(
+            "nexday_prediction_save_seconds", "Persisting one prediction", { { "engine", "market" } });
+        return histogram;
+    }
+}
 
 // ==============================================
 // CONSTRUCTOR AND INITIALIZATION
@@ -28,13 +63,15 @@ MarketPredictionEngine::MarketPredictionEngine(std::unique_ptr<SimpleDatabaseMan
 // ==============================================
 
 bool MarketPredictionEngine::generate_predictions_for_symbol(const std::string& symbol) {
+    std::lock_guard<std::recursive_mutex> lock(engine_mutex_);
     log_info("Generating predictions for symbol: " + symbol);
     
     try {
         // Generate daily prediction
         OHLCPrediction daily_pred = generate_daily_prediction(symbol);
-        if (daily_pred.confidence_score > 0.0) {
+        if (daily_pred.confidence_score > 0.0 && !daily_pred.from_cache) {
             if (!save_daily_prediction_to_database(symbol, daily_pred)) {
+                daily_cache_.invalidate(symbol, TimeFrame::DAILY, model_id_);
                 log_error("Failed to save daily prediction for " + symbol);
                 return false;
             }
@@ -43,8 +80,9 @@ bool MarketPredictionEngine::generate_predictions_for_symbol(const std::string&
         // Generate intraday predictions
         auto intraday_preds = generate_intraday_predictions(symbol);
         for (const auto& [timeframe, prediction] : intraday_preds) {
-            if (prediction.confidence_score > 0.0) {
+            if (prediction.confidence_score > 0.0 && !prediction.from_cache) {
                 if (!save_intraday_prediction_to_database(symbol, prediction)) {
+                    intraday_cache_.invalidate(symbol, timeframe, model_id_);
                     log_error("Failed to save intraday prediction for " + symbol + " " + 
                              timeframe_to_string(timeframe));
                 }
@@ -93,10 +131,14 @@ bool MarketPredictionEngine::generate_predictions_for_all_active_symbols() {
 
 OHLCPrediction MarketPredictionEngine::generate_daily_prediction(const std::string& symbol) {
     OHLCPrediction prediction;
+    PredictionMetrics metrics("daily");
+    NEXDAY_TRACE_SPAN("predict", "predict", symbol, "daily");
     
     try {
         // Get daily historical data - NOW USES REAL DATABASE QUERIES
+        TraceSpan load_span("predict", "load_history", symbol, "daily");
         auto historical_data = get_historical_data(symbol, TimeFrame::DAILY, 100);
+        load_span.end();
         
         if (historical_data.size() < MINIMUM_BARS) {
             set_error("Insufficient historical data for " + symbol + ": " + 
@@ -105,11 +147,23 @@ OHLCPrediction MarketPredictionEngine::generate_daily_prediction(const std::stri
             return prediction;
         }
         
+        // Unchanged inputs since the last run: reuse the already persisted prediction
+        auto last_bar_time = historical_data.back().timestamp;
+        auto input_fingerprint = PredictionCache<OHLCPrediction>::fingerprint(historical_data);
+        if (daily_cache_.lookup(symbol, TimeFrame::DAILY, model_id_, last_bar_time, input_fingerprint, prediction)) {
+            prediction.from_cache = true;
+            metrics.set_result("cached");
+            log_info("Daily prediction for " + symbol + " unchanged (no new bar) - using cached result");
+            return prediction;
+        }
+        
         // Calculate EMA for each OHLC component
+        TraceSpan ema_span("predict", "ema", symbol, "daily");
         auto open_ema = calculate_ema_for_prediction(historical_data, "open");
         auto high_ema = calculate_ema_for_prediction(historical_data, "high");
         auto low_ema = calculate_ema_for_prediction(historical_data, "low");
         auto close_ema = calculate_ema_for_prediction(historical_data, "close");
+        ema_span.end();
         
         // Verify all calculations are valid
         if (!open_ema.valid || !high_ema.valid || !low_ema.valid || !close_ema.valid) {
@@ -127,12 +181,16 @@ OHLCPrediction MarketPredictionEngine::generate_daily_prediction(const std::stri
         prediction.prediction_time = std::chrono::system_clock::now();
         
         // Calculate target time (next business day)
-        auto latest_bar_time = historical_data.back().timestamp;
-        prediction.target_time = BusinessDayCalculator::get_next_business_day(latest_bar_time);
+        prediction.target_time = BusinessDayCalculator::get_next_business_day(last_bar_time);
         
         // Calculate confidence score
         prediction.confidence_score = calculate_prediction_confidence(historical_data);
         
+        if (prediction.confidence_score > 0.0) {
+            daily_cache_.store(symbol, TimeFrame::DAILY, model_id_, last_bar_time, input_fingerprint, prediction);
+            metrics.set_result("generated");
+        }
+        
         log_info("Daily prediction generated for " + symbol + 
                 ": O=" + std::to_string(prediction.predicted_open) +
                 ", H=" + std::to_string(prediction.predicted_high) +
@@ -164,55 +222,141 @@ std::map<TimeFrame, HighLowPrediction> MarketPredictionEngine::generate_intraday
     };
     
     for (auto timeframe : timeframes) {
-        HighLowPrediction prediction;
-        prediction.timeframe = timeframe;
-        
-        try {
-            // Get historical data for this timeframe - NOW USES REAL DATABASE QUERIES
-            auto historical_data = get_historical_data(symbol, timeframe, 100);
-            
-            if (historical_data.size() < MINIMUM_BARS) {
-                log_error("Insufficient data for " + symbol + " " + timeframe_to_string(timeframe) +
-                         ": " + std::to_string(historical_data.size()) + " bars");
-                continue;
-            }
-            
-            // Calculate EMA for high and low
-            auto high_ema = calculate_ema_for_prediction(historical_data, "high");
-            auto low_ema = calculate_ema_for_prediction(historical_data, "low");
-            
-            if (!high_ema.valid || !low_ema.valid) {
-                log_error("EMA calculation failed for " + symbol + " " + timeframe_to_string(timeframe));
-                continue;
-            }
-            
-            // Set prediction values
-            prediction.predicted_high = high_ema.final_ema;
-            prediction.predicted_low = low_ema.final_ema;
-            
-            // Set timing information
-            prediction.prediction_time = std::chrono::system_clock::now();
-            prediction.target_time = calculate_next_prediction_time(timeframe);
-            
-            // Calculate confidence
-            prediction.confidence_score = calculate_prediction_confidence(historical_data);
-            
+        HighLowPrediction prediction = generate_intraday_prediction(symbol, timeframe);
+        if (prediction.confidence_score > 0.0) {
             predictions[timeframe] = prediction;
-            
-            log_info("Intraday prediction generated for " + symbol + " " + 
-                    timeframe_to_string(timeframe) +
-                    ": H=" + std::to_string(prediction.predicted_high) +
-                    ", L=" + std::to_string(prediction.predicted_low));
-            
-        } catch (const std::exception& e) {
-            log_error("Exception generating intraday prediction for " + symbol + " " +
-                     timeframe_to_string(timeframe) + ": " + e.what());
         }
     }
     
     return predictions;
 }
 
+HighLowPrediction MarketPredictionEngine::generate_intraday_prediction(const std::string& symbol, 
+                                                                    TimeFrame timeframe) {
+    HighLowPrediction prediction;
+    prediction.timeframe = timeframe;
+    const std::string timeframe_name = timeframe_to_string(timeframe);
+    PredictionMetrics metrics(timeframe_name);
+    NEXDAY_TRACE_SPAN("predict", "predict", symbol, timeframe_name);
+    
+    try {
+        // Get historical data for this timeframe - NOW USES REAL DATABASE QUERIES
+        TraceSpan load_span("predict", "load_history", symbol, timeframe_name);
+        auto historical_data = get_historical_data(symbol, timeframe, 100);
+        load_span.end();
+        
+        if (historical_data.size() < MINIMUM_BARS) {
+            log_error("Insufficient data for " + symbol + " " + timeframe_to_string(timeframe) +
+                     ": " + std::to_string(historical_data.size()) + " bars");
+            return prediction;
+        }
+        
+        // Unchanged inputs since the last run: reuse the already persisted prediction
+        auto last_bar_time = historical_data.back().timestamp;
+        auto input_fingerprint = PredictionCache<HighLowPrediction>::fingerprint(historical_data);
+        if (intraday_cache_.lookup(symbol, timeframe, model_id_, last_bar_time, input_fingerprint, prediction)) {
+            prediction.from_cache = true;
+            metrics.set_result("cached");
+            log_info("Intraday prediction for " + symbol + " " + timeframe_to_string(timeframe) +
+                    " unchanged (no new bar) - using cached result");
+            return prediction;
+        }
+        
+        // Calculate EMA for high and low
+        TraceSpan ema_span("predict", "ema", symbol, timeframe_name);
+        auto high_ema = calculate_ema_for_prediction(historical_data, "high");
+        auto low_ema = calculate_ema_for_prediction(historical_data, "low");
+        ema_span.end();
+        
+        if (!high_ema.valid || !low_ema.valid) {
+            log_error("EMA calculation failed for " + symbol + " " + timeframe_to_string(timeframe));
+            return prediction;
+        }
+        
+        // Set prediction values
+        prediction.predicted_high = high_ema.final_ema;
+        prediction.predicted_low = low_ema.final_ema;
+        
+        // Set timing information
+        prediction.prediction_time = std::chrono::system_clock::now();
+        prediction.target_time = calculate_next_prediction_time(timeframe);
+        
+        // Calculate confidence
+        prediction.confidence_score = calculate_prediction_confidence(historical_data);
+        
+        if (prediction.confidence_score > 0.0) {
+            intraday_cache_.store(symbol, timeframe, model_id_, last_bar_time, input_fingerprint, prediction);
+            metrics.set_result("generated");
+        }
+        
+        log_info("Intraday prediction generated for " + symbol + " " + 
+                timeframe_to_string(timeframe) +
+                ": H=" + std::to_string(prediction.predicted_high) +
+                ", L=" + std::to_string(prediction.predicted_low));
+        
+    } catch (const std::exception& e) {
+        log_error("Exception generating intraday prediction for " + symbol + " " +
+                 timeframe_to_string(timeframe) + ": " + e.what());
+    }
+    
+    return prediction;
+}
+
+// ==============================================
+// SINGLE TIMEFRAME PREDICTION (EVENT-DRIVEN)
+// ==============================================
+
+bool MarketPredictionEngine::generate_prediction_for_timeframe(const std::string& symbol, TimeFrame timeframe) {
+    std::lock_guard<std::recursive_mutex> lock(engine_mutex_);
+    
+    if (timeframe == TimeFrame::DAILY) {
+        OHLCPrediction daily_pred = generate_daily_prediction(symbol);
+        if (daily_pred.confidence_score <= 0.0) {
+            return false;
+        }
+        if (daily_pred.from_cache) {
+            return true;
+        }
+        if (!save_daily_prediction_to_database(symbol, daily_pred)) {
+            daily_cache_.invalidate(symbol, TimeFrame::DAILY, model_id_);
+            return false;
+        }
+        return true;
+    }
+    
+    HighLowPrediction prediction = generate_intraday_prediction(symbol, timeframe);
+    if (prediction.confidence_score <= 0.0) {
+        return false;
+    }
+    if (prediction.from_cache) {
+        return true;
+    }
+    
+    if (!save_intraday_prediction_to_database(symbol, prediction)) {
+        intraday_cache_.invalidate(symbol, timeframe, model_id_);
+        log_error("Failed to save intraday prediction for " + symbol + " " + timeframe_to_string(timeframe));
+        return false;
+    }
+    return true;
+}
+
+// ==============================================
+// PREDICTION CACHE
+// ==============================================
+
+void MarketPredictionEngine::clear_prediction_cache() {
+    daily_cache_.clear();
+    intraday_cache_.clear();
+    log_info("Prediction cache cleared");
+}
+
+void MarketPredictionEngine::print_cache_stats() const {
+    std::cout << "\n=== PREDICTION CACHE ===" << std::endl;
+    daily_cache_.print_stats("Daily");
+    intraday_cache_.print_stats("Intraday");
+    std::cout << "========================\n" << std::endl;
+}
+
 // ==============================================
 // FIXED HISTORICAL DATA RETRIEVAL - REAL DATABASE QUERIES
 // ==============================================
@@ -246,7 +390,7 @@ std::vector<HistoricalBar> MarketPredictionEngine::get_historical_data(
             query << "SELECT fetch_date, fetch_time, open_price, high_price, low_price, close_price, volume ";
             query << "FROM " << table_name << " ";
             query << "WHERE symbol_id = " << symbol_id << " ";
-            query << "ORDER BY fetch_date DESC, fetch_time DESC ";
+            query << "ORDER BY bar_ts DESC ";
             query << "LIMIT " << num_bars;
         }
         
@@ -309,6 +453,8 @@ std::vector<HistoricalBar> MarketPredictionEngine::get_historical_data(
 
 bool MarketPredictionEngine::save_daily_prediction_to_database(const std::string& symbol, 
                                                               const OHLCPrediction& prediction) {
+    ScopedTimer timer(prediction_save_seconds());
+    NEXDAY_TRACE_SPAN("predict", "save", symbol, "daily");
     try {
         int symbol_id = get_symbol_id(symbol);
         if (symbol_id == -1) {
@@ -392,6 +538,8 @@ bool MarketPredictionEngine::save_daily_prediction_to_database(const std::string
 
 bool MarketPredictionEngine::save_intraday_prediction_to_database(const std::string& symbol,
                                                                  const HighLowPrediction& prediction) {
+    ScopedTimer timer(prediction_save_seconds());
+    NEXDAY_TRACE_SPAN("predict", "save", symbol, timeframe_to_string(prediction.timeframe));
     try {
         int symbol_id = get_symbol_id(symbol);
         if (symbol_id == -1) {
@@ -554,40 +702,24 @@ int MarketPredictionEngine::get_or_create_model_id() {
 // ==============================================
 
 EMAResult MarketPredictionEngine::calculate_ema_for_prediction(
-    const std::vector<HistoricalBar>& historical_data, const std::string& price_type) {
+    const std::vector<HistoricalBar>& historical_data, const std::string& price_type, EMATrace* trace) {
     
     EMAResult result;
     
     try {
-        // Extract price series
-        auto price_series = extract_price_series(historical_data, price_type);
-        
-        if (price_series.size() < MINIMUM_BARS) {
-            set_error("Insufficient data points: " + std::to_string(price_series.size()));
-            return result;
-        }
+        // Resolve the price column once and read it straight from the bars
+        double HistoricalBar::*field = price_field(price_type);
         
-        // Step 1: Calculate SMA bootstrap (SMA1 through SMA10)
-        result.sma_values = calculate_sma_bootstrap(price_series);
-        
-        if (result.sma_values.size() != SMA_PERIODS) {
-            set_error("SMA bootstrap failed: expected " + std::to_string(SMA_PERIODS) + 
-                     " values, got " + std::to_string(result.sma_values.size()));
+        if (historical_data.size() < MINIMUM_BARS) {
+            set_error("Insufficient data points: " + std::to_string(historical_data.size()));
             return result;
         }
         
-        // Step 2: Use SMA10 as initial previous_predict for EMA sequence
-        double initial_previous_predict = result.sma_values.back(); // SMA10
-        
-        // Step 3: Calculate EMA sequence starting from bar 15 (index 14)
-        std::vector<double> ema_input_series(price_series.begin() + 14, price_series.end());
-        result.ema_values = calculate_ema_sequence(ema_input_series, initial_previous_predict);
-        
-        if (!result.ema_values.empty()) {
-            result.final_ema = result.ema_values.back();
-            result.valid = true;
-            result.bars_used = price_series.size();
-        }
+        // SMA1..SMA10 bootstrap, then EMA from bar 15 (index 14) - shared Model 1 kernel
+        result.final_ema = EMAKernel::predict(EMAKernel::view(historical_data, field),
+                                              EMAKernel::STANDARD, BASE_ALPHA, trace);
+        result.valid = true;
+        result.bars_used = historical_data.size();
         
     } catch (const std::exception& e) {
         set_error("Exception in calculate_ema_for_prediction: " + std::string(e.what()));
@@ -596,76 +728,15 @@ EMAResult MarketPredictionEngine::calculate_ema_for_prediction(
     return result;
 }
 
-std::vector<double> MarketPredictionEngine::calculate_sma_bootstrap(const std::vector<double>& values) {
-    std::vector<double> sma_values;
-    sma_values.reserve(SMA_PERIODS);
-    
-    // Calculate SMA1 through SMA10 using 5-bar rolling windows
-    for (int i = 0; i < SMA_PERIODS; i++) {
-        double sma = calculate_sma(values, i, SMA_WINDOW);
-        sma_values.push_back(sma);
-    }
-    
-    return sma_values;
-}
-
-double MarketPredictionEngine::calculate_sma(const std::vector<double>& values, 
-                                           int start_index, int window_size) {
-    if (start_index + window_size > values.size()) {
-        return 0.0; // Not enough data
-    }
-    
-    double sum = 0.0;
-    for (int i = start_index; i < start_index + window_size; i++) {
-        sum += values[i];
-    }
-    
-    return sum / window_size;
-}
-
-std::vector<double> MarketPredictionEngine::calculate_ema_sequence(
-    const std::vector<double>& values, double initial_previous_predict) {
-    
-    std::vector<double> ema_values;
-    ema_values.reserve(values.size());
-    
-    double previous_predict = initial_previous_predict;
-    
-    // Apply Model 1 Standard formula: predict_t = (base_alpha * current_value) + ((1 - base_alpha) * previous_predict)
-    for (double current_value : values) {
-        double predict_t = (BASE_ALPHA * current_value) + ((1.0 - BASE_ALPHA) * previous_predict);
-        ema_values.push_back(predict_t);
-        previous_predict = predict_t; // This prediction becomes previous_predict for next iteration
-    }
-    
-    return ema_values;
-}
-
 // ==============================================
 // REMAINING METHODS - ENHANCED ERROR HANDLING
 // ==============================================
 
-std::vector<double> MarketPredictionEngine::extract_price_series(
-    const std::vector<HistoricalBar>& bars, const std::string& price_type) {
-    
-    std::vector<double> prices;
-    prices.reserve(bars.size());
-    
-    for (const auto& bar : bars) {
-        if (price_type == "open") {
-            prices.push_back(bar.open);
-        } else if (price_type == "high") {
-            prices.push_back(bar.high);
-        } else if (price_type == "low") {
-            prices.push_back(bar.low);
-        } else if (price_type == "close") {
-            prices.push_back(bar.close);
-        } else {
-            prices.push_back(bar.close); // Default to close
-        }
-    }
-    
-    return prices;
+double HistoricalBar::* MarketPredictionEngine::price_field(const std::string& price_type) {
+    if (price_type == "open") return &HistoricalBar::open;
+    if (price_type == "high") return &HistoricalBar::high;
+    if (price_type == "low") return &HistoricalBar::low;
+    return &HistoricalBar::close; // "close" and default
 }
 
 double MarketPredictionEngine::calculate_prediction_confidence(
@@ -722,7 +793,8 @@ void MarketPredictionEngine::log_error(const std::string& message) {
 // ==============================================
 
 void MarketPredictionEngine::print_ema_calculation_debug(const std::vector<HistoricalBar>& data, 
-                                                        const EMAResult& result) {
+                                                        const EMAResult& result,
+                                                        const EMATrace& trace) {
     std::cout << "\n=== EMA CALCULATION DEBUG ===" << std::endl;
     std::cout << "Historical data points: " << data.size() << std::endl;
     std::cout << "Minimum required: " << MINIMUM_BARS << std::endl;
@@ -734,16 +806,21 @@ void MarketPredictionEngine::print_ema_calculation_debug(const std::vector<Histo
     }
     
     std::cout << "\nSMA Bootstrap (SMA1-SMA10):" << std::endl;
-    for (size_t i = 0; i < result.sma_values.size(); i++) {
+    for (size_t i = 0; i < trace.sma_count(); i++) {
         std::cout << "SMA" << (i+1) << ": " << std::fixed << std::setprecision(4) 
-                  << result.sma_values[i] << std::endl;
+                  << trace.sma_values[i] << std::endl;
     }
     
-    std::cout << "\nEMA Sequence (last 10 values):" << std::endl;
-    size_t start_idx = result.ema_values.size() > 10 ? result.ema_values.size() - 10 : 0;
-    for (size_t i = start_idx; i < result.ema_values.size(); i++) {
+    std::cout << "\nEMA Sequence (last 10 captured values):" << std::endl;
+    size_t captured = trace.ema_count();
+    size_t start_idx = captured > 10 ? captured - 10 : 0;
+    for (size_t i = start_idx; i < captured; i++) {
         std::cout << "EMA" << (i + 15) << ": " << std::fixed << std::setprecision(4) 
-                  << result.ema_values[i] << std::endl;
+                  << trace.ema_values[i] << std::endl;
+    }
+    if (trace.ema_total > captured) {
+        std::cout << "(trace truncated: " << captured << " of " << trace.ema_total 
+                  << " EMA values captured)" << std::endl;
     }
     
     std::cout << "\nFinal EMA for prediction: " << std::fixed << std::setprecision(4) 
@@ -162,10 +162,14 @@ public:
         }
         
         // Test EMA calculation
-        auto ema_result = prediction_engine_->calculate_ema_for_prediction(test_data, "close");
+        std::vector<double> sma_buffer(Model1Parameters::SMA_PERIODS);
+        std::vector<double> ema_buffer(test_data.size());
+        EMATrace trace(sma_buffer.data(), sma_buffer.size(), ema_buffer.data(), ema_buffer.size());
+        
+        auto ema_result = prediction_engine_->calculate_ema_for_prediction(test_data, "close", &trace);
         
         if (ema_result.valid) {
-            prediction_engine_->print_ema_calculation_debug(test_data, ema_result);
+            prediction_engine_->print_ema_calculation_debug(test_data, ema_result, trace);
             std::cout << "EMA calculation test: PASSED" << std::endl;
             return true;
         } else {
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "PredictionTypes.h"
+#include <map>
+#include <mutex>
+#include <tuple>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+
+// ==============================================
+// PREDICTION CACHE - MEMOIZED BY LATEST INPUT BAR
+// ==============================================
+
+// A prediction depends only on the input window, so it is memoized per
+// (symbol, timeframe, model) together with the timestamp of the newest bar
+// it was computed from. Only the latest entry per series is kept.
+//
+// An entry is reused only when the newest bar timestamp AND a fingerprint of
+// the whole input window match. A matching timestamp with a different
+// fingerprint means bars were restated (late corrections, re-fetch); the
+// entry is dropped and the prediction recomputed.
+template <typename Prediction>
+class PredictionCache {
+private:
+    using SeriesKey = std::tuple<std::string, TimeFrame, int>;  // symbol, timeframe, model_id
+
+    struct Entry {
+        std::chrono::system_clock::time_point last_bar_time;
+        std::uint64_t input_fingerprint;
+        Prediction prediction;
+    };
+
+    std::map<SeriesKey, Entry> entries_;
+    mutable std::mutex mutex_;
+
+    std::atomic<long long> hits_{0};
+    std::atomic<long long> misses_{0};
+    std::atomic<long long> restatements_{0};
+
+public:
+    // FNV-1a over timestamps and OHLCV of every bar in the window
+    static std::uint64_t fingerprint(const std::vector<HistoricalBar>& bars) {
+        std::uint64_t hash = 14695981039346656037ULL;
+        auto mix = [&hash](const void* data, std::size_t size) {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ULL;
+            }
+        };
+
+        for (const auto& bar : bars) {
+            long long ticks = bar.timestamp.time_since_epoch().count();
+            mix(&ticks, sizeof(ticks));
+            mix(&bar.open, sizeof(bar.open));
+            mix(&bar.high, sizeof(bar.high));
+            mix(&bar.low, sizeof(bar.low));
+            mix(&bar.close, sizeof(bar.close));
+            mix(&bar.volume, sizeof(bar.volume));
+        }
+        return hash;
+    }
+
+    // Returns true and fills `prediction` when the inputs are unchanged
+    bool lookup(const std::string& symbol, TimeFrame timeframe, int model_id,
+                std::chrono::system_clock::time_point last_bar_time, std::uint64_t input_fingerprint,
+                Prediction& prediction) {
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        auto it = entries_.find(SeriesKey(symbol, timeframe, model_id));
+        if (it != entries_.end() && it->second.last_bar_time == last_bar_time) {
+            if (it->second.input_fingerprint == input_fingerprint) {
+                hits_++;
+                prediction = it->second.prediction;
+                return true;
+            }
+
+            // Same newest bar, different inputs: a restatement
+            restatements_++;
+            entries_.erase(it);
+        }
+
+        misses_++;
+        return false;
+    }
+
+    void store(const std::string& symbol, TimeFrame timeframe, int model_id,
+               std::chrono::system_clock::time_point last_bar_time, std::uint64_t input_fingerprint,
+               const Prediction& prediction) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_[SeriesKey(symbol, timeframe, model_id)] = Entry{ last_bar_time, input_fingerprint, prediction };
+    }
+
+    // Drop a series, e.g. after its prediction failed to persist
+    void invalidate(const std::string& symbol, TimeFrame timeframe, int model_id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.erase(SeriesKey(symbol, timeframe, model_id));
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+    }
+
+    // Statistics
+    long long hits() const { return hits_.load(); }
+    long long misses() const { return misses_.load(); }
+    long long restatements() const { return restatements_.load(); }
+
+    std::size_t size() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return entries_.size();
+    }
+
+    double hit_rate() const {
+        long long total = hits() + misses();
+        return total > 0 ? static_cast<double>(hits()) / total : 0.0;
+    }
+
+    void print_stats(const std::string& name) const {
+        std::cout << name << ": " << hits() << " hits, " << misses() << " misses, "
+                  << restatements() << " restatements, " << size() << " entries ("
+                  << static_cast<int>(hit_rate() * 100.0 + 0.5) << "% hit rate)" << std::endl;
+    }
+};
@@ -7,6 +7,8 @@
 #include <iomanip>
 #include <sstream>
 #include "../Database/database_simple.h"
+#include "TradingCalendar.h"
+#include "BusinessDayCalculator.h"
 
 // ==============================================
 // OHLC PREDICTION STRUCTURE
@@ -31,38 +33,13 @@ class PredictionPersister {
 public:
     // Get current timestamp in proper format
     static std::string get_current_timestamp() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        
-        std::stringstream ss;
-        ss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-        return ss.str();
+        return BusinessDayCalculator::format_datetime(std::chrono::system_clock::now());
     }
     
-    // Get next business day (handles weekend skipping)
+    // Get next business day (skips weekends and exchange holidays)
     static std::string get_next_business_day() {
-        auto now = std::chrono::system_clock::now();
-        auto time_t = std::chrono::system_clock::to_time_t(now);
-        auto tm = *std::localtime(&time_t);
-        
-        // Add one day
-        tm.tm_mday += 1;
-        mktime(&tm);  // Normalize the date
-        
-        // Check if it's weekend and skip to Monday
-        int day_of_week = tm.tm_wday;
-        
-        if (day_of_week == 0) {  // Sunday -> Monday
-            tm.tm_mday += 1;
-            mktime(&tm);
-        } else if (day_of_week == 6) {  // Saturday -> Monday
-            tm.tm_mday += 2;
-            mktime(&tm);
-        }
-        
-        std::stringstream ss;
-        ss << std::put_time(&tm, "%Y-%m-%d");
-        return ss.str();
+        long long today = BusinessDayCalculator::local_day(std::chrono::system_clock::now());
+        return TradingCalendar::format_day(TradingCalendar::instance().next_session(today));
     }
     
     // Save daily OHLC prediction to predictions_daily table (ACTUAL SCHEMA)
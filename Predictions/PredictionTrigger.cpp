@@ -0,0 +1,111 @@
+#include "PredictionTrigger.h"
+#include <iostream>
+#include <iomanip>
+
+// ==============================================
+// CONSTRUCTOR AND SUBSCRIPTION
+// ==============================================
+
+PredictionTrigger::PredictionTrigger(MarketPredictionEngine& engine, std::shared_ptr<BarEventBus> event_bus)
+    : engine_(engine), event_bus_(event_bus), subscription_id_(-1),
+      predictions_triggered_(0), predictions_failed_(0) {
+    
+    if (event_bus_) {
+        subscription_id_ = event_bus_->subscribe([this](const NewBarEvent& event) { on_new_bar(event); });
+        log_info("Subscribed to new bar events");
+    }
+}
+
+PredictionTrigger::~PredictionTrigger() {
+    if (event_bus_ && subscription_id_ != -1) {
+        event_bus_->unsubscribe(subscription_id_);
+    }
+}
+
+// ==============================================
+// EVENT HANDLING
+// ==============================================
+
+void PredictionTrigger::on_new_bar(const NewBarEvent& event) {
+    TimeFrame timeframe;
+    if (!to_timeframe(event.timeframe, timeframe)) {
+        log_error("Ignoring bar with unknown timeframe: " + event.timeframe);
+        return;
+    }
+    
+    predictions_triggered_++;
+    
+    if (!engine_.generate_prediction_for_timeframe(event.symbol, timeframe)) {
+        predictions_failed_++;
+        log_error("Triggered prediction failed for " + event.symbol + " " + event.timeframe + ": " +
+                 engine_.get_last_error());
+        return;
+    }
+    
+    // Prediction is persisted - measure from the moment the bar closed
+    auto now = std::chrono::system_clock::now();
+    histogram_for(event.timeframe).observe(now - event.bar_close_time);
+    
+    auto close_to_persist_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - event.bar_close_time).count();
+    auto dispatch_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now - event.persisted_time).count();
+    log_info("Prediction persisted for " + event.symbol + " " + event.timeframe + " bar " +
+            event.bar_date + " " + event.bar_time + " (bar close -> prediction " +
+            std::to_string(close_to_persist_ms) + " ms, of which bar save -> prediction " +
+            std::to_string(dispatch_ms) + " ms)");
+}
+
+Histogram& PredictionTrigger::histogram_for(const std::string& timeframe) {
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    auto& histogram = latency_by_timeframe_[timeframe];
+    if (!histogram) {
+        histogram = &MetricsRegistry::instance().histogram(
+            "nexday_bar_to_prediction_seconds", "Bar close to event-driven prediction persisted",
+            { { "timeframe", timeframe } }, MetricsRegistry::wait_buckets());
+    }
+    return *histogram;
+}
+
+bool PredictionTrigger::to_timeframe(const std::string& scheduler_timeframe, TimeFrame& timeframe) {
+    if (scheduler_timeframe == "15min") timeframe = TimeFrame::MINUTES_15;
+    else if (scheduler_timeframe == "30min") timeframe = TimeFrame::MINUTES_30;
+    else if (scheduler_timeframe == "1hour") timeframe = TimeFrame::HOUR_1;
+    else if (scheduler_timeframe == "2hours" || scheduler_timeframe == "2hour") timeframe = TimeFrame::HOURS_2;
+    else if (scheduler_timeframe == "daily") timeframe = TimeFrame::DAILY;
+    else return false;
+    return true;
+}
+
+// ==============================================
+// STATUS
+// ==============================================
+
+void PredictionTrigger::print_latency_summary() const {
+    std::cout << "\n=== BAR CLOSE -> PREDICTION LATENCY ===" << std::endl;
+    std::cout << "Triggered: " << predictions_triggered_.load() 
+              << ", failed: " << predictions_failed_.load() << std::endl;
+    
+    std::lock_guard<std::mutex> lock(latency_mutex_);
+    if (latency_by_timeframe_.empty()) {
+        std::cout << "No event-driven predictions yet" << std::endl;
+    }
+    for (const auto& [timeframe, histogram] : latency_by_timeframe_) {
+        HistogramSnapshot samples = histogram->snapshot();
+        double mean = samples.count > 0 ? samples.sum / static_cast<double>(samples.count) : 0.0;
+        std::cout << "  " << timeframe << ": " << std::fixed << std::setprecision(1)
+                  << "samples=" << samples.count
+                  << " mean=" << mean * 1000.0 << "ms"
+                  << " p50<=" << samples.quantile(0.50) * 1000.0 << "ms"
+                  << " p95<=" << samples.quantile(0.95) * 1000.0 << "ms"
+                  << " p99<=" << samples.quantile(0.99) * 1000.0 << "ms"
+                  << std::defaultfloat << std::endl;
+    }
+    std::cout << "=======================================\n" << std::endl;
+}
+
+void PredictionTrigger::log_info(const std::string& message) {
+    std::cout << "[INFO] PredictionTrigger: " << message << std::endl;
+}
+
+void PredictionTrigger::log_error(const std::string& message) {
+    std::cerr << "[ERROR] PredictionTrigger: " << message << std::endl;
+}
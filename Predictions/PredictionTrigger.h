@@ -0,0 +1,53 @@
+#pragma once
+
+#include "MarketPredictionEngine.h"
+#include "BarEventBus.h"
+#include "MetricsRegistry.h"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <atomic>
+
+// ==============================================
+// PREDICTION TRIGGER - EVENT-DRIVEN PREDICTIONS
+// ==============================================
+
+// Subscribes a MarketPredictionEngine to the bar event bus. Each newly
+// persisted bar produces that symbol/timeframe's next-interval prediction
+// straight away, and the bar-close -> prediction-persisted latency is recorded
+// per timeframe (nexday_bar_to_prediction_seconds in the metrics registry).
+class PredictionTrigger {
+private:
+    MarketPredictionEngine& engine_;
+    std::shared_ptr<BarEventBus> event_bus_;
+    int subscription_id_;
+    
+    std::map<std::string, Histogram*> latency_by_timeframe_;  // Owned by the registry
+    mutable std::mutex latency_mutex_;
+    
+    std::atomic<long long> predictions_triggered_;
+    std::atomic<long long> predictions_failed_;
+
+public:
+    PredictionTrigger(MarketPredictionEngine& engine, std::shared_ptr<BarEventBus> event_bus);
+    ~PredictionTrigger();
+    
+    PredictionTrigger(const PredictionTrigger&) = delete;
+    PredictionTrigger& operator=(const PredictionTrigger&) = delete;
+    
+    // Status and monitoring
+    long long predictions_triggered() const { return predictions_triggered_.load(); }
+    long long predictions_failed() const { return predictions_failed_.load(); }
+    void print_latency_summary() const;
+
+private:
+    void on_new_bar(const NewBarEvent& event);
+    Histogram& histogram_for(const std::string& timeframe);
+    
+    // Scheduler timeframe names ("2hours") -> prediction TimeFrame
+    static bool to_timeframe(const std::string& scheduler_timeframe, TimeFrame& timeframe);
+    
+    void log_info(const std::string& message);
+    void log_error(const std::string& message);
+};
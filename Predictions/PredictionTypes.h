@@ -46,9 +46,10 @@ struct OHLCPrediction {
     double confidence_score;
     std::chrono::system_clock::time_point prediction_time;
     std::chrono::system_clock::time_point target_time;
+    bool from_cache;                   // Reused unchanged-input result (already persisted)
     
     OHLCPrediction() : predicted_open(0.0), predicted_high(0.0), predicted_low(0.0), 
-                       predicted_close(0.0), confidence_score(0.0) {}
+                       predicted_close(0.0), confidence_score(0.0), from_cache(false) {}
 };
 
 // High/Low prediction for intraday intervals
@@ -59,9 +60,10 @@ struct HighLowPrediction {
     TimeFrame timeframe;
     std::chrono::system_clock::time_point prediction_time;
     std::chrono::system_clock::time_point target_time;
+    bool from_cache;                   // Reused unchanged-input result (already persisted)
     
     HighLowPrediction() : predicted_high(0.0), predicted_low(0.0), confidence_score(0.0), 
-                          timeframe(TimeFrame::MINUTES_15) {}
+                          timeframe(TimeFrame::MINUTES_15), from_cache(false) {}
 };
 
 // Complete prediction set for a symbol
@@ -83,9 +85,9 @@ struct SymbolPrediction {
 };
 
 // EMA calculation result
+// Intermediate SMA/EMA values are not kept here (the hot path must not
+// allocate); capture them with an EMATrace when debugging.
 struct EMAResult {
-    std::vector<double> sma_values;    // SMA1 through SMA10
-    std::vector<double> ema_values;    // EMA11 through final EMA
     double final_ema;                  // The final EMA value for next prediction
     bool valid;                        // Whether calculation was successful
     int bars_used;                     // Number of bars used in calculation
@@ -2,6 +2,8 @@
 
 #include "database_simple.h"
 #include "PredictionTypes.h"
+#include "ErrorMetricsKernel.h"
+#include "ActualsIndex.h"
 #include <memory>
 #include <vector>
 #include <string>
@@ -30,23 +32,11 @@ struct ValidationResult {
     double avg_deviation = 0.0;
 };
 
-struct ErrorMetrics {
-    double mae = 0.0;           // Mean Absolute Error
-    double rmse = 0.0;          // Root Mean Square Error  
-    double mape = 0.0;          // Mean Absolute Percentage Error
-    double smape = 0.0;         // Symmetric Mean Absolute Percentage Error
-    double r_squared = 0.0;     // R-squared coefficient
-    double matthews_correlation = 0.0; // Matthews Correlation Coefficient
-    double directional_accuracy = 0.0; // Percentage of correct direction predictions
-    double max_deviation = 0.0; // Maximum absolute deviation
-    double avg_deviation = 0.0; // Average absolute deviation
-    int sample_count = 0;       // Number of samples used in calculation
-};
-
 class PredictionValidator {
 private:
     std::unique_ptr<SimpleDatabaseManager> db_manager_;
     std::string last_error_;
+    ActualsIndex actuals_index_;    // Loaded for the duration of validate_all_predictions
 
 public:
     // Constructor
@@ -81,6 +71,10 @@ public:
         const std::string& symbol, TimeFrame timeframe, const std::string& prediction_type,
         const std::string& start_date, const std::string& end_date);
 
+    // Bulk-load the validation window so actual bar lookups resolve in memory
+    bool load_actuals_index(int days_back);
+    void clear_actuals_index() { actuals_index_.clear(); }
+
     // Utility methods
     std::string get_last_error() const { return last_error_; }
     bool is_initialized() const { return db_manager_ && db_manager_->is_connected(); }
@@ -288,6 +282,9 @@ ValidationResult PredictionValidator::validate_all_predictions(int days_back) {
     try {
         log_info("Starting comprehensive prediction validation for last " + std::to_string(days_back) + " days");
 
+        // One bulk read per timeframe instead of one query per prediction
+        load_actuals_index(days_back + 1);
+
         // Validate daily predictions
         ValidationResult daily_result = validate_daily_predictions("", days_back);
         combined_result.predictions_found += daily_result.predictions_found;
@@ -307,11 +304,14 @@ ValidationResult PredictionValidator::validate_all_predictions(int days_back) {
             combined_result.predictions_validated += intraday_result.predictions_validated;
         }
 
+        clear_actuals_index();
+
         combined_result.success = true;
         log_info("Comprehensive validation completed: " + std::to_string(combined_result.predictions_validated) + 
                 " / " + std::to_string(combined_result.predictions_found) + " total predictions validated");
 
     } catch (const std::exception& e) {
+        clear_actuals_index();
         combined_result.error_message = "Exception in validate_all_predictions: " + std::string(e.what());
         log_error(combined_result.error_message);
     }
@@ -418,10 +418,28 @@ bool PredictionValidator::validate_intraday_prediction_for_period(const std::str
 // HISTORICAL DATA RETRIEVAL FOR VALIDATION
 // ==============================================
 
+bool PredictionValidator::load_actuals_index(int days_back) {
+    if (!is_initialized()) {
+        return false;
+    }
+    return actuals_index_.load(*db_manager_, days_back);
+}
+
 std::map<std::string, double> PredictionValidator::get_actual_daily_ohlc(const std::string& symbol, const std::string& date) {
     std::map<std::string, double> result;
     
     try {
+        long long day = ActualsIndex::parse_timestamp(date);
+        if (day >= 0 && actuals_index_.covers(day)) {
+            if (const ActualBar* bar = actuals_index_.find_exact(symbol, "daily", day)) {
+                result["open"] = bar->open;
+                result["high"] = bar->high;
+                result["low"] = bar->low;
+                result["close"] = bar->close;
+            }
+            return result;
+        }
+
         int symbol_id = get_symbol_id(symbol);
         if (symbol_id == -1) {
             return result;
@@ -459,11 +477,6 @@ std::map<std::string, double> PredictionValidator::get_actual_intraday_hl(const
     std::map<std::string, double> result;
     
     try {
-        int symbol_id = get_symbol_id(symbol);
-        if (symbol_id == -1) {
-            return result;
-        }
-
         std::string table_name;
         switch (timeframe) {
             case TimeFrame::MINUTES_15: table_name = "historical_fetch_15min"; break;
@@ -473,12 +486,26 @@ std::map<std::string, double> PredictionValidator::get_actual_intraday_hl(const
             default: return result;
         }
 
+        long long bar_start = ActualsIndex::parse_timestamp(target_time);
+        if (bar_start >= 0 && actuals_index_.covers(bar_start)) {
+            if (const ActualBar* bar = actuals_index_.find_exact(
+                    symbol, table_name.substr(std::string("historical_fetch_").size()), bar_start)) {
+                result["high"] = bar->high;
+                result["low"] = bar->low;
+            }
+            return result;
+        }
+
+        int symbol_id = get_symbol_id(symbol);
+        if (symbol_id == -1) {
+            return result;
+        }
+
         // Parse target_time to extract date and time components
         std::stringstream query;
         query << "SELECT high_price, low_price FROM " << table_name << " ";
         query << "WHERE symbol_id = " << symbol_id << " ";
-        query << "AND CONCAT(fetch_date::text, ' ', fetch_time::text)::timestamp ";
-        query << "= '" << target_time << "'";
+        query << "AND bar_ts = " << db_manager_->bar_timestamp(target_time);
 
         PGresult* pg_result = db_manager_->execute_query_with_result(query.str());
         if (!pg_result) {
@@ -505,86 +532,41 @@ std::map<std::string, double> PredictionValidator::get_actual_intraday_hl(const
 
 ErrorMetrics PredictionValidator::calculate_error_metrics(const std::vector<double>& actual_values, 
                                                          const std::vector<double>& predicted_values) {
-    ErrorMetrics metrics;
-    
-    if (actual_values.size() != predicted_values.size() || actual_values.empty()) {
-        return metrics;
-    }
-
-    metrics.sample_count = actual_values.size();
-    metrics.mae = calculate_mae(actual_values, predicted_values);
-    metrics.rmse = calculate_rmse(actual_values, predicted_values);
-    metrics.mape = calculate_mape(actual_values, predicted_values);
-    metrics.smape = calculate_smape(actual_values, predicted_values);
-    metrics.r_squared = calculate_r_squared(actual_values, predicted_values);
-
-    // Calculate max and average deviation
-    std::vector<double> deviations;
-    for (size_t i = 0; i < actual_values.size(); i++) {
-        double dev = std::abs(actual_values[i] - predicted_values[i]);
-        deviations.push_back(dev);
-    }
-
-    if (!deviations.empty()) {
-        metrics.max_deviation = *std::max_element(deviations.begin(), deviations.end());
-        metrics.avg_deviation = std::accumulate(deviations.begin(), deviations.end(), 0.0) / deviations.size();
-    }
+    // All metrics come from one fused pass (see ErrorMetricsKernel.h)
+    return ErrorMetricsKernel::compute(actual_values, predicted_values);
+}
 
-    return metrics;
+ErrorMetrics PredictionValidator::calculate_directional_accuracy(const std::vector<double>& actual_values,
+                                                                const std::vector<double>& predicted_values,
+                                                                const std::vector<double>& previous_values) {
+    return ErrorMetricsKernel::compute(actual_values, predicted_values, previous_values);
 }
 
+// Single-metric helpers - kept for callers that need one value
 double PredictionValidator::calculate_mae(const std::vector<double>& actual, const std::vector<double>& predicted) {
-    double sum = 0.0;
-    for (size_t i = 0; i < actual.size(); i++) {
-        sum += std::abs(actual[i] - predicted[i]);
-    }
-    return sum / actual.size();
+    return ErrorMetricsKernel::compute(actual, predicted).mae;
 }
 
 double PredictionValidator::calculate_rmse(const std::vector<double>& actual, const std::vector<double>& predicted) {
-    double sum = 0.0;
-    for (size_t i = 0; i < actual.size(); i++) {
-        double diff = actual[i] - predicted[i];
-        sum += diff * diff;
-    }
-    return std::sqrt(sum / actual.size());
+    return ErrorMetricsKernel::compute(actual, predicted).rmse;
 }
 
 double PredictionValidator::calculate_mape(const std::vector<double>& actual, const std::vector<double>& predicted) {
-    double sum = 0.0;
-    for (size_t i = 0; i < actual.size(); i++) {
-        if (actual[i] != 0.0) {
-            sum += std::abs((actual[i] - predicted[i]) / actual[i]);
-        }
-    }
-    return (sum / actual.size()) * 100.0;
+    return ErrorMetricsKernel::compute(actual, predicted).mape;
 }
 
 double PredictionValidator::calculate_smape(const std::vector<double>& actual, const std::vector<double>& predicted) {
-    double sum = 0.0;
-    for (size_t i = 0; i < actual.size(); i++) {
-        double denominator = (std::abs(actual[i]) + std::abs(predicted[i])) / 2.0;
-        if (denominator != 0.0) {
-            sum += std::abs(actual[i] - predicted[i]) / denominator;
-        }
-    }
-    return (sum / actual.size()) * 100.0;
+    return ErrorMetricsKernel::compute(actual, predicted).smape;
 }
 
 double PredictionValidator::calculate_r_squared(const std::vector<double>& actual, const std::vector<double>& predicted) {
-    // Calculate mean of actual values
-    double mean_actual = std::accumulate(actual.begin(), actual.end(), 0.0) / actual.size();
-    
-    // Calculate total sum of squares and residual sum of squares
-    double ss_tot = 0.0, ss_res = 0.0;
-    for (size_t i = 0; i < actual.size(); i++) {
-        ss_tot += (actual[i] - mean_actual) * (actual[i] - mean_actual);
-        ss_res += (actual[i] - predicted[i]) * (actual[i] - predicted[i]);
-    }
-    
-    if (ss_tot == 0.0) return 1.0; // Perfect fit case
-    
-    return 1.0 - (ss_res / ss_tot);
+    return ErrorMetricsKernel::compute(actual, predicted).r_squared;
+}
+
+double PredictionValidator::calculate_matthews_correlation(const std::vector<double>& actual,
+                                                          const std::vector<double>& predicted,
+                                                          const std::vector<double>& previous) {
+    return ErrorMetricsKernel::compute(actual, predicted, previous).matthews_correlation;
 }
 
 // ==============================================
@@ -0,0 +1,386 @@
+#pragma once
+
+#include <bitset>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <cstdio>
+#include <cstdint>
+
+// ==============================================
+// TRADING CALENDAR - PRECOMPUTED SESSIONS AND HOLIDAYS
+// ==============================================
+
+// Exchange rules the calendar is built from. Defaults follow CME Globex as
+// traded here: trade date D runs from 18:00 ET on the previous evening to
+// 17:00 ET on D, Monday to Friday, with no trade date on the exchange
+// holidays below (observed Saturday -> Friday, Sunday -> Monday, except New
+// Year's Day, which is not moved back into the old year).
+struct CalendarRules {
+    int first_year = 1990;
+    int last_year = 2099;
+    std::string session_open = "18:00:00";     // Previous calendar day
+    std::string session_close = "17:00:00";
+    std::string early_close = "13:00:00";      // Day after Thanksgiving, Christmas Eve, July 3
+    int juneteenth_from = 2022;
+
+    // Optional file of one-off changes, one per line: "YYYY-MM-DD closed",
+    // "YYYY-MM-DD early [HH:MM:SS]" or "YYYY-MM-DD open"; '#' starts a comment
+    std::string overrides_path = "trading_calendar.txt";
+};
+
+// Times of one trade date's session, wall clock ET
+struct SessionTimes {
+    bool trading = false;
+    bool early_close = false;
+    std::string open;       // On the previous calendar day
+    std::string close;
+};
+
+// Built once from CalendarRules: a bitset of trade dates and one of early
+// closes per year, plus a running count of trade dates per calendar day.
+// With those, is-trading-day, next/previous session and sessions between
+// two dates are a couple of array reads, with no localtime() or day-by-day
+// stepping. Dates are "YYYY-MM-DD" or civil day numbers (days since
+// 1970-01-01). The shared instance is immutable, so any thread may use it.
+class TradingCalendar {
+public:
+    explicit TradingCalendar(const CalendarRules& rules = CalendarRules()) : rules_(rules) {
+        if (rules_.last_year < rules_.first_year) rules_.last_year = rules_.first_year;
+        build();
+    }
+
+    // Shared calendar every component uses
+    static const TradingCalendar& instance() {
+        static const TradingCalendar calendar;
+        return calendar;
+    }
+
+    // ==============================================
+    // QUERIES
+    // ==============================================
+
+    bool is_trading_day(long long day) const {
+        if (!in_range(day)) return weekday(day) >= 1 && weekday(day) <= 5;
+        long long offset = day - first_day_;
+        return sessions_before_[offset + 1] != sessions_before_[offset];
+    }
+
+    bool is_trading_day(const std::string& date) const { return is_trading_day(day_number(date)); }
+
+    bool is_early_close(long long day) const {
+        if (!in_range(day)) return false;
+        const Year& year = years_[year_index(day)];
+        return year.early_close.test(static_cast<std::size_t>(day - year.first_day));
+    }
+
+    // First trade date strictly after / before the given day
+    long long next_session(long long day) const {
+        if (day >= first_day_ && day < last_day_) {
+            std::uint32_t index = sessions_before_[day - first_day_ + 1];
+            if (index < session_days_.size()) return session_days_[index];
+        }
+        return step_weekdays(day, 1);
+    }
+
+    long long previous_session(long long day) const {
+        if (day > first_day_ && day <= last_day_) {
+            std::uint32_t index = sessions_before_[day - first_day_];
+            if (index > 0) return session_days_[index - 1];
+        }
+        return step_weekdays(day, -1);
+    }
+
+    std::string next_session(const std::string& date) const { return format_day(next_session(day_number(date))); }
+    std::string previous_session(const std::string& date) const {
+        return format_day(previous_session(day_number(date)));
+    }
+
+    // Trade dates in [from, to)
+    int sessions_between(long long from, long long to) const {
+        if (to <= from) return 0;
+        if (in_range(from) && to <= last_day_ + 1) {
+            return static_cast<int>(sessions_before_[to - first_day_] - sessions_before_[from - first_day_]);
+        }
+        int count = 0;
+        for (long long day = from; day < to; day++) count += is_trading_day(day) ? 1 : 0;
+        return count;
+    }
+
+    int sessions_between(const std::string& from, const std::string& to) const {
+        return sessions_between(day_number(from), day_number(to));
+    }
+
+    SessionTimes session(long long day) const {
+        SessionTimes times;
+        times.trading = is_trading_day(day);
+        if (times.trading) {
+            times.early_close = is_early_close(day);
+            times.open = rules_.session_open;
+            times.close = times.early_close ? early_close_time(day) : rules_.session_close;
+        }
+        return times;
+    }
+
+    SessionTimes session(const std::string& date) const { return session(day_number(date)); }
+
+    // Weekdays in [from, to] without a trade date (exchange holidays)
+    std::vector<std::string> holidays_between(const std::string& from, const std::string& to) const {
+        std::vector<std::string> holidays;
+        for (long long day = day_number(from); day <= day_number(to); day++) {
+            int dow = weekday(day);
+            if (dow >= 1 && dow <= 5 && !is_trading_day(day)) holidays.push_back(format_day(day));
+        }
+        return holidays;
+    }
+
+    // Trade date a wall-clock "YYYY-MM-DD HH:MM:SS" falls in: from the
+    // session open on, it belongs to the next calendar day's session
+    std::string trade_date_of(const std::string& wall_clock) const {
+        long long day = day_number(wall_clock.substr(0, 10));
+        std::string time = wall_clock.size() >= 19 ? wall_clock.substr(11, 8) : "00:00:00";
+        bool overnight = rules_.session_open > rules_.session_close;
+        return format_day(overnight && time >= rules_.session_open ? day + 1 : day);
+    }
+
+    // Trade date of the bar closing at a wall-clock time: the session its
+    // last second traded in, so the bar closing at the 18:00 open still
+    // belongs to the day before, and the first bar after it to the next one
+    std::string bar_trade_date_of(const std::string& bar_close) const {
+        long long day = day_number(bar_close.substr(0, 10));
+        int hour = 0, minute = 0, second = 0;
+        if (bar_close.size() >= 19) std::sscanf(bar_close.c_str() + 11, "%d:%d:%d", &hour, &minute, &second);
+        long long last_second = hour * 3600LL + minute * 60LL + second - 1;
+        if (last_second < 0) {
+            day--;
+            last_second += 86400;
+        }
+        char time[32];
+        std::snprintf(time, sizeof(time), " %02lld:%02lld:%02lld", last_second / 3600, (last_second / 60) % 60,
+                      last_second % 60);
+        return trade_date_of(format_day(day) + time);
+    }
+
+    // Session a run on the evening of `day` (after the close) follows: the
+    // latest trade date on or before it. -1 when a run on an earlier evening
+    // since then already followed it, given the weekdays runs happen on, as
+    // on the evening of a holiday or a weekend after one
+    long long session_closed_by(long long day, const std::vector<int>& run_weekdays) const {
+        long long session = is_trading_day(day) ? day : previous_session(day);
+        for (long long evening = session; evening < day; evening++) {
+            for (int dow : run_weekdays) {
+                if (dow == weekday(evening)) return -1;
+            }
+        }
+        return session;
+    }
+
+    const CalendarRules& rules() const { return rules_; }
+
+    // ==============================================
+    // DATE ARITHMETIC
+    // ==============================================
+
+    // Days since 1970-01-01 of a proleptic Gregorian date (Howard Hinnant)
+    static long long days_from_civil(long long y, unsigned m, unsigned d) {
+        y -= m <= 2;
+        const long long era = (y >= 0 ? y : y - 399) / 400;
+        const unsigned yoe = static_cast<unsigned>(y - era * 400);
+        const unsigned doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+        const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+        return era * 146097 + static_cast<long long>(doe) - 719468;
+    }
+
+    static void civil_from_days(long long z, long long& y, unsigned& m, unsigned& d) {
+        z += 719468;
+        const long long era = (z >= 0 ? z : z - 146096) / 146097;
+        const unsigned doe = static_cast<unsigned>(z - era * 146097);
+        const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+        const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+        const unsigned mp = (5 * doy + 2) / 153;
+        d = doy - (153 * mp + 2) / 5 + 1;
+        m = mp < 10 ? mp + 3 : mp - 9;
+        y = static_cast<long long>(yoe) + era * 400 + (m <= 2);
+    }
+
+    static long long day_number(const std::string& date) {
+        int year = 1970, month = 1, day = 1;
+        std::sscanf(date.c_str(), "%d-%d-%d", &year, &month, &day);
+        return days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    }
+
+    static std::string format_day(long long day) {
+        long long year;
+        unsigned month, day_of_month;
+        civil_from_days(day, year, month, day_of_month);
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%04lld-%02u-%02u", year, month, day_of_month);
+        return buffer;
+    }
+
+    // 0 = Sunday ... 6 = Saturday (1970-01-01 was a Thursday)
+    static int weekday(long long day) {
+        return static_cast<int>(((day + 4) % 7 + 7) % 7);
+    }
+
+private:
+    enum DayKind { CLOSED, REGULAR, EARLY };
+
+    struct Year {
+        long long first_day = 0;
+        std::bitset<366> trading;
+        std::bitset<366> early_close;
+    };
+
+    struct Override {
+        long long day;
+        DayKind kind;
+        std::string close;
+    };
+
+    bool in_range(long long day) const { return day >= first_day_ && day <= last_day_; }
+
+    std::size_t year_index(long long day) const {
+        long long year;
+        unsigned month, day_of_month;
+        civil_from_days(day, year, month, day_of_month);
+        return static_cast<std::size_t>(year - rules_.first_year);
+    }
+
+    long long step_weekdays(long long day, int direction) const {
+        do {
+            day += direction;
+        } while (!is_trading_day(day));
+        return day;
+    }
+
+    std::string early_close_time(long long day) const {
+        for (const auto& item : overrides_) {
+            if (item.day == day && item.kind == EARLY && !item.close.empty()) return item.close;
+        }
+        return rules_.early_close;
+    }
+
+    // nth (1-based) weekday of a month; n = -1 for the last one
+    static long long nth_weekday(int year, unsigned month, int dow, int n) {
+        if (n < 0) {
+            long long last = (month == 12 ? days_from_civil(year + 1, 1, 1) : days_from_civil(year, month + 1, 1)) - 1;
+            return last - ((weekday(last) - dow + 7) % 7);
+        }
+        long long first = days_from_civil(year, month, 1);
+        return first + ((dow - weekday(first) + 7) % 7) + 7 * (n - 1);
+    }
+
+    // Anonymous Gregorian algorithm
+    static long long easter_sunday(int year) {
+        int a = year % 19, b = year / 100, c = year % 100, d = b / 4, e = b % 4;
+        int f = (b + 8) / 25, g = (b - f + 1) / 3, h = (19 * a + b - d - g + 15) % 30;
+        int i = c / 4, k = c % 4, l = (32 + 2 * e + 2 * i - h - k) % 7;
+        int m = (a + 11 * h + 22 * l) / 451;
+        int month = (h + l - 7 * m + 114) / 31;
+        int day = ((h + l - 7 * m + 114) % 31) + 1;
+        return days_from_civil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    }
+
+    static long long observed(long long day) {
+        int dow = weekday(day);
+        return dow == 6 ? day - 1 : dow == 0 ? day + 1 : day;
+    }
+
+    void mark_year(Year& year, int y) const {
+        auto set = [&](std::bitset<366>& bits, long long day, bool value) {
+            long long offset = day - year.first_day;
+            if (offset >= 0 && offset < 366) bits.set(static_cast<std::size_t>(offset), value);
+        };
+
+        long long year_end = days_from_civil(y + 1, 1, 1);
+        for (long long day = year.first_day; day < year_end; day++) {
+            int dow = weekday(day);
+            set(year.trading, day, dow >= 1 && dow <= 5);
+        }
+
+        std::vector<long long> holidays = {
+            nth_weekday(y, 1, 1, 3),                         // Martin Luther King Jr. Day
+            nth_weekday(y, 2, 1, 3),                         // Presidents Day
+            easter_sunday(y) - 2,                            // Good Friday
+            nth_weekday(y, 5, 1, -1),                        // Memorial Day
+            observed(days_from_civil(y, 7, 4)),              // Independence Day
+            nth_weekday(y, 9, 1, 1),                         // Labor Day
+            nth_weekday(y, 11, 4, 4),                        // Thanksgiving
+            observed(days_from_civil(y, 12, 25)),            // Christmas
+        };
+        long long new_year = days_from_civil(y, 1, 1);
+        if (weekday(new_year) != 6) holidays.push_back(observed(new_year));
+        if (y >= rules_.juneteenth_from) holidays.push_back(observed(days_from_civil(y, 6, 19)));
+
+        for (long long day : holidays) {
+            set(year.trading, day, false);
+        }
+
+        for (long long day : { nth_weekday(y, 11, 4, 4) + 1, days_from_civil(y, 12, 24), days_from_civil(y, 7, 3) }) {
+            long long offset = day - year.first_day;
+            if (offset >= 0 && offset < 366 && year.trading.test(static_cast<std::size_t>(offset))) {
+                set(year.early_close, day, true);
+            }
+        }
+    }
+
+    void load_overrides() {
+        if (rules_.overrides_path.empty()) return;
+        std::ifstream file(rules_.overrides_path);
+        std::string line;
+        while (std::getline(file, line)) {
+            line = line.substr(0, line.find('#'));
+            std::istringstream fields(line);
+            std::string date, kind, close;
+            if (!(fields >> date >> kind)) continue;
+            fields >> close;
+
+            Override item;
+            item.day = day_number(date);
+            item.kind = kind == "closed" ? CLOSED : kind == "early" ? EARLY : REGULAR;
+            item.close = close;
+            if (kind == "closed" || kind == "early" || kind == "open") overrides_.push_back(item);
+        }
+    }
+
+    void build() {
+        first_day_ = days_from_civil(rules_.first_year, 1, 1);
+        last_day_ = days_from_civil(rules_.last_year + 1, 1, 1) - 1;
+
+        for (int y = rules_.first_year; y <= rules_.last_year; y++) {
+            Year year;
+            year.first_day = days_from_civil(y, 1, 1);
+            mark_year(year, y);
+            years_.push_back(year);
+        }
+
+        load_overrides();
+        for (const auto& item : overrides_) {
+            if (!in_range(item.day)) continue;
+            Year& year = years_[year_index(item.day)];
+            std::size_t offset = static_cast<std::size_t>(item.day - year.first_day);
+            year.trading.set(offset, item.kind != CLOSED);
+            year.early_close.set(offset, item.kind == EARLY);
+        }
+
+        // sessions_before_[i] = trade dates in [first_day_, first_day_ + i)
+        sessions_before_.assign(static_cast<std::size_t>(last_day_ - first_day_ + 2), 0);
+        for (long long day = first_day_; day <= last_day_; day++) {
+            const Year& year = years_[year_index(day)];
+            bool trading = year.trading.test(static_cast<std::size_t>(day - year.first_day));
+            std::size_t offset = static_cast<std::size_t>(day - first_day_);
+            sessions_before_[offset + 1] = sessions_before_[offset] + (trading ? 1 : 0);
+            if (trading) session_days_.push_back(static_cast<std::int32_t>(day));
+        }
+    }
+
+    CalendarRules rules_;
+    long long first_day_ = 0;
+    long long last_day_ = 0;
+    std::vector<Year> years_;
+    std::vector<Override> overrides_;
+    std::vector<std::uint32_t> sessions_before_;
+    std::vector<std::int32_t> session_days_;
+};
@@ -0,0 +1,103 @@
+#ifndef ROLLING_METRICS_H
+#define ROLLING_METRICS_H
+
+#include "MetricsAccumulator.h"
+#include <array>
+#include <cstddef>
+
+// ==============================================
+// ROLLING METRICS - 7/30/90 DAY WINDOWS FROM DAILY BUCKETS
+// ==============================================
+
+// Keeps the last 90 days of validated predictions as one MetricsAccumulator
+// per day (a ring indexed by day number), plus a running total for each
+// 7/30/90-day window.
+//
+// Adding a sample updates its day bucket and every window that day falls in,
+// so reads are O(1). When the current day advances, the window totals are
+// rebuilt by merging at most 90 buckets, which drops the expired days
+// exactly. Day numbers are days since 1970-01-01 and a window of N days
+// covers [today - N + 1, today].
+class RollingMetricsWindow {
+public:
+    static constexpr int MAX_DAYS = 90;
+    static constexpr std::size_t WINDOW_COUNT = 3;
+    static constexpr int WINDOW_DAYS[WINDOW_COUNT] = { 7, 30, 90 };
+
+    RollingMetricsWindow() { bucket_day_.fill(EMPTY_DAY); }
+
+    void add(long long day, double predicted, double actual, double accuracy) {
+        MetricsAccumulator sample;
+        sample.add(predicted, actual, accuracy);
+        merge_bucket(day, sample);
+    }
+
+    // Fold a partial state into one day (loading persisted buckets, parallel workers)
+    void merge_bucket(long long day, const MetricsAccumulator& partial) {
+        if (partial.count == 0) return;
+        if (day > current_day_) advance_to(day);
+        if (day <= current_day_ - MAX_DAYS) return;    // Already expired
+
+        std::size_t slot = slot_for(day);
+        if (bucket_day_[slot] != day) {
+            buckets_[slot] = MetricsAccumulator();
+            bucket_day_[slot] = day;
+        }
+        buckets_[slot].merge(partial);
+
+        for (std::size_t w = 0; w < WINDOW_COUNT; w++) {
+            if (day > current_day_ - WINDOW_DAYS[w]) {
+                totals_[w].merge(partial);
+            }
+        }
+    }
+
+    // Move "today" forward, expiring buckets that fall out of each window
+    void advance_to(long long today) {
+        if (today <= current_day_) return;
+        current_day_ = today;
+
+        for (auto& total : totals_) total = MetricsAccumulator();
+        for (std::size_t slot = 0; slot < MAX_DAYS; slot++) {
+            long long day = bucket_day_[slot];
+            if (day == EMPTY_DAY || day <= today - MAX_DAYS) continue;
+            for (std::size_t w = 0; w < WINDOW_COUNT; w++) {
+                if (day > today - WINDOW_DAYS[w]) {
+                    totals_[w].merge(buckets_[slot]);
+                }
+            }
+        }
+    }
+
+    // Totals for a 7, 30 or 90 day window ending on the current day; null for other lengths
+    const MetricsAccumulator* window(int days) const {
+        for (std::size_t w = 0; w < WINDOW_COUNT; w++) {
+            if (WINDOW_DAYS[w] == days) return &totals_[w];
+        }
+        return nullptr;
+    }
+
+    // One day's partial aggregate, or null if nothing was recorded for it
+    const MetricsAccumulator* bucket(long long day) const {
+        std::size_t slot = slot_for(day);
+        if (bucket_day_[slot] != day || day <= current_day_ - MAX_DAYS) return nullptr;
+        return &buckets_[slot];
+    }
+
+    long long current_day() const { return current_day_; }
+
+private:
+    static constexpr long long EMPTY_DAY = -1;
+
+    static std::size_t slot_for(long long day) {
+        long long slot = day % MAX_DAYS;
+        return static_cast<std::size_t>(slot < 0 ? slot + MAX_DAYS : slot);
+    }
+
+    std::array<MetricsAccumulator, MAX_DAYS> buckets_;
+    std::array<long long, MAX_DAYS> bucket_day_;
+    std::array<MetricsAccumulator, WINDOW_COUNT> totals_;
+    long long current_day_ = 0;
+};
+
+#endif // ROLLING_METRICS_H
@@ -0,0 +1,228 @@
+#include "ValidationScheduler.h"
+#include "database_simple.h"
+#include "database_pool.h"
+#include "IQFeedConnection/Logger.h"
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <map>
+
+// ==============================================
+// CONSTRUCTOR AND DESTRUCTOR
+// ==============================================
+
+ValidationScheduler::ValidationScheduler(const DatabaseConfig& config, std::size_t worker_count)
+    : worker_count_(worker_count) {
+    if (worker_count_ == 0) {
+        worker_count_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    logger_ = std::make_unique<Logger>("validation_scheduler.log", true);
+
+    // One extra connection for the partition query on the calling thread
+    pool_ = std::make_unique<DatabaseConnectionPool>(config, worker_count_ + 1);
+    logger_->info("ValidationScheduler initialized: " + std::to_string(worker_count_) + " workers, " +
+                 std::to_string(pool_->connected_count()) + "/" + std::to_string(pool_->size()) +
+                 " connections open");
+}
+
+ValidationScheduler::~ValidationScheduler() = default;
+
+// ==============================================
+// PARALLEL RUN
+// ==============================================
+
+ValidationRunStats ValidationScheduler::run(PredictionValidator* validator) {
+    ValidationRunStats stats;
+    auto start = std::chrono::steady_clock::now();
+
+    std::vector<ValidationPartition> partitions;
+    {
+        auto lease = pool_->acquire();
+        stats.partitions_loaded = load_partitions(*lease, partitions);
+    }
+
+    // Largest partitions first so one big symbol does not finish last alone
+    std::sort(partitions.begin(), partitions.end(),
+              [](const ValidationPartition& a, const ValidationPartition& b) { return a.pending > b.pending; });
+
+    stats.partitions = static_cast<int>(partitions.size());
+    for (const auto& partition : partitions) {
+        stats.predictions_pending += partition.pending;
+    }
+    stats.workers = static_cast<int>(std::min<std::size_t>(worker_count_, partitions.size()));
+
+    logger_->info("Validating " + std::to_string(stats.predictions_pending) + " pending predictions in " +
+                 std::to_string(stats.partitions) + " partitions on " + std::to_string(stats.workers) + " workers");
+
+    std::atomic<std::size_t> next_partition{0};
+    std::mutex merge_mutex;
+    std::vector<std::thread> workers;
+
+    for (int w = 0; w < stats.workers; w++) {
+        workers.emplace_back([&]() {
+            auto lease = pool_->acquire();
+            PredictionValidator::MetricsAccumulatorMap partial;
+            PredictionValidator::BucketAccumulatorMap partial_buckets;
+            long long validated = 0;
+            int failed = 0;
+
+            for (std::size_t i = next_partition++; i < partitions.size(); i = next_partition++) {
+                if (!validate_partition(*lease, partitions[i], partial, partial_buckets, validated)) {
+                    failed++;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(merge_mutex);
+            for (const auto& [key, accumulator] : partial) {
+                stats.metrics[key].merge(accumulator);
+            }
+            for (const auto& [key, accumulator] : partial_buckets) {
+                stats.buckets[key].merge(accumulator);
+            }
+            stats.predictions_validated += validated;
+            stats.failed_partitions += failed;
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    stats.elapsed_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    if (validator) {
+        validator->merge_metric_accumulators(stats.metrics);
+        validator->merge_rolling_buckets(stats.buckets);
+        stats.metrics_persisted = validator->flush_metric_accumulators();
+    }
+
+    std::stringstream summary;
+    summary << std::fixed << std::setprecision(1) << "Validated " << stats.predictions_validated << " of "
+            << stats.predictions_pending << " predictions in " << stats.elapsed_seconds << "s ("
+            << stats.throughput() << " predictions/s, " << stats.failed_partitions << " failed partitions)";
+
+    if (stats.ok()) {
+        logger_->success(summary.str());
+    } else {
+        logger_->error(summary.str());
+    }
+
+    return stats;
+}
+
+bool ValidationScheduler::load_partitions(SimpleDatabaseManager& db, std::vector<ValidationPartition>& partitions) {
+    try {
+        PGresult* result = db.execute_query_with_result(
+            "SELECT p.symbol_id, s.symbol, p.timeframe, COUNT(*) "
+            "FROM predictions_all_symbols p "
+            "JOIN symbols s ON p.symbol_id = s.symbol_id "
+            "WHERE p.is_validated = FALSE "
+            "GROUP BY p.symbol_id, s.symbol, p.timeframe");
+        if (!result) {
+            log_error("Failed to load pending prediction partitions: " + db.get_last_error());
+            return false;
+        }
+
+        // Rows are per raw timeframe ("15min_high", ...); partitions are per base timeframe
+        std::map<std::pair<int, std::string>, ValidationPartition> grouped;
+        int rows = PQntuples(result);
+        for (int i = 0; i < rows; i++) {
+            std::string timeframe = PredictionValidator::base_timeframe(PQgetvalue(result, i, 2));
+            if (PredictionValidator::build_bulk_validation_query(timeframe).empty()) {
+                continue;   // Unknown timeframe, nothing the bulk path can validate
+            }
+
+            int symbol_id = std::stoi(PQgetvalue(result, i, 0));
+            ValidationPartition& partition = grouped[{symbol_id, timeframe}];
+            partition.symbol_id = symbol_id;
+            partition.symbol = PQgetvalue(result, i, 1);
+            partition.timeframe = timeframe;
+            partition.pending += std::stoll(PQgetvalue(result, i, 3));
+        }
+        PQclear(result);
+
+        partitions.reserve(grouped.size());
+        for (auto& [key, partition] : grouped) {
+            partitions.push_back(std::move(partition));
+        }
+
+    } catch (const std::exception& e) {
+        log_error("Exception loading partitions: " + std::string(e.what()));
+        return false;
+    }
+
+    return true;
+}
+
+bool ValidationScheduler::validate_partition(SimpleDatabaseManager& db, const ValidationPartition& partition,
+                                             PredictionValidator::MetricsAccumulatorMap& partial,
+                                             PredictionValidator::BucketAccumulatorMap& buckets,
+                                             long long& validated) {
+    try {
+        PGresult* result = db.execute_query_with_result(
+            PredictionValidator::build_bulk_validation_query(partition.timeframe, partition.symbol_id));
+        if (!result) {
+            log_error("Bulk validation failed for " + partition.symbol + " " + partition.timeframe +
+                      ": " + db.get_last_error());
+            return false;
+        }
+
+        int rows = PQntuples(result);
+        for (int i = 0; i < rows; i++) {
+            PredictionValidator::MetricsKey key(std::stoi(PQgetvalue(result, i, 0)),
+                                                PredictionValidator::base_timeframe(PQgetvalue(result, i, 1)));
+            MetricsAccumulator sample;
+            sample.add(std::stod(PQgetvalue(result, i, 2)), std::stod(PQgetvalue(result, i, 3)),
+                       std::stod(PQgetvalue(result, i, 4)));
+            partial[key].merge(sample);
+
+            long long day = PredictionValidator::day_number(PQgetvalue(result, i, 6));
+            if (day >= 0) {
+                buckets[PredictionValidator::BucketKey(key.first, key.second, std::stoi(PQgetvalue(result, i, 5)), day)]
+                    .merge(sample);
+            }
+        }
+        PQclear(result);
+
+        validated += rows;
+        return true;
+
+    } catch (const std::exception& e) {
+        log_error("Exception validating " + partition.symbol + " " + partition.timeframe + ": " + e.what());
+        return false;
+    }
+}
+
+void ValidationScheduler::log_error(const std::string& message) {
+    std::lock_guard<std::mutex> lock(log_mutex_);
+    logger_->error(message);
+}
+
+// ==============================================
+// REPORTING
+// ==============================================
+
+void ValidationScheduler::print_run_summary(const ValidationRunStats& stats) const {
+    std::cout << "\n=== PARALLEL VALIDATION RUN ===" << std::endl;
+    std::cout << std::fixed << std::setprecision(2);
+    std::cout << "Workers:     " << stats.workers << std::endl;
+    std::cout << "Partitions:  " << stats.partitions << " (" << stats.failed_partitions << " failed)" << std::endl;
+    std::cout << "Validated:   " << stats.predictions_validated << " / " << stats.predictions_pending << std::endl;
+    std::cout << "Elapsed:     " << stats.elapsed_seconds << " s" << std::endl;
+    std::cout << "Throughput:  " << stats.throughput() << " predictions/s" << std::endl;
+
+    if (!stats.metrics.empty()) {
+        std::cout << "\nModel  Timeframe  Samples     MAE        RMSE       MAPE%    R²" << std::endl;
+        for (const auto& [key, acc] : stats.metrics) {
+            std::cout << std::left << std::setw(7) << key.first << std::setw(11) << key.second
+                      << std::setw(12) << acc.count << std::right << std::setprecision(4)
+                      << std::setw(10) << acc.mae() << " " << std::setw(10) << acc.rmse() << " "
+                      << std::setw(8) << acc.mape() << " " << std::setw(8) << acc.r_squared() << std::endl;
+        }
+    }
+}
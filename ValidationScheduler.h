@@ -0,0 +1,72 @@
+#ifndef VALIDATION_SCHEDULER_H
+#define VALIDATION_SCHEDULER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include "PredictionValidator.h"
+
+struct DatabaseConfig;
+class SimpleDatabaseManager;
+class DatabaseConnectionPool;
+class Logger;
+
+// One unit of parallel work: every pending prediction of a symbol in one timeframe
+struct ValidationPartition {
+    int symbol_id = 0;
+    std::string symbol;
+    std::string timeframe;       // Base timeframe: "daily", "15min", "30min", "1hour", "2hours"
+    long long pending = 0;
+};
+
+struct ValidationRunStats {
+    int workers = 0;
+    int partitions = 0;
+    int failed_partitions = 0;
+    long long predictions_pending = 0;
+    long long predictions_validated = 0;
+    double elapsed_seconds = 0.0;
+    bool partitions_loaded = true;     // False when the pending-partition query failed
+    bool metrics_persisted = true;     // False when the validator's flush failed
+
+    // Partial metric states from every worker, merged
+    PredictionValidator::MetricsAccumulatorMap metrics;
+    PredictionValidator::BucketAccumulatorMap buckets;     // Per (model, timeframe, symbol, day)
+
+    double throughput() const { return elapsed_seconds > 0.0 ? predictions_validated / elapsed_seconds : 0.0; }
+    bool ok() const { return partitions_loaded && failed_partitions == 0 && metrics_persisted; }
+};
+
+// Validates the whole pending backlog in parallel. Pending predictions are
+// partitioned by (symbol, timeframe); a fixed set of workers, each holding
+// its own pooled connection, runs the set-based bulk UPDATE for one
+// partition at a time. Every worker keeps a private MetricsAccumulator map,
+// and the maps are merged once all workers finish.
+class ValidationScheduler {
+private:
+    std::size_t worker_count_;
+    std::unique_ptr<DatabaseConnectionPool> pool_;
+    std::unique_ptr<Logger> logger_;
+    std::mutex log_mutex_;
+
+    bool load_partitions(SimpleDatabaseManager& db, std::vector<ValidationPartition>& partitions);
+    bool validate_partition(SimpleDatabaseManager& db, const ValidationPartition& partition,
+                            PredictionValidator::MetricsAccumulatorMap& partial,
+                            PredictionValidator::BucketAccumulatorMap& buckets, long long& validated);
+    void log_error(const std::string& message);
+
+public:
+    // worker_count 0 = one worker per hardware thread
+    explicit ValidationScheduler(const DatabaseConfig& config, std::size_t worker_count = 0);
+    ~ValidationScheduler();
+
+    // Validate everything pending. Merged metrics are also folded into
+    // `validator` (when given) and persisted through it.
+    ValidationRunStats run(PredictionValidator* validator = nullptr);
+
+    std::size_t worker_count() const { return worker_count_; }
+    void print_run_summary(const ValidationRunStats& stats) const;
+};
+
+#endif
@@ -0,0 +1,125 @@
+#include "BacktestEngine.h"
+#include "Predictions/EMAKernel.h"
+#include "Predictions/PredictionTypes.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <cstdlib>
+#include <algorithm>
+
+// ==============================================
+// BACKTEST BENCHMARK - IN-MEMORY REPLAY AT SCALE
+// ==============================================
+// Replays synthetic weekday history for many symbols across all five
+// timeframes through BacktestEngine (no database), reports the replay time,
+// and checks one series against a straightforward recomputation that copies
+// each 100-bar window and predicts it with the plain kernel.
+
+static const long long FIRST_DAY = 19359;   // 2023-01-02, a Monday
+
+struct SyntheticTimeframe {
+    const char* name;
+    int bars_per_day;
+    int minutes_per_bar;
+};
+
+static const SyntheticTimeframe TIMEFRAMES[] = {
+    { "daily", 1, 0 }, { "15min", 26, 15 }, { "30min", 13, 30 }, { "1hour", 7, 60 }, { "2hours", 4, 120 }
+};
+
+static std::vector<ActualBar> make_series(int symbol, const SyntheticTimeframe& tf, int days) {
+    std::vector<ActualBar> bars;
+    double price = 100.0 + symbol * 7.5;
+    unsigned state = 2166136261u ^ static_cast<unsigned>(symbol * 131 + tf.bars_per_day);
+
+    for (long long day = FIRST_DAY; day < FIRST_DAY + days; day++) {
+        if ((day + 4) % 7 >= 5) continue;   // Day 0 was a Thursday: skip Saturday and Sunday
+        for (int b = 0; b < tf.bars_per_day; b++) {
+            state = state * 1664525u + 1013904223u;
+            double move = (static_cast<int>(state >> 24) - 128) * price * 0.00005;
+
+            ActualBar bar;
+            bar.timestamp = day * 86400 + (tf.minutes_per_bar ? 9 * 3600 + 1800 + b * tf.minutes_per_bar * 60 : 0);
+            bar.open = price;
+            price = std::max(1.0, price + move);
+            bar.close = price;
+            bar.high = std::max(bar.open, bar.close) + price * 0.001;
+            bar.low = std::min(bar.open, bar.close) - price * 0.001;
+            bars.push_back(bar);
+        }
+    }
+    return bars;
+}
+
+int main(int argc, char* argv[]) {
+    const int symbols = argc > 1 ? std::atoi(argv[1]) : 300;
+    const int years = argc > 2 ? std::atoi(argv[2]) : 2;
+    const int days = years * 365;
+
+    std::cout << "⏱️  BACKTEST BENCHMARK" << std::endl;
+    std::cout << "=====================" << std::endl;
+    std::cout << "Symbols:     " << symbols << std::endl;
+    std::cout << "History:     " << years << " years, all five timeframes" << std::endl;
+
+    BacktestConfig config;
+    config.days_back = days;
+    BacktestEngine engine(nullptr, config);
+
+    for (int s = 0; s < symbols; s++) {
+        for (const auto& tf : TIMEFRAMES) {
+            engine.history().add_series("SYM" + std::to_string(s), tf.name, make_series(s, tf, days));
+        }
+    }
+    std::cout << "Bars:        " << engine.history().bar_count() << std::endl;
+
+    BacktestRunStats stats = engine.run();
+    engine.print_summary(stats);
+
+    // Reference: copy each window and run the plain kernel, as the live engine does per prediction
+    bool passed = true;
+    const std::vector<ActualBar>* bars = engine.history().bars("SYM0", "15min");
+    MetricsAccumulator reference;
+    for (std::size_t t = Model1Parameters::MINIMUM_BARS - 1; t + 1 < bars->size(); t++) {
+        std::size_t begin = t + 1 > config.window_bars ? t + 1 - config.window_bars : 0;
+        std::vector<double> window;
+        for (std::size_t i = begin; i <= t; i++) window.push_back((*bars)[i].high);
+
+        double predicted = EMAKernel::predict(EMAKernel::view(window), EMAKernel::STANDARD);
+        double actual = (*bars)[t + 1].high;
+        reference.add(predicted, actual, std::max(0.0, 1.0 - std::fabs((actual - predicted) / actual)));
+    }
+
+    PredictionValidator::MetricsAccumulatorMap single;
+    BacktestRunStats counters;
+    BacktestEngine::replay_series(*bars, "15min", config, nullptr, single, counters);
+    const MetricsAccumulator& replayed = single[PredictionValidator::MetricsKey(config.model_id, "15min_high")];
+
+    if (replayed.count != reference.count || replayed.sum_abs_error != reference.sum_abs_error ||
+        replayed.sum_squared_error != reference.sum_squared_error) {
+        std::cout << "❌ Replay differs from reference: " << replayed.count << " vs " << reference.count
+                  << " predictions, MAE " << std::setprecision(17) << replayed.mae() << " vs " << reference.mae()
+                  << std::endl;
+        passed = false;
+    }
+
+    // Every Friday's daily prediction must be scored against the following Monday
+    const std::vector<ActualBar>* daily = engine.history().bars("SYM0", "daily");
+    long long expected_daily = static_cast<long long>(daily->size()) - Model1Parameters::MINIMUM_BARS;
+    const MetricsAccumulator& daily_close = stats.metrics[PredictionValidator::MetricsKey(config.model_id, "daily_close")];
+    if (daily_close.count != expected_daily * symbols) {
+        std::cout << "❌ Daily predictions scored: " << daily_close.count << ", expected "
+                  << expected_daily * symbols << std::endl;
+        passed = false;
+    }
+
+    if (stats.replay_seconds >= 60.0) {
+        std::cout << "❌ Replay took " << stats.replay_seconds << " s (budget 60 s)" << std::endl;
+        passed = false;
+    }
+
+    std::cout << "\n" << (passed ? "✅ Backtest replay matches the reference kernel" : "❌ Backtest benchmark FAILED")
+              << std::endl;
+    return passed ? 0 : 1;
+}
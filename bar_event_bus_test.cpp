@@ -0,0 +1,175 @@
+#include "IQFeedConnection/BarEventBus.h"
+#include "Predictions/PredictionTrigger.h"
+#include "Predictions/MarketPredictionEngine.h"
+#include "Database/database_simple.h"
+#include <iostream>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <chrono>
+#include <atomic>
+
+// ==============================================
+// BAR EVENT BUS TEST
+// ==============================================
+// Checks unsubscribe() waits for a handler the dispatcher is already inside,
+// a handler unsubscribed while another one runs is not called for that event,
+// a handler can unsubscribe itself without deadlocking, and a PredictionTrigger
+// can be destroyed while events are flowing (run under ASan/TSan to see the
+// use-after-free this guards against).
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static NewBarEvent make_event(const std::string& timeframe = "15min") {
+    NewBarEvent event;
+    event.symbol = "QGC#";
+    event.timeframe = timeframe;
+    event.bar_date = "2025-01-06";
+    event.bar_time = "09:30:00";
+    event.bar_close_time = std::chrono::system_clock::now();
+    event.persisted_time = event.bar_close_time;
+    return event;
+}
+
+// Drops everything; keeps no state, so threads can write to it concurrently
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+
+static bool wait_for(const std::atomic<bool>& flag, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!flag.load()) {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static void test_unsubscribe_waits_for_running_handler() {
+    BarEventBus bus;
+    std::atomic<bool> entered{false};
+    std::atomic<bool> finished{false};
+    std::atomic<int> calls{0};
+
+    int id = bus.subscribe([&](const NewBarEvent&) {
+        calls++;
+        entered = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    });
+
+    bus.publish(make_event());
+    check("handler started", wait_for(entered, std::chrono::milliseconds(2000)));
+    bus.unsubscribe(id);
+    check("unsubscribe returned only after the handler finished", finished.load());
+
+    bus.publish(make_event());
+    bus.stop();
+    check("no delivery after unsubscribe", calls.load() == 1, std::to_string(calls.load()) + " calls");
+}
+
+static void test_unsubscribed_while_another_runs() {
+    BarEventBus bus;
+    std::atomic<bool> first_entered{false};
+    std::atomic<bool> release_first{false};
+    std::atomic<int> second_calls{0};
+
+    // Subscription ids are dispatched in order, so the slow one runs first
+    bus.subscribe([&](const NewBarEvent&) {
+        first_entered = true;
+        wait_for(release_first, std::chrono::milliseconds(2000));
+    });
+    int second = bus.subscribe([&](const NewBarEvent&) { second_calls++; });
+
+    bus.publish(make_event());
+    wait_for(first_entered, std::chrono::milliseconds(2000));
+    bus.unsubscribe(second);                        // Still in the dispatcher's snapshot
+    release_first = true;
+    bus.stop();
+    check("handler removed mid-event is skipped", second_calls.load() == 0);
+}
+
+static void test_unsubscribe_from_inside_handler() {
+    BarEventBus bus;
+    std::atomic<int> calls{0};
+    std::atomic<int> id{0};
+    id = bus.subscribe([&](const NewBarEvent&) {
+        calls++;
+        bus.unsubscribe(id.load());                 // Must not wait on itself
+    });
+
+    bus.publish(make_event());
+    bus.publish(make_event());
+    bus.stop();
+    check("handler unsubscribes itself without deadlock", calls.load() == 1);
+}
+
+static void test_destroy_trigger_while_events_flow() {
+    // The database, engine and trigger report every failure; keep this run quiet
+    NullBuffer discard;
+    std::streambuf* saved_out = std::cout.rdbuf(&discard);
+    std::streambuf* saved_err = std::cerr.rdbuf(&discard);
+
+    // Unreachable database: every triggered prediction fails fast, but the
+    // handler still goes through the trigger's members and its engine
+    DatabaseConfig config;
+    config.host = "127.0.0.1";
+    config.port = 1;
+    MarketPredictionEngine engine(std::make_unique<SimpleDatabaseManager>(config));
+
+    auto bus = std::make_shared<BarEventBus>();
+    std::atomic<bool> publishing{true};
+    std::thread publisher([&]() {
+        while (publishing.load()) {
+            bus->publish(make_event("15min"));
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+    });
+
+    long long triggered = 0;
+    const int rounds = 200;
+    for (int i = 0; i < rounds; i++) {
+        auto trigger = std::make_unique<PredictionTrigger>(engine, bus);
+        std::this_thread::sleep_for(std::chrono::microseconds(200 + (i % 7) * 100));
+        triggered += trigger->predictions_triggered();
+        trigger.reset();                            // Dispatcher may be inside on_new_bar right now
+    }
+
+    publishing = false;
+    publisher.join();
+    bus->stop();
+
+    std::cout.rdbuf(saved_out);
+    std::cerr.rdbuf(saved_err);
+
+    check("triggers destroyed mid-delivery (" + std::to_string(rounds) + " rounds)", true);
+    check("events reached the triggers", triggered > 0, std::to_string(triggered) + " triggered");
+}
+
+int main() {
+    std::cout << "=== BAR EVENT BUS TEST ===" << std::endl;
+    Logger::set_console_mirror(false);
+
+    test_unsubscribe_waits_for_running_handler();
+    test_unsubscribed_while_another_runs();
+    test_unsubscribe_from_inside_handler();
+    test_destroy_trigger_while_events_flow();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Bar event bus test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Subscribers can be destroyed while events are flowing" << std::endl;
+    return 0;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "database_simple.h"
+#include <memory>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <cstddef>
+
+// ==============================================
+// DATABASE CONNECTION POOL
+// ==============================================
+
+// A SimpleDatabaseManager owns one libpq connection, which must only be used
+// by one thread at a time. The pool opens a fixed set of connections up
+// front and lends each one out exclusively. acquire() blocks until a
+// connection is free, and the Lease hands it back when it goes out of scope.
+class DatabaseConnectionPool {
+public:
+    class Lease {
+    public:
+        Lease(Lease&& other) noexcept : pool_(other.pool_), index_(other.index_) { other.pool_ = nullptr; }
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+        Lease& operator=(Lease&&) = delete;
+        ~Lease() { if (pool_) pool_->release(index_); }
+
+        SimpleDatabaseManager* get() const { return pool_->connections_[index_].get(); }
+        SimpleDatabaseManager* operator->() const { return get(); }
+        SimpleDatabaseManager& operator*() const { return *get(); }
+
+    private:
+        friend class DatabaseConnectionPool;
+        Lease(DatabaseConnectionPool* pool, std::size_t index) : pool_(pool), index_(index) {}
+
+        DatabaseConnectionPool* pool_;
+        std::size_t index_;
+    };
+
+    DatabaseConnectionPool(const DatabaseConfig& config, std::size_t size) {
+        if (size == 0) size = 1;
+        connections_.reserve(size);
+        for (std::size_t i = 0; i < size; i++) {
+            connections_.push_back(std::make_unique<SimpleDatabaseManager>(config));
+            free_.push_back(i);
+        }
+    }
+
+    DatabaseConnectionPool(const DatabaseConnectionPool&) = delete;
+    DatabaseConnectionPool& operator=(const DatabaseConnectionPool&) = delete;
+
+    Lease acquire() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_.wait(lock, [this] { return !free_.empty(); });
+        std::size_t index = free_.back();
+        free_.pop_back();
+        return Lease(this, index);
+    }
+
+    std::size_t size() const { return connections_.size(); }
+
+    std::size_t connected_count() const {
+        std::size_t connected = 0;
+        for (const auto& connection : connections_) {
+            if (connection->is_connected()) connected++;
+        }
+        return connected;
+    }
+
+private:
+    void release(std::size_t index) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            free_.push_back(index);
+        }
+        available_.notify_one();
+    }
+
+    std::vector<std::unique_ptr<SimpleDatabaseManager>> connections_;
+    std::vector<std::size_t> free_;
+    std::mutex mutex_;
+    std::condition_variable available_;
+};
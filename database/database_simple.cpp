@@ -1,7 +1,62 @@
 #include "database_simple.h"
+#include "MetricsRegistry.h"
+#include "Tracer.h"
 #include <iostream>
 #include <sstream>
 #include <iomanip>
+#include <cctype>
+
+namespace {
+    // Every round trip goes through execute_query or execute_query_with_result;
+    // split by the statement's first keyword so upserts and lookups separate
+    enum QueryKind { QUERY_INSERT, QUERY_SELECT, QUERY_UPDATE, QUERY_DELETE, QUERY_OTHER, QUERY_KINDS };
+
+    QueryKind query_kind(const std::string& query) {
+        std::size_t start = 0;
+        while (start < query.size() && std::isspace(static_cast<unsigned char>(query[start]))) start++;
+        auto starts_with = [&](const char* keyword) {
+            std::size_t i = 0;
+            for (; keyword[i]; i++) {
+                if (start + i >= query.size() ||
+                    std::toupper(static_cast<unsigned char>(query[start + i])) != keyword[i]) {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (starts_with("INSERT")) return QUERY_INSERT;
+        if (starts_with("SELECT")) return QUERY_SELECT;
+        if (starts_with("UPDATE")) return QUERY_UPDATE;
+        if (starts_with("DELETE")) return QUERY_DELETE;
+        return QUERY_OTHER;
+    }
+
+    Histogram& query_seconds(QueryKind kind) {
+        static Histogram* histograms[QUERY_KINDS] = {};
+        static std::once_flag registered;
+        std::call_once(registered, []() {
+            const char* names[QUERY_KINDS] = { "insert", "select", "update", "delete", "other" };
+            for (int i = 0; i < QUERY_KINDS; i++) {
+                histograms[i] = &MetricsRegistry::instance().histogram(
+                    "nexday_db_query_seconds", "PostgreSQL round trip time per statement", { { "statement", names[i] } });
+            }
+        });
+        return *histograms[kind];
+    }
+
+    // Span names for the trace, one per QueryKind
+    const char* query_span_name(QueryKind kind) {
+        static const char* names[QUERY_KINDS] = { "query_insert", "query_select", "query_update",
+                                                  "query_delete", "query_other" };
+        return names[kind];
+    }
+
+    Counter& query_errors() {
+        static Counter& errors = MetricsRegistry::instance().counter(
+            "nexday_db_query_errors_total", "Statements that failed or had no connection");
+        return errors;
+    }
+}
 
 // ==============================================
 // CONSTRUCTOR AND DESTRUCTOR
@@ -34,10 +89,14 @@ bool SimpleDatabaseManager::connect_to_database() {
             std::cerr << last_error_ << std::endl;
             PQfinish(connection_);
             connection_ = nullptr;
+            MetricsRegistry::instance().counter("nexday_db_connects_total", "Connection attempts",
+                                                { { "result", "failed" } }).inc();
             return false;
         }
         
         is_connected_ = true;
+        MetricsRegistry::instance().counter("nexday_db_connects_total", "Connection attempts",
+                                            { { "result", "ok" } }).inc();
         std::cout << "✅ Database connection established successfully" << std::endl;
         return true;
         
@@ -346,13 +405,20 @@ bool SimpleDatabaseManager::insert_historical_data(const std::string& symbol, co
 bool SimpleDatabaseManager::execute_query(const std::string& query) {
     if (!is_connected_) {
         last_error_ = "Not connected to database";
+        query_errors().inc();
         return false;
     }
     
+    QueryKind kind = query_kind(query);
+    ScopedTimer timer(query_seconds(kind));
+    TraceSpan span("db", query_span_name(kind));
     PGresult* result = PQexec(connection_, query.c_str());
+    timer.stop();
+    span.end();
     ExecStatusType status = PQresultStatus(result);
     
     if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+        query_errors().inc();
         last_error_ = std::string("Query execution failed: ") + PQerrorMessage(connection_);
         std::cerr << "Query failed: " << last_error_ << std::endl;
         std::cerr << "Query was: " << query << std::endl;
@@ -367,13 +433,20 @@ bool SimpleDatabaseManager::execute_query(const std::string& query) {
 PGresult* SimpleDatabaseManager::execute_query_with_result(const std::string& query) {
     if (!is_connected_) {
         last_error_ = "Not connected to database";
+        query_errors().inc();
         return nullptr;
     }
     
+    QueryKind kind = query_kind(query);
+    ScopedTimer timer(query_seconds(kind));
+    TraceSpan span("db", query_span_name(kind));
     PGresult* result = PQexec(connection_, query.c_str());
+    timer.stop();
+    span.end();
     ExecStatusType status = PQresultStatus(result);
     
     if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+        query_errors().inc();
         last_error_ = std::string("Query execution failed: ") + PQerrorMessage(connection_);
         std::cerr << "Query failed: " << last_error_ << std::endl;
         std::cerr << "Query was: " << query << std::endl;
@@ -397,7 +470,16 @@ std::string SimpleDatabaseManager::escape_string(const std::string& input) {
     return result;
 }
 
+std::string SimpleDatabaseManager::bar_timestamp(const std::string& wall_clock) {
+    return "('" + escape_string(wall_clock) + "'::timestamp AT TIME ZONE 'UTC')";
+}
+
+std::string SimpleDatabaseManager::bar_timestamp_of(const std::string& timestamptz_expression) {
+    return "((" + timestamptz_expression + ")::timestamp AT TIME ZONE 'UTC')";
+}
+
 int SimpleDatabaseManager::get_symbol_id(const std::string& symbol) {
+    NEXDAY_TRACE_SPAN("db", "symbol_lookup", symbol);
     std::string query = "SELECT symbol_id FROM symbols WHERE symbol = '" + escape_string(symbol) + "'";
     PGresult* result = execute_query_with_result(query);
     
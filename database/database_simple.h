@@ -41,6 +41,13 @@ public:
     bool execute_query(const std::string& query);
     
     std::string escape_string(const std::string& input);
+    
+    // Intraday tables carry bar_ts = (fetch_date + fetch_time) AT TIME ZONE 'UTC'.
+    // These give the matching bar_ts value for a "YYYY-MM-DD HH:MM:SS" wall
+    // clock literal, or for a timestamptz SQL expression (taken in the session
+    // time zone, as ::date/::time casts would), so lookups stay index ranges.
+    std::string bar_timestamp(const std::string& wall_clock);
+    static std::string bar_timestamp_of(const std::string& timestamptz_expression);
     int get_symbol_id(const std::string& symbol);
     int get_or_create_symbol_id(const std::string& symbol);
     
@@ -0,0 +1,241 @@
+#include "Predictions/EMACalculator.h"
+#include "Predictions/MarketPredictionEngine.h"
+#include "IntegratedMarketPredictionEngine.h"
+#include "IQFeedConnection/Logger.h"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// ==============================================
+// EMA HOT PATH BENCHMARK - ALLOCATION COUNTING
+// ==============================================
+// Replaces global operator new/delete with counting versions so we can prove
+// the production prediction path (no trace) never touches the heap, and
+// compares the scalar and SIMD variants of the shared EMA kernel. Both
+// engines' EMA entry points are held to the same bar; they are built with
+// no database (neither method touches it).
+
+static std::atomic<long long> g_allocation_count{0};
+static std::atomic<long long> g_allocated_bytes{0};
+
+void* operator new(std::size_t size) {
+    g_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    g_allocated_bytes.fetch_add(static_cast<long long>(size), std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size ? size : 1)) return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+struct BenchBar {
+    double open;
+    double high;
+    double low;
+    double close;
+};
+
+struct AllocationSnapshot {
+    long long count;
+    long long bytes;
+
+    static AllocationSnapshot take() {
+        return { g_allocation_count.load(), g_allocated_bytes.load() };
+    }
+};
+
+static bool report(const std::string& name, int iterations, double checksum,
+                   const AllocationSnapshot& before, const AllocationSnapshot& after,
+                   std::chrono::steady_clock::duration elapsed, bool expect_zero) {
+    long long allocations = after.count - before.count;
+    long long bytes = after.bytes - before.bytes;
+    double ns_per_call = std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+
+    std::cout << name << std::endl;
+    std::cout << "   Iterations:   " << iterations << std::endl;
+    std::cout << "   ns/call:      " << ns_per_call << std::endl;
+    std::cout << "   Allocations:  " << allocations << " (" << bytes << " bytes)" << std::endl;
+    std::cout << "   Checksum:     " << checksum << std::endl;
+
+    if (expect_zero && allocations != 0) {
+        std::cout << "❌ Hot path allocated memory" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    const int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+    const int num_bars = 100;
+    Logger::set_console_mirror(false);
+    Logger::set_level(LogLevel::Info);          // Debug lines in the engines would allocate
+
+    std::cout << "⏱️  EMA HOT PATH BENCHMARK" << std::endl;
+    std::cout << "=========================" << std::endl;
+    std::cout << "Bars per series: " << num_bars << std::endl;
+
+    // Synthetic price series (allocated up front, outside the measured region)
+    std::vector<double> prices;
+    std::vector<BenchBar> bars;
+    prices.reserve(num_bars);
+    bars.reserve(num_bars);
+    for (int i = 0; i < num_bars; i++) {
+        double close = 2000.0 + (i % 7) * 1.25 - (i % 3) * 0.5;
+        prices.push_back(close);
+        bars.push_back({ close - 0.5, close + 1.0, close - 1.0, close });
+    }
+
+    bool passed = true;
+
+    // 1. Vector input, no trace
+    {
+        double checksum = 0.0;
+        auto before = AllocationSnapshot::take();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            checksum += SimpleEMACalculator::calculate_prediction(prices);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto after = AllocationSnapshot::take();
+        passed &= report("\n📊 calculate_prediction(vector<double>)", iterations, checksum,
+                         before, after, elapsed, true);
+    }
+
+    // 2. Bar container + member pointer, no trace (all four OHLC fields)
+    {
+        double checksum = 0.0;
+        auto before = AllocationSnapshot::take();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            checksum += SimpleEMACalculator::calculate_prediction(bars, &BenchBar::open);
+            checksum += SimpleEMACalculator::calculate_prediction(bars, &BenchBar::high);
+            checksum += SimpleEMACalculator::calculate_prediction(bars, &BenchBar::low);
+            checksum += SimpleEMACalculator::calculate_prediction(bars, &BenchBar::close);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto after = AllocationSnapshot::take();
+        passed &= report("\n📊 calculate_prediction(bars, field) x4 OHLC", iterations, checksum,
+                         before, after, elapsed, true);
+    }
+
+    // 3. Opt-in trace into caller-owned stack buffers - still no heap use
+    {
+        double sma_buffer[10];
+        double ema_buffer[num_bars];
+        EMATrace trace(sma_buffer, 10, ema_buffer, num_bars);
+
+        double checksum = 0.0;
+        auto before = AllocationSnapshot::take();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            checksum += SimpleEMACalculator::calculate_prediction(prices, &trace);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto after = AllocationSnapshot::take();
+        passed &= report("\n📊 calculate_prediction(vector<double>, trace)", iterations, checksum,
+                         before, after, elapsed, true);
+
+        // Traced and untraced paths must agree
+        if (trace.ema_total == 0 ||
+            ema_buffer[trace.ema_count() - 1] != SimpleEMACalculator::calculate_prediction(prices)) {
+            std::cout << "❌ Trace capture does not match final prediction" << std::endl;
+            passed = false;
+        }
+    }
+
+    // 4. Shared kernel: four scalar passes vs one SIMD pass over O/H/L/C
+    {
+        static constexpr double BenchBar::* ohlc[] = { &BenchBar::open, &BenchBar::high, &BenchBar::low, &BenchBar::close };
+        double scalar_out[4];
+        double simd_out[4];
+
+        auto before = AllocationSnapshot::take();
+        auto start = std::chrono::steady_clock::now();
+        double checksum = 0.0;
+        for (int i = 0; i < iterations; i++) {
+            for (int k = 0; k < 4; k++) {
+                scalar_out[k] = EMAKernel::predict(EMAKernel::view(bars, ohlc[k]), EMAKernel::STANDARD);
+            }
+            checksum += scalar_out[0] + scalar_out[1] + scalar_out[2] + scalar_out[3];
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto after = AllocationSnapshot::take();
+        passed &= report("\n📊 EMAKernel::predict x4 (scalar)", iterations, checksum,
+                         before, after, elapsed, true);
+
+        before = AllocationSnapshot::take();
+        start = std::chrono::steady_clock::now();
+        checksum = 0.0;
+        for (int i = 0; i < iterations; i++) {
+            EMAKernel::predict_fields(bars, ohlc, false, EMAKernel::STANDARD, simd_out);
+            checksum += simd_out[0] + simd_out[1] + simd_out[2] + simd_out[3];
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        after = AllocationSnapshot::take();
+        passed &= report(std::string("\n📊 EMAKernel::predict_fields OHLC (") + EMAKernel::simd_path() + ")",
+                         iterations, checksum, before, after, elapsed, true);
+
+        for (int k = 0; k < 4; k++) {
+            if (scalar_out[k] != simd_out[k]) {
+                std::cout << "❌ SIMD lane " << k << " differs from scalar kernel" << std::endl;
+                passed = false;
+            }
+        }
+    }
+
+    // 5. The engines' own EMA methods, as generate_daily_prediction calls them (no trace)
+    {
+        std::vector<HistoricalBar> historical;
+        std::vector<PriceBar> price_bars;
+        historical.reserve(num_bars);
+        price_bars.reserve(num_bars);
+        auto first = std::chrono::system_clock::from_time_t(1704153600);
+        for (const BenchBar& bar : bars) {
+            historical.emplace_back(first + std::chrono::hours(24 * historical.size()),
+                                    bar.open, bar.high, bar.low, bar.close, 1000);
+            price_bars.emplace_back("2024-01-02", bar.open, bar.high, bar.low, bar.close, 1000);
+        }
+        const std::string fields[] = { "open", "high", "low", "close" };
+
+        DatabaseConfig no_database;
+        no_database.host = "127.0.0.1";
+        no_database.port = 1;
+        MarketPredictionEngine engine(std::make_unique<SimpleDatabaseManager>(no_database));
+        Logger::flush();
+
+        double checksum = 0.0;
+        auto before = AllocationSnapshot::take();
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            for (const auto& field : fields) {
+                checksum += engine.calculate_ema_for_prediction(historical, field).final_ema;
+            }
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        auto after = AllocationSnapshot::take();
+        passed &= report("\n📊 MarketPredictionEngine::calculate_ema_for_prediction x4 OHLC", iterations, checksum,
+                         before, after, elapsed, true);
+
+        IntegratedMarketPredictionEngine integrated(nullptr, nullptr);
+        Logger::flush();        // The constructor's log lines are written off-thread; keep them out of the count
+
+        checksum = 0.0;
+        before = AllocationSnapshot::take();
+        start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; i++) {
+            for (const auto& field : fields) {
+                checksum += integrated.calculate_ema_sequence(price_bars, field).final_ema;
+            }
+        }
+        elapsed = std::chrono::steady_clock::now() - start;
+        after = AllocationSnapshot::take();
+        passed &= report("\n📊 IntegratedMarketPredictionEngine::calculate_ema_sequence x4 OHLC", iterations, checksum,
+                         before, after, elapsed, true);
+    }
+
+    std::cout << "\n" << (passed ? "✅ EMA hot path is allocation-free" : "❌ EMA benchmark FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+#include "Predictions/EMAKernel.h"
+#include "Predictions/EMACalculator.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+
+// ==============================================
+// EMA KERNEL GOLDEN-VALUE TEST
+// ==============================================
+// Expected values were recorded from the engine implementations as they were
+// before they were moved onto EMAKernel:
+//   standard   - MarketPredictionEngine / ema_test (SMA1..SMA10, EMA from bar 15)
+//   overlapped - SimpleEMACalculator (reversed input, EMA from bar 11)
+//   sma10      - IntegratedMarketPredictionEngine (SMA of first 10 bars, EMA from bar 11)
+
+struct GoldenCase {
+    const char* name;
+    std::vector<double> prices;
+    double standard;
+    double overlapped;
+    double sma10;
+};
+
+struct TestBar {
+    double open;
+    double high;
+    double low;
+    double close;
+};
+
+static const double TOLERANCE = 1e-9;
+static int g_failures = 0;
+
+static void check(const std::string& label, double actual, double expected) {
+    bool ok = std::fabs(actual - expected) <= TOLERANCE;
+    std::cout << (ok ? "✅ " : "❌ ") << label << ": " << std::setprecision(17) << actual;
+    if (!ok) {
+        std::cout << " (expected " << expected << ")";
+        g_failures++;
+    }
+    std::cout << std::endl;
+}
+
+// Deterministic synthetic series (integer arithmetic only, so identical on every platform)
+static std::vector<double> synthetic_series(int num_bars, int k) {
+    std::vector<double> prices;
+    for (int i = 0; i < num_bars; i++) {
+        prices.push_back(2000.0 + ((i * 37 + k * 11) % 23) * 0.35 - (i % 5) * 0.8 + k * 3.25);
+    }
+    return prices;
+}
+
+int main() {
+    std::cout << "=== EMA KERNEL GOLDEN-VALUE TEST ===" << std::endl;
+    std::cout << "SIMD path: " << EMAKernel::simd_path() << std::endl;
+
+    std::vector<double> sample = {100.0, 101.0, 102.0, 103.0, 104.0, 103.5, 102.0, 101.5, 102.5, 103.0,
+                                  104.0, 105.0, 104.5, 103.0, 102.5, 103.5, 104.0, 105.5, 106.0, 105.0};
+
+    std::vector<GoldenCase> cases = {
+        { "sample20", sample, 105.14687499999999, 100.89902343750001, 105.142822265625 },
+        { "sample15", std::vector<double>(sample.begin(), sample.begin() + 15), 103.2, 100.89687499999999, 103.0703125 },
+        { "synthetic0", synthetic_series(100, 0), 2000.3848853327822, 2001.3725801498658, 2000.3848853327822 },
+        { "synthetic1", synthetic_series(100, 1), 2005.1467761747301, 2005.8755528603529, 2005.1467761747301 },
+        { "synthetic2", synthetic_series(100, 2), 2006.5663306490308, 2011.5475806296834, 2006.5663306490308 },
+        { "synthetic3", synthetic_series(100, 3), 2011.2968375913633, 2012.0257985268861, 2011.2968375913633 },
+    };
+
+    // Scalar kernel, per layout
+    std::cout << "\n📊 Scalar kernel" << std::endl;
+    for (const auto& c : cases) {
+        std::string name = c.name;
+        check(name + " standard", EMAKernel::predict(EMAKernel::view(c.prices), EMAKernel::STANDARD), c.standard);
+        check(name + " overlapped", EMAKernel::predict(EMAKernel::view(c.prices, true), EMAKernel::OVERLAPPED), c.overlapped);
+        check(name + " sma10", EMAKernel::predict(EMAKernel::view(c.prices), EMAKernel::SMA10_SEED), c.sma10);
+        check(name + " SimpleEMACalculator", SimpleEMACalculator::calculate_prediction(c.prices), c.overlapped);
+    }
+
+    // SIMD kernel: the four synthetic series as O/H/L/C of one bar array
+    std::cout << "\n📊 SIMD kernel (O/H/L/C lanes)" << std::endl;
+    std::vector<TestBar> bars(100);
+    for (int k = 0; k < 4; k++) {
+        const std::vector<double>& prices = cases[2 + k].prices;
+        for (size_t i = 0; i < bars.size(); i++) {
+            double TestBar::* fields[] = { &TestBar::open, &TestBar::high, &TestBar::low, &TestBar::close };
+            bars[i].*fields[k] = prices[i];
+        }
+    }
+
+    static constexpr double TestBar::* ohlc[] = { &TestBar::open, &TestBar::high, &TestBar::low, &TestBar::close };
+    double standard[4];
+    double overlapped[4];
+    EMAKernel::predict_fields(bars, ohlc, false, EMAKernel::STANDARD, standard);
+    SimpleEMACalculator::calculate_predictions(bars, ohlc, overlapped);
+    for (int k = 0; k < 4; k++) {
+        std::string name = cases[2 + k].name;
+        check(name + " standard (SIMD)", standard[k], cases[2 + k].standard);
+        check(name + " overlapped (SIMD)", overlapped[k], cases[2 + k].overlapped);
+    }
+
+    // Two-lane path (intraday High/Low)
+    static constexpr double TestBar::* high_low[] = { &TestBar::high, &TestBar::low };
+    double hl[2];
+    EMAKernel::predict_fields(bars, high_low, true, EMAKernel::OVERLAPPED, hl);
+    check("synthetic1 overlapped (SIMD H/L)", hl[0], cases[3].overlapped);
+    check("synthetic2 overlapped (SIMD H/L)", hl[1], cases[4].overlapped);
+
+    // Trace capture must agree with the final value and layout
+    std::cout << "\n📊 Trace capture" << std::endl;
+    double sma_buffer[10];
+    double ema_buffer[8];
+    EMATrace trace(sma_buffer, 10, ema_buffer, 8);
+    double traced = EMAKernel::predict(EMAKernel::view(sample), EMAKernel::STANDARD, EMAKernel::BASE_ALPHA, &trace);
+    check("sample20 traced", traced, cases[0].standard);
+    check("sample20 last EMA in trace", ema_buffer[trace.ema_total - 1], traced);
+    if (trace.sma_total != 10 || trace.ema_total != sample.size() - 14) {
+        std::cout << "❌ Unexpected trace counts: " << trace.sma_total << " SMA, " << trace.ema_total << " EMA" << std::endl;
+        g_failures++;
+    }
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ EMA kernel test FAILED (" << g_failures << " mismatches)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ EMA kernel matches all golden values!" << std::endl;
+    return 0;
+}
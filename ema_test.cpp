@@ -2,33 +2,7 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-
-// Simple EMA calculation test
-class SimpleEMACalculator {
-public:
-    static double calculate_sma(const std::vector<double>& values, int start_index, int window_size) {
-        if (start_index + window_size > values.size()) return 0.0;
-        
-        double sum = 0.0;
-        for (int i = start_index; i < start_index + window_size; i++) {
-            sum += values[i];
-        }
-        return sum / window_size;
-    }
-    
-    static std::vector<double> calculate_ema_sequence(const std::vector<double>& values, double initial_previous_predict) {
-        std::vector<double> ema_values;
-        double previous_predict = initial_previous_predict;
-        const double BASE_ALPHA = 0.5;
-        
-        for (double current_value : values) {
-            double predict_t = (BASE_ALPHA * current_value) + ((1.0 - BASE_ALPHA) * previous_predict);
-            ema_values.push_back(predict_t);
-            previous_predict = predict_t;
-        }
-        return ema_values;
-    }
-};
+#include "Predictions/EMAKernel.h"
 
 int main() {
     std::cout << "=== EMA CALCULATION TEST ===" << std::endl;
@@ -43,28 +17,29 @@ int main() {
     }
     std::cout << "..." << std::endl;
     
-    // Calculate SMA bootstrap (SMA1-SMA10)
-    std::vector<double> sma_values;
-    for (int i = 0; i < 10; i++) {
-        double sma = SimpleEMACalculator::calculate_sma(sample_prices, i, 5);
-        sma_values.push_back(sma);
-        std::cout << "SMA" << (i+1) << ": " << sma << std::endl;
-    }
+    // Capture the SMA bootstrap and EMA chain from the shared kernel
+    std::vector<double> sma_values(EMAKernel::STANDARD.sma_periods);
+    std::vector<double> ema_values(sample_prices.size());
+    EMATrace trace(sma_values.data(), sma_values.size(), ema_values.data(), ema_values.size());
+    
+    double final_prediction = EMAKernel::predict(EMAKernel::view(sample_prices), EMAKernel::STANDARD, 
+                                                 EMAKernel::BASE_ALPHA, &trace);
+    ema_values.resize(trace.ema_count());
     
-    // Use SMA10 as initial previous_predict
-    double initial_previous_predict = sma_values.back();
-    std::cout << "\nUsing SMA10 as initial previous_predict: " << initial_previous_predict << std::endl;
+    // SMA bootstrap (SMA1-SMA10)
+    for (size_t i = 0; i < sma_values.size(); i++) {
+        std::cout << "SMA" << (i+1) << ": " << sma_values[i] << std::endl;
+    }
     
-    // Calculate EMA sequence from bar 15 onwards
-    std::vector<double> ema_input_series(sample_prices.begin() + 14, sample_prices.end());
-    auto ema_values = SimpleEMACalculator::calculate_ema_sequence(ema_input_series, initial_previous_predict);
+    // SMA10 is the initial previous_predict
+    std::cout << "\nUsing SMA10 as initial previous_predict: " << sma_values.back() << std::endl;
     
+    // EMA sequence from bar 15 onwards
     std::cout << "\nEMA sequence:" << std::endl;
     for (size_t i = 0; i < ema_values.size(); i++) {
         std::cout << "EMA" << (i + 15) << ": " << ema_values[i] << std::endl;
     }
     
-    double final_prediction = ema_values.back();
     std::cout << "\nFinal EMA prediction: " << final_prediction << std::endl;
     std::cout << "✅ EMA calculation test completed!" << std::endl;
     
@@ -0,0 +1,136 @@
+#include "Predictions/ErrorMetricsKernel.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+#include <algorithm>
+#include <cstdlib>
+
+// ==============================================
+// ERROR METRICS BENCHMARK - FUSED KERNEL VS SEPARATE PASSES
+// ==============================================
+// Times the previous one-loop-per-metric implementation against the fused
+// single-pass kernel on 1M samples, and checks that both agree.
+
+struct SeparatePassMetrics {
+    double mae, rmse, mape, smape, r_squared, max_deviation, directional_accuracy;
+};
+
+// The per-metric loops the validators used before the fused kernel
+static SeparatePassMetrics separate_passes(const std::vector<double>& actual, const std::vector<double>& predicted,
+                                           const std::vector<double>& previous) {
+    SeparatePassMetrics m{};
+    const size_t n = actual.size();
+
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++) sum += std::abs(actual[i] - predicted[i]);
+    m.mae = sum / n;
+
+    sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double diff = actual[i] - predicted[i];
+        sum += diff * diff;
+    }
+    m.rmse = std::sqrt(sum / n);
+
+    sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        if (actual[i] != 0.0) sum += std::abs((actual[i] - predicted[i]) / actual[i]);
+    }
+    m.mape = (sum / n) * 100.0;
+
+    sum = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        double denominator = (std::abs(actual[i]) + std::abs(predicted[i])) / 2.0;
+        if (denominator != 0.0) sum += std::abs(actual[i] - predicted[i]) / denominator;
+    }
+    m.smape = (sum / n) * 100.0;
+
+    double mean_actual = std::accumulate(actual.begin(), actual.end(), 0.0) / n;
+    double ss_tot = 0.0, ss_res = 0.0;
+    for (size_t i = 0; i < n; i++) {
+        ss_tot += (actual[i] - mean_actual) * (actual[i] - mean_actual);
+        ss_res += (actual[i] - predicted[i]) * (actual[i] - predicted[i]);
+    }
+    m.r_squared = ss_tot == 0.0 ? 1.0 : 1.0 - (ss_res / ss_tot);
+
+    std::vector<double> deviations;
+    for (size_t i = 0; i < n; i++) deviations.push_back(std::abs(actual[i] - predicted[i]));
+    m.max_deviation = *std::max_element(deviations.begin(), deviations.end());
+
+    long long correct = 0;
+    for (size_t i = 0; i < n; i++) {
+        if ((actual[i] > previous[i]) == (predicted[i] > previous[i])) correct++;
+    }
+    m.directional_accuracy = static_cast<double>(correct) / n;
+
+    return m;
+}
+
+static bool agree(const std::string& name, double fused, double reference) {
+    double scale = std::max(1.0, std::abs(reference));
+    if (std::abs(fused - reference) > 1e-9 * scale) {
+        std::cout << "❌ " << name << " differs: fused=" << std::setprecision(17) << fused
+                  << " separate=" << reference << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    const size_t samples = argc > 1 ? static_cast<size_t>(std::atol(argv[1])) : 1000000;
+    const int repetitions = argc > 2 ? std::atoi(argv[2]) : 20;
+
+    std::cout << "⏱️  ERROR METRICS BENCHMARK" << std::endl;
+    std::cout << "==========================" << std::endl;
+    std::cout << "Samples:     " << samples << std::endl;
+    std::cout << "Repetitions: " << repetitions << std::endl;
+    std::cout << "SIMD path:   " << ErrorMetricsKernel::simd_path() << std::endl;
+
+    // Deterministic price-like series: actual moves from previous, prediction errs around actual
+    std::vector<double> actual(samples), predicted(samples), previous(samples);
+    double price = 2000.0;
+    for (size_t i = 0; i < samples; i++) {
+        previous[i] = price;
+        price += ((i * 37) % 23 - 11) * 0.25;
+        actual[i] = price;
+        predicted[i] = price + ((i * 13) % 17 - 8) * 0.3;
+    }
+
+    // Separate passes
+    SeparatePassMetrics reference{};
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        reference = separate_passes(actual, predicted, previous);
+    }
+    double separate_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    // Fused kernel
+    ErrorMetrics fused;
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repetitions; r++) {
+        fused = ErrorMetricsKernel::compute(actual, predicted, previous);
+    }
+    double fused_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "\n📊 Separate passes:  " << separate_ms << " ms/run" << std::endl;
+    std::cout << "📊 Fused kernel:     " << fused_ms << " ms/run" << std::endl;
+    std::cout << "📊 Speedup:          " << (fused_ms > 0 ? separate_ms / fused_ms : 0.0) << "x" << std::endl;
+    std::cout << "📊 Throughput:       " << (samples / (fused_ms / 1000.0)) / 1e6 << " M samples/s" << std::endl;
+
+    bool passed = true;
+    passed &= agree("MAE", fused.mae, reference.mae);
+    passed &= agree("RMSE", fused.rmse, reference.rmse);
+    passed &= agree("MAPE", fused.mape, reference.mape);
+    passed &= agree("SMAPE", fused.smape, reference.smape);
+    passed &= agree("R²", fused.r_squared, reference.r_squared);
+    passed &= agree("max deviation", fused.max_deviation, reference.max_deviation);
+    passed &= agree("directional accuracy", fused.directional_accuracy, reference.directional_accuracy);
+
+    std::cout << "\n" << (passed ? "✅ Fused kernel matches separate passes" : "❌ Error metrics benchmark FAILED") << std::endl;
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,237 @@
+#include "IQFeedConnection/FetchExecutor.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+
+// ==============================================
+// FETCH EXECUTOR TEST
+// ==============================================
+// Checks FetchExecutor's priority order (live before backfill, 15min before
+// 2hours), its global in-flight cap and queue backpressure, and replays a
+// 15:00 bar close (every symbol on all four intraday timeframes) with a
+// simulated IQFeed round trip to check the bars land close together.
+
+using Clock = std::chrono::steady_clock;
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static FetchJob make_job(const std::string& timeframe, const std::string& symbol, FetchPriority priority,
+                         std::function<bool()> run) {
+    FetchJob job;
+    job.timeframe = timeframe;
+    job.symbol = symbol;
+    job.priority = priority;
+    job.run = std::move(run);
+    return job;
+}
+
+static void test_priority_order() {
+    FetchExecutorConfig config;
+    config.worker_count = 1;
+    FetchExecutor executor(config);
+
+    // Hold the only worker so everything below queues up behind it
+    std::mutex gate;
+    gate.lock();
+    executor.submit(make_job("daily", "GATE", FetchPriority::LIVE, [&] {
+        std::lock_guard<std::mutex> hold(gate);
+        return true;
+    }));
+    while (executor.in_flight() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    std::vector<std::string> order;
+    std::mutex order_mutex;
+    auto record = [&](const std::string& label) {
+        return [&, label] {
+            std::lock_guard<std::mutex> lock(order_mutex);
+            order.push_back(label);
+            return true;
+        };
+    };
+
+    executor.submit(make_job("2hours", "A", FetchPriority::BACKFILL, record("backfill 2hours")));
+    executor.submit(make_job("2hours", "A", FetchPriority::LIVE, record("live 2hours")));
+    executor.submit(make_job("15min", "A", FetchPriority::BACKFILL, record("backfill 15min")));
+    executor.submit(make_job("1hour", "A", FetchPriority::LIVE, record("live 1hour")));
+    executor.submit(make_job("15min", "A", FetchPriority::LIVE, record("live 15min")));
+
+    gate.unlock();
+    executor.wait_idle();
+
+    std::vector<std::string> expected = { "live 15min", "live 1hour", "live 2hours", "backfill 15min", "backfill 2hours" };
+    check("live before backfill, shorter timeframes first", order == expected);
+}
+
+static void test_in_flight_cap() {
+    FetchExecutorConfig config;
+    config.worker_count = 8;
+    config.max_in_flight = 3;
+    FetchExecutor executor(config);
+
+    std::atomic<int> running{ 0 };
+    std::atomic<int> peak{ 0 };
+    for (int i = 0; i < 40; i++) {
+        executor.submit(make_job("15min", "S" + std::to_string(i), FetchPriority::LIVE, [&] {
+            int now = ++running;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+            running--;
+            return true;
+        }));
+    }
+    executor.wait_idle();
+    check("in-flight cap of 3 respected", peak <= 3 && peak >= 2, "peak " + std::to_string(peak.load()));
+
+    // Lowering the cap at runtime takes effect for the next jobs
+    executor.set_max_in_flight(1);
+    peak = 0;
+    for (int i = 0; i < 10; i++) {
+        executor.submit(make_job("30min", "S" + std::to_string(i), FetchPriority::LIVE, [&] {
+            int now = ++running;
+            int seen = peak.load();
+            while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            running--;
+            return true;
+        }));
+    }
+    executor.wait_idle();
+    check("lowered in-flight cap respected", peak == 1, "peak " + std::to_string(peak.load()));
+}
+
+static void test_backpressure() {
+    FetchExecutorConfig config;
+    config.worker_count = 1;
+    config.max_queue_depth = 2;
+    FetchExecutor executor(config);
+
+    std::mutex gate;
+    gate.lock();
+    executor.submit(make_job("15min", "GATE", FetchPriority::LIVE, [&] {
+        std::lock_guard<std::mutex> hold(gate);
+        return true;
+    }));
+    while (executor.in_flight() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    bool first = executor.try_submit(make_job("15min", "A", FetchPriority::LIVE, [] { return true; }));
+    bool second = executor.try_submit(make_job("15min", "B", FetchPriority::LIVE, [] { return true; }));
+    bool third = executor.try_submit(make_job("15min", "C", FetchPriority::LIVE, [] { return true; }));
+    check("try_submit rejects beyond the queue depth", first && second && !third);
+
+    // A blocking submit waits for space instead of failing
+    std::atomic<bool> submitted{ false };
+    std::thread producer([&] {
+        submitted = executor.submit(make_job("15min", "D", FetchPriority::LIVE, [] { return true; }));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    bool blocked = !submitted;
+    gate.unlock();
+    producer.join();
+    executor.wait_idle();
+    check("submit blocks while the queue is full", blocked && submitted);
+
+    auto stats = executor.stats();
+    auto live_15 = std::find_if(stats.begin(), stats.end(), [](const FetchQueueStats& s) {
+        return s.timeframe == "15min" && s.priority == FetchPriority::LIVE;
+    });
+    check("queue stats exported", live_15 != stats.end() && live_15->completed == 4 && live_15->rejected == 1 &&
+                                  live_15->max_depth == 2);
+}
+
+static void test_stop_discards_queue() {
+    FetchExecutorConfig config;
+    config.worker_count = 1;
+    FetchExecutor executor(config);
+
+    std::mutex gate;
+    gate.lock();
+    executor.submit(make_job("15min", "GATE", FetchPriority::LIVE, [&] {
+        std::lock_guard<std::mutex> hold(gate);
+        return true;
+    }));
+    while (executor.in_flight() == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+    auto batch = std::make_shared<FetchBatch>();
+    for (int i = 0; i < 5; i++) {
+        FetchJob job = make_job("1hour", "S" + std::to_string(i), FetchPriority::BACKFILL, [] { return true; });
+        job.batch = batch;
+        executor.submit(std::move(job));
+    }
+
+    std::thread stopper([&] { executor.stop(); });
+    bool all_ok = batch->wait();
+    gate.unlock();
+    stopper.join();
+    check("stop() fails queued batch jobs instead of hanging", !all_ok && batch->failed_count() == 5);
+}
+
+static void test_bar_close_burst() {
+    const int symbols = 50;
+    const auto iqfeed_round_trip = std::chrono::milliseconds(20);
+    const std::vector<std::string> timeframes = { "15min", "30min", "1hour", "2hours" };
+
+    FetchExecutorConfig config;
+    config.worker_count = 8;
+    config.max_in_flight = 8;
+    FetchExecutor executor(config);
+
+    std::mutex landed_mutex;
+    std::vector<std::pair<std::string, Clock::time_point>> landed;
+
+    auto start = Clock::now();
+    for (const auto& timeframe : timeframes) {
+        for (int s = 0; s < symbols; s++) {
+            executor.submit(make_job(timeframe, "S" + std::to_string(s), FetchPriority::LIVE, [&, timeframe] {
+                std::this_thread::sleep_for(iqfeed_round_trip);
+                std::lock_guard<std::mutex> lock(landed_mutex);
+                landed.push_back({ timeframe, Clock::now() });
+                return true;
+            }));
+        }
+    }
+    executor.wait_idle();
+
+    double spread_ms = std::chrono::duration<double, std::milli>(landed.back().second - start).count();
+    double serial_ms = std::chrono::duration<double, std::milli>(iqfeed_round_trip).count() * symbols * timeframes.size();
+
+    std::cout << "   " << landed.size() << " bars landed within " << spread_ms << " ms (serial: ~" << serial_ms
+              << " ms)" << std::endl;
+    check("15:00 burst lands well ahead of the serial loop", spread_ms < serial_ms / 3.0);
+
+    // 15min bars are never behind the 2hours bars
+    auto last_15min = std::find_if(landed.rbegin(), landed.rend(), [](const auto& l) { return l.first == "15min"; });
+    auto first_2hours = std::find_if(landed.begin(), landed.end(), [](const auto& l) { return l.first == "2hours"; });
+    check("15min bars land before 2hours bars", last_15min->second <= first_2hours->second + iqfeed_round_trip);
+
+    executor.print_stats(std::cout);
+}
+
+int main() {
+    std::cout << "=== FETCH EXECUTOR TEST ===" << std::endl;
+
+    test_priority_order();
+    test_in_flight_cap();
+    test_backpressure();
+    test_stop_discards_queue();
+    test_bar_close_burst();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Fetch executor test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Fetch executor honours priorities, caps and backpressure" << std::endl;
+    return 0;
+}
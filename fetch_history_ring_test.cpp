@@ -0,0 +1,194 @@
+#include "IQFeedConnection/FetchHistoryRing.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <set>
+
+// ==============================================
+// FETCH HISTORY RING TEST
+// ==============================================
+// Checks the scheduler's lock-free fetch history: interned symbols and
+// timeframes round-trip and a full interner counts what it turns away, the
+// ring overwrites its oldest records, window queries filter by start time,
+// per-timeframe percentiles are exact, and concurrent workers record while
+// a monitor reads without torn records.
+// Also times a full-ring stats() call, the once-a-second monitoring query.
+
+using SystemClock = std::chrono::system_clock;
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static void record(FetchHistoryRing& ring, const std::string& symbol, const std::string& timeframe,
+                   int latency_ms, bool ok, SystemClock::time_point started = SystemClock::now()) {
+    ring.record(symbol, timeframe, started, started, std::chrono::milliseconds(latency_ms), ok, ok ? 1 : 0,
+                ok ? "" : "IQFeed fetch failed");
+}
+
+static void test_interner() {
+    StringInterner interner(3);
+    std::uint16_t a = interner.intern("QGC#");
+    std::uint16_t b = interner.intern("QCL#");
+    check("interning is idempotent", interner.intern("QGC#") == a && a != b);
+    check("ids resolve back to strings", interner.lookup(a) == "QGC#" && interner.lookup(b) == "QCL#");
+    interner.intern("QES#");
+    check("full table reports FULL", interner.intern("QNQ#") == StringInterner::FULL &&
+                                     interner.lookup(StringInterner::FULL).empty());
+    interner.intern("QYM#");
+    check("overflows are counted", interner.overflows() == 2, std::to_string(interner.overflows()));
+    check("known strings still intern once full", interner.intern("QES#") == 2 && interner.intern("QGC#") == a &&
+                                                  interner.overflows() == 2);
+
+    // Ids stay dense and distinct past the first few hundred entries
+    StringInterner symbols(4096);
+    bool dense = true;
+    for (int i = 0; i < 4096; i++) {
+        dense = dense && symbols.intern("SYM" + std::to_string(i)) == i;
+    }
+    for (int i = 0; i < 4096; i += 97) {
+        dense = dense && symbols.intern("SYM" + std::to_string(i)) == i &&
+                symbols.lookup(static_cast<std::uint16_t>(i)) == "SYM" + std::to_string(i);
+    }
+    check("4096 symbols intern to dense ids", dense && symbols.size() == 4096 && symbols.overflows() == 0);
+}
+
+static void test_round_trip_and_wrap() {
+    FetchHistoryRing ring(8);
+    check("capacity rounds to a power of two", FetchHistoryRing(5).capacity() == 8);
+
+    auto scheduled = SystemClock::now() - std::chrono::seconds(3);
+    ring.record("QGC#", "15min", scheduled, scheduled + std::chrono::seconds(1), std::chrono::milliseconds(250),
+                false, 0, "Database save failed");
+    auto records = ring.recent(std::chrono::hours(1));
+    bool ok = records.size() == 1 && records[0].symbol == "QGC#" && records[0].timeframe == "15min" &&
+              records[0].error_message == "Database save failed" && !records[0].successful &&
+              records[0].latency == std::chrono::milliseconds(250) &&
+              records[0].actual_time - records[0].scheduled_time == std::chrono::seconds(1);
+    check("record round trips through the packed slot", ok);
+
+    for (int i = 0; i < 20; i++) {
+        record(ring, "S" + std::to_string(i), "30min", i, true);
+    }
+    records = ring.recent(std::chrono::hours(1));
+    check("ring keeps only the newest capacity records", records.size() == 8 && records.front().symbol == "S12" &&
+                                                          records.back().symbol == "S19");
+    check("overwritten records counted", ring.recorded() == 21 && ring.overwritten() == 13);
+}
+
+static void test_window_and_percentiles() {
+    FetchHistoryRing ring(1024);
+    auto now = SystemClock::now();
+
+    // 100 recent 15min fetches at 1..100 ms, two of them failed
+    for (int i = 1; i <= 100; i++) {
+        record(ring, "QGC#", "15min", i, i != 40 && i != 80, now);
+    }
+    // Old records outside the window must not count
+    for (int i = 0; i < 50; i++) {
+        record(ring, "QGC#", "15min", 5000, false, now - std::chrono::hours(3));
+    }
+    record(ring, "QCL#", "daily", 1200, true, now);
+
+    auto stats = ring.stats(std::chrono::hours(1));
+    check("one entry per timeframe seen in the window", stats.size() == 2);
+    if (stats.size() == 2) {
+        const auto& intraday = stats[0];
+        check("window excludes old records", intraday.timeframe == "15min" && intraday.total == 100,
+              std::to_string(intraday.total));
+        check("success ratio", intraday.successful == 98 && intraday.failed == 2 && intraday.success_ratio == 0.98);
+        check("exact nearest-rank percentiles", intraday.p50_ms == 50.0 && intraday.p95_ms == 95.0 &&
+                                                intraday.p99_ms == 99.0 && intraday.max_ms == 100.0,
+              std::to_string(intraday.p50_ms) + "/" + std::to_string(intraday.p95_ms) + "/" +
+              std::to_string(intraday.p99_ms));
+        check("daily kept separate", stats[1].timeframe == "daily" && stats[1].total == 1 && stats[1].p99_ms == 1200.0);
+    }
+}
+
+static void test_concurrent_producers() {
+    FetchHistoryRing ring(4096);
+    const std::vector<std::string> timeframes = { "15min", "30min", "1hour", "2hours" };
+    std::atomic<bool> done{ false };
+    std::atomic<long long> torn{ 0 };
+    std::atomic<long long> reads{ 0 };
+
+    // Each worker writes latency == bars so a torn record would show up
+    std::thread monitor([&] {
+        while (!done) {
+            for (const auto& record : ring.recent(std::chrono::hours(1))) {
+                if (record.latency != std::chrono::milliseconds(record.bars_fetched) || record.symbol.empty()) {
+                    torn++;
+                }
+            }
+            ring.stats(std::chrono::hours(1));
+            reads++;
+        }
+    });
+
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; w++) {
+        workers.emplace_back([&, w] {
+            for (int i = 0; i < 5000; i++) {
+                auto now = SystemClock::now();
+                ring.record("SYM" + std::to_string(i % 50), timeframes[w], now, now,
+                            std::chrono::milliseconds(i % 900), true, i % 900);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    done = true;
+    monitor.join();
+
+    auto stats = ring.stats(std::chrono::hours(1));
+    long long total = 0;
+    for (const auto& entry : stats) total += entry.total;
+    check("20000 concurrent records, newest 4096 kept", ring.recorded() == 20000 && total == 4096,
+          std::to_string(total));
+    check("monitor never saw a torn record", torn == 0, std::to_string(torn.load()) + " torn in " +
+                                                        std::to_string(reads.load()) + " reads");
+}
+
+static void test_stats_cost() {
+    FetchHistoryRing ring(16384);
+    const std::vector<std::string> timeframes = { "daily", "15min", "30min", "1hour", "2hours" };
+    auto now = SystemClock::now();
+    for (int i = 0; i < 16384; i++) {
+        ring.record("SYM" + std::to_string(i % 40), timeframes[i % 5], now, now, std::chrono::milliseconds(i % 700),
+                    i % 17 != 0, 1);
+    }
+
+    const int iterations = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        ring.stats(std::chrono::hours(24));
+    }
+    double per_call_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() /
+                         iterations;
+    std::cout << "   stats() over a full 16384-record ring: " << per_call_ms << " ms" << std::endl;
+    check("full-ring stats well under a monitoring tick", per_call_ms < 100.0);
+}
+
+int main() {
+    std::cout << "=== FETCH HISTORY RING TEST ===" << std::endl;
+
+    test_interner();
+    test_round_trip_and_wrap();
+    test_window_and_percentiles();
+    test_concurrent_producers();
+    test_stats_cost();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Fetch history ring test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Fetch history records lock-free and reports windowed percentiles" << std::endl;
+    return 0;
+}
@@ -0,0 +1,200 @@
+#include "Database/database_simple.h"
+#include "IQFeedConnection/GapDetector.h"
+#include "Predictions/TradingCalendar.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+// ==============================================
+// GAP DETECTION AND BACKFILL PLANNING TEST
+// ==============================================
+// Checks how GapDetector::coalesce turns missing-bar gaps into IQFeed range
+// requests (merging, splitting, per-symbol isolation, a week's outage), and
+// that the grid built from the trading calendar knows Thanksgiving week.
+// When the database is reachable, it also seeds a week of 15min bars with
+// one hole and checks that the generate_series gap query finds exactly that
+// hole, and nothing in the daily break or at the weekend.
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static BarGap gap(const std::string& symbol, const std::string& timeframe, const std::string& first,
+                  const std::string& last, int missing) {
+    BarGap g;
+    g.symbol = symbol;
+    g.timeframe = timeframe;
+    g.first_missing = first;
+    g.last_missing = last;
+    g.missing_bars = missing;
+    return g;
+}
+
+static void test_wall_clock() {
+    const std::string stamp = "2024-02-29 23:45:00";
+    long long seconds = GapDetector::parse_wall_clock(stamp);
+    check("wall clock round trip", GapDetector::format_wall_clock(seconds, false) == stamp);
+    check("next slot crosses into March",
+          GapDetector::format_wall_clock(seconds + 900, false) == "2024-03-01 00:00:00");
+    check("date-only round trip",
+          GapDetector::format_wall_clock(GapDetector::parse_wall_clock("1999-12-31"), true) == "1999-12-31");
+}
+
+static void test_coalesce() {
+    std::vector<BarGap> gaps = {
+        gap("AAA", "15min", "2025-01-06 10:00:00", "2025-01-06 10:45:00", 4),
+        gap("AAA", "15min", "2025-01-06 11:30:00", "2025-01-06 11:45:00", 2),   // 2 present slots apart
+        gap("AAA", "15min", "2025-01-07 10:00:00", "2025-01-07 10:00:00", 1),   // a day later
+        gap("BBB", "15min", "2025-01-06 12:00:00", "2025-01-06 12:00:00", 1),
+    };
+
+    std::vector<BackfillRange> ranges = GapDetector::coalesce(gaps);
+    check("nearby gaps merge, distant ones and other symbols do not", ranges.size() == 3,
+          std::to_string(ranges.size()) + " ranges");
+    if (ranges.size() == 3) {
+        check("merged range spans both gaps",
+              ranges[0].begin == "2025-01-06 10:00:00" && ranges[0].end == "2025-01-06 11:45:00" &&
+              ranges[0].missing_bars == 6 && ranges[0].gaps == 2);
+        check("other symbol kept separate", ranges[2].symbol == "BBB");
+    }
+
+    // Gaps split only by the 17:00-18:00 break still become one request
+    std::vector<BarGap> daily_islands;
+    for (int day = 6; day <= 9; day++) {
+        std::string today = "2025-01-0" + std::to_string(day);
+        std::string tomorrow = "2025-01-" + std::string(day + 1 < 10 ? "0" : "") + std::to_string(day + 1);
+        daily_islands.push_back(gap("AAA", "15min", today + " 18:00:00", tomorrow + " 16:45:00", 92));
+    }
+    ranges = GapDetector::coalesce(daily_islands);
+    check("sessions split by the daily break coalesce", ranges.size() == 1 && ranges[0].missing_bars == 368);
+
+    // A long hole is split into bounded requests that tile it exactly
+    BackfillOptions options;
+    options.max_slots_per_request = 100;
+    ranges = GapDetector::coalesce({ gap("AAA", "1hour", "2025-01-01 00:00:00", "2025-01-11 09:00:00", 250) }, options);
+    bool tiled = ranges.size() == 3 && ranges.front().begin == "2025-01-01 00:00:00" &&
+                 ranges.back().end == "2025-01-11 09:00:00";
+    for (std::size_t i = 1; i < ranges.size() && tiled; i++) {
+        tiled = GapDetector::parse_wall_clock(ranges[i].begin) == GapDetector::parse_wall_clock(ranges[i - 1].end) + 3600;
+    }
+    check("long gap split into contiguous requests", tiled, std::to_string(ranges.size()) + " requests");
+}
+
+// A week offline, as the gap query reports it: one island per symbol and
+// timeframe (the grid has no weekend or break slots to interrupt it)
+static void test_week_outage_plan() {
+    const std::vector<std::string> symbols = { "QGC#", "QCL#", "QES#" };
+    std::vector<BarGap> gaps;
+
+    for (const auto& symbol : symbols) {
+        gaps.push_back(gap(symbol, "daily", "2025-01-06", "2025-01-10", 5));
+        gaps.push_back(gap(symbol, "15min", "2025-01-05 18:00:00", "2025-01-10 16:45:00", 460));
+        gaps.push_back(gap(symbol, "30min", "2025-01-05 18:00:00", "2025-01-10 16:30:00", 230));
+        gaps.push_back(gap(symbol, "1hour", "2025-01-05 18:00:00", "2025-01-10 16:00:00", 115));
+        gaps.push_back(gap(symbol, "2hours", "2025-01-05 18:00:00", "2025-01-10 16:00:00", 60));
+    }
+
+    std::vector<BackfillRange> ranges;
+    for (const std::string timeframe : { "daily", "15min", "30min", "1hour", "2hours" }) {
+        std::vector<BarGap> per_timeframe;
+        for (const auto& g : gaps) {
+            if (g.timeframe == timeframe) per_timeframe.push_back(g);
+        }
+        auto planned = GapDetector::coalesce(per_timeframe);
+        ranges.insert(ranges.end(), planned.begin(), planned.end());
+    }
+    check("a week's outage is 5 requests per symbol", ranges.size() == symbols.size() * 5,
+          std::to_string(ranges.size()) + " requests");
+}
+
+static void test_session_grid() {
+    CalendarRules rules;
+    rules.overrides_path.clear();
+    TradingCalendar calendar(rules);
+
+    SessionGrid grid = GapDetector::session_grid(calendar, "2024-11-24", "2024-12-01");
+    check("grid takes the calendar's session times",
+          grid.session_open == rules.session_open && grid.session_close == rules.session_close);
+    check("Thanksgiving is a holiday", grid.holidays == std::vector<std::string>{ "2024-11-28" },
+          std::to_string(grid.holidays.size()) + " holidays");
+    check("the day after closes early",
+          grid.early_closes.size() == 1 && grid.early_closes[0].first == "2024-11-29" &&
+          grid.early_closes[0].second == rules.early_close,
+          std::to_string(grid.early_closes.size()) + " early closes");
+}
+
+static void test_gap_query(SimpleDatabaseManager& db) {
+    const std::string symbol = "GAPTEST#";
+    int symbol_id = db.get_or_create_symbol_id(symbol);
+    if (symbol_id <= 0) {
+        check("test symbol created", false, db.get_last_error());
+        return;
+    }
+    db.execute_query("DELETE FROM historical_fetch_15min WHERE symbol_id = " + std::to_string(symbol_id));
+
+    // Sunday 18:00 to Friday 16:45 in session, minus Wednesday 10:00-11:45
+    long long begin = GapDetector::parse_wall_clock("2025-01-05 18:00:00");
+    long long end = GapDetector::parse_wall_clock("2025-01-10 16:45:00");
+    long long hole_begin = GapDetector::parse_wall_clock("2025-01-08 10:00:00");
+    long long hole_end = GapDetector::parse_wall_clock("2025-01-08 11:45:00");
+
+    for (long long slot = begin; slot <= end; slot += 900) {
+        std::string stamp = GapDetector::format_wall_clock(slot, false);
+        std::string time = stamp.substr(11);
+        bool in_break = time >= "17:00:00" && time < "18:00:00";
+        if (in_break || (slot >= hole_begin && slot <= hole_end)) continue;
+
+        db.insert_historical_data_15min(symbol, stamp.substr(0, 10), time, 100.0, 101.0, 99.0, 100.5, 10);
+    }
+
+    GapDetector detector(db);
+    std::vector<BarGap> gaps;
+    bool ok = detector.find_gaps("15min", { symbol }, "2025-01-04 00:00:00", "2025-01-10 16:45:00", gaps);
+    check("gap query runs", ok, db.get_last_error());
+
+    bool exact = gaps.size() == 1 && gaps[0].first_missing == "2025-01-08 10:00:00" &&
+                 gaps[0].last_missing == "2025-01-08 11:45:00" && gaps[0].missing_bars == 8;
+    check("only the Wednesday hole is reported", exact, std::to_string(gaps.size()) + " gaps");
+    for (const auto& g : gaps) {
+        std::cout << "   " << g.first_missing << " .. " << g.last_missing << " (" << g.missing_bars << ")" << std::endl;
+    }
+
+    db.execute_query("DELETE FROM historical_fetch_15min WHERE symbol_id = " + std::to_string(symbol_id));
+    db.execute_query("DELETE FROM symbols WHERE symbol_id = " + std::to_string(symbol_id));
+}
+
+int main() {
+    std::cout << "=== GAP DETECTION AND BACKFILL TEST ===" << std::endl;
+
+    test_wall_clock();
+    test_coalesce();
+    test_week_outage_plan();
+    test_session_grid();
+
+    DatabaseConfig config;
+    config.host = "localhost";
+    config.port = 5432;
+    config.database = "nexday_trading";
+    config.username = "postgres";
+    config.password = "magical.521";
+
+    SimpleDatabaseManager db(config);
+    if (db.is_connected()) {
+        test_gap_query(db);
+    } else {
+        std::cout << "➖ Database not available - gap query checks skipped" << std::endl;
+    }
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Gap backfill test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Gaps coalesce into a handful of range requests" << std::endl;
+    return 0;
+}
@@ -2,32 +2,7 @@
 #include <iostream>
 #include <vector>
 #include <algorithm>
-
-// Your working EMA calculator (from ema_test.cpp)
-class SimpleEMACalculator {
-public:
-    static double calculate_sma(const std::vector<double>& values, int start_index, int window_size) {
-        if (start_index + window_size > values.size()) return 0.0;
-        double sum = 0.0;
-        for (int i = start_index; i < start_index + window_size; i++) {
-            sum += values[i];
-        }
-        return sum / window_size;
-    }
-    
-    static std::vector<double> calculate_ema_sequence(const std::vector<double>& values, double initial_previous_predict) {
-        std::vector<double> ema_values;
-        double previous_predict = initial_previous_predict;
-        const double BASE_ALPHA = 0.5;
-        
-        for (double current_value : values) {
-            double predict_t = (BASE_ALPHA * current_value) + ((1.0 - BASE_ALPHA) * previous_predict);
-            ema_values.push_back(predict_t);
-            previous_predict = predict_t;
-        }
-        return ema_values;
-    }
-};
+#include "Predictions/EMAKernel.h"
 
 // Get real historical data from your database
 std::vector<double> get_real_close_prices(SimpleDatabaseManager& db, const std::string& symbol, int limit = 25) {
@@ -178,18 +153,11 @@ int main() {
             return 1;
         }
         
-        std::vector<double> sma_values;
-        for (int i = 0; i < sma_periods; i++) {
-            double sma = SimpleEMACalculator::calculate_sma(real_prices, i, std::min(5, int(real_prices.size()) - i));
-            sma_values.push_back(sma);
-        }
-        
-        double initial_previous_predict = sma_values.back();
-        std::vector<double> ema_input_series(real_prices.begin() + sma_periods + 4, real_prices.end());
+        // Same Model 1 recurrence with a shortened bootstrap
+        EMALayout short_layout = { sma_periods, 5, sma_periods + 4 };
         
-        if (!ema_input_series.empty()) {
-            auto ema_values = SimpleEMACalculator::calculate_ema_sequence(ema_input_series, initial_previous_predict);
-            double prediction = ema_values.back();
+        if (real_prices.size() > short_layout.min_bars()) {
+            double prediction = EMAKernel::predict(EMAKernel::view(real_prices), short_layout);
             std::cout << "\nSimplified EMA prediction for " << test_symbol << ": " << prediction << std::endl;
         } else {
             std::cout << "Not enough data for EMA sequence calculation" << std::endl;
@@ -198,26 +166,26 @@ int main() {
         // Full EMA calculation with 15+ bars
         std::cout << "Performing full EMA calculation..." << std::endl;
         
-        // Apply your working EMA calculation to real data
-        std::vector<double> sma_values;
-        for (int i = 0; i < 10; i++) {
-            double sma = SimpleEMACalculator::calculate_sma(real_prices, i, 5);
-            sma_values.push_back(sma);
-            std::cout << "SMA" << (i+1) << ": " << sma << std::endl;
-        }
+        // Apply the shared Model 1 kernel to real data, capturing intermediate values
+        std::vector<double> sma_values(EMAKernel::STANDARD.sma_periods);
+        std::vector<double> ema_values(real_prices.size());
+        EMATrace trace(sma_values.data(), sma_values.size(), ema_values.data(), ema_values.size());
+        
+        double prediction = EMAKernel::predict(EMAKernel::view(real_prices), EMAKernel::STANDARD,
+                                               EMAKernel::BASE_ALPHA, &trace);
+        ema_values.resize(trace.ema_count());
         
-        double initial_previous_predict = sma_values.back();
-        std::cout << "\nUsing SMA10 as initial previous_predict: " << initial_previous_predict << std::endl;
+        for (size_t i = 0; i < sma_values.size(); i++) {
+            std::cout << "SMA" << (i+1) << ": " << sma_values[i] << std::endl;
+        }
         
-        std::vector<double> ema_input_series(real_prices.begin() + 14, real_prices.end());
-        auto ema_values = SimpleEMACalculator::calculate_ema_sequence(ema_input_series, initial_previous_predict);
+        std::cout << "\nUsing SMA10 as initial previous_predict: " << sma_values.back() << std::endl;
         
         std::cout << "\nEMA sequence:" << std::endl;
         for (size_t i = 0; i < ema_values.size(); i++) {
             std::cout << "EMA" << (i + 15) << ": " << ema_values[i] << std::endl;
         }
         
-        double prediction = ema_values.back();
         std::cout << "\nFull EMA prediction for " << test_symbol << ": " << prediction << std::endl;
     }
     
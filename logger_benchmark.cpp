@@ -0,0 +1,187 @@
+#include "IQFeedConnection/Logger.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <ctime>
+#include <cstdio>
+
+// ==============================================
+// LOGGER BENCHMARK - PER-CALL COST ON THE HOT PATH
+// ==============================================
+// What one log call costs the calling thread, for a per-bar line like the
+// ones parse_historical_data writes:
+//   - a debug line below the runtime level through NEXDAY_LOG_DEBUG (the
+//     message is never built) and through logger->debug() (it is)
+//   - an enabled line handed to the async sink, one thread and four, and
+//     with the message already built to show the enqueue alone
+//   - the old synchronous path: localtime + put_time per line, endl and
+//     flush() on every write
+// The console mirror is off for all of them so the terminal is not timed.
+// Finally checks the sink wrote every line it accepted.
+
+using Clock = std::chrono::steady_clock;
+
+static const int kCalls = 200000;
+
+// The pre-sink Logger::log, file half only
+class SynchronousLogger {
+public:
+    explicit SynchronousLogger(const std::string& path) : file_(path, std::ios::app) {}
+
+    void log(const std::string& level, const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto now = std::chrono::system_clock::now();
+        auto time_t = std::chrono::system_clock::to_time_t(now);
+        auto tm = *std::localtime(&time_t);
+        std::ostringstream oss;
+        oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
+        auto entry = "[" + level + "] " + oss.str() + " - " + message;
+        file_ << entry << std::endl;
+        file_.flush();
+    }
+
+private:
+    std::ofstream file_;
+    std::mutex mutex_;
+};
+
+struct BenchBar {
+    double open = 4501.25;
+    double high = 4503.75;
+    double low = 4499.50;
+    double close = 4502.00;
+    int volume = 1834;
+};
+
+static std::string bar_line(const BenchBar& bar, int i) {
+    return "Parsed bar - StartTime: 2025-06-02 09:" + std::to_string(i % 60) +
+           ":00 | O:" + std::to_string(bar.open) + " H:" + std::to_string(bar.high) +
+           " L:" + std::to_string(bar.low) + " C:" + std::to_string(bar.close) +
+           " V:" + std::to_string(bar.volume);
+}
+
+template <typename Body>
+static double ns_per_call(int calls, Body body) {
+    auto start = Clock::now();
+    for (int i = 0; i < calls; i++) {
+        body(i);
+    }
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count() / calls;
+}
+
+static long count_lines(const std::string& path) {
+    std::ifstream in(path);
+    long lines = 0;
+    std::string line;
+    while (std::getline(in, line)) lines++;
+    return lines;
+}
+
+static void report(const std::string& label, double ns) {
+    std::cout << "  " << std::left << std::setw(44) << label << std::right << std::fixed
+              << std::setprecision(1) << std::setw(10) << ns << " ns/call" << std::endl;
+}
+
+int main() {
+    std::cout << "=== LOGGER BENCHMARK ===" << std::endl;
+    std::cout << kCalls << " per-bar lines per case, console mirror off\n" << std::endl;
+
+    std::remove("logs/logger_benchmark.log");
+    std::remove("logs/logger_benchmark_sync.log");
+    Logger::set_console_mirror(false);
+    Logger::set_level(LogLevel::Info);
+
+    Logger logger("logger_benchmark.log", true);
+    BenchBar bar;
+
+    // Filtered: the macro skips building the string, the plain call does not
+    volatile double sink_guard = 0;
+    double filtered_macro = ns_per_call(kCalls, [&](int i) {
+        NEXDAY_LOG_DEBUG(&logger, bar_line(bar, i));
+        sink_guard = sink_guard + 1;
+    });
+    double filtered_call = ns_per_call(kCalls, [&](int i) {
+        logger.debug(bar_line(bar, i));
+    });
+
+    // Enabled, one thread
+    LogSinkStats before = LogSink::instance().stats();
+    double async_one = ns_per_call(kCalls, [&](int i) {
+        NEXDAY_LOG_INFO(&logger, bar_line(bar, i));
+    });
+    const std::string prebuilt = bar_line(bar, 0);
+    double async_prebuilt = ns_per_call(kCalls, [&](int) {
+        NEXDAY_LOG_INFO(&logger, prebuilt);
+    });
+    auto flush_start = Clock::now();
+    Logger::flush();
+    double flush_ms = std::chrono::duration<double, std::milli>(Clock::now() - flush_start).count();
+
+    // Enabled, four threads sharing the sink
+    const int threads = 4;
+    std::vector<double> per_thread(threads, 0.0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&, t]() {
+            Logger worker_logger("logger_benchmark.log", true);      // Same file: same handle
+            per_thread[t] = ns_per_call(kCalls / threads, [&](int i) {
+                NEXDAY_LOG_INFO(&worker_logger, bar_line(bar, i));
+            });
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    Logger::flush();
+    double async_four = 0;
+    for (double ns : per_thread) async_four += ns / threads;
+    LogSinkStats after = LogSink::instance().stats();
+
+    // The old path
+    SynchronousLogger sync("logs/logger_benchmark_sync.log");
+    double synchronous = ns_per_call(kCalls, [&](int i) {
+        sync.log("INFO", bar_line(bar, i));
+    });
+
+    // Building the message alone, for reference
+    std::size_t total = 0;
+    double build_only = ns_per_call(kCalls, [&](int i) {
+        total += bar_line(bar, i).size();
+    });
+
+    std::cout << "Per-call cost on the calling thread:" << std::endl;
+    report("debug filtered, NEXDAY_LOG_DEBUG", filtered_macro);
+    report("debug filtered, logger->debug(...)", filtered_call);
+    report("message construction alone", build_only);
+    report("info enqueued, 1 thread", async_one);
+    report("info enqueued, prebuilt message (copy)", async_prebuilt);
+    report("info enqueued, 4 threads (mean per thread)", async_four);
+    report("synchronous localtime + endl + flush", synchronous);
+
+    std::uint64_t accepted = (after.submitted - before.submitted) - (after.dropped - before.dropped);
+    std::uint64_t written = after.written - before.written;
+    long on_disk = count_lines("logs/logger_benchmark.log");
+    std::cout << "\nSink: " << (after.submitted - before.submitted) << " submitted, " << written << " written, "
+              << (after.dropped - before.dropped) << " dropped (queue full), "
+              << (after.batches - before.batches) << " batches; flush after the 1-thread burst took "
+              << std::setprecision(2) << flush_ms << " ms" << std::endl;
+    std::cout << "Speedup vs synchronous (1 thread): " << std::setprecision(1)
+              << (async_one > 0 ? synchronous / async_one : 0.0) << "x" << std::endl;
+
+    bool ok = written == accepted && on_disk == static_cast<long>(written) && filtered_macro < filtered_call;
+    std::remove("logs/logger_benchmark.log");
+    std::remove("logs/logger_benchmark_sync.log");
+    (void)total;
+
+    if (!ok) {
+        std::cout << "\n❌ Sink lost lines or the filtered macro built its message (" << on_disk
+                  << " lines on disk, " << accepted << " accepted)" << std::endl;
+        return 1;
+    }
+    std::cout << "\n✅ Every accepted line written; filtered debug lines cost no formatting" << std::endl;
+    return 0;
+}
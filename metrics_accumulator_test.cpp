@@ -0,0 +1,164 @@
+#include "MetricsAccumulator.h"
+#include "RollingMetrics.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <cmath>
+#include <numeric>
+
+// ==============================================
+// STREAMING METRICS ACCUMULATOR TEST
+// ==============================================
+// Checks MetricsAccumulator against the two-pass formulas used by
+// PredictionValidator::calculate_model_metrics, checks that merging
+// partial states gives the same result as one sequential pass, and checks
+// the 7/30/90-day rolling windows against a recomputation from raw samples.
+
+static int g_failures = 0;
+
+static void check(const std::string& label, double actual, double expected, double tolerance) {
+    double scale = std::max(1.0, std::fabs(expected));
+    bool ok = std::fabs(actual - expected) <= tolerance * scale;
+    std::cout << (ok ? "✅ " : "❌ ") << label << ": " << std::setprecision(15) << actual;
+    if (!ok) {
+        std::cout << " (expected " << expected << ")";
+        g_failures++;
+    }
+    std::cout << std::endl;
+}
+
+struct Reference {
+    double mae, rmse, mape, r_squared, mean_accuracy, std_deviation;
+};
+
+// Straightforward multi-pass computation, as calculate_model_metrics does it
+static Reference two_pass(const std::vector<double>& predicted, const std::vector<double>& actual) {
+    size_t n = predicted.size();
+    double sum_abs = 0.0, sum_sq = 0.0, sum_pct = 0.0, sum_acc = 0.0;
+    std::vector<double> errors;
+    for (size_t i = 0; i < n; i++) {
+        double error = actual[i] - predicted[i];
+        errors.push_back(error);
+        sum_abs += std::fabs(error);
+        sum_sq += error * error;
+        sum_pct += std::fabs(error / actual[i]);
+        sum_acc += std::max(0.0, 1.0 - std::fabs(error / actual[i]));
+    }
+
+    double mean_actual = std::accumulate(actual.begin(), actual.end(), 0.0) / n;
+    double ss_tot = 0.0;
+    for (double a : actual) ss_tot += (a - mean_actual) * (a - mean_actual);
+
+    double mean_error = std::accumulate(errors.begin(), errors.end(), 0.0) / n;
+    double variance = 0.0;
+    for (double e : errors) variance += (e - mean_error) * (e - mean_error);
+
+    return { sum_abs / n, std::sqrt(sum_sq / n), sum_pct / n * 100.0,
+             1.0 - sum_sq / ss_tot, sum_acc / n, std::sqrt(variance / n) };
+}
+
+static void check_against(const std::string& name, const MetricsAccumulator& acc, const Reference& ref) {
+    check(name + " MAE", acc.mae(), ref.mae, 1e-12);
+    check(name + " RMSE", acc.rmse(), ref.rmse, 1e-12);
+    check(name + " MAPE", acc.mape(), ref.mape, 1e-12);
+    check(name + " R²", acc.r_squared(), ref.r_squared, 1e-9);
+    check(name + " mean accuracy", acc.mean_accuracy(), ref.mean_accuracy, 1e-12);
+    check(name + " error std dev", acc.std_deviation(), ref.std_deviation, 1e-9);
+}
+
+int main() {
+    std::cout << "=== STREAMING METRICS ACCUMULATOR TEST ===" << std::endl;
+
+    // Gold-like prices around 2000 with small errors: the case where a naive
+    // sum-of-squares variance loses most of its significant digits
+    std::vector<double> predicted, actual;
+    for (int i = 0; i < 5000; i++) {
+        double a = 2000.0 + ((i * 37) % 23) * 0.35 - (i % 5) * 0.8;
+        double p = a + ((i * 13) % 11 - 5) * 0.125;
+        actual.push_back(a);
+        predicted.push_back(p);
+    }
+
+    Reference ref = two_pass(predicted, actual);
+
+    std::cout << "\n📊 Sequential updates" << std::endl;
+    MetricsAccumulator sequential;
+    for (size_t i = 0; i < actual.size(); i++) {
+        double accuracy = std::max(0.0, 1.0 - std::fabs((actual[i] - predicted[i]) / actual[i]));
+        sequential.add(predicted[i], actual[i], accuracy);
+    }
+    check_against("sequential", sequential, ref);
+
+    std::cout << "\n📊 Merged partial states (4 uneven workers)" << std::endl;
+    const size_t bounds[] = { 0, 7, 1800, 1801, actual.size() };
+    MetricsAccumulator merged;
+    for (int w = 0; w < 4; w++) {
+        MetricsAccumulator partial;
+        for (size_t i = bounds[w]; i < bounds[w + 1]; i++) {
+            double accuracy = std::max(0.0, 1.0 - std::fabs((actual[i] - predicted[i]) / actual[i]));
+            partial.add(predicted[i], actual[i], accuracy);
+        }
+        merged.merge(partial);
+    }
+    merged.merge(MetricsAccumulator());    // Empty partials are a no-op
+    check_against("merged", merged, ref);
+
+    if (merged.count != sequential.count) {
+        std::cout << "❌ Merged count " << merged.count << " != " << sequential.count << std::endl;
+        g_failures++;
+    }
+
+    std::cout << "\n📊 Empty accumulator" << std::endl;
+    MetricsAccumulator empty;
+    check("empty MAE", empty.mae(), 0.0, 0.0);
+    check("empty R²", empty.r_squared(), 0.0, 0.0);
+
+    std::cout << "\n📊 Rolling 7/30/90-day windows" << std::endl;
+    // Spread the samples over 150 days, feed them in day order, then check
+    // every window against a direct two-pass recomputation of its days
+    const long long first_day = 20000;
+    const long long last_day = first_day + 149;
+    RollingMetricsWindow rolling;
+    for (size_t i = 0; i < actual.size(); i++) {
+        double accuracy = std::max(0.0, 1.0 - std::fabs((actual[i] - predicted[i]) / actual[i]));
+        rolling.add(first_day + static_cast<long long>(i * 150 / actual.size()), predicted[i], actual[i], accuracy);
+    }
+
+    for (long long today : { last_day, last_day + 20 }) {
+        rolling.advance_to(today);
+        for (int days : RollingMetricsWindow::WINDOW_DAYS) {
+            std::vector<double> window_predicted, window_actual;
+            for (size_t i = 0; i < actual.size(); i++) {
+                long long day = first_day + static_cast<long long>(i * 150 / actual.size());
+                if (day > today - days && day <= today) {
+                    window_predicted.push_back(predicted[i]);
+                    window_actual.push_back(actual[i]);
+                }
+            }
+
+            std::string name = std::to_string(days) + "d window (today+" + std::to_string(today - last_day) + ")";
+            const MetricsAccumulator* window = rolling.window(days);
+            if (window_actual.empty()) {
+                check(name + " samples", static_cast<double>(window->count), 0.0, 0.0);
+                continue;
+            }
+            check(name + " samples", static_cast<double>(window->count),
+                  static_cast<double>(window_actual.size()), 0.0);
+            check_against(name, *window, two_pass(window_predicted, window_actual));
+        }
+    }
+
+    if (rolling.window(14) != nullptr || rolling.bucket(first_day) != nullptr) {
+        std::cout << "❌ Unsupported window length or expired bucket still readable" << std::endl;
+        g_failures++;
+    }
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Metrics accumulator test FAILED (" << g_failures << " mismatches)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Streaming metrics match the two-pass formulas!" << std::endl;
+    return 0;
+}
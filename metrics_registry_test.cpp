@@ -0,0 +1,196 @@
+#include "IQFeedConnection/MetricsRegistry.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+#include <cmath>
+#include <stdexcept>
+
+// ==============================================
+// METRICS REGISTRY TEST
+// ==============================================
+// Checks the sharded counters and histograms add up exactly under
+// concurrent writers, histogram buckets follow Prometheus "le" semantics,
+// the text exposition is well formed (HELP/TYPE once per family, cumulative
+// buckets ending in +Inf, escaped label values), a name cannot change type,
+// and the file export replaces the file whole. Also times a counter
+// increment and a histogram observation, the per-event costs on hot paths.
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static bool contains(const std::string& text, const std::string& line) {
+    return text.find(line) != std::string::npos;
+}
+
+static std::size_t occurrences(const std::string& text, const std::string& part) {
+    std::size_t count = 0;
+    for (std::size_t at = text.find(part); at != std::string::npos; at = text.find(part, at + 1)) count++;
+    return count;
+}
+
+static void test_concurrent_updates() {
+    MetricsRegistry registry;
+    Counter& counter = registry.counter("test_events_total", "Events");
+    Histogram& histogram = registry.histogram("test_seconds", "Durations", {}, { 0.001, 0.01, 0.1 });
+    Gauge& gauge = registry.gauge("test_in_flight", "In flight");
+
+    const int threads = 8;
+    const int per_thread = 100000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([&]() {
+            for (int i = 0; i < per_thread; i++) {
+                counter.inc();
+                histogram.observe((i % 4) == 0 ? 0.0005 : 0.05);
+                gauge.inc();
+                gauge.dec();
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    HistogramSnapshot snapshot = histogram.snapshot();
+    std::uint64_t total = static_cast<std::uint64_t>(threads) * per_thread;
+    check("counter shards sum exactly", counter.value() == total, std::to_string(counter.value()));
+    check("histogram counts every observation", snapshot.count == total);
+    check("observations land in their buckets",
+          snapshot.counts[0] == total / 4 && snapshot.counts[2] == total * 3 / 4 && snapshot.counts[3] == 0);
+    double expected_sum = (total / 4) * 0.0005 + (total * 3 / 4) * 0.05;
+    check("histogram sum matches", std::abs(snapshot.sum - expected_sum) < 1e-6 * expected_sum);
+    check("gauge returns to zero", gauge.value() == 0.0);
+    check("same name and labels give the same series", &registry.counter("test_events_total", "Events") == &counter);
+}
+
+static void test_histogram_buckets() {
+    Histogram histogram({ 0.5, 0.1, 1.0, 0.1 });
+    check("bounds sorted and deduplicated", histogram.bounds() == std::vector<double>({ 0.1, 0.5, 1.0 }));
+
+    histogram.observe(0.1);                     // le="0.1" includes 0.1 itself
+    histogram.observe(0.2);
+    histogram.observe(0.7);
+    histogram.observe(5.0);                     // +Inf only
+    HistogramSnapshot snapshot = histogram.snapshot();
+    check("upper bound is inclusive", snapshot.counts[0] == 1);
+    check("overflow bucket", snapshot.counts[3] == 1);
+    check("median is the bucket bound", snapshot.quantile(0.5) == 0.5);
+    check("empty histogram quantile is zero", Histogram({ 1.0 }).snapshot().quantile(0.99) == 0.0);
+}
+
+static void test_exposition() {
+    MetricsRegistry registry;
+    registry.counter("nexday_fetches_total", "Fetches", { { "timeframe", "15min" }, { "result", "success" } }).inc(3);
+    registry.counter("nexday_fetches_total", "Fetches", { { "timeframe", "daily" }, { "result", "failure" } }).inc();
+    registry.gauge("nexday_fetch_queued", "Queued").set(2.5);
+    Histogram& latency = registry.histogram("nexday_parse_seconds", "Parse", { { "timeframe", "15min" } },
+                                            { 0.01, 0.1 });
+    latency.observe(0.005);
+    latency.observe(0.05);
+    latency.observe(3.0);
+    registry.counter("nexday_odd_total", "Odd labels", { { "symbol", "Q\"GC\\#\n" } }).inc();
+
+    std::string text = registry.prometheus_text();
+    check("HELP and TYPE once per family", occurrences(text, "# TYPE nexday_fetches_total counter\n") == 1 &&
+                                          occurrences(text, "# HELP nexday_fetches_total Fetches\n") == 1);
+    check("labelled counter series",
+          contains(text, "nexday_fetches_total{timeframe=\"15min\",result=\"success\"} 3\n") &&
+          contains(text, "nexday_fetches_total{timeframe=\"daily\",result=\"failure\"} 1\n"));
+    check("gauge value", contains(text, "# TYPE nexday_fetch_queued gauge\nnexday_fetch_queued 2.5\n"));
+    check("cumulative buckets ending in +Inf",
+          contains(text, "nexday_parse_seconds_bucket{timeframe=\"15min\",le=\"0.01\"} 1\n") &&
+          contains(text, "nexday_parse_seconds_bucket{timeframe=\"15min\",le=\"0.1\"} 2\n") &&
+          contains(text, "nexday_parse_seconds_bucket{timeframe=\"15min\",le=\"+Inf\"} 3\n") &&
+          contains(text, "nexday_parse_seconds_count{timeframe=\"15min\"} 3\n"));
+    check("histogram sum", contains(text, "nexday_parse_seconds_sum{timeframe=\"15min\"} 3.055"));
+    check("label values escaped", contains(text, "nexday_odd_total{symbol=\"Q\\\"GC\\\\#\\n\"} 1\n"));
+    check("families sorted by name", text.find("nexday_fetch_queued") < text.find("nexday_fetches_total") &&
+                                     text.find("nexday_fetches_total") < text.find("nexday_odd_total"));
+
+    bool threw = false;
+    try {
+        registry.gauge("nexday_fetches_total", "Fetches");
+    } catch (const std::logic_error&) {
+        threw = true;
+    }
+    check("a name cannot change type", threw);
+}
+
+static std::string read_file(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+static void test_file_export() {
+    MetricsRegistry registry;
+    Counter& counter = registry.counter("nexday_test_total", "Test");
+    counter.inc(7);
+
+    const std::string path = "metrics_registry_test_out/nexday.prom";
+    std::string error;
+    bool written = registry.write_prometheus_file(path, error);
+    check("file written", written && contains(read_file(path), "nexday_test_total 7\n"), error);
+    check("no temporary left behind", !std::ifstream(path + ".tmp").good());
+
+    counter.inc();
+    {
+        MetricsFileExporter exporter(path, std::chrono::milliseconds(100), registry);
+        std::this_thread::sleep_for(std::chrono::milliseconds(250));
+        check("exporter rewrites on its interval", contains(read_file(path), "nexday_test_total 8\n") &&
+                                                   exporter.last_error().empty());
+        counter.inc();
+    }
+    check("exporter writes once more on shutdown", contains(read_file(path), "nexday_test_total 9\n"));
+
+    std::remove(path.c_str());
+    std::remove("metrics_registry_test_out");
+}
+
+static void test_hot_path_cost() {
+    MetricsRegistry registry;
+    Counter& counter = registry.counter("bench_total", "Bench");
+    Histogram& histogram = registry.histogram("bench_seconds", "Bench");
+    const int iterations = 2000000;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) counter.inc();
+    double counter_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                        iterations;
+
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) histogram.observe(0.0001 * (i % 1000));
+    double histogram_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                          iterations;
+
+    std::cout << "   counter.inc() " << counter_ns << " ns, histogram.observe() " << histogram_ns << " ns" << std::endl;
+    check("counter increments counted", counter.value() == static_cast<std::uint64_t>(iterations));
+}
+
+int main() {
+    std::cout << "=== METRICS REGISTRY TEST ===" << std::endl;
+
+    test_concurrent_updates();
+    test_histogram_buckets();
+    test_exposition();
+    test_file_export();
+    test_hot_path_cost();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Metrics registry test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Metrics add up under concurrency and export as Prometheus text" << std::endl;
+    return 0;
+}
@@ -0,0 +1,631 @@
+#include "Predictions/EMACalculator.h"
+#include "Predictions/EMAKernel.h"
+#include "Predictions/ErrorMetricsKernel.h"
+#include "Predictions/ActualsIndex.h"
+#include "Predictions/TradingCalendar.h"
+#include "IQFeedConnection/HistoricalDataFetcher.h"
+#include "IQFeedConnection/Logger.h"
+#include "Database/database_simple.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <functional>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+
+// ==============================================
+// NEXDAY BENCHMARK SUITE - EVERY HOT KERNEL
+// ==============================================
+// One repeatable timing run over the kernels the pipeline spends its time
+// in: EMA prediction, IQFeed CSV/HIX parsing, timestamp parsing, the fused
+// error metrics, and bar upserts row-by-row versus one multi-row statement
+// (skipped when the local database is not reachable).
+//
+// Each benchmark is calibrated until one sample takes at least --min-time-ms,
+// warmed up with one discarded sample, then timed for --samples samples. The
+// median is the reported figure; MAD (median absolute deviation) is its noise.
+//
+//   nexday_bench --json out.json                  record a run
+//   nexday_bench --baseline base.json             compare against a recorded run
+//
+// With --baseline, a benchmark regresses when its median is more than
+// --threshold percent slower than the baseline median AND the difference is
+// larger than three times the noise of either run. Any regression exits 1.
+
+static volatile double g_sink = 0.0;      // Results land here so nothing is optimized away
+
+struct Options {
+    std::string json_path;
+    std::string baseline_path;
+    std::string filter;
+    double threshold_percent = 10.0;
+    int samples = 15;
+    double min_time_ms = 20.0;
+    bool list_only = false;
+};
+
+struct Benchmark {
+    std::string name;                                   // "group/kernel", the key a baseline matches on
+    std::string unit;                                   // What one op is, for the table
+    std::function<void(long long)> run;                 // Performs that many ops
+};
+
+struct BenchResult {
+    std::string name;
+    std::string unit;
+    long long iterations = 0;                           // Ops per sample
+    double median_ns = 0.0;                             // All per op
+    double mean_ns = 0.0;
+    double stddev_ns = 0.0;
+    double min_ns = 0.0;
+    double max_ns = 0.0;
+    double mad_ns = 0.0;
+};
+
+struct BaselineEntry {
+    double median_ns = 0.0;
+    double mad_ns = 0.0;
+};
+
+// ==============================================
+// HARNESS
+// ==============================================
+
+static double median_of(std::vector<double> values) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    std::size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2.0;
+}
+
+static double time_ns(const Benchmark& bench, long long iterations) {
+    auto start = std::chrono::steady_clock::now();
+    bench.run(iterations);
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+static BenchResult measure(const Benchmark& bench, const Options& options) {
+    const double min_sample_ns = options.min_time_ms * 1e6;
+
+    // Grow the op count until one sample is long enough to time reliably
+    long long iterations = 1;
+    double elapsed = time_ns(bench, iterations);
+    while (elapsed < min_sample_ns && iterations < (1LL << 40)) {
+        double scale = elapsed > 0.0 ? min_sample_ns * 1.2 / elapsed : 10.0;
+        iterations = static_cast<long long>(iterations * std::min(10.0, std::max(2.0, scale)));
+        elapsed = time_ns(bench, iterations);
+    }
+    time_ns(bench, iterations);                         // Warm-up sample, discarded
+
+    std::vector<double> per_op;
+    for (int s = 0; s < options.samples; s++) {
+        per_op.push_back(time_ns(bench, iterations) / static_cast<double>(iterations));
+    }
+
+    BenchResult result;
+    result.name = bench.name;
+    result.unit = bench.unit;
+    result.iterations = iterations;
+    result.median_ns = median_of(per_op);
+    result.min_ns = *std::min_element(per_op.begin(), per_op.end());
+    result.max_ns = *std::max_element(per_op.begin(), per_op.end());
+
+    double sum = 0.0;
+    for (double v : per_op) sum += v;
+    result.mean_ns = sum / per_op.size();
+
+    double squares = 0.0;
+    std::vector<double> deviations;
+    for (double v : per_op) {
+        squares += (v - result.mean_ns) * (v - result.mean_ns);
+        deviations.push_back(std::abs(v - result.median_ns));
+    }
+    result.stddev_ns = per_op.size() > 1 ? std::sqrt(squares / (per_op.size() - 1)) : 0.0;
+    result.mad_ns = median_of(deviations);
+    return result;
+}
+
+static std::string format_ns(double ns) {
+    char text[32];
+    if (ns >= 1e9) std::snprintf(text, sizeof(text), "%.3f s", ns / 1e9);
+    else if (ns >= 1e6) std::snprintf(text, sizeof(text), "%.3f ms", ns / 1e6);
+    else if (ns >= 1e3) std::snprintf(text, sizeof(text), "%.3f us", ns / 1e3);
+    else std::snprintf(text, sizeof(text), "%.2f ns", ns);
+    return text;
+}
+
+// ==============================================
+// JSON REPORT AND BASELINE
+// ==============================================
+
+static bool write_json(const std::string& path, const std::vector<BenchResult>& results, const Options& options,
+                       std::string& error) {
+    std::ofstream out(path, std::ios::trunc);
+    if (!out.is_open()) {
+        error = "Cannot open " + path;
+        return false;
+    }
+
+    out << std::setprecision(6) << std::fixed;
+    out << "{\n";
+    out << "  \"suite\": \"nexday_bench\",\n";
+    out << "  \"ema_simd_path\": \"" << EMAKernel::simd_path() << "\",\n";
+    out << "  \"error_metrics_simd_path\": \"" << ErrorMetricsKernel::simd_path() << "\",\n";
+    out << "  \"samples\": " << options.samples << ",\n";
+    out << "  \"min_time_ms\": " << options.min_time_ms << ",\n";
+    out << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << (i == 0 ? "\n" : ",\n");
+        out << "    {\"name\": \"" << r.name << "\", \"unit\": \"" << r.unit << "\", \"iterations\": "
+            << r.iterations << ", \"median_ns\": " << r.median_ns << ", \"mean_ns\": " << r.mean_ns
+            << ", \"stddev_ns\": " << r.stddev_ns << ", \"min_ns\": " << r.min_ns << ", \"max_ns\": " << r.max_ns
+            << ", \"mad_ns\": " << r.mad_ns << "}";
+    }
+    out << "\n  ]\n}\n";
+
+    out.flush();
+    if (!out) {
+        error = "Write failed: " + path;
+        return false;
+    }
+    return true;
+}
+
+// Number after "key": inside one benchmark object
+static bool read_number(const std::string& object, const std::string& key, double& value) {
+    std::size_t at = object.find("\"" + key + "\":");
+    if (at == std::string::npos) return false;
+    const char* begin = object.c_str() + at + key.size() + 3;
+    char* end = nullptr;
+    value = std::strtod(begin, &end);
+    return end != begin;
+}
+
+// Reads back the file write_json produces
+static bool load_baseline(const std::string& path, std::map<std::string, BaselineEntry>& baseline,
+                          std::string& error) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    const std::string text = buffer.str();
+
+    std::size_t list = text.find("\"benchmarks\":");
+    if (list == std::string::npos) {
+        error = path + " has no \"benchmarks\" list";
+        return false;
+    }
+    for (std::size_t at = text.find('{', list); at != std::string::npos; at = text.find('{', at + 1)) {
+        std::size_t close = text.find('}', at);
+        if (close == std::string::npos) break;
+        const std::string object = text.substr(at, close - at);
+
+        std::size_t name_at = object.find("\"name\": \"");
+        if (name_at == std::string::npos) continue;
+        name_at += 9;
+        std::string name = object.substr(name_at, object.find('"', name_at) - name_at);
+
+        BaselineEntry entry;
+        if (!read_number(object, "median_ns", entry.median_ns)) {
+            error = path + ": no median_ns for " + name;
+            return false;
+        }
+        read_number(object, "mad_ns", entry.mad_ns);
+        baseline[name] = entry;
+    }
+    if (baseline.empty()) {
+        error = path + " lists no benchmarks";
+        return false;
+    }
+    return true;
+}
+
+// Returns the number of regressions
+static int compare_to_baseline(const std::vector<BenchResult>& results,
+                               const std::map<std::string, BaselineEntry>& baseline, double threshold_percent) {
+    std::cout << "\n📈 Compared to baseline (threshold " << threshold_percent << "%, noise 3x MAD)" << std::endl;
+    int regressions = 0;
+    for (const auto& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end()) {
+            std::cout << "   ➖ " << std::left << std::setw(34) << r.name << " new, no baseline" << std::endl;
+            continue;
+        }
+        const BaselineEntry& base = it->second;
+        double delta = r.median_ns - base.median_ns;
+        double change = base.median_ns > 0.0 ? delta / base.median_ns * 100.0 : 0.0;
+        double noise = 3.0 * std::max(r.mad_ns, base.mad_ns);
+        bool beyond = std::abs(delta) > noise && std::abs(change) > threshold_percent;
+
+        const char* mark = "✅";
+        const char* verdict = "unchanged";
+        if (beyond && delta > 0) {
+            mark = "❌";
+            verdict = "REGRESSED";
+            regressions++;
+        } else if (beyond) {
+            mark = "🚀";
+            verdict = "faster";
+        }
+        char pct[16];
+        std::snprintf(pct, sizeof(pct), "%+.1f%%", change);
+        std::cout << "   " << mark << " " << std::left << std::setw(34) << r.name << std::right << std::setw(12)
+                  << format_ns(base.median_ns) << " -> " << std::setw(12) << format_ns(r.median_ns) << "  "
+                  << std::setw(7) << pct << "  " << verdict << std::endl;
+    }
+    for (const auto& entry : baseline) {
+        bool ran = std::any_of(results.begin(), results.end(),
+                               [&](const BenchResult& r) { return r.name == entry.first; });
+        if (!ran) {
+            std::cout << "   ➖ " << std::left << std::setw(34) << entry.first << " in baseline, not run" << std::endl;
+        }
+    }
+    return regressions;
+}
+
+// ==============================================
+// INPUTS
+// ==============================================
+
+struct BenchBar {
+    double open;
+    double high;
+    double low;
+    double close;
+};
+
+// parse_historical_data and split_csv are the fetcher's own; a 15min
+// fetcher with no connection exposes them
+class ParseBenchFetcher : public HistoricalDataFetcher {
+protected:
+    std::string get_interval_code() const override { return "900"; }
+    std::chrono::seconds get_interval_offset() const override { return std::chrono::seconds(900); }
+
+public:
+    ParseBenchFetcher() : HistoricalDataFetcher(nullptr, "15min") {}
+
+    using HistoricalDataFetcher::parse_historical_data;
+    using HistoricalDataFetcher::split_csv;
+};
+
+static std::string wall_clock(long long seconds) {
+    int second_of_day = static_cast<int>(seconds % 86400);
+    long long year;
+    unsigned month, day;
+    TradingCalendar::civil_from_days(seconds / 86400, year, month, day);
+
+    char text[64];
+    std::snprintf(text, sizeof(text), "%04lld-%02u-%02u %02d:%02d:%02d", year, month, day, second_of_day / 3600,
+                  (second_of_day / 60) % 60, second_of_day % 60);
+    return text;
+}
+
+// 15min bars from 2024-01-02 09:30 on, as "YYYY-MM-DD HH:MM:SS"
+static std::vector<std::string> bar_stamps(int count) {
+    const long long start = ActualsIndex::parse_timestamp("2024-01-02 09:30:00");
+    std::vector<std::string> stamps;
+    for (int i = 0; i < count; i++) {
+        stamps.push_back(wall_clock(start + i * 900LL));
+    }
+    return stamps;
+}
+
+// An HIX response as IQFeed sends it, newest bar first
+static std::string hix_response(int bars) {
+    std::vector<std::string> stamps = bar_stamps(bars);
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(2);
+    for (int i = bars - 1; i >= 0; i--) {
+        double close = 2000.0 + (i % 7) * 1.25 - (i % 3) * 0.5;
+        out << "BENCH15," << "LH," << stamps[i] << "," << close + 1.0 << "," << close - 1.0 << ","
+            << close - 0.5 << "," << close << "," << 1200 + i << "," << 500000 + i * 10 << "," << 1200 + i
+            << ",\r\n";
+    }
+    out << "BENCH15,!ENDMSG!,\r\n";
+    return out.str();
+}
+
+// The std::get_time + mktime parse the fetcher and scheduler use for bar times
+static long long stream_parse_timestamp(const std::string& text) {
+    std::istringstream ss(text);
+    std::tm tm = {};
+    ss >> std::get_time(&tm, "%Y-%m-%d %H:%M:%S");
+    if (ss.fail()) return -1;
+    tm.tm_isdst = -1;
+    return static_cast<long long>(std::mktime(&tm));
+}
+
+// ==============================================
+// BENCHMARKS
+// ==============================================
+
+static void add_ema_benchmarks(std::vector<Benchmark>& benches) {
+    const int num_bars = 100;
+    auto prices = std::make_shared<std::vector<double>>();
+    auto bars = std::make_shared<std::vector<BenchBar>>();
+    for (int i = 0; i < num_bars; i++) {
+        double close = 2000.0 + (i % 7) * 1.25 - (i % 3) * 0.5;
+        prices->push_back(close);
+        bars->push_back({ close - 0.5, close + 1.0, close - 1.0, close });
+    }
+
+    benches.push_back({ "ema/calculate_prediction", "100-bar series", [prices](long long n) {
+        double sum = 0.0;
+        for (long long i = 0; i < n; i++) sum += SimpleEMACalculator::calculate_prediction(*prices);
+        g_sink = g_sink + sum;
+    } });
+
+    benches.push_back({ "ema/kernel_predict_x4", "OHLC, 4 scalar passes", [bars](long long n) {
+        static constexpr double BenchBar::* ohlc[] = { &BenchBar::open, &BenchBar::high, &BenchBar::low,
+                                                       &BenchBar::close };
+        double sum = 0.0;
+        for (long long i = 0; i < n; i++) {
+            for (int k = 0; k < 4; k++) {
+                sum += EMAKernel::predict(EMAKernel::view(*bars, ohlc[k]), EMAKernel::STANDARD);
+            }
+        }
+        g_sink = g_sink + sum;
+    } });
+
+    benches.push_back({ "ema/kernel_predict_fields", "OHLC, one SIMD pass", [bars](long long n) {
+        static constexpr double BenchBar::* ohlc[] = { &BenchBar::open, &BenchBar::high, &BenchBar::low,
+                                                       &BenchBar::close };
+        double out[4];
+        double sum = 0.0;
+        for (long long i = 0; i < n; i++) {
+            EMAKernel::predict_fields(*bars, ohlc, false, EMAKernel::STANDARD, out);
+            sum += out[0] + out[1] + out[2] + out[3];
+        }
+        g_sink = g_sink + sum;
+    } });
+}
+
+static void add_parse_benchmarks(std::vector<Benchmark>& benches) {
+    auto fetcher = std::make_shared<ParseBenchFetcher>();
+    auto response = std::make_shared<std::string>(hix_response(500));
+    auto line = std::make_shared<std::string>(response->substr(0, response->find('\n')));
+
+    benches.push_back({ "parse/split_csv", "one HIX line", [fetcher, line](long long n) {
+        std::size_t fields = 0;
+        for (long long i = 0; i < n; i++) fields += fetcher->split_csv(*line).size();
+        g_sink = g_sink + static_cast<double>(fields);
+    } });
+
+    benches.push_back({ "parse/hix_response", "500-bar response", [fetcher, response](long long n) {
+        std::vector<HistoricalBar> data;
+        std::size_t bars = 0;
+        for (long long i = 0; i < n; i++) {
+            fetcher->parse_historical_data(*response, "BENCH#", data);
+            bars += data.size();
+        }
+        g_sink = g_sink + static_cast<double>(bars);
+    } });
+}
+
+static void add_timestamp_benchmarks(std::vector<Benchmark>& benches) {
+    auto stamps = std::make_shared<std::vector<std::string>>(bar_stamps(1024));
+
+    benches.push_back({ "timestamp/actuals_index", "one timestamp", [stamps](long long n) {
+        long long sum = 0;
+        for (long long i = 0; i < n; i++) sum += ActualsIndex::parse_timestamp((*stamps)[i & 1023]);
+        g_sink = g_sink + static_cast<double>(sum);
+    } });
+
+    benches.push_back({ "timestamp/get_time_mktime", "one timestamp", [stamps](long long n) {
+        long long sum = 0;
+        for (long long i = 0; i < n; i++) sum += stream_parse_timestamp((*stamps)[i & 1023]);
+        g_sink = g_sink + static_cast<double>(sum);
+    } });
+}
+
+static void add_error_metrics_benchmarks(std::vector<Benchmark>& benches) {
+    const std::size_t count = 10000;
+    auto actual = std::make_shared<std::vector<double>>();
+    auto predicted = std::make_shared<std::vector<double>>();
+    auto previous = std::make_shared<std::vector<double>>();
+    for (std::size_t i = 0; i < count; i++) {
+        double price = 2000.0 + std::sin(i * 0.01) * 50.0;
+        actual->push_back(price);
+        predicted->push_back(price + std::cos(i * 0.37) * 2.0);
+        previous->push_back(price - std::sin(i * 0.05));
+    }
+
+    benches.push_back({ "metrics/error_metrics", "10k samples", [actual, predicted, previous](long long n) {
+        double sum = 0.0;
+        for (long long i = 0; i < n; i++) {
+            ErrorMetrics m = ErrorMetricsKernel::compute(actual->data(), predicted->data(), actual->size(),
+                                                         previous->data());
+            sum += m.rmse + m.directional_accuracy;
+        }
+        g_sink = g_sink + sum;
+    } });
+}
+
+// ==============================================
+// DATABASE UPSERTS
+// ==============================================
+
+static const int DB_BATCH_BARS = 500;
+static const char* DB_BENCH_SYMBOL = "BENCH#";
+static const char* DB_ROW_BENCH = "db/upsert_row_x500";
+static const char* DB_BATCH_BENCH = "db/upsert_batch_x500";
+
+static void add_database_benchmarks(std::vector<Benchmark>& benches, std::shared_ptr<SimpleDatabaseManager> db,
+                                    int symbol_id) {
+    auto stamps = std::make_shared<std::vector<std::string>>(bar_stamps(DB_BATCH_BARS));
+
+    // The scheduler's path: one autocommitted statement per bar
+    benches.push_back({ DB_ROW_BENCH, "500 bars, one statement each", [db, stamps](long long n) {
+        for (long long i = 0; i < n; i++) {
+            for (int b = 0; b < DB_BATCH_BARS; b++) {
+                const std::string& stamp = (*stamps)[b];
+                double close = 2000.0 + b * 0.25 + static_cast<double>(i % 2);
+                db->insert_historical_data_30min(DB_BENCH_SYMBOL, stamp.substr(0, 10), stamp.substr(11),
+                                                 close - 0.5, close + 1.0, close - 1.0, close, 1000 + b);
+            }
+        }
+    } });
+
+    // The same bars in one multi-row upsert
+    benches.push_back({ DB_BATCH_BENCH, "500 bars, one statement", [db, stamps, symbol_id](long long n) {
+        for (long long i = 0; i < n; i++) {
+            std::ostringstream query;
+            query << "INSERT INTO historical_fetch_30min (fetch_date, fetch_time, symbol_id, open_price, "
+                     "high_price, low_price, close_price, volume, open_interest, data_source) VALUES ";
+            for (int b = 0; b < DB_BATCH_BARS; b++) {
+                const std::string& stamp = (*stamps)[b];
+                double close = 2000.0 + b * 0.25 + static_cast<double>(i % 2);
+                query << (b == 0 ? "" : ", ") << "('" << stamp.substr(0, 10) << "', '" << stamp.substr(11)
+                      << "', " << symbol_id << ", " << close - 0.5 << ", " << close + 1.0 << ", " << close - 1.0
+                      << ", " << close << ", " << 1000 + b << ", 0, 'iqfeed')";
+            }
+            query << " ON CONFLICT (fetch_date, fetch_time, symbol_id) DO UPDATE SET "
+                     "open_price = EXCLUDED.open_price, high_price = EXCLUDED.high_price, "
+                     "low_price = EXCLUDED.low_price, close_price = EXCLUDED.close_price, "
+                     "volume = EXCLUDED.volume, open_interest = EXCLUDED.open_interest";
+            db->execute_query(query.str());
+        }
+    } });
+}
+
+static void cleanup_database(SimpleDatabaseManager& db, int symbol_id) {
+    db.execute_query("DELETE FROM historical_fetch_30min WHERE symbol_id = " + std::to_string(symbol_id));
+    db.execute_query("DELETE FROM symbols WHERE symbol_id = " + std::to_string(symbol_id));
+}
+
+// ==============================================
+// MAIN
+// ==============================================
+
+static void print_usage() {
+    std::cout << "Usage: nexday_bench [--json PATH] [--baseline PATH] [--threshold PCT] [--filter TEXT]\n"
+                 "                    [--samples N] [--min-time-ms MS] [--list]" << std::endl;
+}
+
+static bool parse_options(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        bool has_value = i + 1 < argc;
+        if (arg == "--json" && has_value) options.json_path = argv[++i];
+        else if (arg == "--baseline" && has_value) options.baseline_path = argv[++i];
+        else if (arg == "--filter" && has_value) options.filter = argv[++i];
+        else if (arg == "--threshold" && has_value) options.threshold_percent = std::atof(argv[++i]);
+        else if (arg == "--samples" && has_value) options.samples = std::max(3, std::atoi(argv[++i]));
+        else if (arg == "--min-time-ms" && has_value) options.min_time_ms = std::max(1.0, std::atof(argv[++i]));
+        else if (arg == "--list") options.list_only = true;
+        else {
+            print_usage();
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parse_options(argc, argv, options)) return 2;
+
+    // The parse benchmark measures parsing, not the fetcher's log lines
+    Logger::set_console_mirror(false);
+    Logger::set_level(LogLevel::Error);
+
+    std::map<std::string, BaselineEntry> baseline;
+    if (!options.baseline_path.empty()) {
+        std::string error;
+        if (!load_baseline(options.baseline_path, baseline, error)) {
+            std::cout << "❌ Baseline: " << error << std::endl;
+            return 2;
+        }
+    }
+
+    std::cout << "⏱️  NEXDAY BENCHMARK SUITE" << std::endl;
+    std::cout << "=========================" << std::endl;
+    std::cout << "EMA SIMD path:           " << EMAKernel::simd_path() << std::endl;
+    std::cout << "Error metrics SIMD path: " << ErrorMetricsKernel::simd_path() << std::endl;
+    std::cout << "Samples: " << options.samples << " x >= " << options.min_time_ms << " ms" << std::endl;
+
+    std::vector<Benchmark> benches;
+    add_ema_benchmarks(benches);
+    add_parse_benchmarks(benches);
+    add_timestamp_benchmarks(benches);
+    add_error_metrics_benchmarks(benches);
+
+    // Only connect when the filter keeps an upsert benchmark
+    bool wants_db = std::string(DB_ROW_BENCH).find(options.filter) != std::string::npos ||
+                    std::string(DB_BATCH_BENCH).find(options.filter) != std::string::npos;
+    std::shared_ptr<SimpleDatabaseManager> db;
+    int symbol_id = -1;
+    if (wants_db && !options.list_only) {
+        DatabaseConfig config;
+        config.host = "localhost";
+        config.port = 5432;
+        config.database = "nexday_trading";
+        config.username = "postgres";
+        config.password = "magical.521";
+
+        db = std::make_shared<SimpleDatabaseManager>(config);
+        symbol_id = db->is_connected() ? db->get_or_create_symbol_id(DB_BENCH_SYMBOL) : -1;
+        if (symbol_id > 0) {
+            add_database_benchmarks(benches, db, symbol_id);
+        } else {
+            std::cout << "➖ Database not available - upsert benchmarks skipped" << std::endl;
+        }
+    } else if (options.list_only) {
+        add_database_benchmarks(benches, nullptr, -1);
+    }
+
+    std::vector<Benchmark> selected;
+    for (const auto& bench : benches) {
+        if (bench.name.find(options.filter) != std::string::npos) selected.push_back(bench);
+    }
+    if (options.list_only) {
+        for (const auto& bench : selected) std::cout << "   " << bench.name << " (" << bench.unit << ")" << std::endl;
+        return 0;
+    }
+
+    std::cout << "\n" << std::left << std::setw(30) << "BENCHMARK" << std::right << std::setw(12) << "MEDIAN"
+              << std::setw(12) << "MAD" << std::setw(12) << "MIN" << std::setw(12) << "MAX" << "  PER OP" << std::endl;
+    std::vector<BenchResult> results;
+    for (const auto& bench : selected) {
+        BenchResult r = measure(bench, options);
+        std::cout << std::left << std::setw(30) << r.name << std::right << std::setw(12) << format_ns(r.median_ns)
+                  << std::setw(12) << format_ns(r.mad_ns) << std::setw(12) << format_ns(r.min_ns) << std::setw(12)
+                  << format_ns(r.max_ns) << "  " << r.unit << std::endl;
+        results.push_back(r);
+    }
+
+    if (db && symbol_id > 0) {
+        cleanup_database(*db, symbol_id);
+    }
+
+    if (!options.json_path.empty()) {
+        std::string error;
+        if (!write_json(options.json_path, results, options, error)) {
+            std::cout << "❌ JSON report: " << error << std::endl;
+            return 2;
+        }
+        std::cout << "\n📄 Results written to " << options.json_path << std::endl;
+    }
+
+    if (!baseline.empty()) {
+        int regressions = compare_to_baseline(results, baseline, options.threshold_percent);
+        if (regressions > 0) {
+            std::cout << "\n❌ " << regressions << " benchmark(s) regressed against the baseline" << std::endl;
+            return 1;
+        }
+        std::cout << "\n✅ No regressions against the baseline" << std::endl;
+    }
+    return 0;
+}
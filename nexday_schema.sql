@@ -79,6 +79,7 @@ CREATE TABLE IF NOT EXISTS symbols (
 CREATE TABLE IF NOT EXISTS historical_fetch_15min (
     fetch_date          DATE NOT NULL,
     fetch_time          TIME NOT NULL,
+    bar_ts              TIMESTAMP WITH TIME ZONE GENERATED ALWAYS AS ((fetch_date + fetch_time) AT TIME ZONE 'UTC') STORED,
     time_of_fetch       TIMESTAMP WITH TIME ZONE DEFAULT CURRENT_TIMESTAMP,
     symbol_id           INTEGER NOT NULL REFERENCES symbols(symbol_id) ON DELETE CASCADE,
     
@@ -114,6 +115,7 @@ CREATE TABLE IF NOT EXISTS historical_fetch_15min (
 CREATE TABLE IF NOT EXISTS historical_fetch_30min (
     fetch_date          DATE NOT NULL,
     fetch_time          TIME NOT NULL,
+    bar_ts              TIMESTAMP WITH TIME ZONE GENERATED ALWAYS AS ((fetch_date + fetch_time) AT TIME ZONE 'UTC') STORED,
     time_of_fetch       TIMESTAMP WITH TIME ZONE DEFAULT CURRENT_TIMESTAMP,
     symbol_id           INTEGER NOT NULL REFERENCES symbols(symbol_id) ON DELETE CASCADE,
     
@@ -149,6 +151,7 @@ CREATE TABLE IF NOT EXISTS historical_fetch_30min (
 CREATE TABLE IF NOT EXISTS historical_fetch_1hour (
     fetch_date          DATE NOT NULL,
     fetch_time          TIME NOT NULL,
+    bar_ts              TIMESTAMP WITH TIME ZONE GENERATED ALWAYS AS ((fetch_date + fetch_time) AT TIME ZONE 'UTC') STORED,
     time_of_fetch       TIMESTAMP WITH TIME ZONE DEFAULT CURRENT_TIMESTAMP,
     symbol_id           INTEGER NOT NULL REFERENCES symbols(symbol_id) ON DELETE CASCADE,
     
@@ -184,6 +187,7 @@ CREATE TABLE IF NOT EXISTS historical_fetch_1hour (
 CREATE TABLE IF NOT EXISTS historical_fetch_2hours (
     fetch_date          DATE NOT NULL,
     fetch_time          TIME NOT NULL,
+    bar_ts              TIMESTAMP WITH TIME ZONE GENERATED ALWAYS AS ((fetch_date + fetch_time) AT TIME ZONE 'UTC') STORED,
     time_of_fetch       TIMESTAMP WITH TIME ZONE DEFAULT CURRENT_TIMESTAMP,
     symbol_id           INTEGER NOT NULL REFERENCES symbols(symbol_id) ON DELETE CASCADE,
     
@@ -307,6 +311,86 @@ CREATE TABLE IF NOT EXISTS predictions_all_symbols (
     UNIQUE(prediction_time, symbol_id, model_id, timeframe)
 );
 
+-- Streaming error-metric state per model and timeframe (see MetricsAccumulator.h)
+-- Validators flush deltas that ON CONFLICT merges into the row (parallel Welford/Chan)
+CREATE TABLE IF NOT EXISTS model_metric_accumulators (
+    model_id INTEGER NOT NULL,
+    timeframe VARCHAR(10) NOT NULL,
+    sample_count BIGINT NOT NULL DEFAULT 0,
+    mean_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    m2_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    mean_actual DOUBLE PRECISION NOT NULL DEFAULT 0,
+    m2_actual DOUBLE PRECISION NOT NULL DEFAULT 0,
+    sum_abs_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    sum_squared_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    sum_abs_pct_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    sum_accuracy DOUBLE PRECISION NOT NULL DEFAULT 0,
+    updated_at TIMESTAMP WITH TIME ZONE DEFAULT CURRENT_TIMESTAMP,
+    
+    PRIMARY KEY (model_id, timeframe)
+);
+
+-- Per-day partial metric state feeding the 7/30/90-day rolling windows (see RollingMetrics.h)
+CREATE TABLE IF NOT EXISTS model_metric_daily_buckets (
+    model_id INTEGER NOT NULL,
+    timeframe VARCHAR(10) NOT NULL,
+    symbol_id INTEGER NOT NULL,
+    bucket_date DATE NOT NULL,
+    sample_count BIGINT NOT NULL DEFAULT 0,
+    mean_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    m2_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    mean_actual DOUBLE PRECISION NOT NULL DEFAULT 0,
+    m2_actual DOUBLE PRECISION NOT NULL DEFAULT 0,
+    sum_abs_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    sum_squared_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    sum_abs_pct_error DOUBLE PRECISION NOT NULL DEFAULT 0,
+    sum_accuracy DOUBLE PRECISION NOT NULL DEFAULT 0,
+    updated_at TIMESTAMP WITH TIME ZONE DEFAULT CURRENT_TIMESTAMP,
+    
+    PRIMARY KEY (model_id, timeframe, symbol_id, bucket_date)
+);
+
+-- Backtest runs replayed in memory by BacktestEngine (summary only, no per-prediction rows)
+CREATE TABLE IF NOT EXISTS backtest_runs (
+    run_id SERIAL PRIMARY KEY,
+    model_id INTEGER NOT NULL,
+    days_back INTEGER NOT NULL,
+    symbols INTEGER NOT NULL DEFAULT 0,
+    bars_replayed BIGINT NOT NULL DEFAULT 0,
+    predictions BIGINT NOT NULL DEFAULT 0,
+    unmatched BIGINT NOT NULL DEFAULT 0,
+    replay_seconds DOUBLE PRECISION,
+    run_at TIMESTAMP WITH TIME ZONE DEFAULT CURRENT_TIMESTAMP
+);
+
+-- Per-component ("daily_open", "15min_high", ...) and per-timeframe metrics of a backtest run
+CREATE TABLE IF NOT EXISTS backtest_results (
+    run_id INTEGER NOT NULL REFERENCES backtest_runs(run_id) ON DELETE CASCADE,
+    model_id INTEGER NOT NULL,
+    timeframe VARCHAR(20) NOT NULL,
+    sample_count BIGINT NOT NULL DEFAULT 0,
+    mae DOUBLE PRECISION,
+    rmse DOUBLE PRECISION,
+    mape DOUBLE PRECISION,
+    r_squared DOUBLE PRECISION,
+    mean_accuracy DOUBLE PRECISION,
+    std_deviation DOUBLE PRECISION,
+    
+    PRIMARY KEY (run_id, model_id, timeframe)
+);
+
+-- Scheduler processes in sharded mode (see ShardCoordinator.h): one row per live
+-- process, refreshed every heartbeat; shard ownership itself is advisory locks
+CREATE TABLE IF NOT EXISTS scheduler_members (
+    cluster VARCHAR(64) NOT NULL,
+    member_id VARCHAR(128) NOT NULL,
+    backend_pid INTEGER,
+    started_at TIMESTAMP WITH TIME ZONE NOT NULL DEFAULT now(),
+    heartbeat_at TIMESTAMP WITH TIME ZONE NOT NULL DEFAULT now(),
+    
+    PRIMARY KEY (cluster, member_id)
+);
+
 -- =====================================================
 -- 5. ERROR TRACKING TABLES (UPDATED FOR 2-HOUR)
 -- =====================================================
@@ -388,6 +472,23 @@ CREATE INDEX IF NOT EXISTS idx_symbols_symbol ON symbols(symbol);
 CREATE INDEX IF NOT EXISTS idx_symbols_active ON symbols(is_active) WHERE is_active = TRUE;
 
 -- Historical Data (Time-series optimized with new structure)
+-- Databases created before bar_ts existed get the generated column here
+ALTER TABLE historical_fetch_15min ADD COLUMN IF NOT EXISTS bar_ts TIMESTAMP WITH TIME ZONE GENERATED ALWAYS AS ((fetch_date + fetch_time) AT TIME ZONE 'UTC') STORED;
+ALTER TABLE historical_fetch_30min ADD COLUMN IF NOT EXISTS bar_ts TIMESTAMP WITH TIME ZONE GENERATED ALWAYS AS ((fetch_date + fetch_time) AT TIME ZONE 'UTC') STORED;
+ALTER TABLE historical_fetch_1hour ADD COLUMN IF NOT EXISTS bar_ts TIMESTAMP WITH TIME ZONE GENERATED ALWAYS AS ((fetch_date + fetch_time) AT TIME ZONE 'UTC') STORED;
+ALTER TABLE historical_fetch_2hours ADD COLUMN IF NOT EXISTS bar_ts TIMESTAMP WITH TIME ZONE GENERATED ALWAYS AS ((fetch_date + fetch_time) AT TIME ZONE 'UTC') STORED;
+
+-- Range lookups on bar_ts; the INCLUDE list covers the engine and validator
+-- queries so they run as index-only scans
+CREATE INDEX IF NOT EXISTS idx_historical_15min_symbol_bar_ts ON historical_fetch_15min(symbol_id, bar_ts)
+    INCLUDE (fetch_date, fetch_time, open_price, high_price, low_price, close_price, volume);
+CREATE INDEX IF NOT EXISTS idx_historical_30min_symbol_bar_ts ON historical_fetch_30min(symbol_id, bar_ts)
+    INCLUDE (fetch_date, fetch_time, open_price, high_price, low_price, close_price, volume);
+CREATE INDEX IF NOT EXISTS idx_historical_1hour_symbol_bar_ts ON historical_fetch_1hour(symbol_id, bar_ts)
+    INCLUDE (fetch_date, fetch_time, open_price, high_price, low_price, close_price, volume);
+CREATE INDEX IF NOT EXISTS idx_historical_2hours_symbol_bar_ts ON historical_fetch_2hours(symbol_id, bar_ts)
+    INCLUDE (fetch_date, fetch_time, open_price, high_price, low_price, close_price, volume);
+
 CREATE INDEX IF NOT EXISTS idx_historical_15min_symbol_date_time ON historical_fetch_15min(symbol_id, fetch_date DESC, fetch_time DESC);
 CREATE INDEX IF NOT EXISTS idx_historical_15min_time_of_fetch ON historical_fetch_15min(time_of_fetch DESC);
 
@@ -469,6 +570,7 @@ COMMENT ON TABLE historical_fetch_daily IS 'IQFeed daily historical OHLCV data w
 
 COMMENT ON COLUMN historical_fetch_15min.fetch_date IS 'Date of the trading bar (e.g., 2025-09-12)';
 COMMENT ON COLUMN historical_fetch_15min.fetch_time IS 'Time of the trading bar (e.g., 07:00:00)';
+COMMENT ON COLUMN historical_fetch_15min.bar_ts IS 'Bar start (fetch_date + fetch_time) read as UTC, for indexed range lookups';
 COMMENT ON COLUMN historical_fetch_15min.time_of_fetch IS 'Timestamp when the data fetch was initiated';
 COMMENT ON COLUMN historical_fetch_15min.open_interest IS 'Open interest from IQFeed (futures/options)';
 
@@ -0,0 +1,138 @@
+#include "Predictions/PredictionCache.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+
+// ==============================================
+// PREDICTION CACHE TEST
+// ==============================================
+// Drives PredictionCache the way the engine does (lookup, compute on a miss,
+// store) with synthetic bar windows: an unchanged window is a hit, a new bar
+// is a miss, a restated bar with the same newest timestamp drops the entry
+// and is counted, and invalidate() after a failed save forces a recompute.
+
+using Clock = std::chrono::system_clock;
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+struct Forecast {
+    double close = 0.0;
+    int run = 0;
+};
+
+// Daily bars from 2024-01-02 on, close rising by one a day
+static std::vector<HistoricalBar> bar_window(int count) {
+    auto first = Clock::from_time_t(1704153600);
+    std::vector<HistoricalBar> bars;
+    for (int i = 0; i < count; i++) {
+        double close = 100.0 + i;
+        bars.emplace_back(first + std::chrono::hours(24 * i), close - 0.5, close + 1.0, close - 1.0, close, 1000 + i);
+    }
+    return bars;
+}
+
+// Stand-in for the engine: reuse the cached forecast or compute a new one
+class Predictor {
+public:
+    Forecast predict(const std::string& symbol, const std::vector<HistoricalBar>& bars) {
+        auto last_bar_time = bars.back().timestamp;
+        auto input_fingerprint = PredictionCache<Forecast>::fingerprint(bars);
+
+        Forecast forecast;
+        if (cache.lookup(symbol, TimeFrame::DAILY, 1, last_bar_time, input_fingerprint, forecast)) {
+            return forecast;
+        }
+
+        forecast.close = bars.back().close;
+        forecast.run = ++computed;
+        cache.store(symbol, TimeFrame::DAILY, 1, last_bar_time, input_fingerprint, forecast);
+        return forecast;
+    }
+
+    PredictionCache<Forecast> cache;
+    int computed = 0;
+};
+
+static void test_unchanged_window() {
+    Predictor predictor;
+    auto bars = bar_window(50);
+
+    Forecast first = predictor.predict("AAA", bars);
+    Forecast second = predictor.predict("AAA", bars);
+    check("unchanged window is a hit", predictor.computed == 1 && second.run == first.run);
+    check("other symbols do not share the entry", predictor.predict("BBB", bars).run == 2);
+    check("counters: 1 hit, 2 misses", predictor.cache.hits() == 1 && predictor.cache.misses() == 2,
+          std::to_string(predictor.cache.hits()) + " hits, " + std::to_string(predictor.cache.misses()) + " misses");
+}
+
+static void test_new_bar() {
+    Predictor predictor;
+    auto bars = bar_window(50);
+    predictor.predict("AAA", bars);
+
+    bars = bar_window(51);
+    Forecast forecast = predictor.predict("AAA", bars);
+    check("a new bar is a miss", predictor.computed == 2 && forecast.close == bars.back().close);
+    check("only the latest entry per series is kept", predictor.cache.size() == 1);
+    check("a new bar is not a restatement", predictor.cache.restatements() == 0);
+}
+
+static void test_restatement() {
+    Predictor predictor;
+    auto bars = bar_window(50);
+    predictor.predict("AAA", bars);
+
+    // Same newest bar, corrected close further back in the window
+    bars[40].close += 0.25;
+    Forecast forecast;
+    bool hit = predictor.cache.lookup("AAA", TimeFrame::DAILY, 1, bars.back().timestamp,
+                                      PredictionCache<Forecast>::fingerprint(bars), forecast);
+    check("a restated window is a miss", !hit);
+    check("the stale entry is dropped", predictor.cache.size() == 0);
+    check("the restatement is counted", predictor.cache.restatements() == 1);
+
+    predictor.predict("AAA", bars);
+    predictor.predict("AAA", bars);
+    check("the recomputed entry is reused", predictor.computed == 2 && predictor.cache.hits() == 1);
+}
+
+static void test_invalidate_after_failed_save() {
+    Predictor predictor;
+    auto bars = bar_window(50);
+    predictor.predict("AAA", bars);
+
+    // The engine drops the series when its prediction did not persist
+    predictor.cache.invalidate("AAA", TimeFrame::DAILY, 1);
+    Forecast forecast = predictor.predict("AAA", bars);
+    check("invalidate forces a recompute", predictor.computed == 2 && forecast.run == 2);
+    check("invalidate is not a restatement", predictor.cache.restatements() == 0);
+    check("no hits across the invalidation", predictor.cache.hits() == 0 && predictor.cache.hit_rate() == 0.0);
+
+    predictor.predict("AAA", bars);
+    check("hit rate: 1 of 3 lookups", predictor.cache.hit_rate() > 0.3 && predictor.cache.hit_rate() < 0.34);
+}
+
+int main() {
+    std::cout << "=== PREDICTION CACHE TEST ===" << std::endl;
+
+    test_unchanged_window();
+    test_new_bar();
+    test_restatement();
+    test_invalidate_after_failed_save();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Prediction cache test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Prediction cache reuses unchanged windows and drops restated ones" << std::endl;
+    return 0;
+}
@@ -0,0 +1,174 @@
+#include "IQFeedConnection/RateLimiter.h"
+#include "IQFeedConnection/HistoricalDataFetcher.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+// ==============================================
+// RATE LIMITER TEST
+// ==============================================
+// Checks the shared IQFeed request limiter: the token bucket paces
+// requests, the concurrency cap holds across threads, error responses and
+// timeouts back the rate off multiplicatively (once per cooldown), clean
+// requests win it back additively, and waits past max_wait are rejected.
+// Also checks which lookup responses count as errors for that feedback.
+
+using Clock = std::chrono::steady_clock;
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static void test_pacing() {
+    RateLimiterConfig config;
+    config.max_rate = 100.0;
+    config.burst = 1.0;
+    config.additive_increase = 0.0;
+    RateLimiter limiter(config);
+
+    auto start = Clock::now();
+    for (int i = 0; i < 21; i++) {
+        limiter.acquire().success();
+    }
+    double elapsed_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    check("21 requests at 100/s take about 200 ms", elapsed_ms >= 180.0 && elapsed_ms < 400.0,
+          std::to_string(elapsed_ms) + " ms");
+}
+
+static void test_concurrency_cap() {
+    RateLimiterConfig config;
+    config.max_rate = 10000.0;
+    config.burst = 100.0;
+    config.max_concurrency = 3;
+    RateLimiter limiter(config);
+
+    std::atomic<int> running{ 0 };
+    std::atomic<int> peak{ 0 };
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.emplace_back([&] {
+            for (int i = 0; i < 10; i++) {
+                RateLimiter::Permit permit = limiter.acquire();
+                int now = ++running;
+                int seen = peak.load();
+                while (now > seen && !peak.compare_exchange_weak(seen, now)) {}
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                running--;
+                permit.success();
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    check("never more than 3 requests in flight", peak <= 3, "peak " + std::to_string(peak.load()));
+    check("all 80 requests acquired", limiter.stats().acquired == 80 && limiter.stats().in_flight == 0);
+}
+
+static void test_aimd() {
+    RateLimiterConfig config;
+    config.max_rate = 20.0;
+    config.burst = 100.0;
+    config.decrease_factor = 0.5;
+    config.decrease_cooldown = std::chrono::milliseconds(1000);
+    RateLimiter limiter(config);
+
+    limiter.acquire().error();
+    check("error response halves the rate", limiter.current_rate() == 10.0);
+
+    // A burst of failures within the cooldown is one backoff, not three
+    limiter.acquire().error();
+    limiter.acquire().timeout();
+    RateLimiterStats stats = limiter.stats();
+    check("failures inside the cooldown back off once", limiter.current_rate() == 10.0 && stats.decreases == 1);
+    check("errors and timeouts counted", stats.errors == 2 && stats.timeouts == 1);
+
+    // Without a cooldown every failure halves, down to the floor
+    RateLimiterConfig floor_config;
+    floor_config.max_rate = 200.0;
+    floor_config.min_rate = 25.0;
+    floor_config.burst = 100.0;
+    floor_config.additive_increase = 2.0;
+    floor_config.decrease_cooldown = std::chrono::milliseconds(0);
+    RateLimiter backoff(floor_config);
+
+    backoff.acquire().timeout();
+    check("timeout halves the rate", backoff.current_rate() == 100.0);
+    for (int i = 0; i < 3; i++) {
+        backoff.acquire().error();
+    }
+    check("rate floors at min_rate", backoff.current_rate() == 25.0);
+
+    // Clean requests add additive_increase / rate each: ~2 requests/s per second of traffic
+    double before = backoff.current_rate();
+    for (int i = 0; i < 10; i++) {
+        backoff.acquire().success();
+    }
+    double after = backoff.current_rate();
+    check("clean requests raise the rate additively", after > before + 0.7 && after < before + 0.9,
+          std::to_string(before) + " -> " + std::to_string(after));
+
+    // Unreported permits neither raise nor lower the rate
+    { RateLimiter::Permit permit = backoff.acquire(); }
+    check("unreported permit leaves the rate alone", backoff.current_rate() == after);
+}
+
+static void test_rejection() {
+    RateLimiterConfig config;
+    config.max_rate = 1.0;
+    config.burst = 1.0;
+    config.max_wait = std::chrono::milliseconds(50);
+    RateLimiter limiter(config);
+
+    RateLimiter::Permit first = limiter.acquire();
+    auto start = Clock::now();
+    RateLimiter::Permit second = limiter.acquire();
+    double waited_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    check("first request granted", static_cast<bool>(first));
+    check("second request rejected after max_wait", !second && waited_ms >= 45.0 && waited_ms < 500.0,
+          std::to_string(waited_ms) + " ms");
+    check("try_acquire rejects without waiting", !limiter.try_acquire());
+    check("rejections counted", limiter.stats().rejected == 2);
+}
+
+static void test_error_responses() {
+    std::string message;
+    check("request ID error line is an error",
+          HistoricalDataFetcher::is_error_response("HIST_QGC#_daily,E,Could not connect to History socket.,\r\n"
+                                                   "HIST_QGC#_daily,!ENDMSG!,\r\n", &message) &&
+          message == "Could not connect to History socket.", message);
+    check("bare error line is an error",
+          HistoricalDataFetcher::is_error_response("E,!NO_DATA!,\r\n!ENDMSG!,\r\n", &message) && message == "!NO_DATA!",
+          message);
+    check("data whose symbol ends in E is not an error",
+          !HistoricalDataFetcher::is_error_response("HIST_QCLE,LH,2025-01-06 09:30:00,71.2,70.9,71.0,71.1,150,0,\r\n"
+                                                    "HIST_QCLE,!ENDMSG!,\r\n"));
+    check("\"E,\" inside a later field is not an error",
+          !HistoricalDataFetcher::is_error_response("RANGE_ES_15min,LH,2025-01-06 09:30:00,E,\r\n"));
+    check("empty response is not a protocol error", !HistoricalDataFetcher::is_error_response(""));
+}
+
+int main() {
+    std::cout << "=== RATE LIMITER TEST ===" << std::endl;
+
+    test_pacing();
+    test_concurrency_cap();
+    test_aimd();
+    test_rejection();
+    test_error_responses();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Rate limiter test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ IQFeed request limiter paces, caps and adapts (AIMD)" << std::endl;
+    return 0;
+}
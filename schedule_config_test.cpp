@@ -0,0 +1,203 @@
+#include "IQFeedConnection/ScheduleConfig.h"
+#include <iostream>
+#include <sstream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+
+// ==============================================
+// SCHEDULE CONFIG TEST
+// ==============================================
+// Checks the hot-reloadable scheduler config: the key = value file format
+// (round trip, comments next to QGC#-style symbols, rejected files leave
+// the config alone), symbol diffs between snapshots, and the copy-on-write
+// store - readers on other threads only ever see whole configs while a
+// writer swaps in thousands-of-symbol universes, and an old snapshot stays
+// valid after it has been replaced.
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static bool parse(const std::string& text, ScheduleConfig& config, std::string& error) {
+    std::istringstream in(text);
+    return parse_schedule_config(in, config, error);
+}
+
+static void test_file_format() {
+    ScheduleConfig config;
+    std::string error;
+    bool ok = parse("# Futures universe\n"
+                    "symbols = QGC#, QCL#,QES#   # metals, energy, index\n"
+                    "daily_hour = 18\n"
+                    "trading_days = 1,2,3\n"
+                    "iqfeed_requests_per_second = 7.5\n"
+                    "symbols_from_db = yes\n"
+                    "\n", config, error);
+    check("file parses", ok, error);
+    check("'#' inside a symbol is kept, after a blank it comments",
+          config.symbols == std::vector<std::string>({ "QGC#", "QCL#", "QES#" }));
+    check("values applied", config.daily_hour == 18 && config.trading_days == std::vector<int>({ 1, 2, 3 }) &&
+                            config.iqfeed_requests_per_second == 7.5 && config.symbols_from_db);
+    check("keys left out keep their value", config.daily_minute == 0 && config.bars_15min == 100);
+
+    ScheduleConfig round_trip;
+    ok = parse(format_schedule_config(config), round_trip, error);
+    check("format and parse round trip", ok && same_schedule_config(config, round_trip), error);
+
+    ScheduleConfig untouched = config;
+    check("unknown key rejected", !parse("daily_hour = 20\nbars_5min = 10\n", untouched, error) &&
+                                  error.find("line 2") != std::string::npos, error);
+    check("bad value rejected", !parse("daily_hour = 25\n", untouched, error));
+    check("missing '=' rejected", !parse("symbols QGC#\n", untouched, error));
+    check("rejected file changes nothing", same_schedule_config(untouched, config));
+
+    const std::string path = "schedule_config_test.conf";
+    {
+        std::ofstream file(path);
+        file << "symbols = QNG#\nconfig_reload_seconds = 5\n";
+    }
+    ScheduleConfig from_file;
+    ok = load_schedule_config_file(path, from_file, error);
+    std::remove(path.c_str());
+    check("load from file", ok && from_file.symbols == std::vector<std::string>({ "QNG#" }) &&
+                            from_file.config_reload_seconds == 5, error);
+    check("missing file reported", !load_schedule_config_file(path, from_file, error) && !error.empty());
+}
+
+static void test_store_updates() {
+    ScheduleConfigStore store;
+    auto first = store.snapshot();
+
+    auto unchanged = store.update([](ScheduleConfig&) { return true; });
+    check("equal copy publishes nothing", !unchanged.changed() && store.version() == 0 && store.snapshot() == first);
+
+    auto declined = store.update([](ScheduleConfig& config) {
+        config.daily_hour = 3;
+        return false;
+    });
+    check("declined change publishes nothing", !declined.changed() && store.snapshot()->daily_hour == 19);
+
+    auto change = store.update([](ScheduleConfig& config) {
+        config.symbols = { "QCL#", "QES#" };
+        return true;
+    });
+    check("change publishes a new snapshot", change.changed() && store.version() == 1 && store.snapshot() != first);
+    check("added and removed symbols", change.added_symbols() == std::vector<std::string>({ "QCL#", "QES#" }) &&
+                                       change.removed_symbols() == std::vector<std::string>({ "QGC#" }));
+    check("old snapshot still intact", first->symbols == std::vector<std::string>({ "QGC#" }));
+
+    ScheduleConfig replacement;
+    replacement.daily_minute = 30;
+    store.replace(replacement);
+    check("replace", store.snapshot()->daily_minute == 30 && store.snapshot()->symbols.size() == 1);
+}
+
+// Every published config is self-consistent: symbols.size() == bars_15min
+// and every symbol carries the same generation tag as daily_minute. A
+// reader that saw half of one config and half of another would notice.
+static ScheduleConfig generation(int tag, int symbols) {
+    ScheduleConfig config;
+    config.daily_minute = tag % 60;
+    config.bars_15min = symbols;
+    config.symbols.clear();
+    for (int i = 0; i < symbols; i++) {
+        config.symbols.push_back("S" + std::to_string(i) + "@" + std::to_string(tag % 60));
+    }
+    return config;
+}
+
+static void test_concurrent_readers() {
+    ScheduleConfigStore store(generation(0, 2000));
+    std::atomic<bool> done{ false };
+    std::atomic<long long> reads{ 0 };
+    std::atomic<long long> torn{ 0 };
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 4; r++) {
+        readers.emplace_back([&] {
+            while (!done) {
+                auto config = store.snapshot();
+                std::string tag = "@" + std::to_string(config->daily_minute);
+                bool whole = static_cast<int>(config->symbols.size()) == config->bars_15min;
+                for (std::size_t i = 0; whole && i < config->symbols.size(); i += 97) {
+                    const std::string& symbol = config->symbols[i];
+                    whole = symbol.compare(symbol.size() - tag.size(), tag.size(), tag) == 0;
+                }
+                if (!whole) torn++;
+                reads++;
+            }
+        });
+    }
+
+    // Long-running "job" keeps the snapshot it started with across every swap
+    auto held = store.snapshot();
+
+    const int swaps = 200;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 1; i <= swaps; i++) {
+        ScheduleConfig next = generation(i, 1000 + (i * 37) % 3000);
+        store.replace(next);
+    }
+    double swap_us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count() /
+                     swaps;
+    done = true;
+    for (auto& reader : readers) reader.join();
+
+    std::cout << "   " << swaps << " swaps of 1000-4000 symbol configs: " << swap_us << " us each, "
+              << reads.load() << " concurrent reads" << std::endl;
+    check("readers never saw a torn config", torn == 0, std::to_string(torn.load()) + " torn");
+    check("every swap published", store.version() == static_cast<std::uint64_t>(swaps));
+    check("held snapshot unchanged by later swaps", held->bars_15min == 2000 && held->symbols.size() == 2000 &&
+                                                    held->symbols.back() == "S1999@0");
+}
+
+static void test_concurrent_writers() {
+    ScheduleConfigStore store;
+    const int writers = 4;
+    const int per_writer = 250;
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; w++) {
+        threads.emplace_back([&, w] {
+            for (int i = 0; i < per_writer; i++) {
+                std::string symbol = "W" + std::to_string(w) + "-" + std::to_string(i);
+                store.update([&symbol](ScheduleConfig& config) {
+                    config.symbols.push_back(symbol);
+                    return true;
+                });
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    check("no update lost between concurrent writers",
+          store.snapshot()->symbols.size() == 1 + writers * per_writer,
+          std::to_string(store.snapshot()->symbols.size()));
+}
+
+int main() {
+    std::cout << "=== SCHEDULE CONFIG TEST ===" << std::endl;
+
+    test_file_format();
+    test_store_updates();
+    test_concurrent_readers();
+    test_concurrent_writers();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Schedule config test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Schedule config reloads as whole copy-on-write snapshots" << std::endl;
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include "IQFeedConnection/SchedulerJournal.h"
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <thread>
+
+// ==============================================
+// SCHEDULER JOURNAL TEST
+// ==============================================
+// Checks the crash-safe scheduler state journal: saves survive a reopen,
+// entries only move forward, a record torn by a crash (or garbled on disk)
+// is dropped without losing the ones before it, compaction folds the
+// journal into the snapshot, and a crash between snapshot rename and
+// journal truncation replays to the same state.
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static const std::string kDirectory = "scheduler_journal_test_state";
+
+static void reset_directory() {
+    std::error_code ec;
+    std::filesystem::remove_all(kDirectory, ec);
+}
+
+static void append_raw(const std::string& file, const std::string& text) {
+    std::ofstream out(kDirectory + "/" + file, std::ios::binary | std::ios::app);
+    out << text;
+}
+
+static std::string last_bar(const SchedulerJournal& journal, const std::string& symbol, const std::string& timeframe) {
+    JournalEntry entry;
+    return journal.lookup(symbol, timeframe, entry) ? entry.last_bar : "<none>";
+}
+
+static void test_record_format() {
+    JournalEntry entry;
+    entry.symbol = "QGC#";
+    entry.timeframe = "15min";
+    entry.last_bar = "2025-01-08 10:45:00";
+    entry.last_fetch = 1736351160;
+
+    std::string line = SchedulerJournal::encode(entry);
+    JournalEntry decoded;
+    bool ok = SchedulerJournal::decode(line.substr(0, line.size() - 1), decoded);
+    check("record round trip", ok && decoded.symbol == entry.symbol && decoded.timeframe == entry.timeframe &&
+                               decoded.last_bar == entry.last_bar && decoded.last_fetch == entry.last_fetch);
+
+    std::string garbled = line.substr(0, line.size() - 1);
+    garbled[12] = garbled[12] == '1' ? '2' : '1';
+    check("flipped byte fails the checksum", !SchedulerJournal::decode(garbled, decoded));
+    check("truncated record rejected", !SchedulerJournal::decode(line.substr(0, line.size() / 2), decoded));
+}
+
+static void test_replay() {
+    reset_directory();
+    {
+        SchedulerJournal journal(kDirectory);
+        check("journal opens on an empty directory", journal.open() && journal.size() == 0);
+        journal.record("QGC#", "15min", "2025-01-08 10:30:00");
+        journal.record("QGC#", "15min", "2025-01-08 10:45:00");
+        journal.record("QGC#", "daily", "2025-01-07");
+        journal.record("QCL#", "1hour", "2025-01-08 09:00:00");
+        // A backfill of an older gap must not rewind the entry
+        journal.record("QGC#", "15min", "2025-01-06 03:00:00");
+        check("five appends pending compaction", journal.journal_records() == 5);
+    }   // No compaction on the way out: state lives only in the journal file
+
+    SchedulerJournal reopened(kDirectory);
+    check("journal reopens", reopened.open());
+    check("three series recovered", reopened.size() == 3, std::to_string(reopened.size()));
+    check("newest 15min bar kept", last_bar(reopened, "QGC#", "15min") == "2025-01-08 10:45:00",
+          last_bar(reopened, "QGC#", "15min"));
+    check("daily bar recovered", last_bar(reopened, "QGC#", "daily") == "2025-01-07");
+    check("other symbol recovered", last_bar(reopened, "QCL#", "1hour") == "2025-01-08 09:00:00");
+    check("reopen folds the journal into the snapshot", reopened.journal_records() == 0 &&
+                                                        reopened.discarded_records() == 0);
+}
+
+static void test_torn_tail() {
+    reset_directory();
+    {
+        SchedulerJournal journal(kDirectory);
+        journal.open();
+        journal.record("QGC#", "30min", "2025-01-08 10:00:00");
+        journal.record("QGC#", "30min", "2025-01-08 10:30:00");
+    }
+
+    // A crash mid-write leaves half a record with no newline
+    JournalEntry torn;
+    torn.symbol = "QGC#";
+    torn.timeframe = "30min";
+    torn.last_bar = "2025-01-08 11:00:00";
+    std::string line = SchedulerJournal::encode(torn);
+    append_raw("fetch_scheduler.journal", line.substr(0, line.size() / 2));
+
+    SchedulerJournal journal(kDirectory);
+    check("journal with a torn tail still opens", journal.open());
+    check("torn record dropped, earlier ones kept", last_bar(journal, "QGC#", "30min") == "2025-01-08 10:30:00",
+          last_bar(journal, "QGC#", "30min"));
+    check("torn record counted", journal.discarded_records() == 1);
+
+    // Appends after recovery start on a clean line
+    journal.record("QGC#", "30min", "2025-01-08 11:00:00");
+    journal.close();
+    SchedulerJournal again(kDirectory);
+    again.open();
+    check("append after a torn tail replays cleanly", last_bar(again, "QGC#", "30min") == "2025-01-08 11:00:00" &&
+                                                      again.discarded_records() == 0);
+}
+
+static void test_corrupt_middle() {
+    reset_directory();
+    {
+        SchedulerJournal journal(kDirectory);
+        journal.open();
+    }
+
+    JournalEntry good;
+    good.symbol = "QES#";
+    good.timeframe = "2hours";
+    good.last_bar = "2025-01-08 08:00:00";
+    std::string bad = SchedulerJournal::encode(good);
+    bad[0] = 'X';
+    good.last_bar = "2025-01-08 10:00:00";
+    append_raw("fetch_scheduler.journal", bad + SchedulerJournal::encode(good));
+
+    SchedulerJournal journal(kDirectory);
+    journal.open();
+    check("corrupt record skipped, the next one applied",
+          last_bar(journal, "QES#", "2hours") == "2025-01-08 10:00:00" && journal.discarded_records() == 1 &&
+          journal.size() == 1);
+}
+
+static void test_compaction() {
+    reset_directory();
+    SchedulerJournal journal(kDirectory, 10);
+    journal.open();
+
+    for (int i = 0; i < 25; i++) {
+        char stamp[32];
+        std::snprintf(stamp, sizeof(stamp), "2025-01-08 %02d:%02d:00", 6 + i / 4, (i % 4) * 15);
+        journal.record("QGC#", "15min", stamp);
+    }
+    check("journal compacted every 10 records", journal.journal_records() == 5,
+          std::to_string(journal.journal_records()));
+
+    auto journal_size = std::filesystem::file_size(kDirectory + "/fetch_scheduler.journal");
+    check("journal file holds only records since the snapshot", journal_size > 0 && journal_size < 5 * 80,
+          std::to_string(journal_size) + " bytes");
+
+    journal.close();
+    SchedulerJournal reopened(kDirectory);
+    reopened.open();
+    check("snapshot plus journal replay to the newest bar", last_bar(reopened, "QGC#", "15min") == "2025-01-08 12:00:00",
+          last_bar(reopened, "QGC#", "15min"));
+}
+
+// Crash after the snapshot rename but before the journal was truncated:
+// the journal's records are already in the snapshot and replay again
+static void test_crash_during_compaction() {
+    reset_directory();
+    std::string journal_copy;
+    {
+        SchedulerJournal journal(kDirectory);
+        journal.open();
+        journal.record("QGC#", "1hour", "2025-01-08 09:00:00");
+        journal.record("QCL#", "1hour", "2025-01-08 10:00:00");
+
+        std::ifstream in(kDirectory + "/fetch_scheduler.journal", std::ios::binary);
+        journal_copy.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        journal.compact();
+    }
+    append_raw("fetch_scheduler.journal", journal_copy);
+
+    SchedulerJournal journal(kDirectory);
+    journal.open();
+    check("double-applied journal gives the same state",
+          journal.size() == 2 && last_bar(journal, "QGC#", "1hour") == "2025-01-08 09:00:00" &&
+          last_bar(journal, "QCL#", "1hour") == "2025-01-08 10:00:00");
+}
+
+static void test_concurrent_records() {
+    reset_directory();
+    SchedulerJournal journal(kDirectory, 64);
+    journal.open();
+
+    const std::vector<std::string> symbols = { "QGC#", "QCL#", "QES#", "QNQ#" };
+    std::vector<std::thread> workers;
+    for (const auto& symbol : symbols) {
+        workers.emplace_back([&journal, symbol] {
+            for (int i = 0; i < 50; i++) {
+                char stamp[32];
+                std::snprintf(stamp, sizeof(stamp), "2025-01-08 %02d:%02d:00", i / 4, (i % 4) * 15);
+                journal.record(symbol, "15min", stamp);
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    journal.close();
+
+    SchedulerJournal reopened(kDirectory);
+    reopened.open();
+    bool all = reopened.size() == symbols.size() && reopened.discarded_records() == 0;
+    for (const auto& symbol : symbols) {
+        all = all && last_bar(reopened, symbol, "15min") == "2025-01-08 12:15:00";
+    }
+    check("records from concurrent workers all land intact", all);
+}
+
+int main() {
+    std::cout << "=== SCHEDULER JOURNAL TEST ===" << std::endl;
+
+    test_record_format();
+    test_replay();
+    test_torn_tail();
+    test_corrupt_middle();
+    test_compaction();
+    test_crash_during_compaction();
+    test_concurrent_records();
+    reset_directory();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Scheduler journal test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Scheduler state survives restarts and torn writes" << std::endl;
+    return 0;
+}
@@ -0,0 +1,219 @@
+#include "Database/database_simple.h"
+#include "IQFeedConnection/ShardCoordinator.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <set>
+#include <memory>
+#include <thread>
+#include <chrono>
+
+// ==============================================
+// SHARD COORDINATOR TEST
+// ==============================================
+// Checks the consistent hash ring (every shard has one owner, load is
+// spread, a join or leave only moves the shards next to that member) and,
+// when the database is reachable, runs three coordinators on three
+// connections - to PostgreSQL, three scheduler processes - through a join,
+// a clean leave and a crash: shards always end up covered exactly once,
+// one member leads, and a shard never has two lock holders.
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static std::map<std::string, std::string> assign(const ConsistentHashRing& ring, int keys) {
+    std::map<std::string, std::string> owners;
+    for (int i = 0; i < keys; i++) {
+        std::string key = "shard:" + std::to_string(i);
+        owners[key] = ring.owner_of(key);
+    }
+    return owners;
+}
+
+static void test_ring() {
+    ConsistentHashRing empty;
+    check("empty ring owns nothing", empty.owner_of("QGC#").empty());
+
+    ConsistentHashRing ring(64);
+    ring.set_members({ "nexday-b:2", "nexday-a:1", "nexday-c:3", "nexday-d:4", "nexday-a:1" });
+    check("members sorted and deduplicated", ring.members().size() == 4 && ring.members()[0] == "nexday-a:1");
+
+    ConsistentHashRing reordered(64);
+    reordered.set_members({ "nexday-d:4", "nexday-c:3", "nexday-b:2", "nexday-a:1" });
+    const int keys = 4096;
+    auto before = assign(ring, keys);
+    check("same members give the same assignment in any order", before == assign(reordered, keys));
+
+    std::map<std::string, int> load;
+    for (const auto& pair : before) load[pair.second]++;
+    int fair = keys / 4;
+    bool balanced = load.size() == 4;
+    for (const auto& pair : load) {
+        balanced = balanced && pair.second > fair / 2 && pair.second < fair * 3 / 2;
+    }
+    check("load within half of fair share", balanced);
+
+    // A fifth member only takes shards; none move between the old four
+    ConsistentHashRing grown(64);
+    grown.set_members({ "nexday-a:1", "nexday-b:2", "nexday-c:3", "nexday-d:4", "nexday-e:5" });
+    auto after_join = assign(grown, keys);
+    int moved = 0;
+    bool only_to_new = true;
+    for (const auto& pair : before) {
+        if (after_join[pair.first] != pair.second) {
+            moved++;
+            only_to_new = only_to_new && after_join[pair.first] == "nexday-e:5";
+        }
+    }
+    check("join moves shards only to the new member", only_to_new);
+    check("join moves about 1/5 of the shards", moved > keys / 10 && moved < keys * 3 / 10,
+          std::to_string(moved) + " of " + std::to_string(keys));
+
+    // Removing a member only moves that member's shards
+    ConsistentHashRing shrunk(64);
+    shrunk.set_members({ "nexday-a:1", "nexday-c:3", "nexday-d:4" });
+    bool only_from_leaver = true;
+    for (const auto& pair : assign(shrunk, keys)) {
+        if (pair.second != before[pair.first]) {
+            only_from_leaver = only_from_leaver && before[pair.first] == "nexday-b:2";
+        }
+    }
+    check("leave moves only the leaver's shards", only_from_leaver);
+}
+
+// ==============================================
+// COORDINATORS AGAINST POSTGRESQL
+// ==============================================
+
+struct Member {
+    std::shared_ptr<SimpleDatabaseManager> db;
+    std::unique_ptr<ShardCoordinator> coordinator;
+};
+
+static Member start_member(const DatabaseConfig& db_config, const ShardConfig& base, const std::string& id) {
+    ShardConfig config = base;
+    config.member_id = id;
+    Member member;
+    member.db = std::make_shared<SimpleDatabaseManager>(db_config);
+    member.coordinator = std::make_unique<ShardCoordinator>(member.db, config);
+    return member;
+}
+
+static void heartbeat_rounds(std::vector<Member*> members, int rounds) {
+    for (int round = 0; round < rounds; round++) {
+        for (auto* member : members) member->coordinator->heartbeat();
+    }
+}
+
+// Every shard held by exactly one member
+static bool covered_once(const std::vector<Member*>& members, int shard_count, std::string& detail) {
+    std::vector<int> holders(shard_count, 0);
+    for (auto* member : members) {
+        for (int shard : member->coordinator->owned_shards()) holders[shard]++;
+    }
+    for (int shard = 0; shard < shard_count; shard++) {
+        if (holders[shard] != 1) {
+            detail = "shard " + std::to_string(shard) + " held " + std::to_string(holders[shard]) + " times";
+            return false;
+        }
+    }
+    return true;
+}
+
+static int leaders(const std::vector<Member*>& members) {
+    int count = 0;
+    for (auto* member : members) count += member->coordinator->is_leader() ? 1 : 0;
+    return count;
+}
+
+static void test_cluster(const DatabaseConfig& db_config, SimpleDatabaseManager& admin) {
+    admin.execute_query("CREATE TABLE IF NOT EXISTS scheduler_members ("
+                        "cluster VARCHAR(64) NOT NULL, member_id VARCHAR(128) NOT NULL, backend_pid INTEGER, "
+                        "started_at TIMESTAMP WITH TIME ZONE NOT NULL DEFAULT now(), "
+                        "heartbeat_at TIMESTAMP WITH TIME ZONE NOT NULL DEFAULT now(), "
+                        "PRIMARY KEY (cluster, member_id))");
+
+    ShardConfig config;
+    config.cluster = "shard_test_" + ShardCoordinator::default_member_id();
+    config.shard_count = 32;
+    config.member_timeout_seconds = 2;
+    admin.execute_query("DELETE FROM scheduler_members WHERE cluster = '" + admin.escape_string(config.cluster) + "'");
+
+    Member a = start_member(db_config, config, "member-a");
+    Member b = start_member(db_config, config, "member-b");
+    Member c = start_member(db_config, config, "member-c");
+
+    // A alone owns everything; B and C find their shards still locked by A
+    ShardAssignment first;
+    a.coordinator->heartbeat(&first);
+    check("first member takes every shard", first.gained.size() == 32 && a.coordinator->is_leader());
+    ShardAssignment joining;
+    b.coordinator->heartbeat(&joining);
+    check("joiner waits for the previous owner", joining.gained.empty() && !joining.pending.empty());
+
+    std::string detail;
+    heartbeat_rounds({ &a, &b, &c }, 3);
+    check("three members cover every shard once", covered_once({ &a, &b, &c }, 32, detail), detail);
+    check("exactly one leader", leaders({ &a, &b, &c }) == 1);
+    check("each member owns some shards", !a.coordinator->owned_shards().empty() &&
+                                          !b.coordinator->owned_shards().empty() &&
+                                          !c.coordinator->owned_shards().empty());
+
+    std::vector<std::string> universe;
+    for (int i = 0; i < 500; i++) universe.push_back("SYM" + std::to_string(i));
+    std::size_t owned_total = a.coordinator->owned(universe).size() + b.coordinator->owned(universe).size() +
+                              c.coordinator->owned(universe).size();
+    check("symbol universe partitioned", owned_total == universe.size(), std::to_string(owned_total));
+
+    // Clean leave: the others rebalance on their next heartbeat
+    c.coordinator->leave();
+    heartbeat_rounds({ &a, &b }, 2);
+    check("after a leave two members cover every shard", covered_once({ &a, &b }, 32, detail), detail);
+
+    // Crash: B's session ends without leave(); its locks go with it, its row expires
+    b.db->disconnect_from_database();          // Session gone first, so the destructor cannot leave()
+    b.coordinator.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(2500));
+    heartbeat_rounds({ &a }, 2);
+    check("survivor takes over a crashed member's shards", a.coordinator->owned_shards().size() == 32,
+          std::to_string(a.coordinator->owned_shards().size()));
+    check("crashed member expired from the ring", a.coordinator->members() == std::vector<std::string>({ "member-a" }));
+
+    a.coordinator->leave();
+    admin.execute_query("DELETE FROM scheduler_members WHERE cluster = '" + admin.escape_string(config.cluster) + "'");
+}
+
+int main() {
+    std::cout << "=== SHARD COORDINATOR TEST ===" << std::endl;
+
+    test_ring();
+
+    DatabaseConfig config;
+    config.host = "localhost";
+    config.port = 5432;
+    config.database = "nexday_trading";
+    config.username = "postgres";
+    config.password = "magical.521";
+
+    SimpleDatabaseManager db(config);
+    if (db.is_connected()) {
+        test_cluster(config, db);
+    } else {
+        std::cout << "➖ Database not available - advisory lock cluster checks skipped" << std::endl;
+    }
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Shard coordinator test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Shards split by consistent hashing and owned through advisory locks" << std::endl;
+    return 0;
+}
@@ -0,0 +1,176 @@
+#include "IQFeedConnection/TimerQueue.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <mutex>
+
+// ==============================================
+// TIMER QUEUE TEST
+// ==============================================
+// Checks that TimerQueue runs jobs in deadline order close to their
+// deadlines, repeats recurring jobs, and that stop() and reschedule() wake a
+// loop that is sleeping on a deadline an hour away. A reschedule() from
+// inside a slow action must not drop a deadline that came due meanwhile.
+
+using Clock = TimerQueue::Clock;
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static long long elapsed_ms(Clock::time_point since) {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - since).count();
+}
+
+// A job that fires once at start + offset and then never again
+static TimerQueue::NextDeadline once_at(Clock::time_point deadline) {
+    return [deadline](Clock::time_point after) {
+        return after < deadline ? deadline : after + std::chrono::hours(24);
+    };
+}
+
+static void test_deadline_order() {
+    MetricsRegistry registry;   // Fresh drift histograms
+    TimerQueue queue(registry);
+    std::vector<std::string> fired;
+    std::mutex fired_mutex;
+    auto start = Clock::now();
+
+    for (int offset_ms : { 60, 20, 40 }) {
+        std::string name = "job" + std::to_string(offset_ms);
+        queue.add_job(name, once_at(start + std::chrono::milliseconds(offset_ms)), [&, name](Clock::time_point) {
+            std::lock_guard<std::mutex> lock(fired_mutex);
+            fired.push_back(name);
+        });
+    }
+
+    std::thread runner([&] { queue.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(150));
+    queue.stop();
+    runner.join();
+
+    check("jobs run in deadline order", fired == std::vector<std::string>({ "job20", "job40", "job60" }),
+          std::to_string(fired.size()) + " fired");
+
+    for (int job_id = 0; job_id < 3; job_id++) {
+        const Histogram* drift = queue.drift(job_id);
+        HistogramSnapshot samples = drift ? drift->snapshot() : HistogramSnapshot();
+        check("job " + std::to_string(job_id) + " started within 50 ms of its deadline",
+              drift && samples.count == 1 && samples.sum < 0.050,
+              drift ? std::to_string(samples.sum * 1000.0) + " ms" : "no histogram");
+    }
+}
+
+static void test_recurring() {
+    TimerQueue queue;
+    std::atomic<int> runs{ 0 };
+    std::vector<std::string> drift_reports;
+
+    queue.set_drift_handler([&](const std::string& job, Clock::duration) { drift_reports.push_back(job); });
+    queue.add_job("every10ms",
+        [](Clock::time_point after) { return after + std::chrono::milliseconds(10); },
+        [&](Clock::time_point) { runs++; });
+
+    std::thread runner([&] { queue.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    queue.stop();
+    runner.join();
+
+    check("recurring job repeats", runs >= 5, std::to_string(runs.load()) + " runs");
+    check("drift handler sees every run", static_cast<int>(drift_reports.size()) == runs.load());
+}
+
+static void test_stop_wakes_immediately() {
+    TimerQueue queue;
+    queue.add_job("hourly", [](Clock::time_point after) { return after + std::chrono::hours(1); },
+                  [](Clock::time_point) {});
+
+    std::thread runner([&] { queue.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto stop_requested = Clock::now();
+    queue.stop();
+    runner.join();
+
+    long long waited = elapsed_ms(stop_requested);
+    check("stop() wakes a sleeping loop at once", waited < 100, std::to_string(waited) + " ms");
+}
+
+static void test_reschedule() {
+    TimerQueue queue;
+    std::atomic<bool> soon{ false };
+    std::atomic<bool> ran{ false };
+
+    queue.add_job("configurable",
+        [&](Clock::time_point after) {
+            return after + (soon ? std::chrono::milliseconds(10) : std::chrono::milliseconds(3600 * 1000));
+        },
+        [&](Clock::time_point) { ran = true; });
+
+    std::thread runner([&] { queue.run(); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto changed = Clock::now();
+    soon = true;
+    queue.reschedule();
+    while (!ran && elapsed_ms(changed) < 1000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    long long waited = elapsed_ms(changed);
+
+    queue.stop();
+    runner.join();
+
+    check("reschedule() picks up an earlier deadline", ran && waited < 100, std::to_string(waited) + " ms");
+}
+
+// Like a config reload job: its action calls reschedule() after another
+// job's deadline has passed, and that deadline must still run
+static void test_reschedule_during_action() {
+    TimerQueue queue;
+    auto start = Clock::now();
+    std::atomic<bool> overtaken_ran{ false };
+
+    queue.add_job("slow reload", once_at(start + std::chrono::milliseconds(10)),
+        [&](Clock::time_point) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+            queue.reschedule();
+        });
+    queue.add_job("due meanwhile", once_at(start + std::chrono::milliseconds(30)),
+        [&](Clock::time_point) { overtaken_ran = true; });
+
+    std::thread runner([&] { queue.run(); });
+    while (!overtaken_ran && elapsed_ms(start) < 1000) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    queue.stop();
+    runner.join();
+
+    check("a deadline that came due during the rescheduling action still runs", overtaken_ran.load());
+}
+
+int main() {
+    std::cout << "=== TIMER QUEUE TEST ===" << std::endl;
+
+    test_deadline_order();
+    test_recurring();
+    test_stop_wakes_immediately();
+    test_reschedule();
+    test_reschedule_during_action();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Timer queue test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Timer queue runs jobs on their deadlines and wakes on stop/reschedule" << std::endl;
+    return 0;
+}
@@ -0,0 +1,261 @@
+#include "IQFeedConnection/Tracer.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <set>
+#include <thread>
+#include <chrono>
+#include <cstdio>
+
+// ==============================================
+// TRACER TEST
+// ==============================================
+// Checks spans are only recorded while tracing is on, nested spans nest in
+// time and keep their symbol/timeframe tags, concurrent threads each get
+// their own buffer and none of their spans are lost, a full buffer keeps
+// its newest spans and exports them oldest first, and the Chrome trace JSON
+// is well formed (balanced, escaped, one "X" event per span). Also times a
+// span with tracing off and on, the cost added to every traced stage.
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static bool contains(const std::string& text, const std::string& part) {
+    return text.find(part) != std::string::npos;
+}
+
+static std::size_t occurrences(const std::string& text, const std::string& part) {
+    std::size_t count = 0;
+    for (std::size_t at = text.find(part); at != std::string::npos; at = text.find(part, at + 1)) count++;
+    return count;
+}
+
+// Brackets balance outside strings and every string is closed
+static bool balanced_json(const std::string& text) {
+    int depth = 0;
+    bool in_string = false;
+    for (std::size_t i = 0; i < text.size(); i++) {
+        char c = text[i];
+        if (in_string) {
+            if (c == '\\') i++;
+            else if (c == '"') in_string = false;
+            else if (static_cast<unsigned char>(c) < 0x20) return false;
+            continue;
+        }
+        if (c == '"') in_string = true;
+        else if (c == '{' || c == '[') depth++;
+        else if (c == '}' || c == ']') {
+            if (--depth < 0) return false;
+        }
+    }
+    return depth == 0 && !in_string;
+}
+
+static const TraceEvent* find_event(const std::vector<TraceEvent>& events, const std::string& name) {
+    for (const auto& event : events) {
+        if (name == event.name) return &event;
+    }
+    return nullptr;
+}
+
+static void test_disabled_records_nothing() {
+    Tracer::set_enabled(false);
+    Tracer::instance().clear();
+    {
+        NEXDAY_TRACE_SPAN("iqfeed", "parse", std::string("QGC#"), std::string("15min"));
+    }
+    check("no spans while tracing is off", Tracer::instance().stats().events == 0);
+}
+
+static void test_nested_spans() {
+    Tracer& tracer = Tracer::instance();
+    tracer.clear();
+    Tracer::set_enabled(true);
+    {
+        NEXDAY_TRACE_SPAN("scheduler", "fetch", std::string("QGC#"), std::string("15min"));
+        {
+            NEXDAY_TRACE_SPAN("iqfeed", "read", std::string("QGC#"), std::string("15min"));
+            std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        }
+        TraceSpan parse("iqfeed", "parse", "QGC#", "15min");
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        parse.end();
+        parse.end();                                // Second end() records nothing
+    }
+    Tracer::set_enabled(false);
+
+    std::vector<TraceEvent> events = tracer.events();
+    const TraceEvent* fetch = find_event(events, "fetch");
+    const TraceEvent* read = find_event(events, "read");
+    const TraceEvent* parse = find_event(events, "parse");
+    check("three spans recorded", events.size() == 3 && fetch && read && parse, std::to_string(events.size()));
+    if (!fetch || !read || !parse) return;
+
+    check("children inside the parent",
+          read->start_ns >= fetch->start_ns && parse->start_ns + parse->duration_ns <= fetch->start_ns + fetch->duration_ns);
+    check("children in order", read->start_ns + read->duration_ns <= parse->start_ns);
+    check("durations measured", read->duration_ns >= 2000000 && parse->duration_ns >= 1000000);
+    check("tags kept", fetch->symbol == "QGC#" && fetch->timeframe == "15min" && std::string(read->category) == "iqfeed");
+}
+
+static void test_concurrent_threads() {
+    Tracer& tracer = Tracer::instance();
+    tracer.clear();
+    Tracer::set_enabled(true);
+
+    const int threads = 8;
+    const int per_thread = 20000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; t++) {
+        workers.emplace_back([t]() {
+            Tracer::instance().set_thread_name("worker " + std::to_string(t));
+            const std::string symbol = "SYM" + std::to_string(t);
+            for (int i = 0; i < per_thread; i++) {
+                NEXDAY_TRACE_SPAN("db", "query_insert", symbol, std::string("1hour"));
+            }
+        });
+    }
+    for (auto& worker : workers) worker.join();
+    Tracer::set_enabled(false);
+
+    TracerStats stats = tracer.stats();
+    check("every span from every thread kept", stats.events == static_cast<std::size_t>(threads) * per_thread &&
+                                                stats.overwritten == 0, std::to_string(stats.events));
+
+    std::string json = tracer.chrome_trace_json();
+    std::set<std::string> tids;
+    for (std::size_t at = json.find("\"tid\":"); at != std::string::npos; at = json.find("\"tid\":", at + 1)) {
+        tids.insert(json.substr(at + 6, json.find_first_of(",}", at) - at - 6));
+    }
+    check("one trace thread per worker", tids.size() >= static_cast<std::size_t>(threads));
+    check("thread names exported", contains(json, "\"args\":{\"name\":\"worker 7\"}"));
+    check("buffers outlive their threads", occurrences(json, "\"args\":{\"symbol\":\"SYM3\"") ==
+                                          static_cast<std::size_t>(per_thread));
+}
+
+static void test_ring_keeps_newest() {
+    Tracer& tracer = Tracer::instance();
+    tracer.clear();
+    tracer.set_per_thread_capacity(4);
+    Tracer::set_enabled(true);
+
+    std::thread worker([]() {
+        const char* names[] = { "s0", "s1", "s2", "s3", "s4", "s5" };
+        for (const char* name : names) {
+            NEXDAY_TRACE_SPAN("test", name);
+        }
+    });
+    worker.join();
+    Tracer::set_enabled(false);
+    tracer.set_per_thread_capacity(65536);
+
+    TracerStats stats = tracer.stats();
+    check("full buffer overwrites", stats.events == 4 && stats.overwritten == 2);
+
+    std::string json = tracer.chrome_trace_json();
+    std::size_t s2 = json.find("\"name\":\"s2\"");
+    std::size_t s5 = json.find("\"name\":\"s5\"");
+    check("newest spans kept, oldest first", !contains(json, "\"name\":\"s1\"") && s2 != std::string::npos &&
+                                             s5 != std::string::npos && s2 < s5);
+}
+
+static std::string read_file(const std::string& path) {
+    std::ifstream in(path);
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
+
+static void test_chrome_export() {
+    Tracer& tracer = Tracer::instance();
+    tracer.clear();
+    Tracer::set_enabled(true);
+    {
+        NEXDAY_TRACE_SPAN("pipeline", "persist", std::string("Q\"GC\\#\n"), std::string("daily"));
+    }
+    {
+        NEXDAY_TRACE_SPAN("db", "query_select");
+    }
+    Tracer::set_enabled(false);
+
+    std::string json = tracer.chrome_trace_json();
+    const std::string opening = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    check("trace-event object", json.compare(0, opening.size(), opening) == 0);
+    check("well formed", balanced_json(json));
+    check("complete events", occurrences(json, "\"ph\":\"X\"") == 2);
+    check("tags as args, escaped",
+          contains(json, "\"cat\":\"pipeline\"") &&
+          contains(json, "\"args\":{\"symbol\":\"Q\\\"GC\\\\#\\n\",\"timeframe\":\"daily\"}"));
+    std::size_t untagged = json.find("\"name\":\"query_select\"");
+    check("untagged span has no args", untagged != std::string::npos &&
+                                       !contains(json.substr(untagged, json.find('}', untagged) - untagged), "args"));
+
+    const std::string path = "tracer_test_out/trace.json";
+    std::string error;
+    bool written = tracer.write_chrome_trace(path, error);
+    check("file written", written && read_file(path) == json, error);
+    check("no temporary left behind", !std::ifstream(path + ".tmp").good());
+    std::remove(path.c_str());
+    std::remove("tracer_test_out");
+}
+
+static void test_span_cost() {
+    Tracer& tracer = Tracer::instance();
+    const std::string symbol = "QGC#";
+    const std::string timeframe = "15min";
+    const int iterations = 1000000;
+
+    Tracer::set_enabled(false);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        NEXDAY_TRACE_SPAN("iqfeed", "parse", symbol, timeframe);
+    }
+    double off_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                    iterations;
+
+    tracer.clear();
+    Tracer::set_enabled(true);
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        NEXDAY_TRACE_SPAN("iqfeed", "parse", symbol, timeframe);
+    }
+    double on_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                   iterations;
+    Tracer::set_enabled(false);
+
+    std::cout << "   span with tracing off " << off_ns << " ns, on " << on_ns << " ns" << std::endl;
+    check("disabled span far cheaper than a recorded one", off_ns < on_ns);
+    tracer.clear();
+}
+
+int main() {
+    std::cout << "=== TRACER TEST ===" << std::endl;
+
+#if !NEXDAY_TRACING
+    std::cout << "⚠️  Built with NEXDAY_TRACING=0: spans are compiled out, nothing to check" << std::endl;
+    return 0;
+#endif
+
+    test_disabled_records_nothing();
+    test_nested_spans();
+    test_concurrent_threads();
+    test_ring_keeps_newest();
+    test_chrome_export();
+    test_span_cost();
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Tracer test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Spans recorded per thread and exported as Chrome trace JSON" << std::endl;
+    return 0;
+}
@@ -0,0 +1,211 @@
+#include "Predictions/TradingCalendar.h"
+#include "Predictions/BusinessDayCalculator.h"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+
+// ==============================================
+// TRADING CALENDAR TEST
+// ==============================================
+// Checks the shared trading calendar against known exchange holidays
+// (observed-date rules, Good Friday, Juneteenth from 2022), next/previous
+// session across holiday weekends, O(1) session counts against a
+// day-by-day count, early closes, overnight trade dates, the session the
+// evening fetches look back at before a holiday, the overrides file, and
+// that BusinessDayCalculator now agrees with it.
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static CalendarRules rules_without_overrides() {
+    CalendarRules rules;
+    rules.overrides_path = "";
+    return rules;
+}
+
+static void test_holidays(const TradingCalendar& calendar) {
+    const std::vector<std::string> holidays_2024 = {
+        "2024-01-01", "2024-01-15", "2024-02-19", "2024-03-29", "2024-05-27",
+        "2024-06-19", "2024-07-04", "2024-09-02", "2024-11-28", "2024-12-25",
+    };
+    auto found = calendar.holidays_between("2024-01-01", "2024-12-31");
+    check("2024 exchange holidays", found == holidays_2024, std::to_string(found.size()) + " found");
+
+    check("Sunday New Year observed Monday", !calendar.is_trading_day("2023-01-02"));
+    check("Saturday New Year not moved into the old year", calendar.is_trading_day("2021-12-31"));
+    check("Saturday Christmas observed Friday", !calendar.is_trading_day("2027-12-24"));
+    check("Juneteenth only from 2022", calendar.is_trading_day("2021-06-18") && !calendar.is_trading_day("2023-06-19"));
+    check("Good Friday follows Easter", !calendar.is_trading_day("2025-04-18") && !calendar.is_trading_day("2019-04-19"));
+    check("weekends closed", !calendar.is_trading_day("2024-06-15") && !calendar.is_trading_day("2024-06-16"));
+}
+
+static void test_navigation(const TradingCalendar& calendar) {
+    check("next session skips Good Friday weekend", calendar.next_session("2024-03-28") == "2024-04-01",
+          calendar.next_session("2024-03-28"));
+    check("previous session skips Good Friday weekend", calendar.previous_session("2024-04-01") == "2024-03-28",
+          calendar.previous_session("2024-04-01"));
+    check("next session from a Friday is Monday", calendar.next_session("2024-06-14") == "2024-06-17");
+    check("next session over Christmas", calendar.next_session("2024-12-24") == "2024-12-26");
+    check("navigation outside the table falls back to weekdays", calendar.next_session("2150-01-02") == "2150-01-05",
+          calendar.next_session("2150-01-02"));
+
+    // Prefix counts agree with counting day by day
+    bool counts_match = true;
+    long long first = TradingCalendar::day_number("2019-12-20");
+    for (long long from = first; from < first + 400 && counts_match; from += 7) {
+        for (long long to = from; to < from + 60; to += 5) {
+            int expected = 0;
+            for (long long day = from; day < to; day++) expected += calendar.is_trading_day(day) ? 1 : 0;
+            if (calendar.sessions_between(from, to) != expected) {
+                counts_match = false;
+                break;
+            }
+        }
+    }
+    check("sessions_between matches a day-by-day count", counts_match);
+    check("252 sessions in 2024", calendar.sessions_between("2024-01-01", "2025-01-01") == 252,
+          std::to_string(calendar.sessions_between("2024-01-01", "2025-01-01")));
+}
+
+static void test_sessions(const TradingCalendar& calendar) {
+    SessionTimes black_friday = calendar.session("2024-11-29");
+    check("day after Thanksgiving closes early", black_friday.trading && black_friday.early_close &&
+                                                 black_friday.close == "13:00:00");
+    SessionTimes regular = calendar.session("2024-11-26");
+    check("regular session times", regular.trading && !regular.early_close && regular.open == "18:00:00" &&
+                                   regular.close == "17:00:00");
+    check("holiday has no session", !calendar.session("2024-11-28").trading);
+
+    check("evening after the open belongs to the next trade date",
+          calendar.trade_date_of("2024-03-31 19:00:00") == "2024-04-01");
+    check("afternoon belongs to the same trade date", calendar.trade_date_of("2024-03-28 16:45:00") == "2024-03-28");
+    check("Thursday evening before Good Friday has no session",
+          !calendar.is_trading_day(calendar.trade_date_of("2024-03-28 19:00:00")));
+}
+
+// The evening fetches look back at the session that just closed, not the
+// one the 18:00 open has already started
+static void test_evenings_before_holidays(const TradingCalendar& calendar) {
+    const std::vector<int> sun_to_thu = { 0, 1, 2, 3, 4 };
+    const std::vector<int> mon_to_fri = { 1, 2, 3, 4, 5 };
+    auto closed_by = [&](const std::string& date, const std::vector<int>& run_days) {
+        long long session = calendar.session_closed_by(TradingCalendar::day_number(date), run_days);
+        return session == -1 ? std::string("none") : TradingCalendar::format_day(session);
+    };
+
+    check("Thursday before Good Friday fetches its own session", closed_by("2024-03-28", sun_to_thu) == "2024-03-28",
+          closed_by("2024-03-28", sun_to_thu));
+    check("Wednesday before Thanksgiving fetches its own session", closed_by("2024-11-27", sun_to_thu) == "2024-11-27",
+          closed_by("2024-11-27", sun_to_thu));
+    check("Thanksgiving evening has nothing new", closed_by("2024-11-28", sun_to_thu) == "none");
+    check("Sunday after Good Friday has nothing new", closed_by("2024-03-31", sun_to_thu) == "none");
+    check("Sunday picks up Friday's session", closed_by("2024-06-16", sun_to_thu) == "2024-06-14",
+          closed_by("2024-06-16", sun_to_thu));
+    check("Good Friday evening has nothing new", closed_by("2025-04-18", mon_to_fri) == "none");
+    check("Friday before a Monday holiday fetches its own session",
+          closed_by("2024-01-12", mon_to_fri) == "2024-01-12" && closed_by("2024-01-15", mon_to_fri) == "none");
+
+    check("bar closing at the session close belongs to that session",
+          calendar.bar_trade_date_of("2024-03-28 17:00:00") == "2024-03-28");
+    check("bar closing at the 18:00 open belongs to the session before",
+          calendar.bar_trade_date_of("2024-03-28 18:00:00") == "2024-03-28");
+    check("first bar after the open before Good Friday has no session",
+          !calendar.is_trading_day(calendar.bar_trade_date_of("2024-03-28 18:15:00")));
+    check("Wednesday before Thanksgiving: the close is its own, evening bars are not",
+          calendar.is_trading_day(calendar.bar_trade_date_of("2024-11-27 17:00:00")) &&
+          !calendar.is_trading_day(calendar.bar_trade_date_of("2024-11-27 18:30:00")));
+    check("bar closing at midnight belongs to the overnight session",
+          calendar.bar_trade_date_of("2024-04-02 00:00:00") == "2024-04-02");
+}
+
+static void test_overrides() {
+    const std::string path = "trading_calendar_test_overrides.txt";
+    {
+        std::ofstream file(path);
+        file << "# National day of mourning\n"
+             << "2025-01-09 closed\n"
+             << "2025-01-10 early 12:15:00\n"
+             << "2024-11-28 open   # pretend Thanksgiving trades\n";
+    }
+
+    CalendarRules rules;
+    rules.overrides_path = path;
+    TradingCalendar calendar(rules);
+    std::remove(path.c_str());
+
+    check("override closes a day", !calendar.is_trading_day("2025-01-09"));
+    check("override early close with its own time", calendar.session("2025-01-10").close == "12:15:00");
+    check("override opens a holiday", calendar.is_trading_day("2024-11-28"));
+    check("counts see overrides", calendar.sessions_between("2025-01-06", "2025-01-13") == 4);
+}
+
+static void test_business_day_calculator(const TradingCalendar& calendar) {
+    auto thursday = BusinessDayCalculator::parse_date("2024-03-28") + std::chrono::hours(16);
+    auto next = BusinessDayCalculator::get_next_business_day(thursday);
+    check("BusinessDayCalculator skips Good Friday", BusinessDayCalculator::format_date(next) == "2024-04-01",
+          BusinessDayCalculator::format_date(next));
+    auto previous = BusinessDayCalculator::get_previous_business_day(next);
+    check("BusinessDayCalculator steps back over it", BusinessDayCalculator::format_date(previous) == "2024-03-28");
+
+    auto start = BusinessDayCalculator::parse_date("2024-12-23") + std::chrono::hours(12);
+    auto end = BusinessDayCalculator::parse_date("2025-01-03") + std::chrono::hours(12);
+    check("business days over the holidays", BusinessDayCalculator::count_business_days_between(start, end) ==
+                                             calendar.sessions_between("2024-12-23", "2025-01-03"));
+
+    // Cached local day against a fresh localtime, every 37 minutes through 2024 (both DST changes)
+    auto from = BusinessDayCalculator::parse_date("2024-01-01");
+    int mismatches = 0;
+    for (auto t = from; t < from + std::chrono::hours(24 * 366); t += std::chrono::minutes(37)) {
+        std::tm tm = BusinessDayCalculator::local_time(std::chrono::system_clock::to_time_t(t));
+        long long expected = TradingCalendar::days_from_civil(tm.tm_year + 1900, static_cast<unsigned>(tm.tm_mon + 1),
+                                                              static_cast<unsigned>(tm.tm_mday));
+        mismatches += BusinessDayCalculator::local_day(t) != expected ? 1 : 0;
+    }
+    check("cached local day matches localtime", mismatches == 0, std::to_string(mismatches) + " mismatches");
+}
+
+static void test_query_cost(const TradingCalendar& calendar) {
+    const int queries = 1000000;
+    long long first = TradingCalendar::day_number("2000-01-01");
+    long long sink = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < queries; i++) {
+        long long day = first + (i * 7919LL) % 30000;
+        sink += calendar.next_session(day) + calendar.sessions_between(day, day + 30) + calendar.is_trading_day(day);
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / queries;
+    std::cout << "   next_session + sessions_between + is_trading_day: " << ns << " ns (" << (sink & 1) << ")"
+              << std::endl;
+    check("calendar queries cost well under a microsecond", ns < 1000.0);
+}
+
+int main() {
+    std::cout << "=== TRADING CALENDAR TEST ===" << std::endl;
+
+    TradingCalendar calendar(rules_without_overrides());
+    test_holidays(calendar);
+    test_navigation(calendar);
+    test_sessions(calendar);
+    test_evenings_before_holidays(calendar);
+    test_overrides();
+    test_business_day_calculator(calendar);
+    test_query_cost(calendar);
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Trading calendar test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Trading calendar answers sessions and holidays in O(1)" << std::endl;
+    return 0;
+}
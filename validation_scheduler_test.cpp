@@ -0,0 +1,203 @@
+#include "ValidationScheduler.h"
+#include "PredictionValidator.h"
+#include "Database/database_simple.h"
+#include "Database/database_pool.h"
+#include "IQFeedConnection/Logger.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <set>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+// ==============================================
+// PARALLEL VALIDATION SCHEDULER TEST
+// ==============================================
+// Checks that DatabaseConnectionPool lends each of its connections to one
+// holder at a time (three workers hold three distinct connections, a fourth
+// waits for a release), and that a scheduler with an unreachable database
+// reports the failed partition query instead of success. When the database
+// is reachable, it seeds two symbols with daily and 15min predictions and
+// checks a three-worker run validates every one of them against the bar
+// after it and the workers' partial metrics merge. Like the nightly run,
+// that also validates anything else already due.
+
+static int g_failures = 0;
+
+static void check(const std::string& label, bool ok, const std::string& detail = "") {
+    std::cout << (ok ? "✅ " : "❌ ") << label;
+    if (!ok && !detail.empty()) std::cout << " (" << detail << ")";
+    std::cout << std::endl;
+    if (!ok) g_failures++;
+}
+
+static DatabaseConfig unreachable_config() {
+    DatabaseConfig config;
+    config.host = "127.0.0.1";
+    config.port = 1;
+    return config;
+}
+
+static void test_pool_leases() {
+    DatabaseConnectionPool pool(unreachable_config(), 3);
+    check("pool opens three connections", pool.size() == 3);
+
+    std::mutex mutex;
+    std::condition_variable all_held;
+    std::set<SimpleDatabaseManager*> held;
+    std::atomic<bool> release{false};
+    std::vector<std::thread> workers;
+
+    for (int w = 0; w < 3; w++) {
+        workers.emplace_back([&]() {
+            auto lease = pool.acquire();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                held.insert(lease.get());
+            }
+            all_held.notify_all();
+            while (!release.load()) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+        });
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        all_held.wait_for(lock, std::chrono::seconds(5), [&] { return held.size() == 3; });
+        check("three workers hold three distinct connections", held.size() == 3,
+              std::to_string(held.size()) + " distinct");
+    }
+
+    std::atomic<bool> fourth_acquired{false};
+    std::thread fourth([&]() {
+        auto lease = pool.acquire();
+        fourth_acquired = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    check("a fourth acquire waits while all are lent", !fourth_acquired.load());
+
+    release = true;
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    fourth.join();
+    check("it gets a connection once one is released", fourth_acquired.load());
+}
+
+static void test_unreachable_database() {
+    ValidationScheduler scheduler(unreachable_config(), 2);
+    ValidationRunStats stats = scheduler.run();
+    check("unreachable database is a failed run, not an empty one", !stats.partitions_loaded && !stats.ok());
+    check("no workers start without partitions", stats.workers == 0 && stats.predictions_validated == 0);
+}
+
+static void test_parallel_run(const DatabaseConfig& config, SimpleDatabaseManager& db) {
+    const std::vector<std::string> symbols = { "VSTEST_A", "VSTEST_B" };
+    std::vector<int> symbol_ids;
+    for (const auto& symbol : symbols) {
+        int symbol_id = db.get_or_create_symbol_id(symbol);
+        if (symbol_id <= 0) {
+            check("test symbols created", false, db.get_last_error());
+            return;
+        }
+        symbol_ids.push_back(symbol_id);
+    }
+
+    auto cleanup = [&]() {
+        for (int symbol_id : symbol_ids) {
+            std::string id = std::to_string(symbol_id);
+            db.execute_query("DELETE FROM predictions_all_symbols WHERE symbol_id = " + id);
+            db.execute_query("DELETE FROM historical_fetch_daily WHERE symbol_id = " + id);
+            db.execute_query("DELETE FROM historical_fetch_15min WHERE symbol_id = " + id);
+        }
+    };
+    cleanup();
+
+    // Actual bars: 2025-01-07 daily and the 10:15 15min bar, close 100 + symbol index
+    const int predictions_per_partition = 4;
+    for (std::size_t s = 0; s < symbols.size(); s++) {
+        double close = 100.0 + static_cast<double>(s);
+        db.insert_historical_data_daily(symbols[s], "2025-01-07", close, close, close, close, 10);
+        db.insert_historical_data_15min(symbols[s], "2025-01-06", "10:15:00", close, close, close, close, 10);
+
+        for (int i = 0; i < predictions_per_partition; i++) {
+            std::string id = std::to_string(symbol_ids[s]);
+            std::string price = std::to_string(close + i - 1.5);
+            db.execute_query("INSERT INTO predictions_all_symbols (prediction_time, symbol_id, model_id, timeframe, "
+                             "predicted_price, prediction_horizon) VALUES ('2025-01-06 0" + std::to_string(i) +
+                             ":00:00', " + id + ", 1, 'daily', " + price + ", 1)");
+            db.execute_query("INSERT INTO predictions_all_symbols (prediction_time, symbol_id, model_id, timeframe, "
+                             "predicted_price, prediction_horizon) VALUES ('2025-01-06 10:0" + std::to_string(i) +
+                             ":00', " + id + ", 1, '15min', " + price + ", 1)");
+        }
+    }
+
+    auto validator = std::make_unique<PredictionValidator>(std::make_shared<SimpleDatabaseManager>(config));
+    ValidationScheduler scheduler(config, 3);
+    ValidationRunStats stats = scheduler.run(validator.get());
+    scheduler.print_run_summary(stats);
+
+    const long long seeded = static_cast<long long>(symbols.size()) * 2 * predictions_per_partition;
+    check("run succeeds", stats.ok(), std::to_string(stats.failed_partitions) + " failed partitions");
+    check("the seeded partitions run on more than one worker", stats.workers > 1 && stats.partitions >= 4,
+          std::to_string(stats.workers) + " workers, " + std::to_string(stats.partitions) + " partitions");
+    check("every seeded prediction is validated", stats.predictions_validated >= seeded,
+          std::to_string(stats.predictions_validated) + " validated");
+
+    std::string ids = std::to_string(symbol_ids[0]) + ", " + std::to_string(symbol_ids[1]);
+    PGresult* result = db.execute_query_with_result(
+        "SELECT COUNT(*) FILTER (WHERE is_validated), "
+        "COUNT(*) FILTER (WHERE actual_price = 100 + (symbol_id <> " + std::to_string(symbol_ids[0]) + ")::int) "
+        "FROM predictions_all_symbols WHERE symbol_id IN (" + ids + ")");
+    if (result) {
+        long long validated = std::stoll(PQgetvalue(result, 0, 0));
+        long long matched = std::stoll(PQgetvalue(result, 0, 1));
+        PQclear(result);
+        check("seeded rows are marked validated", validated == seeded, std::to_string(validated));
+        check("each got the bar after its prediction", matched == seeded, std::to_string(matched));
+    } else {
+        check("seeded rows can be read back", false, db.get_last_error());
+    }
+
+    const MetricsAccumulator& daily = stats.metrics[PredictionValidator::MetricsKey(1, "daily")];
+    const MetricsAccumulator& intraday = stats.metrics[PredictionValidator::MetricsKey(1, "15min")];
+    check("worker metrics merge across symbols", daily.count >= seeded / 2 && intraday.count >= seeded / 2,
+          std::to_string(daily.count) + " daily, " + std::to_string(intraday.count) + " 15min");
+
+    cleanup();
+}
+
+int main() {
+    std::cout << "=== VALIDATION SCHEDULER TEST ===" << std::endl;
+    Logger::set_console_mirror(false);
+
+    test_pool_leases();
+    test_unreachable_database();
+
+    DatabaseConfig config;
+    config.host = "localhost";
+    config.port = 5432;
+    config.database = "nexday_trading";
+    config.username = "postgres";
+    config.password = "magical.521";
+
+    SimpleDatabaseManager db(config);
+    if (db.is_connected()) {
+        test_parallel_run(config, db);
+    } else {
+        std::cout << "➖ Database not available - parallel run checks skipped" << std::endl;
+    }
+
+    if (g_failures > 0) {
+        std::cout << "\n❌ Validation scheduler test FAILED (" << g_failures << " checks)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "\n✅ Pooled workers validate the backlog in parallel" << std::endl;
+    return 0;
+}